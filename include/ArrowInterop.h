@@ -0,0 +1,45 @@
+#pragma once
+
+#include "ArrowCDataInterface.h"
+#include "Exports.h"
+#include "SmartPointer.h"
+#include "Table.h"
+#include "Types.h"
+#include "Vector.h"
+
+namespace dolphindb {
+
+/**
+ * Hand a table to an Arrow consumer in the same process (Polars, DuckDB, pyarrow, ...) through
+ * the Arrow C data interface, without an Arrow library.
+ *
+ * The table becomes a struct array with one child per column. Columns whose values are laid out
+ * as Arrow expects (CHAR, SHORT, INT, LONG, FLOAT, DOUBLE, DATE, TIME, SECOND, NANOTIME,
+ * TIMESTAMP, NANOTIMESTAMP and DECIMAL128) are exported without a copy: the Arrow buffer is the
+ * vector's own, kept alive until the consumer calls release, so the vector mustn't be changed
+ * meanwhile. Validity bitmaps are computed from the null values. SYMBOL columns become
+ * dictionary-encoded strings whose indices are likewise shared. Other columns are converted in one
+ * pass: BOOL to bits, STRING and BLOB to utf8 and binary, MONTH to date32, MINUTE to time32[s],
+ * DATETIME and DATEHOUR to timestamp[s], DECIMAL32 and DECIMAL64 to decimal128. Timestamps
+ * carry no time zone. Other types throw a RuntimeException.
+ *
+ * schema and array are filled in and belong to the caller, who must release them.
+ */
+EXPORT_DECL void exportToArrow(const TableSP& table, ArrowSchema* schema, ArrowArray* array);
+EXPORT_DECL void exportToArrow(const VectorSP& vector, ArrowSchema* schema, ArrowArray* array);
+
+/**
+ * Take data from an Arrow producer: a struct array becomes a table and any other array a
+ * vector, mapping types the opposite way of exportToArrow; dictionary-encoded strings become
+ * SYMBOL, timestamp[us] and time64[us] become NANOTIMESTAMP and NANOTIME, and date64 becomes
+ * TIMESTAMP. Fixed-width arrays without nulls are imported without a copy and keep the Arrow data
+ * alive until the last vector over it is gone; those vectors are read-only (isReadOnly), as the
+ * buffers belong to the producer. Arrays with nulls are copied so the nulls can be written as
+ * null values.
+ *
+ * The array is moved from (its release is set to NULL) and the schema is released, also when an
+ * exception is thrown.
+ */
+EXPORT_DECL ConstantSP importFromArrow(ArrowSchema* schema, ArrowArray* array);
+
+}
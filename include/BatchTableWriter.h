@@ -8,10 +8,13 @@
 #include "Constant.h"
 #include "Dictionary.h"
 #include "Table.h"
+#include "Tracing.h"
+#include "SymbolEncoder.h"
 #include <unordered_map>
 #include <string>
 #include <vector>
 #include <memory>
+#include <atomic>
 #include <functional>
 #include <tuple>
 #include <cassert>
@@ -23,8 +26,15 @@ class EXPORT_DECL BatchTableWriter {
 public:
     /**
      * If fail to connect to the specified DolphinDB server, this function throw an exception.
+     * The background thread of a table sends the buffered rows once there are batchSize rows, once they take
+     * batchBytes bytes (0 disables the byte limit), or once the oldest row has waited throttle milliseconds.
+     * The defaults send rows as soon as they are inserted.
+     * With workerCount 0 every added table gets its own connection and background thread. Otherwise workerCount
+     * threads, each with one connection, flush all tables, and the batches of several tables that are due at the
+     * same time are sent in one request.
      */
-    BatchTableWriter(const std::string& hostName, int port, const std::string& userId, const std::string& password, bool acquireLock=true);
+    BatchTableWriter(const std::string& hostName, int port, const std::string& userId, const std::string& password, bool acquireLock=true,
+                     int batchSize=1, long long batchBytes=0, int throttle=0, int workerCount=0);
 
     virtual ~BatchTableWriter();
 
@@ -73,7 +83,7 @@ public:
      */
     template<typename... Targs>
     void insert(const std::string& dbName, const std::string& tableName, Targs... Fargs){
-        //RECORDTIME("BTW::insert");
+        DDB_TRACE("BatchTableWriter::insert");
         SmartPointer<DestTable> destTable;
         {
             RWLockGuard<RWLock> _(&rwLock, false, acquireLock_);
@@ -96,6 +106,7 @@ public:
 
 private:
     struct DestTable{
+        DestTable() : pendingRows(0) {}
         SmartPointer<DBConnection> conn;
         std::string dbName;
         std::string tableName;
@@ -107,28 +118,50 @@ private:
         std::vector<std::string> colNames;
         std::vector<DATA_TYPE> colTypes;
         std::string createTmpSharedTable;
-        SynchronizedQueue<std::vector<ConstantSP>> writeQueue;
-        SynchronizedQueue<std::vector<ConstantSP>> saveQueue;
+        bool partitioned = true;
         ThreadSP writeThread;
-        TableSP writeTable;
+        SymbolEncoder symbolEncoder;
 
+        //Inserts append to activeColumns. The write thread swaps them with flushColumns, which it cleared after
+        //the previous send, so both buffers keep their capacity. SYMBOL columns are buffered as STRING and
+        //encoded by the write thread.
         Mutex writeMutex;
         ConditionalVariable writeNotifier;
-        
+        std::vector<VectorSP> activeColumns;
+        std::vector<VectorSP> flushColumns;
+        //Columns of the batch that failed to be sent
+        std::vector<VectorSP> failedColumns;
+        int activeRows = 0;
+        long long activeBytes = 0;
+        //Epoch milliseconds of the oldest row in activeColumns
+        long long activeSince = -1;
+        //Rows inserted but not sent yet
+        std::atomic<int> pendingRows;
+        //Set while a pool worker sends the flush columns of this table
+        bool flushing = false;
+        int fixedRowBytes = 0;
+
         int sendedRows = 0;
         bool destroy = false;
         bool finished = false;
     };
-    //write failed or no data
+    //Wait for a flush trigger, swap the buffers and send. Returns false once the table is removed.
     bool writeTableAllData(SmartPointer<DestTable> destTable,bool partitioned);
+    bool readyToFlush(const DestTable* destTable, long long now) const;
+    //Swap the buffers of a table under its writeMutex and return the number of rows to send.
+    int takeBatch(DestTable* destTable);
+    void finishBatch(DestTable* destTable, int rows, bool succeeded);
+    //Send the flush columns of the tables. Tables that can be written by a plain tableInsert share one request.
+    void sendBatches(DBConnection& conn, const std::vector<DestTable*>& tables, const std::vector<int>& rows, std::vector<bool>& succeeded);
+    void runWorker(DBConnection* conn);
+    void appendRow(DestTable* destTable, const std::vector<ConstantSP>& row);
     void insertRecursive(std::vector<ConstantSP>* row, DestTable* destTable, int colIndex){
         assert(colIndex == destTable->columnNum);
         RWLockGuard<RWLock> _(&rwLock, false, acquireLock_);
         if(destTable->finished){
             throw RuntimeException(std::string("Failed to insert data. Error writing data in backgroud thread. Please use getUnwrittenData to get data not written to server and remove talbe (") + destTable->dbName + " " + destTable->tableName + ").");
         }
-        destTable->writeQueue.push(std::move(*row));
-        destTable->writeNotifier.notify();
+        appendRow(destTable, *row);
     }
 
     template<typename T, typename... Targs>
@@ -170,6 +203,19 @@ private:
     const std::string userId_;
     const std::string password_;
     bool acquireLock_;
+    const int batchSize_;
+    const long long batchBytes_;
+    const int throttle_;
+
+    //Shared flush pool, used when workerCount > 0
+    static const int MAX_TABLES_PER_REQUEST = 64;
+    const int workerCount_;
+    std::vector<SmartPointer<DBConnection>> workerConns_;
+    std::vector<ThreadSP> workers_;
+    std::vector<SmartPointer<DestTable>> pooledTables_;
+    Mutex scheduleMutex_;
+    ConditionalVariable scheduleNotifier_;
+    bool stopping_;
 
     struct pairHash{
         std::size_t operator()(std::pair<std::string,std::string> const& p) const noexcept{
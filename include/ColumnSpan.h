@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "Exceptions.h"
+#include "Types.h"
+#include "Util.h"
+#include "Vector.h"
+
+namespace dolphindb {
+
+/**
+ * Non-owning, contiguous run of column values, like a read-only std::span. Loops over a span
+ * index a plain pointer, so compilers can unroll and vectorize them.
+ */
+template<class T>
+class ColumnSpan {
+public:
+    typedef T value_type;
+    typedef const T* const_iterator;
+
+    ColumnSpan() : data_(nullptr), size_(0) {}
+    ColumnSpan(const T* data, INDEX size) : data_(data), size_(size) {}
+
+    const T* data() const { return data_; }
+    INDEX size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T& operator[](INDEX index) const { return data_[index]; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    ColumnSpan subspan(INDEX offset, INDEX length) const { return ColumnSpan(data_ + offset, length); }
+
+private:
+    const T* data_;
+    INDEX size_;
+};
+
+namespace column_view_detail {
+
+template<class T> struct Accessor;
+
+#define DDB_COLUMN_ACCESSOR(T, GETTER, RAW1, RAW2) \
+template<> struct Accessor<T> { \
+    static const T* get(const Vector* vec, INDEX start, int len, T* buf) { return vec->GETTER(start, len, buf); } \
+    static bool matches(DATA_TYPE raw) { return raw == RAW1 || raw == RAW2; } \
+};
+DDB_COLUMN_ACCESSOR(char, getCharConst, DT_CHAR, DT_BOOL)
+DDB_COLUMN_ACCESSOR(short, getShortConst, DT_SHORT, DT_SHORT)
+DDB_COLUMN_ACCESSOR(int, getIntConst, DT_INT, DT_INT)
+DDB_COLUMN_ACCESSOR(long long, getLongConst, DT_LONG, DT_LONG)
+DDB_COLUMN_ACCESSOR(float, getFloatConst, DT_FLOAT, DT_FLOAT)
+DDB_COLUMN_ACCESSOR(double, getDoubleConst, DT_DOUBLE, DT_DOUBLE)
+#undef DDB_COLUMN_ACCESSOR
+
+}
+
+/**
+ * Typed, read-only view of a range of a vector, replacing the std::function based
+ * Util::enum*Vector helpers. When the vector is a fast vector whose storage already has type T
+ * (e.g. ColumnView<int> over INT, DATE or SYMBOL, ColumnView<double> over DOUBLE) the view is
+ * contiguous and span() hands out the storage itself. Otherwise values are converted through
+ * the get*Const accessors in chunks of Util::BUF_SIZE, and forEachSpan/iterators walk the
+ * chunks. Supported element types are char, short, int, long long, float and double.
+ *
+ * The view borrows the vector: it must not be resized while the view is in use.
+ */
+template<class T>
+class ColumnView {
+    typedef column_view_detail::Accessor<T> Accessor;
+public:
+    typedef T value_type;
+
+    explicit ColumnView(const VectorSP& vec, INDEX offset = 0, INDEX length = -1)
+            : vec_(vec), offset_(offset), data_(nullptr) {
+        if (vec.isNull())
+            throw RuntimeException("ColumnView requires a vector.");
+        INDEX total = vec->size();
+        if (offset < 0 || offset > total)
+            throw RuntimeException("ColumnView offset " + std::to_string(offset) + " is out of range.");
+        size_ = length < 0 ? total - offset : (std::min)(length, total - offset);
+        if (vec->isFastMode() && Accessor::matches(vec->getRawType()) && vec->getDataArray() != nullptr)
+            data_ = static_cast<const T*>(vec->getDataArray()) + offset;
+    }
+
+    INDEX size() const { return size_; }
+    bool isContiguous() const { return data_ != nullptr; }
+
+    //The whole range as one span. Only available for contiguous views.
+    ColumnSpan<T> span() const {
+        if (data_ == nullptr)
+            throw RuntimeException("ColumnView over a " + Util::getDataTypeString(vec_->getType()) + " vector is not contiguous.");
+        return ColumnSpan<T>(data_, size_);
+    }
+
+    //Single value. Cheap for contiguous views, a virtual call for the others.
+    T operator[](INDEX index) const {
+        if (data_ != nullptr)
+            return data_[index];
+        T value;
+        return *Accessor::get(vec_.get(), offset_ + index, 1, &value);
+    }
+
+    /**
+     * Call func(ColumnSpan<T> span, INDEX start) for consecutive chunks covering the view,
+     * where start is the position of span[0] within the view. A contiguous view is a single
+     * chunk. Returning false from func stops the walk; func may also return void.
+     */
+    template<class F>
+    void forEachSpan(F func) const {
+        if (data_ != nullptr) {
+            invoke(func, ColumnSpan<T>(data_, size_), 0);
+            return;
+        }
+        T buf[Util::BUF_SIZE];
+        for (INDEX start = 0; start < size_; start += Util::BUF_SIZE) {
+            int len = (int)(std::min)((INDEX)Util::BUF_SIZE, size_ - start);
+            const T* chunk = Accessor::get(vec_.get(), offset_ + start, len, buf);
+            if (!invoke(func, ColumnSpan<T>(chunk, len), start))
+                return;
+        }
+    }
+
+    //Call func(T value) for every value of the view.
+    template<class F>
+    void forEach(F func) const {
+        forEachSpan([&](ColumnSpan<T> span, INDEX) {
+            const T* data = span.data();
+            INDEX len = span.size();
+            for (INDEX i = 0; i < len; ++i)
+                func(data[i]);
+        });
+    }
+
+    /**
+     * Forward iterator. Over a contiguous view it is a pointer walk; otherwise it refills a
+     * private buffer of Util::BUF_SIZE values whenever it crosses a chunk boundary.
+     */
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator() : view_(nullptr), index_(0), cur_(nullptr), limit_(nullptr) {}
+        const_iterator(const ColumnView* view, INDEX index) : view_(view), index_(index), cur_(nullptr), limit_(nullptr) {
+            if (view != nullptr && view->data_ != nullptr) {
+                cur_ = view->data_ + index;
+                limit_ = view->data_ + view->size_;
+            }
+        }
+        //A copy refills its own buffer instead of pointing into the original's.
+        const_iterator(const const_iterator& other) : const_iterator(other.view_, other.index_) {}
+        const_iterator& operator=(const const_iterator& other) {
+            if (this != &other) {
+                const_iterator copy(other);
+                view_ = copy.view_;
+                index_ = copy.index_;
+                cur_ = copy.cur_;
+                limit_ = copy.limit_;
+            }
+            return *this;
+        }
+
+        const T& operator*() const {
+            if (cur_ == limit_)
+                const_cast<const_iterator*>(this)->load();
+            return *cur_;
+        }
+        const T* operator->() const { return &**this; }
+        const_iterator& operator++() { ++index_; ++cur_; return *this; }
+        const_iterator operator++(int) { const_iterator old(*this); ++*this; return old; }
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        void load() {
+            buffer_.resize(Util::BUF_SIZE);
+            int len = (int)(std::min)((INDEX)Util::BUF_SIZE, view_->size_ - index_);
+            cur_ = Accessor::get(view_->vec_.get(), view_->offset_ + index_, len, buffer_.data());
+            limit_ = cur_ + len;
+        }
+
+        const ColumnView* view_;
+        INDEX index_;
+        const T* cur_;
+        const T* limit_;
+        std::vector<T> buffer_;
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+private:
+    template<class F>
+    static auto invoke(F& func, ColumnSpan<T> span, INDEX start) -> decltype(func(span, start), bool()) {
+        return callAndCheck(func, span, start, std::is_same<decltype(func(span, start)), bool>());
+    }
+    template<class F>
+    static bool callAndCheck(F& func, ColumnSpan<T> span, INDEX start, std::true_type) { return func(span, start); }
+    template<class F>
+    static bool callAndCheck(F& func, ColumnSpan<T> span, INDEX start, std::false_type) { func(span, start); return true; }
+
+    VectorSP vec_;
+    INDEX offset_;
+    INDEX size_;
+    const T* data_;
+};
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Exports.h"
+#include "Types.h"
+#include "SmartPointer.h"
+#include "Table.h"
+#include "Vector.h"
+
+namespace dolphindb {
+
+class MappedFile;
+
+/**
+ * A table saved in one file, column by column, for reloading without a server.
+ *
+ * Every column occupies its own contiguous section, aligned to 64 bytes, and a footer at the end
+ * of the file records the schema and where each section is. Fixed-width columns without a codec
+ * (BOOL, CHAR, SHORT, INT, LONG, FLOAT, DOUBLE and the temporal types) are stored as their raw
+ * values; all others, and every column with a COMPRESS_LZ4 or COMPRESS_DELTA codec, are stored
+ * in the VectorMarshall wire format, compressed by the same encoders as over the network.
+ *
+ * Opening a file maps it and reads only the footer. Columns are loaded on first use: a raw
+ * column becomes a vector pointing straight into the mapping, with no copy; the mapping is private
+ * copy-on-write, so such a vector may still be modified without touching the file.
+ */
+class EXPORT_DECL ColumnarFile {
+public:
+    /**
+     * Save table to path, replacing the file. compressMethods holds a codec per column; when empty,
+     * the table's own column compress methods are used. Columns are encoded by up to workerCount
+     * threads at once, 0 meaning one per core.
+     */
+    static void write(const std::string& path, const TableSP& table, const std::vector<COMPRESS_METHOD>& compressMethods = {},
+                      int workerCount = 0);
+
+    explicit ColumnarFile(const std::string& path);
+    ~ColumnarFile();
+
+    INDEX rows() const { return rows_; }
+    int columns() const { return (int)columns_.size(); }
+    const std::string& getColumnName(int index) const { return columns_[index].name; }
+    DATA_TYPE getColumnType(int index) const { return columns_[index].type; }
+    COMPRESS_METHOD getColumnCompressMethod(int index) const { return columns_[index].compressMethod; }
+    //-1 if there is no such column.
+    int getColumnIndex(const std::string& name) const;
+
+    //Load the column on first use; later calls return the same vector.
+    VectorSP getColumn(int index);
+    VectorSP getColumn(const std::string& name);
+    //A table of all columns, or of the named ones in the given order.
+    TableSP getTable();
+    TableSP getTable(const std::vector<std::string>& colNames);
+
+private:
+    struct Column {
+        std::string name;
+        DATA_TYPE type;
+        int extra;
+        COMPRESS_METHOD compressMethod;
+        bool raw;
+        bool containNull;
+        long long offset;
+        long long length;
+        VectorSP vector;
+    };
+
+    VectorSP load(const Column& column) const;
+
+    std::string path_;
+    std::shared_ptr<MappedFile> file_;
+    INDEX rows_;
+    std::vector<Column> columns_;
+    std::unordered_map<std::string, int> nameIndex_;
+};
+
+}
@@ -483,6 +483,13 @@ private:
 #endif
 };
 
+/**
+ * Run func(0) .. func(count - 1) concurrently, func(0) on the calling thread and each of the
+ * others on a Thread of its own, and return when all have finished. If any of them throws, the
+ * first message in index order is rethrown as a RuntimeException.
+ */
+EXPORT_DECL void runInParallel(size_t count, const std::function<void(size_t)>& func);
+
 class EXPORT_DECL SemLock{
 public:
 	SemLock(Semaphore &sem, bool acquired = false)
@@ -11,6 +11,7 @@
 #include <climits>
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <stdio.h>
 #include <cstring>
 #include <iostream>
@@ -20,6 +21,8 @@
 #include <iomanip>
 #include <map>
 #include <deque>
+#include <atomic>
+#include <mutex>
 
 #include "Util.h"
 #include "ScalarImp.h"
@@ -27,6 +30,8 @@
 #include "WideInteger.h"
 #include "SysIO.h"
 #include "Matrix.h"
+#include "VectorKernels.h"
+#include "TemporalKernels.h"
 
 
 namespace dolphindb {
@@ -156,7 +161,42 @@ public:
 		data_ = srcData;
 	}
 	virtual ~AbstractFastVector(){
-		delete[] data_;
+		releaseData();
+	}
+
+	/**
+	 * Point the vector at size values of storage it doesn't own, such as a mapped file, kept alive
+	 * by owner. The vector never frees that storage: growing it copies the values into a buffer of
+	 * its own first. A readOnly vector is flagged with setReadOnly; its storage must not be written
+	 * to, and sub vectors of it share the storage rather than copy it.
+	 */
+	void setExternalData(T* data, INDEX size, const std::shared_ptr<void>& owner, bool containNull, bool readOnly = false){
+		releaseData();
+		data_ = data;
+		size_ = size;
+		capacity_ = size;
+		containNull_ = containNull;
+		dataOwner_ = owner;
+		setReadOnly(readOnly);
+	}
+
+	/**
+	 * An owner of the values, for views that share them. A buffer the vector allocated itself is
+	 * first handed to a shared owner, so it outlives the vector and any later growth; views still
+	 * see in-place updates. Safe to call from several readers at once; they all get the same owner.
+	 */
+	std::shared_ptr<void> shareData() const {
+		std::shared_ptr<void> owner = std::atomic_load(&dataOwner_);
+		if(owner)
+			return owner;
+		static std::mutex shareMutex;
+		std::lock_guard<std::mutex> guard(shareMutex);
+		owner = std::atomic_load(&dataOwner_);
+		if(!owner){
+			owner = std::shared_ptr<T>(data_, std::default_delete<T[]>());
+			std::atomic_store(&dataOwner_, owner);
+		}
+		return owner;
 	}
 
 	virtual INDEX reserve(INDEX capacity){
@@ -164,7 +204,7 @@ public:
 			INDEX newCapacity= (std::max)((INDEX)(capacity_ * 1.2), capacity);
 			T* newData = new T[newCapacity];
 			memcpy(newData,data_,size_*sizeof(T));
-			delete[] data_;
+			releaseData();
 			data_=newData;
 			capacity_=newCapacity;
 		}
@@ -172,19 +212,20 @@ public:
 	}
 
 	virtual bool isSorted(bool asc, bool strict=false) const {
-		if (size_ <= 1) {
-			return true;
-		}
-		for (int i = 1; i < size_; i++) {
-			if (asc) {
-				if (strict && data_[i] <= data_[i-1]) return false;
-				if (!strict && data_[i] < data_[i-1]) return false;
-			} else {
-				if (strict && data_[i] >= data_[i-1]) return false;
-				if (!strict && data_[i] > data_[i-1]) return false;
-			}
-		}
-		return true;
+		return kernels::isSorted(data_, size_, asc, strict);
+	}
+
+	virtual VectorStats stats() const {
+		kernels::Reduction<T> reduction;
+		kernels::reduce(data_, size_, nullVal_, reduction);
+		VectorStats result;
+		result.count = size_ - reduction.nullCount;
+		result.nullCount = reduction.nullCount;
+		result.min = createScalar(reduction.min);
+		result.max = createScalar(reduction.max);
+		result.sum = static_cast<double>(reduction.sum);
+		result.avg = result.count > 0 ? result.sum / result.count : DBL_NMIN;
+		return result;
 	}
 
 	virtual ConstantSP getSubVector(INDEX start, INDEX length) const {
@@ -193,6 +234,12 @@ public:
 
 	virtual ConstantSP getSubVector(INDEX start, INDEX length, INDEX capacity) const {
 		DATA_TYPE type = getType();
+		std::shared_ptr<void> owner = std::atomic_load(&dataOwner_);
+		if(owner && isReadOnly() && length >= 0){
+			VectorSP sub = Util::createVector(type, 0, 1, true, getExtraParamForType());
+			static_cast<AbstractFastVector<T>*>(sub.get())->setExternalData(data_ + start, length, owner, containNull_, true);
+			return sub;
+		}
 		T* data = getDataArray(start,length,capacity);
 		if(data)
 			return Util::createVector(type,std::abs(length), capacity, true, getExtraParamForType(), data, containNull_);
@@ -299,8 +346,7 @@ public:
 	}
 
 	bool hasNullInRange(INDEX start, INDEX end){
-		for(;start<end && data_[start]!=nullVal_;++start);
-		return start<end;
+		return start < end && kernels::findNull(data_ + start, end - start, nullVal_) < end - start;
 	}
 
 	virtual INDEX getCapacity() const {return capacity_;}
@@ -863,6 +909,42 @@ public:
 	}
 
 protected:
+	/**
+	 * Body of castTemporal for the temporal vectors. With inPlace, a target type of the same width
+	 * is converted in this vector's buffer, which the result takes over; this vector is left empty.
+	 */
+	ConstantSP convertTemporal(DATA_TYPE expectType, bool inPlace){
+		DATA_TYPE type = getType();
+		if(!kernels::canConvertTemporal(type, expectType))
+			throw RuntimeException("castTemporal from "+ Util::getDataTypeString(type)+" to "+ Util::getDataTypeString(expectType)+" not supported ");
+		if(!inPlace || dataOwner_ || Util::getDataTypeSize(expectType) != (int)sizeof(T)){
+			if(expectType == type)
+				return getValue();
+			VectorSP res = Util::createVector(expectType, size_);
+			kernels::convertTemporal(type, data_, expectType, res->getDataArray(), size_);
+			res->setNullFlag(containNull_);
+			return res;
+		}
+		kernels::convertTemporal(type, data_, expectType, data_, size_);
+		T* data = data_;
+		INDEX size = size_;
+		INDEX capacity = capacity_;
+		bool containNull = containNull_;
+		data_ = new T[1];
+		size_ = 0;
+		capacity_ = 1;
+		containNull_ = false;
+		return Util::createVector(expectType, size, capacity, true, 0, (void*)data, containNull);
+	}
+
+	//A scalar of this vector's type (and scale) holding the raw value.
+	ConstantSP createScalar(T raw) const {
+		T* data = new T[1];
+		data[0] = raw;
+		VectorSP vec = Util::createVector(getType(), 1, 1, true, getExtraParamForType(), (void*)data, raw == nullVal_);
+		return vec->get(0);
+	}
+
 	void replaceNull(T rep){
 		for(int i=0;i<size_;++i)
 			if(data_[i]==nullVal_)
@@ -960,7 +1042,7 @@ protected:
 			INDEX newCapacity= static_cast<INDEX>((size_ + appendSize) * 1.2);
 			T* newData = new T[newCapacity];
 			memcpy(newData,data_,size_*sizeof(T));
-			delete[] data_;
+			releaseData();
 			capacity_=newCapacity;
 			data_=newData;
 		}
@@ -1095,6 +1177,17 @@ protected:
 	int capacity_;
 	bool containNull_;
 	DATA_TYPE dataType_;
+
+private:
+	void releaseData(){
+		if(dataOwner_)
+			dataOwner_.reset();
+		else
+			delete[] data_;
+	}
+
+	//Keeps data_ alive when it points into storage the vector doesn't own or shares; null otherwise.
+	mutable std::shared_ptr<void> dataOwner_;
 };
 
 class FastVoidVector:public AbstractFastVector<char>{
@@ -1429,7 +1522,8 @@ public:
 	virtual DATA_CATEGORY getCategory() const {return TEMPORAL;}
 	virtual bool isIndexArray() const { return false;}
 	virtual INDEX* getIndexArray() const { return NULL;}
-	virtual ConstantSP castTemporal(DATA_TYPE expectType) = 0;
+	virtual ConstantSP castTemporal(DATA_TYPE expectType){return convertTemporal(expectType, false);}
+	virtual ConstantSP castTemporalInPlace(DATA_TYPE expectType){return convertTemporal(expectType, true);}
 };
 
 class FastArrayVector: public Vector {
@@ -1607,7 +1701,6 @@ public:
 	virtual ConstantSP get(INDEX index) const {return ConstantSP(new Date(data_[index]));}
 	virtual ConstantSP get(const ConstantSP& index) const;
 	virtual std::string getString(INDEX index) const {return Date::toString(data_[index]);}
-	virtual ConstantSP castTemporal(DATA_TYPE expectType);
 };
 
 class FastDateTimeVector:public FastTemporalVector{
@@ -1620,7 +1713,6 @@ public:
 	virtual ConstantSP get(INDEX index) const {return ConstantSP(new DateTime(data_[index]));}
 	virtual ConstantSP get(const ConstantSP& index) const;
 	virtual std::string getString(INDEX index) const { return DateTime::toString(data_[index]);}
-	virtual ConstantSP castTemporal(DATA_TYPE expectType);
 };
 
 class FastDateHourVector:public FastTemporalVector{
@@ -1633,7 +1725,6 @@ public:
     virtual ConstantSP get(INDEX index) const {return ConstantSP(new DateHour(data_[index]));}
     virtual ConstantSP get(const ConstantSP& index) const;
     virtual std::string getString(INDEX index) const { return DateHour::toString(data_[index]);}
-    virtual ConstantSP castTemporal(DATA_TYPE expectType);
 };
 
 class FastMonthVector:public FastTemporalVector{
@@ -1646,12 +1737,6 @@ public:
 	virtual ConstantSP get(INDEX index) const {return ConstantSP(new Month(data_[index]));}
 	virtual ConstantSP get(const ConstantSP& index) const;
 	virtual std::string getString(INDEX index) const { return Month::toString(data_[index]);}
-	virtual ConstantSP castTemporal(DATA_TYPE expectType){
-		if(expectType == DT_MONTH)
-			return getValue();
-		else
-			throw RuntimeException("castTemporal from MONTH to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
 };
 
 class FastTimeVector:public FastTemporalVector{
@@ -1665,7 +1750,6 @@ public:
 	virtual ConstantSP get(const ConstantSP& index) const;
 	virtual std::string getString(INDEX index) const { return Time::toString(data_[index]);}
 	virtual void validate();
-	virtual ConstantSP castTemporal(DATA_TYPE expectType);
 };
 
 class FastMinuteVector:public FastTemporalVector{
@@ -1679,7 +1763,6 @@ public:
 	virtual ConstantSP get(const ConstantSP& index) const;
 	virtual std::string getString(INDEX index) const { return Minute::toString(data_[index]);}
 	virtual void validate();
-	virtual ConstantSP castTemporal(DATA_TYPE expectType);
 };
 
 class FastSecondVector:public FastTemporalVector{
@@ -1693,7 +1776,6 @@ public:
 	virtual ConstantSP get(const ConstantSP& index) const;
 	virtual std::string getString(INDEX index) const { return Second::toString(data_[index]);}
 	virtual void validate();
-	virtual ConstantSP castTemporal(DATA_TYPE expectType);
 };
 
 class FastNanoTimeVector:public FastLongVector{
@@ -1708,7 +1790,8 @@ public:
 	virtual ConstantSP get(const ConstantSP& index) const;
 	virtual std::string getString(INDEX index) const { return NanoTime::toString(data_[index]);}
 	virtual void validate();
-	virtual ConstantSP castTemporal(DATA_TYPE expectType);
+	virtual ConstantSP castTemporal(DATA_TYPE expectType){return convertTemporal(expectType, false);}
+	virtual ConstantSP castTemporalInPlace(DATA_TYPE expectType){return convertTemporal(expectType, true);}
 };
 
 class FastTimestampVector:public FastLongVector{
@@ -1722,7 +1805,8 @@ public:
 	virtual ConstantSP get(INDEX index) const {return ConstantSP(new Timestamp(data_[index]));}
 	virtual ConstantSP get(const ConstantSP& index) const;
 	virtual std::string getString(INDEX index) const { return Timestamp::toString(data_[index]);}
-	virtual ConstantSP castTemporal(DATA_TYPE expectType);
+	virtual ConstantSP castTemporal(DATA_TYPE expectType){return convertTemporal(expectType, false);}
+	virtual ConstantSP castTemporalInPlace(DATA_TYPE expectType){return convertTemporal(expectType, true);}
 };
 
 class FastNanoTimestampVector:public FastLongVector{
@@ -1736,7 +1820,8 @@ public:
 	virtual ConstantSP get(INDEX index) const {return ConstantSP(new NanoTimestamp(data_[index]));}
 	virtual ConstantSP get(const ConstantSP& index) const;
 	virtual std::string getString(INDEX index) const { return NanoTimestamp::toString(data_[index]);}
-	virtual ConstantSP castTemporal(DATA_TYPE expectType);
+	virtual ConstantSP castTemporal(DATA_TYPE expectType){return convertTemporal(expectType, false);}
+	virtual ConstantSP castTemporalInPlace(DATA_TYPE expectType){return convertTemporal(expectType, true);}
 };
 
 class FastBoolMatrix:public Matrix, public FastBoolVector{
@@ -2338,9 +2423,31 @@ protected:
 	bool containNull_;
 };
 
+/**
+ * Non-owning view of one element of a string or blob vector. The bytes of a string are
+ * followed by '\0'; blobs may contain zeros themselves, so always go by length.
+ */
+struct StringView {
+	const char* data;
+	size_t length;
+	std::string toString() const { return std::string(data, length);}
+};
+
+/**
+ * A string or blob vector. By default each element is a std::string. In arena mode the
+ * elements are instead stored back to back in one byte buffer and addressed by an offsets
+ * array, so decoding a column of n strings costs a couple of buffer growths rather than n
+ * allocations. Reads, appends and serialization work on the arena directly; any call that
+ * needs a std::string (getStringRef, getStringConst(std::string**), in-place updates, ...)
+ * first converts the vector to the legacy layout with materialize(). A call that modifies the
+ * vector frees the arena once converted. Concurrent const readers may trigger the conversion
+ * too: it runs once under a lock, and the arena stays readable until the next modification, so
+ * readers still on the arena are not affected. Prefer getStringView in read paths; it never
+ * converts the vector.
+ */
 class StringVector: public AbstractStringVector{
 public:
-	StringVector(INDEX size, INDEX capacity, bool blob = false);
+	StringVector(INDEX size, INDEX capacity, bool blob = false, bool arena = false);
 	StringVector(const std::vector<std::string>& data, INDEX capacity, bool containNull, bool blob = false);
     virtual DATA_TYPE getType() const {return blob_ ? DT_BLOB: DT_STRING;}
     virtual DATA_TYPE getRawType() const { return blob_ ? DT_BLOB: DT_STRING;}
@@ -2348,34 +2455,31 @@ public:
 
 	virtual ~StringVector(){}
 	virtual IO_ERR deserialize(DataInputStream* in, INDEX indexStart, INDEX targetNumElement, INDEX& numElement);
-	virtual INDEX getCapacity() const {return static_cast<INDEX>(data_.capacity());}
+	virtual INDEX getCapacity() const {return static_cast<INDEX>(arenaMode_ ? offsets_.capacity() - 1 : data_.capacity());}
 	virtual	INDEX reserve(INDEX capacity);
 	virtual bool isFastMode() const {return false;}
 	virtual short getUnitLength() const {return 0;}
-	virtual void clear(){
-		data_.clear();
-		containNull_ = false;
-	}
+	virtual void clear();
 	virtual bool sizeable() const {return true;}
-	virtual int compare(INDEX index, const ConstantSP& target) const {return data_[index].compare(target->getString());}
-	virtual std::string getString(INDEX index) const {return data_[index];}
-	virtual const std::string& getStringRef() const {return data_[0];}
-	virtual const std::string& getStringRef(INDEX index) const { return data_[index];}
+	virtual int compare(INDEX index, const ConstantSP& target) const;
+	virtual std::string getString(INDEX index) const {return arenaMode_ ? view(index).toString() : data_[index];}
+	virtual const std::string& getStringRef() const {return legacy()[0];}
+	virtual const std::string& getStringRef(INDEX index) const { return legacy()[index];}
 	virtual bool set(INDEX index, const ConstantSP& value){
-		data_[index]=value->getString();
+		legacy()[index]=value->getString();
 		if(data_[index].empty())
 			containNull_ = true;
 		return true;
 	}
 	virtual bool set(const ConstantSP& index, const ConstantSP& value);
 	virtual bool assign(const ConstantSP& value);
-	virtual ConstantSP get(INDEX index) const {return ConstantSP(new String(data_[index], blob_));}
+	virtual ConstantSP get(INDEX index) const {return ConstantSP(new String(getString(index), blob_));}
 	virtual ConstantSP get(const ConstantSP& index) const;
-	virtual bool isNull(INDEX index) const {return data_[index].size()==0;}
+	virtual bool isNull(INDEX index) const {return arenaMode_ ? offsets_[index + 1] - offsets_[index] == 1 : data_[index].size()==0;}
 	virtual bool isNull() const {return false;}
-	virtual void setNull(INDEX index){data_[index]="";}
+	virtual void setNull(INDEX index){legacy()[index]="";}
 	virtual void setNull(){}
-	virtual bool hasNull(){return hasNullInRange(0, static_cast<INDEX>(data_.size()));}
+	virtual bool hasNull(){return hasNullInRange(0, size());}
 	virtual bool hasNull(INDEX start, INDEX length){return hasNullInRange(start, start + length);}
 	bool hasNullInRange(INDEX start, INDEX end);
 	virtual void fill(INDEX start, INDEX length, const ConstantSP& value);
@@ -2383,9 +2487,9 @@ public:
 	virtual bool isNull(INDEX start, int len, char* buf) const;
 	virtual ConstantSP getSubVector(INDEX start, INDEX length) const { return getSubVector(start, length, std::abs(length));}
 	virtual ConstantSP getSubVector(INDEX start, INDEX length, INDEX capacity) const;
-	virtual ConstantSP getInstance(INDEX sz) const {return ConstantSP(new StringVector(sz, sz, blob_));}
+	virtual ConstantSP getInstance(INDEX sz) const {return ConstantSP(new StringVector(sz, sz, blob_, arenaMode_));}
 	virtual ConstantSP getValue() const;
-	virtual ConstantSP getValue(INDEX capacity) const {return ConstantSP(new StringVector(data_, capacity, containNull_, blob_));}
+	virtual ConstantSP getValue(INDEX capacity) const;
 	virtual bool append(const ConstantSP& value, INDEX appendSize);
 	virtual bool appendString(std::string* buf, int len);
 	virtual bool appendString(char** buf, int len);
@@ -2400,43 +2504,58 @@ public:
 	virtual char** getStringConst(INDEX start, int len, char** buf) const;
 	virtual void setString(const std::string& val){
 		checkString(val);
-		data_[0]=val;
+		legacy()[0]=val;
 	}
 	virtual void setString(INDEX index, const std::string& val){
 		checkString(val);
-		data_[index]=val;
+		legacy()[index]=val;
 	}
 	virtual bool setString(INDEX start, int len, const std::string* buf){
 		for(int i = 0; i < len; ++i){
 			checkString(*(buf+i));
 		}
-		copy(buf,buf+len,data_.begin()+start);
+		copy(buf,buf+len,legacy().begin()+start);
 		return true;
 	}
 	virtual bool setString(INDEX start, int len, char** buf){
-		copy(buf,buf+len,data_.begin()+start);
+		copy(buf,buf+len,legacy().begin()+start);
 		return true;
 	}
-	bool has(const std::string& val) const {	return std::find(data_.begin(),data_.end(),val)!=data_.end();}
+	bool has(const std::string& val) const {
+		INDEX sz = size();
+		for(INDEX i = 0; i < sz; ++i){
+			if(compareView(view(i), val) == 0)
+				return true;
+		}
+		return false;
+	}
 	INDEX search(const std::string& val);
-	virtual INDEX size() const {return static_cast<INDEX>(data_.size());}
-	std::string getMember(const int& index) const { return data_[index];}
-	void setMember(const int& index, const std::string& val){data_[index]=val;}
+	virtual INDEX size() const {return static_cast<INDEX>(arenaMode_ ? offsets_.size() - 1 : data_.size());}
+	std::string getMember(const int& index) const { return getString(index);}
+	void setMember(const int& index, const std::string& val){legacy()[index]=val;}
 	virtual void upper();
 	virtual void lower();
 	virtual void trim();
 	virtual void strip();
-	virtual void reverse(){std::reverse(data_.begin(),data_.end());}
-	virtual void reverse(INDEX start, INDEX end){std::reverse(data_.begin()+start,data_.begin()+end+1);}
+	virtual void reverse(){
+		std::vector<std::string>& data = legacy();
+		std::reverse(data.begin(),data.end());
+	}
+	virtual void reverse(INDEX start, INDEX end){
+		std::vector<std::string>& data = legacy();
+		std::reverse(data.begin()+start,data.begin()+end+1);
+	}
 	virtual void replace(const ConstantSP& oldVal, const ConstantSP& newVal);
 	virtual long long getAllocatedMemory() const;
 	virtual long long getAllocatedMemory(INDEX size) const;
 	virtual bool getHash(INDEX start, int len, int buckets, int* buf) const {
-		for(int i=0; i<len; ++i)
-			buf[i] = murmur32(data_[start + i].data(), data_[start + i].size()) % buckets;
+		for(int i=0; i<len; ++i){
+			StringView str = view(start + i);
+			buf[i] = murmur32(str.data, str.length) % buckets;
+		}
 		return true;
 	}
-	virtual void* getDataArray() const {return (void*)&data_[0];}
+	virtual void* getDataArray() const {return (void*)&legacy()[0];}
 
 	virtual int asof(const ConstantSP& value) const{
 		const std::string& target = value->getStringRef();
@@ -2445,7 +2564,7 @@ public:
 		int mid;
 		while(start <= end){
 			mid = (start + end) / 2;
-			if(data_[mid].compare(target) <= 0){
+			if(compareView(view(mid), target) <= 0){
 				start = mid + 1;
 			}
 			else {
@@ -2455,11 +2574,91 @@ public:
 		return end;
 	}
 
+	bool isArena() const {return arenaMode_;}
+	StringView getStringView(INDEX index) const {return view(index);}
+	void getStringView(INDEX start, int len, StringView* buf) const {
+		for(int i=0; i<len; ++i)
+			buf[i] = view(start + i);
+	}
+	//Element index of any STRING or BLOB vector vec; strings is vec as a StringVector, or null for other vectors.
+	static StringView getStringView(const Vector* vec, const StringVector* strings, INDEX index){
+		if(strings != nullptr)
+			return strings->view(index);
+		const std::string& str = vec->getStringRef(index);
+		return StringView{str.data(), str.size()};
+	}
+	//Append len strings given as (pointer, length) pairs; they need no terminating '\0'.
+	void appendStringView(const StringView* buf, int len){
+		if(arenaMode_){
+			for(int i=0; i<len; ++i)
+				appendArena(buf[i].data, buf[i].length);
+			return;
+		}
+		releaseArena();
+		for(int i=0; i<len; ++i){
+			data_.emplace_back(buf[i].data, buf[i].length);
+			if(buf[i].length == 0)
+				containNull_ = true;
+		}
+	}
+	//Convert an arena vector to the legacy std::string layout. No-op for legacy vectors.
+	void materialize() const;
+
 private:
 	void checkString(const std::string& val);
+	StringView view(INDEX index) const {
+		if(arenaMode_){
+			long long offset = offsets_[index];
+			return StringView{arena_.data() + offset, static_cast<size_t>(offsets_[index + 1] - offset - 1)};
+		}
+		const std::string& str = data_[index];
+		return StringView{str.c_str(), str.size()};
+	}
+	void assignTo(std::string& out, INDEX index) const {
+		StringView str = view(index);
+		out.assign(str.data, str.length);
+	}
+	const std::vector<std::string>& legacy() const {
+		if(arenaMode_)
+			materialize();
+		return data_;
+	}
+	//Calls that modify the vector have no concurrent readers, so they free the arena as well.
+	std::vector<std::string>& legacy(){
+		materializeForWrite();
+		return data_;
+	}
+	void materializeForWrite(){
+		materialize();
+		releaseArena();
+	}
+	void releaseArena(){
+		if(!offsets_.empty()){
+			std::vector<long long>().swap(offsets_);
+			std::vector<char>().swap(arena_);
+		}
+	}
+	void appendArena(const char* data, size_t length){
+		arena_.insert(arena_.end(), data, data + length);
+		arena_.push_back(0);
+		offsets_.push_back(static_cast<long long>(arena_.size()));
+		if(length == 0)
+			containNull_ = true;
+	}
+	static int compareView(const StringView& str, const std::string& target){
+		int ret = memcmp(str.data, target.data(), (std::min)(str.length, target.size()));
+		if(ret != 0)
+			return ret;
+		return str.length < target.size() ? -1 : (str.length > target.size() ? 1 : 0);
+	}
 
 private:
 	mutable std::vector<std::string> data_;
+	//Arena layout: element i is arena_[offsets_[i], offsets_[i+1]-1) followed by '\0'.
+	mutable std::vector<long long> offsets_;
+	mutable std::vector<char> arena_;
+	mutable std::atomic<bool> arenaMode_;
+	mutable std::mutex materializeMutex_;
     bool blob_;
 };
 
@@ -2810,6 +3009,7 @@ public:
 	virtual DATA_TYPE getType() const {return DT_SYMBOL;}
 	virtual DATA_CATEGORY getCategory() const {return LITERAL;}
 	virtual DATA_TYPE getRawType() const {return DT_INT;};
+	virtual VectorStats stats() const {throw RuntimeException("stats method not supported for SYMBOL vector");}
 	virtual int compare(INDEX index, const ConstantSP& target) const {return base_->getSymbol(data_[index]).compare(target->getString());}
 	virtual std::string getString(INDEX index) const override {return base_->getSymbol(data_[index]);}
 	virtual const std::string& getStringRef() const override { return base_->getSymbol(data_[0]); }
@@ -3859,6 +4059,15 @@ public:
 
     int getExtraParamForType() const override { return scale_; }
 
+    VectorStats stats() const override {
+        VectorStats result = AbstractFastVector<T>::stats();
+        double unit = std::pow(10.0, scale_);
+        result.sum /= unit;
+        if (result.count > 0)
+            result.avg /= unit;
+        return result;
+    }
+
     std::string getString(INDEX index) const override {
         if (data_[index] == nullVal_) {
             return "";
@@ -215,7 +215,9 @@ private:
 
 class EXPORT_DECL SymbolBaseUnmarshall {
 public:
-	SymbolBaseUnmarshall(const DataInputStreamSP& in):symbaseId_(0), size_(0), in_(in){}
+	//Without a shared cache the symbol bases are only kept until reset, i.e. for one object.
+	SymbolBaseUnmarshall(const DataInputStreamSP& in, const SymbolBaseCacheSP& cache = nullptr):symbaseId_(0), size_(0), in_(in),
+		cache_(cache.isNull() ? new SymbolBaseCache() : cache), ownCache_(cache.isNull()){}
 	~SymbolBaseUnmarshall(){}
 	bool start(bool blocking, IO_ERR& ret);
 	void reset();
@@ -228,7 +230,8 @@ private:
 	int size_;
 	DataInputStreamSP in_;
 	SymbolBaseSP obj_;
-	std::unordered_map<int, SymbolBaseSP> dict_;
+	SymbolBaseCacheSP cache_;
+	bool ownCache_;
 };
 
 class EXPORT_DECL VectorUnmarshall: public ConstantUnmarshallImp{
@@ -238,6 +241,8 @@ public:
 	virtual bool start(short flag, bool blocking, IO_ERR& ret);
 	virtual void reset();
 	void resetSymbolBaseUnmarshall(DataInputStreamSP in, bool createIfNotExist);
+	//Keep symbol bases in cache across objects instead of dropping them on reset.
+	void setSymbolBaseCache(const SymbolBaseCacheSP& cache);
 private:
 	short flag_;
 	int rows_;
@@ -245,6 +250,7 @@ private:
 	INDEX nextStart_;
 	ConstantUnmarshallSP unmarshall_;
 	SymbolBaseUnmarshallSP symbaseUnmarshall_;
+	SymbolBaseCacheSP symbaseCache_;
 	int scale_;
 };
 
@@ -255,6 +261,7 @@ public:
 	virtual ~MatrixUnmarshall(){}
 	virtual bool start(short flag, bool blocking, IO_ERR& ret);
 	virtual void reset();
+	void setSymbolBaseCache(const SymbolBaseCacheSP& cache){ vectorUnmarshall_.setSymbolBaseCache(cache); }
 private:
 	char labelFlag_;
 	bool rowLabelReceived_;
@@ -272,6 +279,7 @@ public:
 	virtual ~TableUnmarshall(){}
 	virtual bool start(short flag, bool blocking, IO_ERR& ret);
 	virtual void reset();
+	void setSymbolBaseCache(const SymbolBaseCacheSP& cache){ vectorUnmarshall_.setSymbolBaseCache(cache); }
 private:
 	TABLE_TYPE type_;
 	bool tableNameReceived_;
@@ -337,7 +345,8 @@ private:
 
 class EXPORT_DECL ConstantUnmarshallFactory{
 public:
-	ConstantUnmarshallFactory(const DataInputStreamSP& in);
+	//Symbol bases of vectors, matrices and tables go through symbolBaseCache when one is given.
+	ConstantUnmarshallFactory(const DataInputStreamSP& in, const SymbolBaseCacheSP& symbolBaseCache = nullptr);
 	~ConstantUnmarshallFactory();
 	ConstantUnmarshall* getConstantUnmarshall(DATA_FORM form){return (form<0 || form>DF_CHUNK) ? NULL: arrUnmarshall[form];}
 	static ConstantUnmarshallSP getInstance(DATA_FORM form, const DataInputStreamSP& in);
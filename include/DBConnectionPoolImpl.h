@@ -63,7 +63,12 @@ public:
     int getConnectionCount(){
         return static_cast<int>(workers_.size());
     }
+
+    const std::string& getHostName() const { return hostName_; }
+    int getPort() const { return port_; }
 private:
+    std::string hostName_;
+    int port_;
     std::atomic<bool> shutDownFlag_;
     CountDownLatchSP latch_;
     std::vector<ThreadSP> workers_;
@@ -10,6 +10,7 @@
 
 #include "Util.h"
 #include <unordered_map>
+#include "FlatHashMap.h"
 #include "Dictionary.h"
 namespace dolphindb {
 
@@ -58,7 +59,8 @@ protected:
 class CharDictionary: public AbstractDictionary{
 public:
 	CharDictionary(DATA_TYPE keyType, DATA_TYPE type):AbstractDictionary(keyType,type){}
-	CharDictionary(const std::unordered_map<char,U8>& dict, DATA_TYPE keyType, DATA_TYPE type);
+	CharDictionary(const std::unordered_map<char,U8>& dict, DATA_TYPE keyType, DATA_TYPE type) : CharDictionary(FlatHashMap<char,U8>(dict.begin(), dict.end()), keyType, type){}
+	CharDictionary(const FlatHashMap<char,U8>& dict, DATA_TYPE keyType, DATA_TYPE type);
 	virtual ~CharDictionary();
 	virtual void clear(){dict_.clear();}
 	virtual INDEX size() const {return (INDEX)dict_.size();}
@@ -74,13 +76,14 @@ public:
 	virtual std::string getString() const;
 	virtual long long getAllocatedMemory() const;
 private:
-	std::unordered_map<char,U8> dict_;
+	FlatHashMap<char,U8> dict_;
 };
 
 class ShortDictionary: public AbstractDictionary{
 public:
 	ShortDictionary(DATA_TYPE keyType, DATA_TYPE type):AbstractDictionary(keyType,type){}
-	ShortDictionary(const std::unordered_map<short,U8>& dict, DATA_TYPE keyType, DATA_TYPE type);
+	ShortDictionary(const std::unordered_map<short,U8>& dict, DATA_TYPE keyType, DATA_TYPE type) : ShortDictionary(FlatHashMap<short,U8>(dict.begin(), dict.end()), keyType, type){}
+	ShortDictionary(const FlatHashMap<short,U8>& dict, DATA_TYPE keyType, DATA_TYPE type);
 	virtual ~ShortDictionary();
 	virtual void clear(){dict_.clear();}
 	virtual INDEX size() const {return (INDEX)dict_.size();}
@@ -96,13 +99,14 @@ public:
 	virtual std::string getString() const;
 	virtual long long getAllocatedMemory() const;
 private:
-	std::unordered_map<short,U8> dict_;
+	FlatHashMap<short,U8> dict_;
 };
 
 class IntDictionary: public AbstractDictionary{
 public:
 	IntDictionary(DATA_TYPE keyType, DATA_TYPE type):AbstractDictionary(keyType,type){}
-	IntDictionary(const std::unordered_map<int,U8>& dict, DATA_TYPE keyType, DATA_TYPE type);
+	IntDictionary(const std::unordered_map<int,U8>& dict, DATA_TYPE keyType, DATA_TYPE type) : IntDictionary(FlatHashMap<int,U8>(dict.begin(), dict.end()), keyType, type){}
+	IntDictionary(const FlatHashMap<int,U8>& dict, DATA_TYPE keyType, DATA_TYPE type);
 	virtual ~IntDictionary();
 	virtual void clear(){dict_.clear();}
 	virtual INDEX size() const {return (INDEX)dict_.size();}
@@ -118,13 +122,14 @@ public:
 	virtual std::string getString() const;
 	virtual long long getAllocatedMemory() const;
 private:
-	std::unordered_map<int,U8> dict_;
+	FlatHashMap<int,U8> dict_;
 };
 
 class LongDictionary: public AbstractDictionary{
 public:
 	LongDictionary(DATA_TYPE keyType, DATA_TYPE type):AbstractDictionary(keyType,type){}
-	LongDictionary(const std::unordered_map<long long,U8>& dict, DATA_TYPE keyType,DATA_TYPE type);
+	LongDictionary(const std::unordered_map<long long,U8>& dict, DATA_TYPE keyType,DATA_TYPE type) : LongDictionary(FlatHashMap<long long,U8>(dict.begin(), dict.end()), keyType, type){}
+	LongDictionary(const FlatHashMap<long long,U8>& dict, DATA_TYPE keyType,DATA_TYPE type);
 	virtual ~LongDictionary();
 	virtual void clear(){dict_.clear();}
 	virtual INDEX size() const {return (INDEX)dict_.size();}
@@ -140,13 +145,14 @@ public:
 	virtual std::string getString() const;
 	virtual long long getAllocatedMemory() const;
 private:
-	std::unordered_map<long long,U8> dict_;
+	FlatHashMap<long long,U8> dict_;
 };
 
 class FloatDictionary: public AbstractDictionary{
 public:
 	FloatDictionary(DATA_TYPE type):AbstractDictionary(DT_FLOAT,type){}
-	FloatDictionary(const std::unordered_map<float,U8>& dict, DATA_TYPE type);
+	FloatDictionary(const std::unordered_map<float,U8>& dict, DATA_TYPE type) : FloatDictionary(FlatHashMap<float,U8>(dict.begin(), dict.end()), type){}
+	FloatDictionary(const FlatHashMap<float,U8>& dict, DATA_TYPE type);
 	virtual ~FloatDictionary();
 	virtual void clear(){dict_.clear();}
 	virtual INDEX size() const {return (INDEX)dict_.size();}
@@ -162,13 +168,14 @@ public:
 	virtual std::string getString() const;
 	virtual long long getAllocatedMemory() const;
 private:
-	std::unordered_map<float,U8> dict_;
+	FlatHashMap<float,U8> dict_;
 };
 
 class DoubleDictionary: public AbstractDictionary{
 public:
 	DoubleDictionary(DATA_TYPE type):AbstractDictionary(DT_DOUBLE,type){}
-	DoubleDictionary(const std::unordered_map<double,U8>& dict, DATA_TYPE type);
+	DoubleDictionary(const std::unordered_map<double,U8>& dict, DATA_TYPE type) : DoubleDictionary(FlatHashMap<double,U8>(dict.begin(), dict.end()), type){}
+	DoubleDictionary(const FlatHashMap<double,U8>& dict, DATA_TYPE type);
 	virtual ~DoubleDictionary();
 	virtual void clear(){dict_.clear();}
 	virtual INDEX size() const {return (INDEX)dict_.size();}
@@ -184,13 +191,14 @@ public:
 	virtual std::string getString() const;
 	virtual long long getAllocatedMemory() const;
 private:
-	std::unordered_map<double,U8> dict_;
+	FlatHashMap<double,U8> dict_;
 };
 
 class StringDictionary: public AbstractDictionary{
 public:
 	StringDictionary(DATA_TYPE keyType, DATA_TYPE type):AbstractDictionary(keyType,type){}
-	StringDictionary(const std::unordered_map<std::string,U8>& dict, DATA_TYPE keyType,DATA_TYPE type);
+	StringDictionary(const std::unordered_map<std::string,U8>& dict, DATA_TYPE keyType,DATA_TYPE type) : StringDictionary(FlatHashMap<std::string,U8>(dict.begin(), dict.end()), keyType, type){}
+	StringDictionary(const FlatHashMap<std::string,U8>& dict, DATA_TYPE keyType,DATA_TYPE type);
 	virtual ~StringDictionary();
 	virtual void clear(){dict_.clear();}
 	virtual INDEX size() const {return (INDEX)dict_.size();}
@@ -208,7 +216,7 @@ public:
 	virtual std::string getString() const;
 	virtual long long getAllocatedMemory() const;
 private:
-	std::unordered_map<std::string,U8> dict_;
+	FlatHashMap<std::string,U8> dict_;
 };
 
 class Int128Dictionary: public AbstractDictionary{
@@ -231,6 +239,7 @@ public:
 	virtual std::string getString() const;
 	virtual long long getAllocatedMemory() const;
 private:
+	//Stays a std::unordered_map, because getInternalDict() exposes it.
 	std::unordered_map<Guid,U8> dict_;
 };
 
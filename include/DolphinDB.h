@@ -16,9 +16,11 @@
 #include <deque>
 #include <algorithm>
 #include <memory>
+#include <atomic>
 #include <chrono>
 #include <cstring>
 #include <functional>
+#include <future>
 
 #include "Exports.h"
 #include "Types.h"
@@ -29,6 +31,7 @@
 #include "Constant.h"
 #include "Dictionary.h"
 #include "Table.h"
+#include "SymbolEncoder.h"
 
 namespace dolphindb {
 
@@ -109,6 +112,11 @@ public:
 	const std::string& getInitScript() const;
 
 	DataInputStreamSP getDataInputStream();
+
+	/**
+	 * Host and port of the node the session is currently attached to.
+	 */
+	void getHostPort(std::string& host, int& port) const;
 private:
     DBConnection(DBConnection& oth); // = delete
     DBConnection& operator=(DBConnection& oth); // = delete
@@ -207,6 +215,43 @@ private:
 
 };
 
+/**
+ * Process-wide cache of table schemas shared by AutoFitTableAppender, AutoFitTableUpsert and
+ * PartitionedTableAppender, so that creating an appender for a table whose schema is cached skips the
+ * schema(loadTable(...)) round trip. Entries expire after the TTL and are dropped when a write through an
+ * appender fails. Only DFS tables are cached: an in-memory table name may refer to a different table in
+ * every session.
+ */
+class EXPORT_DECL TableSchemaCache {
+public:
+	static TableSchemaCache& instance();
+
+	//Returns the cached schema, or calls loader and caches its result. An empty key bypasses the cache.
+	DictionarySP get(const std::string& key, const std::function<DictionarySP()>& loader);
+	void invalidate(const std::string& key);
+	void clear();
+	std::size_t size();
+
+	//Entries older than ttl milliseconds are reloaded. 0 disables caching.
+	void setTTL(long long ttl);
+	long long getTTL() const { return ttl_.load(); }
+
+	//An empty key for in-memory tables (empty dbUrl).
+	static std::string makeKey(const std::string& host, int port, const std::string& dbUrl, const std::string& tableName);
+
+	static const long long DEFAULT_TTL = 60000;
+
+private:
+	TableSchemaCache() : ttl_(DEFAULT_TTL) {}
+	struct Entry {
+		DictionarySP schema;
+		long long loadTime;
+	};
+	Mutex mutex_;
+	std::unordered_map<std::string, Entry> entries_;
+	std::atomic<long long> ttl_;
+};
+
 class EXPORT_DECL PartitionedTableAppender {
 public:
 	PartitionedTableAppender(std::string dbUrl, std::string tableName, std::string partitionColName, DBConnectionPool& pool);
@@ -231,7 +276,7 @@ private:
     std::vector<DATA_CATEGORY> columnCategories_;
  	std::vector<DATA_TYPE> columnTypes_;
 	int identity_ = -1;
-    std::vector<std::vector<int>> chunkIndices_;
+	std::string schemaKey_;
 };
 
 
@@ -251,17 +296,41 @@ private:
     std::vector<DATA_CATEGORY> columnCategories_;
  	std::vector<DATA_TYPE> columnTypes_;
 	std::vector<std::string> columnNames_;
+	//An encoder serves one sender at a time; append holds encoderMutex_ from encoding to sending.
+	SymbolEncoder symbolEncoder_;
+	Mutex encoderMutex_;
+	std::string schemaKey_;
 };
 
 class EXPORT_DECL AutoFitTableUpsert {
 public:
 	AutoFitTableUpsert(std::string dbUrl, std::string tableName, DBConnection& conn,bool ignoreNull=false,
-                                        std::vector<std::string> *pkeyColNames=nullptr,std::vector<std::string> *psortColumns=nullptr);
-	virtual ~AutoFitTableUpsert() = default;
+                                        std::vector<std::string> *pkeyColNames=nullptr,std::vector<std::string> *psortColumns=nullptr,
+                                        int batchSize=10000, int throttle=100);
+	virtual ~AutoFitTableUpsert();
+	//Rows buffered by upsertAsync are sent first, their errors are reported through their own futures.
 	int upsert(TableSP table);
 
+	/**
+	 * Buffer the rows for an upsert on a background thread. Unless ignoreNull is set, a buffered row is replaced by
+	 * a later row with the same pkeyColNames values, so only the last version of each key is sent. A batch is sent
+	 * once it holds batchSize rows or its oldest rows are throttle milliseconds old. The future resolves with the
+	 * number of rows of this table that were sent, not counting rows replaced by a later row with the same key,
+	 * or with the error of the upsert! call that carried them. The table is sent without copying when possible
+	 * and must not be modified until the future is ready.
+	 */
+	std::future<int> upsertAsync(TableSP table);
+	//Send the buffered rows now and wait for them. Throws the error of the last batch.
+	void flush();
+
 private:
 	void checkColumnType(int col, DATA_CATEGORY category, DATA_TYPE type);
+	//The input table cast to the target column types.
+	TableSP fitTable(const TableSP& table);
+	int runUpsert(const TableSP& table);
+	//Queue an empty request behind the buffered rows, it resolves once they have been sent. Invalid if nothing was ever buffered.
+	std::future<int> requestFlush();
+	void runAsync();
 
 private:
     DBConnection& conn_;
@@ -270,9 +339,31 @@ private:
     std::vector<DATA_CATEGORY> columnCategories_;
  	std::vector<DATA_TYPE> columnTypes_;
 	std::vector<std::string> columnNames_;
+	std::string schemaKey_;
+
+	//Rows are merged by key only if keyColumns_ isn't empty
+	std::vector<int> keyColumns_;
+	int batchSize_;
+	int throttle_;
+	Mutex asyncMutex_;
+	ConditionalVariable asyncNotifier_;
+	ThreadSP asyncThread_;
+	bool stopping_ = false;
+	bool flushRequested_ = false;
+	//Buffered input tables, rowAlive_ flags their rows in order. A row is dead once a later row has the same key.
+	std::vector<TableSP> pendingTables_;
+	std::vector<char> rowAlive_;
+	INDEX deadRows_ = 0;
+	std::unordered_map<std::string, INDEX> pendingKeys_;
+	std::vector<std::promise<int>> pendingPromises_;
+	//The number of rows of each request in pendingPromises_.
+	std::vector<INDEX> pendingRows_;
+	long long pendingSince_ = 0;
+	//upsert and the background thread share conn_.
+	Mutex connMutex_;
 };
 
-
+//Kept for compatibility. RecordTime locks a global map on every scope exit; use DDB_TRACE in Tracing.h instead.
 class RecordTime {
 public:
 	RecordTime(const std::string &name);
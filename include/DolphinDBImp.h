@@ -4,6 +4,8 @@
 #include <string>
 namespace dolphindb {
 
+class MetricHistogram;
+
 class DdbInit {
 public:
     DdbInit() {
@@ -57,6 +59,9 @@ private:
     bool isReverseStreaming_;
     std::string runClientId_;
     DataInputStreamSP inputStream_;
+    MetricHistogram* rpcLatency_;
+    //Symbol bases of earlier results, reused when the server sends them again
+    SymbolBaseCacheSP symbolBaseCache_;
 };
 
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "SysIO.h"
 #include "Types.h"
 #include "DolphinDB.h"
+#include "StreamingUtil.h"
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -71,13 +73,50 @@ struct EventInfo{
     EventSchemaExSP                     eventSchema_;
 };
 
+//Reusable decoding state of one event type for the batch deserializeEvent.
+struct EventBatchDecoder{
+    enum AttributeKind { RAW_VALUE, FAST_ARRAY, OBJECT };
+    std::string                     eventType_;
+    const EventSchema*              schema_;
+    std::vector<AttributeKind>      kinds_;
+    //One column per attribute. FAST_ARRAY columns are rebuilt from arrayIndex_ and arrayValues_ for every run of events.
+    std::vector<VectorSP>           columns_;
+    std::vector<VectorSP>           arrayIndex_;
+    std::vector<VectorSP>           arrayValues_;
+    INDEX                           rows_ = 0;
+    bool                            hasObject_ = false;
+};
+
+//In-memory output stream whose buffer is kept between events.
+class EventBufferStream : public DataOutputStream{
+public:
+    EventBufferStream(size_t capacity) : DataOutputStream(capacity) {}
+    void reset() { size_ = 0; }
+};
+
 class EventHandler{
 public:
     EventHandler(const std::vector<EventSchema>& eventSchemas, const std::vector<std::string>& eventTimeKeys, const std::vector<std::string>& commonKeys);
     bool checkOutputTable(TableSP outputTable, std::string& errMsg);
     bool serializeEvent(const std::string& eventType, const std::vector<ConstantSP>& attributes, std::vector<ConstantSP>& serializedEvent, std::string& errMsg);
+    //Serialize one event into a new row of columns, which have the types of the output table. Not thread-safe.
+    bool appendEvent(const std::string& eventType, const std::vector<ConstantSP>& attributes, std::vector<VectorSP>& columns, std::string& errMsg);
     bool deserializeEvent(ConstantSP obj, std::vector<std::string>& eventTypes, std::vector<std::vector<ConstantSP>>& attributes, ErrorCodeInfo& errorInfo);
+    /**
+     * Decode the events of obj into reusable per-type columns and call handler once for every run of consecutive
+     * events of the same type. Event types are resolved to ids without copying, and fixed-width attributes are
+     * read straight from the blob into the columns. Not thread-safe.
+     */
+    bool deserializeEvent(ConstantSP obj, const EventBatchMessageHandler& handler, ErrorCodeInfo& errorInfo);
 private:
+    void initDecoders();
+    //-1 if eventType is unknown
+    int findEventId(const VectorSP& eventTypeVec, INDEX row);
+    //sharedInput wraps input, it is only needed by decoders with OBJECT attributes.
+    IO_ERR decodeAttributes(EventBatchDecoder& decoder, DataInputStream* input, const DataInputStreamSP& sharedInput);
+    void deliver(EventBatchDecoder& decoder, const EventBatchMessageHandler& handler);
+    const EventInfo* checkAttributes(const std::string& eventType, const std::vector<ConstantSP>& attributes, std::string& errMsg);
+    bool serializeAttributes(const EventInfo& info, const std::vector<ConstantSP>& attributes, const DataOutputStreamSP& outStream, std::string& errMsg);
     bool checkSchema(const std::vector<EventSchema>& eventSchemas, const std::vector<std::string> &expandTimeKeys, const std::vector<std::string>& commonKeys, std::string& errMsg);
     ConstantSP deserializeScalar(DATA_TYPE type, int extraParam, DataInputStreamSP input, IO_ERR& ret);
     ConstantSP deserializeFastArray(DATA_TYPE type, int extraParam, DataInputStreamSP input, IO_ERR& ret);
@@ -88,17 +127,65 @@ private:
 
     int outputColNums_;                 //the number of columns of the output table
     int commonKeySize_;
+    SmartPointer<EventBufferStream> appendBuffer_;
+
+    std::unordered_map<std::string, int> eventIds_;
+    std::vector<EventBatchDecoder> decoders_;
+    //Event ids of the symbols of symbolBase_, the dictionary of a SYMBOL eventType column.
+    SymbolBaseSP symbolBase_;
+    std::vector<int> symbolIds_;
+    int lastEventId_ = -1;
 };
 
 class EXPORT_DECL EventSender{
 public:
-    EventSender(DBConnectionSP conn, const std::string& tableName, const std::vector<EventSchema>& eventSchema, const std::vector<std::string>& eventTimeFields = std::vector<std::string>(), const std::vector<std::string>& commonFields = std::vector<std::string>());
+    /**
+     * With batchSize > 0, sendEvent appends the serialized event to reusable column buffers and returns. A background
+     * thread inserts the buffered events with one tableInsert once batchSize events are buffered or the oldest one is
+     * throttle milliseconds old, while the next batch is filled. sendEvent blocks while maxPending events (4 * batchSize
+     * by default) are buffered or being inserted. The events of a failed insert are dropped and reported to the
+     * failure handler and by flush.
+     */
+    EventSender(DBConnectionSP conn, const std::string& tableName, const std::vector<EventSchema>& eventSchema, const std::vector<std::string>& eventTimeFields = std::vector<std::string>(), const std::vector<std::string>& commonFields = std::vector<std::string>(),
+                int batchSize = 0, int throttle = 10, int maxPending = 0);
+    ~EventSender();
     void sendEvent(const std::string& eventType, const std::vector<ConstantSP>& attributes);
+    //Wait until the buffered events are inserted. Throws if an insert failed since the last flush.
+    void flush();
+    //Called on the background thread with the error and the number of events that were dropped.
+    void setSendFailureHandler(const std::function<void(const ErrorCodeInfo&, int)>& handler);
+    long long getPendingEvents();
+    long long getSentEvents();
+    long long getFailedEvents();
+
+private:
+    void runSender();
 
 private:
     std::string             insertScript_;
     EventHandler            eventHandler_;
     DBConnectionSP          conn_;
+
+    int                     batchSize_;
+    int                     throttle_;
+    int                     maxPending_;
+    std::vector<std::string>    columnNames_;
+    //sendEvent fills activeColumns_, the sender thread swaps them with flushColumns_ and inserts those.
+    std::vector<VectorSP>   activeColumns_;
+    std::vector<VectorSP>   flushColumns_;
+    int                     activeRows_ = 0;
+    int                     sendingRows_ = 0;
+    long long               activeSince_ = 0;
+    long long               sentEvents_ = 0;
+    long long               failedEvents_ = 0;
+    bool                    flushRequested_ = false;
+    bool                    stopping_ = false;
+    ErrorCodeInfo           lastError_;
+    std::function<void(const ErrorCodeInfo&, int)>  failureHandler_;
+    Mutex                   mutex_;
+    ConditionalVariable     sendNotifier_;
+    ConditionalVariable     spaceNotifier_;
+    ThreadSP                sendThread_;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,518 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DDB_FLAT_HASH_SSE2 1
+#endif
+
+namespace dolphindb {
+
+namespace flat_hash_detail {
+
+//Control bytes. A full slot keeps the low 7 bits of its hash, so it is always non-negative.
+const int8_t CTRL_EMPTY = -128;
+const int8_t CTRL_DELETED = -2;
+const size_t GROUP_WIDTH = 16;
+
+inline uint64_t mix(uint64_t h) {
+    //std::hash is the identity for integers on most platforms, spread the bits before masking.
+    h *= 0x9E3779B97F4A7C15ULL;
+    return h ^ (h >> 32);
+}
+
+inline int lowestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+inline void prefetch(const void* p) {
+#if defined(_MSC_VER) && defined(DDB_FLAT_HASH_SSE2)
+    _mm_prefetch((const char*)p, _MM_HINT_T0);
+#elif defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+//Sixteen control bytes probed at once. Bit i of a mask refers to ctrl[i].
+struct Group {
+#ifdef DDB_FLAT_HASH_SSE2
+    explicit Group(const int8_t* ctrl) : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+    uint32_t match(int8_t h2) const {
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+    }
+    uint32_t matchEmpty() const { return match(CTRL_EMPTY); }
+    uint32_t matchEmptyOrDeleted() const {
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_));
+    }
+    __m128i ctrl_;
+#else
+    explicit Group(const int8_t* ctrl) : ctrl_(ctrl) {}
+    uint32_t match(int8_t h2) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i)
+            mask |= (uint32_t)(ctrl_[i] == h2) << i;
+        return mask;
+    }
+    uint32_t matchEmpty() const { return match(CTRL_EMPTY); }
+    uint32_t matchEmptyOrDeleted() const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i)
+            mask |= (uint32_t)(ctrl_[i] < -1) << i;
+        return mask;
+    }
+    const int8_t* ctrl_;
+#endif
+};
+
+struct MapKey {
+    template<class Slot>
+    static const typename Slot::first_type& get(const Slot& slot) { return slot.first; }
+};
+
+struct SetKey {
+    template<class Slot>
+    static const Slot& get(const Slot& slot) { return slot; }
+};
+
+}
+
+/**
+ * Open addressing hash table in the style of Abseil's Swiss tables. Slots live in one flat
+ * array next to an array of one-byte control words; a lookup hashes once, then compares the
+ * 7-bit hash fragments of sixteen neighbouring slots with a single SSE2 instruction and only
+ * touches the slots that match. Erased slots become tombstones and are reclaimed on the next
+ * rehash, so iterators and references are invalidated by any insertion that grows the table.
+ */
+template<class K, class Slot, class KeyOf, class Hash, class Eq>
+class FlatHashTable {
+public:
+    template<class Ref, class Ptr>
+    class Iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Slot value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Ptr pointer;
+        typedef Ref reference;
+
+        Iterator() : ctrl_(nullptr), slot_(nullptr), end_(nullptr) {}
+        Iterator(const int8_t* ctrl, Slot* slot, const int8_t* end) : ctrl_(ctrl), slot_(slot), end_(end) { skipEmpty(); }
+        //iterator converts to const_iterator
+        template<class R, class P>
+        Iterator(const Iterator<R, P>& other) : ctrl_(other.ctrl_), slot_(other.slot_), end_(other.end_) {}
+
+        Ref operator*() const { return *slot_; }
+        Ptr operator->() const { return slot_; }
+        Iterator& operator++() { ++ctrl_; ++slot_; skipEmpty(); return *this; }
+        Iterator operator++(int) { Iterator old(*this); ++*this; return old; }
+        template<class R, class P>
+        bool operator==(const Iterator<R, P>& other) const { return ctrl_ == other.ctrl_; }
+        template<class R, class P>
+        bool operator!=(const Iterator<R, P>& other) const { return ctrl_ != other.ctrl_; }
+
+    private:
+        template<class R, class P> friend class Iterator;
+        friend class FlatHashTable;
+        void skipEmpty() {
+            while (ctrl_ != end_ && *ctrl_ < 0) { ++ctrl_; ++slot_; }
+        }
+        const int8_t* ctrl_;
+        Slot* slot_;
+        const int8_t* end_;
+    };
+
+    typedef K key_type;
+    typedef Slot value_type;
+    typedef size_t size_type;
+
+    FlatHashTable() : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growthLeft_(0) {}
+    FlatHashTable(const FlatHashTable& other) : FlatHashTable() { copyFrom(other); }
+    FlatHashTable(FlatHashTable&& other) noexcept : ctrl_(other.ctrl_), slots_(other.slots_), capacity_(other.capacity_),
+            size_(other.size_), growthLeft_(other.growthLeft_) {
+        other.ctrl_ = nullptr;
+        other.slots_ = nullptr;
+        other.capacity_ = other.size_ = other.growthLeft_ = 0;
+    }
+    FlatHashTable& operator=(const FlatHashTable& other) {
+        if (this != &other) {
+            release();
+            copyFrom(other);
+        }
+        return *this;
+    }
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept {
+        if (this != &other) {
+            release();
+            std::swap(ctrl_, other.ctrl_);
+            std::swap(slots_, other.slots_);
+            std::swap(capacity_, other.capacity_);
+            std::swap(size_, other.size_);
+            std::swap(growthLeft_, other.growthLeft_);
+        }
+        return *this;
+    }
+    ~FlatHashTable() { release(); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    //Number of slots, for parity with std::unordered_map::bucket_count.
+    size_t bucket_count() const { return capacity_; }
+    long long getAllocatedMemory() const {
+        return capacity_ == 0 ? 0 : (long long)(capacity_ * (sizeof(Slot) + 1) + flat_hash_detail::GROUP_WIDTH);
+    }
+
+    //Tombstones are reset too, even when no element is left, since growthLeft_ counts on empty slots.
+    void clear() {
+        if (capacity_ == 0)
+            return;
+        if (size_ > 0)
+            destroySlots();
+        memset(ctrl_, flat_hash_detail::CTRL_EMPTY, capacity_ + flat_hash_detail::GROUP_WIDTH);
+        size_ = 0;
+        growthLeft_ = growthLimit(capacity_);
+    }
+
+    void reserve(size_t count) {
+        if (count > growthLimit(capacity_))
+            resize(capacityFor(count));
+    }
+
+    Iterator<Slot&, Slot*> begin() { return Iterator<Slot&, Slot*>(ctrl_, slots_, ctrl_ + capacity_); }
+    Iterator<Slot&, Slot*> end() { return Iterator<Slot&, Slot*>(ctrl_ + capacity_, slots_ + capacity_, ctrl_ + capacity_); }
+    Iterator<const Slot&, const Slot*> begin() const { return Iterator<const Slot&, const Slot*>(ctrl_, slots_, ctrl_ + capacity_); }
+    Iterator<const Slot&, const Slot*> end() const {
+        return Iterator<const Slot&, const Slot*>(ctrl_ + capacity_, slots_ + capacity_, ctrl_ + capacity_);
+    }
+
+protected:
+    static const size_t NOT_FOUND = (size_t)-1;
+
+    template<class It>
+    It iteratorAt(size_t index) const {
+        return It(ctrl_ + index, slots_ + index, ctrl_ + capacity_);
+    }
+
+    Slot& slotAt(size_t index) { return slots_[index]; }
+
+    template<class It>
+    size_t indexOf(const It& it) const { return (size_t)(it.ctrl_ - ctrl_); }
+
+    static uint64_t hashOf(const K& key) { return flat_hash_detail::mix((uint64_t)Hash()(key)); }
+
+    size_t findIndex(const K& key, uint64_t hash) const {
+        if (capacity_ == 0)
+            return NOT_FOUND;
+        size_t mask = capacity_ - 1;
+        size_t pos = (size_t)(hash >> 7) & mask;
+        int8_t h2 = (int8_t)(hash & 0x7F);
+        size_t step = 0;
+        Eq eq;
+        while (true) {
+            flat_hash_detail::Group group(ctrl_ + pos);
+            for (uint32_t match = group.match(h2); match != 0; match &= match - 1) {
+                size_t index = (pos + flat_hash_detail::lowestBit(match)) & mask;
+                if (eq(KeyOf::get(slots_[index]), key))
+                    return index;
+            }
+            if (group.matchEmpty() != 0)
+                return NOT_FOUND;
+            step += flat_hash_detail::GROUP_WIDTH;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    size_t findIndex(const K& key) const { return findIndex(key, hashOf(key)); }
+
+    //Returns the slot of key and whether it has to be constructed by the caller.
+    std::pair<size_t, bool> findOrPrepareInsert(const K& key) {
+        uint64_t hash = hashOf(key);
+        size_t index = findIndex(key, hash);
+        if (index != NOT_FOUND)
+            return std::make_pair(index, false);
+        return std::make_pair(prepareInsert(hash), true);
+    }
+
+    template<class... Args>
+    size_t emplaceAt(const K& key, Args&&... args) {
+        std::pair<size_t, bool> found = findOrPrepareInsert(key);
+        if (found.second) {
+            new (slots_ + found.first) Slot(std::forward<Args>(args)...);
+            commitInsert(found.first, hashOf(key));
+        }
+        return found.first;
+    }
+
+    void commitInsert(size_t index, uint64_t hash) {
+        if (ctrl_[index] == flat_hash_detail::CTRL_EMPTY)
+            --growthLeft_;
+        ++size_;
+        setCtrl(index, (int8_t)(hash & 0x7F));
+    }
+
+    void eraseAt(size_t index) {
+        slots_[index].~Slot();
+        --size_;
+        setCtrl(index, flat_hash_detail::CTRL_DELETED);
+    }
+
+    /**
+     * Look up count keys in one pass. The hashes of the whole batch are computed and their
+     * home groups prefetched first, so the cache misses of different keys overlap instead of
+     * being paid one after another. out[i] is null when keys[i] is absent.
+     */
+    void findBatch(const K* keys, int count, const Slot** out) const {
+        const int chunk = 32;
+        uint64_t hashes[chunk];
+        for (int start = 0; start < count; start += chunk) {
+            int n = (std::min)(chunk, count - start);
+            if (capacity_ == 0) {
+                for (int i = 0; i < n; ++i)
+                    out[start + i] = nullptr;
+                continue;
+            }
+            size_t mask = capacity_ - 1;
+            for (int i = 0; i < n; ++i) {
+                hashes[i] = hashOf(keys[start + i]);
+                size_t pos = (size_t)(hashes[i] >> 7) & mask;
+                flat_hash_detail::prefetch(ctrl_ + pos);
+                flat_hash_detail::prefetch(slots_ + pos);
+            }
+            for (int i = 0; i < n; ++i) {
+                size_t index = findIndex(keys[start + i], hashes[i]);
+                out[start + i] = index == NOT_FOUND ? nullptr : slots_ + index;
+            }
+        }
+    }
+
+private:
+    static size_t growthLimit(size_t capacity) { return capacity - capacity / 8; }
+
+    static size_t capacityFor(size_t count) {
+        size_t capacity = flat_hash_detail::GROUP_WIDTH;
+        while (growthLimit(capacity) < count)
+            capacity <<= 1;
+        return capacity;
+    }
+
+    //The first GROUP_WIDTH control bytes are mirrored after the end so that a group load never wraps.
+    void setCtrl(size_t index, int8_t h) {
+        ctrl_[index] = h;
+        if (index < flat_hash_detail::GROUP_WIDTH)
+            ctrl_[capacity_ + index] = h;
+    }
+
+    size_t findFirstNonFull(uint64_t hash) const {
+        size_t mask = capacity_ - 1;
+        size_t pos = (size_t)(hash >> 7) & mask;
+        size_t step = 0;
+        while (true) {
+            uint32_t match = flat_hash_detail::Group(ctrl_ + pos).matchEmptyOrDeleted();
+            if (match != 0)
+                return (pos + flat_hash_detail::lowestBit(match)) & mask;
+            step += flat_hash_detail::GROUP_WIDTH;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    size_t prepareInsert(uint64_t hash) {
+        if (capacity_ == 0)
+            resize(flat_hash_detail::GROUP_WIDTH);
+        size_t index = findFirstNonFull(hash);
+        if (growthLeft_ == 0 && ctrl_[index] != flat_hash_detail::CTRL_DELETED) {
+            //Drop tombstones in place when they, not live entries, used up the growth budget.
+            resize(size_ * 2 < growthLimit(capacity_) ? capacity_ : capacity_ * 2);
+            index = findFirstNonFull(hash);
+        }
+        return index;
+    }
+
+    void allocate(size_t capacity) {
+        ctrl_ = new int8_t[capacity + flat_hash_detail::GROUP_WIDTH];
+        memset(ctrl_, flat_hash_detail::CTRL_EMPTY, capacity + flat_hash_detail::GROUP_WIDTH);
+        slots_ = static_cast<Slot*>(::operator new(capacity * sizeof(Slot)));
+        capacity_ = capacity;
+    }
+
+    void resize(size_t capacity) {
+        int8_t* oldCtrl = ctrl_;
+        Slot* oldSlots = slots_;
+        size_t oldCapacity = capacity_;
+        allocate(capacity);
+        growthLeft_ = growthLimit(capacity) - size_;
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldCtrl[i] < 0)
+                continue;
+            uint64_t hash = hashOf(KeyOf::get(oldSlots[i]));
+            size_t index = findFirstNonFull(hash);
+            new (slots_ + index) Slot(std::move(oldSlots[i]));
+            oldSlots[i].~Slot();
+            setCtrl(index, (int8_t)(hash & 0x7F));
+        }
+        delete[] oldCtrl;
+        ::operator delete(oldSlots);
+    }
+
+    void destroySlots() {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0)
+                slots_[i].~Slot();
+        }
+    }
+
+    void release() {
+        if (capacity_ == 0)
+            return;
+        destroySlots();
+        delete[] ctrl_;
+        ::operator delete(slots_);
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = size_ = growthLeft_ = 0;
+    }
+
+    void copyFrom(const FlatHashTable& other) {
+        if (other.size_ == 0)
+            return;
+        allocate(other.capacity_);
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (other.ctrl_[i] >= 0)
+                new (slots_ + i) Slot(other.slots_[i]);
+            //Publish each control byte after its slot so that a throwing copy leaves nothing half built.
+            ctrl_[i] = other.ctrl_[i];
+        }
+        memcpy(ctrl_ + capacity_, other.ctrl_ + capacity_, flat_hash_detail::GROUP_WIDTH);
+        size_ = other.size_;
+        growthLeft_ = other.growthLeft_;
+    }
+
+    int8_t* ctrl_;
+    Slot* slots_;
+    size_t capacity_;
+    size_t size_;
+    size_t growthLeft_;
+};
+
+/**
+ * Drop-in replacement for the subset of std::unordered_map used by the dictionary
+ * implementations, backed by FlatHashTable.
+ */
+template<class K, class V, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class FlatHashMap : public FlatHashTable<K, std::pair<K, V>, flat_hash_detail::MapKey, Hash, Eq> {
+    typedef FlatHashTable<K, std::pair<K, V>, flat_hash_detail::MapKey, Hash, Eq> Base;
+public:
+    typedef V mapped_type;
+    typedef typename Base::template Iterator<std::pair<K, V>&, std::pair<K, V>*> iterator;
+    typedef typename Base::template Iterator<const std::pair<K, V>&, const std::pair<K, V>*> const_iterator;
+
+    FlatHashMap() {}
+    template<class It>
+    FlatHashMap(It first, It last) {
+        for (; first != last; ++first)
+            emplace(first->first, first->second);
+    }
+
+    iterator find(const K& key) {
+        size_t index = this->findIndex(key);
+        return index == Base::NOT_FOUND ? this->end() : this->template iteratorAt<iterator>(index);
+    }
+    const_iterator find(const K& key) const {
+        size_t index = this->findIndex(key);
+        return index == Base::NOT_FOUND ? this->end() : this->template iteratorAt<const_iterator>(index);
+    }
+    size_t count(const K& key) const { return this->findIndex(key) == Base::NOT_FOUND ? 0 : 1; }
+
+    V& operator[](const K& key) {
+        return this->slotAt(this->emplaceAt(key, key, V())).second;
+    }
+    std::pair<iterator, bool> insert(const std::pair<K, V>& value) { return emplace(value.first, value.second); }
+    std::pair<iterator, bool> emplace(const K& key, const V& value) {
+        size_t oldSize = this->size();
+        size_t index = this->emplaceAt(key, key, value);
+        return std::make_pair(this->template iteratorAt<iterator>(index), this->size() != oldSize);
+    }
+
+    size_t erase(const K& key) {
+        size_t index = this->findIndex(key);
+        if (index == Base::NOT_FOUND)
+            return 0;
+        this->eraseAt(index);
+        return 1;
+    }
+    void erase(const_iterator it) { this->eraseAt(this->indexOf(it)); }
+
+    void findBatch(const K* keys, int count, const std::pair<K, V>** out) const { Base::findBatch(keys, count, out); }
+};
+
+/**
+ * Drop-in replacement for the subset of std::unordered_set used by the set implementations.
+ */
+template<class K, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class FlatHashSet : public FlatHashTable<K, K, flat_hash_detail::SetKey, Hash, Eq> {
+    typedef FlatHashTable<K, K, flat_hash_detail::SetKey, Hash, Eq> Base;
+public:
+    typedef typename Base::template Iterator<const K&, const K*> const_iterator;
+    typedef const_iterator iterator;
+
+    FlatHashSet() {}
+    template<class It>
+    FlatHashSet(It first, It last) { insert(first, last); }
+
+    //Keys must not be modified in place, so a set only hands out const iterators.
+    const_iterator begin() const { return Base::begin(); }
+    const_iterator end() const { return Base::end(); }
+
+    const_iterator find(const K& key) const {
+        size_t index = this->findIndex(key);
+        return index == Base::NOT_FOUND ? this->end() : this->template iteratorAt<const_iterator>(index);
+    }
+    size_t count(const K& key) const { return this->findIndex(key) == Base::NOT_FOUND ? 0 : 1; }
+
+    std::pair<const_iterator, bool> insert(const K& key) {
+        size_t oldSize = this->size();
+        size_t index = this->emplaceAt(key, key);
+        return std::make_pair(this->template iteratorAt<const_iterator>(index), this->size() != oldSize);
+    }
+    template<class It>
+    void insert(It first, It last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    size_t erase(const K& key) {
+        size_t index = this->findIndex(key);
+        if (index == Base::NOT_FOUND)
+            return 0;
+        this->eraseAt(index);
+        return 1;
+    }
+    void erase(const_iterator it) { this->eraseAt(this->indexOf(it)); }
+
+    //Sets out[i] to 1 when keys[i] is a member and 0 otherwise.
+    void containBatch(const K* keys, int count, char* out) const {
+        const K* found[256];
+        for (int start = 0; start < count; start += 256) {
+            int n = (std::min)(256, count - start);
+            Base::findBatch(keys + start, n, found);
+            for (int i = 0; i < n; ++i)
+                out[start + i] = found[i] != nullptr;
+        }
+    }
+};
+
+}
@@ -19,8 +19,13 @@ namespace dolphindb {
 
 class TemporalFormat {
 public:
+    //The longest output of any format: 128 format characters plus 12 fields widened to 9 digits.
+    static const int MAX_OUTPUT_LENGTH = 256;
+
     TemporalFormat(const string& format);
     string format(long long nowtime, DATA_TYPE dtype) const;
+    //Write the formatted value to buf, which must hold MAX_OUTPUT_LENGTH chars, and return its length. No '\0' is appended.
+    int format(long long nowtime, DATA_TYPE dtype, char* buf) const;
     static vector<pair<int, int> > initFormatMap();
 
 private:
@@ -53,7 +58,12 @@ class NumberFormat {
 public:
     NumberFormat(const string& format);
     string format(double x) const;
+    //Write the formatted value to buf, which must hold getMaxLength() chars, and return its length. No '\0' is appended.
+    int format(double x, char* buf) const;
+    int getMaxLength() const;
     static string toString(long long x);
+    //Decimal digits of x into buf, which must hold 20 chars; returns the length.
+    static int toString(long long x, char* buf);
 
 private:
 	 void initialize(const string& format);
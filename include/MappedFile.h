@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include "Exports.h"
+
+namespace dolphindb {
+
+/**
+ * A whole file mapped into memory. A writable mapping is private copy-on-write: pages written
+ * through data() are copied first and the file itself never changes. The mapping stays valid
+ * after the file is deleted or renamed.
+ */
+class EXPORT_DECL MappedFile {
+public:
+    //sequential hints the OS to read ahead for one front-to-back scan.
+    explicit MappedFile(const std::string& path, bool writable = false, bool sequential = false);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    char* data_;
+    size_t size_;
+#ifdef WINDOWS
+    void* file_;
+    void* mapping_;
+#endif
+};
+
+}
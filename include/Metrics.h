@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include "Exports.h"
+#include "Concurrent.h"
+
+namespace dolphindb {
+
+class EXPORT_DECL MetricCounter {
+public:
+    MetricCounter() : value_(0) {}
+    void increment(long long n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    long long get() const { return value_.load(std::memory_order_relaxed); }
+private:
+    std::atomic<long long> value_;
+};
+
+class EXPORT_DECL MetricGauge {
+public:
+    MetricGauge() : value_(0) {}
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+    void add(double delta) {
+        double old = value_.load(std::memory_order_relaxed);
+        while (!value_.compare_exchange_weak(old, old + delta, std::memory_order_relaxed)) {}
+    }
+    double get() const { return value_.load(std::memory_order_relaxed); }
+private:
+    std::atomic<double> value_;
+};
+
+/**
+ * HDR-style histogram of non-negative integers. Values are kept in log-linear buckets with
+ * 2^SUB_BUCKET_BITS sub-buckets per power of two, so quantiles have a relative error below
+ * 1/2^(SUB_BUCKET_BITS-1) over the whole 64-bit range. Recording is a few atomic adds.
+ */
+class EXPORT_DECL MetricHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 7;
+    static const int BUCKET_COUNT = (1 << SUB_BUCKET_BITS) + (63 - SUB_BUCKET_BITS) * (1 << (SUB_BUCKET_BITS - 1));
+
+    MetricHistogram();
+    void record(long long value);
+    long long count() const { return count_.load(std::memory_order_relaxed); }
+    long long sum() const { return sum_.load(std::memory_order_relaxed); }
+    long long min() const;
+    long long max() const { return max_.load(std::memory_order_relaxed); }
+    //q in [0, 1]
+    long long percentile(double q) const;
+    void reset();
+
+    static int bucketIndex(long long value);
+    static long long bucketLowerBound(int index);
+
+private:
+    std::unique_ptr<std::atomic<long long>[]> buckets_;
+    std::atomic<long long> count_;
+    std::atomic<long long> sum_;
+    std::atomic<long long> min_;
+    std::atomic<long long> max_;
+};
+
+enum METRIC_TYPE { METRIC_COUNTER, METRIC_GAUGE, METRIC_HISTOGRAM };
+
+struct MetricSample {
+    std::string name;
+    //Prometheus label list without braces, e.g. topic="a",site="b"
+    std::string labels;
+    METRIC_TYPE type;
+    //counter and gauge value
+    double value;
+    //histogram count and sum
+    long long count;
+    long long sum;
+    //histogram quantiles as (q, value) pairs
+    std::vector<std::pair<double, long long>> quantiles;
+};
+
+/**
+ * Process-wide registry of counters, gauges and histograms. Metric objects live until the
+ * process exits, so the returned pointers can be cached by the instrumented code. Gauges
+ * backed by a callback must be unregistered before the object they read from is destroyed.
+ */
+class EXPORT_DECL MetricsRegistry {
+public:
+    static MetricsRegistry& instance();
+
+    MetricCounter* counter(const std::string &name, const std::string &labels = "");
+    MetricGauge* gauge(const std::string &name, const std::string &labels = "");
+    MetricHistogram* histogram(const std::string &name, const std::string &labels = "");
+    //The callback is evaluated on every snapshot. Registering the same name and labels again replaces it.
+    void registerGauge(const std::string &name, const std::string &labels, const std::function<double()> &func);
+    void unregisterGauge(const std::string &name, const std::string &labels);
+
+    void snapshot(std::vector<MetricSample> &samples);
+    //Prometheus text exposition format, histograms are exposed as summaries.
+    std::string toPrometheusText();
+    //Zero every counter, gauge and histogram.
+    void reset();
+
+    //Format one label pair, escaping the value.
+    static std::string label(const std::string &key, const std::string &value);
+
+private:
+    MetricsRegistry() {}
+    struct Entry {
+        METRIC_TYPE type;
+        std::string name;
+        std::string labels;
+        std::unique_ptr<MetricCounter> counter;
+        std::unique_ptr<MetricGauge> gauge;
+        std::unique_ptr<MetricHistogram> histogram;
+        std::function<double()> func;
+    };
+    Entry* findOrCreate(const std::string &name, const std::string &labels, METRIC_TYPE type);
+
+    Mutex mutex_;
+    std::vector<std::unique_ptr<Entry>> entries_;
+    std::unordered_map<std::string, Entry*> index_;
+};
+
+}
@@ -6,6 +6,7 @@
 #include "Util.h"
 #include "Types.h"
 #include "Exceptions.h"
+#include "SymbolEncoder.h"
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -106,7 +107,8 @@ private:
 			dataType = (DATA_TYPE)(dataType - ARRAY_TYPE_BASE);
 		return dataType;
 	}
-	void insertThreadWrite(int threadhashkey, std::vector<ConstantSP> *prow);
+	//Append records[rows[0]], ..., records[rows[count - 1]] (records[0..count) when rows is null) to the queue of a thread.
+	void insertThreadWrite(int threadIndex, std::vector<ConstantSP> **records, const int *rows, int count);
     static void callBack(std::function<void(ConstantSP)> callbackFunc, bool result, std::vector<ConstantSP>* block);
     std::vector<ConstantSP>* createColumnBlock();
     struct WriterThread {
@@ -121,6 +123,8 @@ private:
         Mutex mutex_, writeQueueMutex_;
         unsigned int threadId;
         long sentRows;
+        //Interns the symbols of every batch this thread sends
+        SymbolEncoder symbolEncoder;
 		bool exit;
     };
     class SendExecutor : public dolphindb::Runnable {
@@ -174,6 +178,7 @@ private:
     RWLock insertRWLock_;
 
     bool enableStreamTableTimestamp_;
+    std::string metricsLabels_;
 public:
     PytoDdbRowPool * getPytoDdb(){ return pytoDdb_;}
 };
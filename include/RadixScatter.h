@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include "Exports.h"
+#include "SmartPointer.h"
+#include "Table.h"
+#include "Types.h"
+#include "Vector.h"
+
+namespace dolphindb {
+
+/**
+ * Routes the rows of a table to a number of destinations, given the destination of each row, in
+ * two passes. The constructor counts the rows of each destination (the histogram); scatter then
+ * copies each column into one contiguous vector per destination, keeping the input order of the
+ * rows within a destination.
+ *
+ * Fixed-width columns (including SYMBOL, INT128, UUID and IPADDR) are scattered straight from
+ * their raw storage in one sequential read, with one write cursor per destination. STRING and
+ * BLOB values go into arena string vectors. Other columns are gathered row by row.
+ *
+ * All methods are const and may be called from several threads at once.
+ */
+class EXPORT_DECL RadixScatter {
+public:
+    //Every partition id must be in [0, destinations); throws a RuntimeException otherwise.
+    RadixScatter(std::vector<int> partitionIds, int destinations);
+
+    int destinations() const { return destinations_; }
+    INDEX rows() const { return (INDEX)ids_.size(); }
+    const std::vector<int>& partitionIds() const { return ids_; }
+    INDEX count(int destination) const { return offsets_[destination + 1] - offsets_[destination]; }
+    //Where the rows of destination begin in rowOrder(); offset(destinations()) is rows().
+    INDEX offset(int destination) const { return offsets_[destination]; }
+    //The row numbers grouped by destination, in input order within each destination.
+    std::vector<int> rowOrder() const;
+
+    //One vector per destination with the values of its rows.
+    std::vector<VectorSP> scatter(const VectorSP& column) const;
+    //One table per destination, with the same columns as table; destinations without rows get empty tables.
+    std::vector<TableSP> scatter(const TableSP& table) const;
+
+private:
+    std::vector<int> ids_;
+    int destinations_;
+    std::vector<INDEX> offsets_;
+};
+
+}
@@ -10,6 +10,8 @@
 
 #include <unordered_set>
 
+#include "FlatHashMap.h"
+
 #include "Set.h"
 #include "Util.h"
 
@@ -21,7 +23,8 @@ public:
 	AbstractSet(DATA_TYPE type, INDEX capacity = 0) : type_(type), category_(Util::getCategory(type_)){
 		if(capacity > 0) data_.reserve(capacity);
 	}
-	AbstractSet(DATA_TYPE type, const std::unordered_set<T>& data) : type_(type), category_(Util::getCategory(type_)), data_(data){}
+	AbstractSet(DATA_TYPE type, const std::unordered_set<T>& data) : type_(type), category_(Util::getCategory(type_)), data_(data.begin(), data.end()){}
+	AbstractSet(DATA_TYPE type, const FlatHashSet<T>& data) : type_(type), category_(Util::getCategory(type_)), data_(data){}
 	virtual bool sizeable() const {return true;}
 	virtual INDEX size() const {return static_cast<INDEX>(data_.size());}
 	virtual ConstantSP keys() const {
@@ -30,7 +33,7 @@ public:
 	virtual DATA_TYPE getType() const {return type_;}
 	virtual DATA_TYPE getRawType() const {return type_ == DT_SYMBOL ? DT_INT : Util::convertToIntegralDataType(type_);}
 	virtual DATA_CATEGORY getCategory() const {return category_;}
-	virtual long long getAllocatedMemory() const { return sizeof(T) * data_.bucket_count();}
+	virtual long long getAllocatedMemory() const { return data_.getAllocatedMemory();}
 	virtual std::string getString() const {
 		int len=(std::min)(Util::DISPLAY_ROWS,size());
 		ConstantSP key = getSubVector(0, len);
@@ -72,13 +75,14 @@ public:
 protected:
 	DATA_TYPE type_;
 	DATA_CATEGORY category_;
-	std::unordered_set<T> data_;
+	FlatHashSet<T> data_;
 };
 
 class CharSet : public AbstractSet<char> {
 public:
 	CharSet(INDEX capacity = 0) : AbstractSet<char>(DT_CHAR, capacity){}
 	CharSet(const std::unordered_set<char>& data) : AbstractSet<char>(DT_CHAR, data){}
+	CharSet(const FlatHashSet<char>& data) : AbstractSet<char>(DT_CHAR, data){}
 	virtual ConstantSP getInstance() const { return new CharSet();}
 	virtual ConstantSP getValue() const { return new CharSet(data_);}
 	virtual void contain(const ConstantSP& target, const ConstantSP& resultSP) const;
@@ -95,6 +99,7 @@ class ShortSet : public AbstractSet<short> {
 public:
 	ShortSet(INDEX capacity = 0) : AbstractSet<short>(DT_SHORT, capacity){}
 	ShortSet(const std::unordered_set<short>& data) : AbstractSet<short>(DT_SHORT, data){}
+	ShortSet(const FlatHashSet<short>& data) : AbstractSet<short>(DT_SHORT, data){}
 	virtual ConstantSP getInstance() const { return new ShortSet();}
 	virtual ConstantSP getValue() const { return new ShortSet(data_);}
 	virtual void contain(const ConstantSP& target, const ConstantSP& resultSP) const;
@@ -111,6 +116,7 @@ class IntSet : public AbstractSet<int> {
 public:
 	IntSet(DATA_TYPE type = DT_INT, INDEX capacity = 0) : AbstractSet<int>(type, capacity){}
 	IntSet(DATA_TYPE type, const std::unordered_set<int>& data) : AbstractSet<int>(type, data){}
+	IntSet(DATA_TYPE type, const FlatHashSet<int>& data) : AbstractSet<int>(type, data){}
 	virtual ConstantSP getInstance() const { return new IntSet(type_);}
 	virtual ConstantSP getValue() const { return new IntSet(type_, data_);}
 	virtual void contain(const ConstantSP& target, const ConstantSP& resultSP) const;
@@ -127,6 +133,7 @@ class LongSet : public AbstractSet<long long> {
 public:
 	LongSet(DATA_TYPE type = DT_LONG, INDEX capacity = 0) : AbstractSet<long long>(type, capacity){}
 	LongSet(DATA_TYPE type, const std::unordered_set<long long>& data) : AbstractSet<long long>(type, data){}
+	LongSet(DATA_TYPE type, const FlatHashSet<long long>& data) : AbstractSet<long long>(type, data){}
 	virtual ConstantSP getInstance() const { return new LongSet(type_);}
 	virtual ConstantSP getValue() const { return new LongSet(type_, data_);}
 	virtual void contain(const ConstantSP& target, const ConstantSP& resultSP) const;
@@ -143,6 +150,7 @@ class FloatSet : public AbstractSet<float> {
 public:
 	FloatSet(INDEX capacity = 0) : AbstractSet<float>(DT_FLOAT, capacity){}
 	FloatSet(const std::unordered_set<float>& data) : AbstractSet<float>(DT_FLOAT, data){}
+	FloatSet(const FlatHashSet<float>& data) : AbstractSet<float>(DT_FLOAT, data){}
 	virtual ConstantSP getInstance() const { return new FloatSet();}
 	virtual ConstantSP getValue() const { return new FloatSet(data_);}
 	virtual void contain(const ConstantSP& target, const ConstantSP& resultSP) const;
@@ -159,6 +167,7 @@ class DoubleSet : public AbstractSet<double> {
 public:
 	DoubleSet(INDEX capacity = 0) : AbstractSet<double>(DT_DOUBLE, capacity){}
 	DoubleSet(const std::unordered_set<double>& data) : AbstractSet<double>(DT_DOUBLE, data){}
+	DoubleSet(const FlatHashSet<double>& data) : AbstractSet<double>(DT_DOUBLE, data){}
 	virtual ConstantSP getInstance() const { return new DoubleSet();}
 	virtual ConstantSP getValue() const { return new DoubleSet(data_);}
 	virtual void contain(const ConstantSP& target, const ConstantSP& resultSP) const;
@@ -177,6 +186,8 @@ public:
 		: AbstractSet<std::string>(isBlob ? DT_BLOB : isSymbol ? DT_SYMBOL : DT_STRING, capacity), isBlob_(isBlob), isSymbol_(isSymbol){}
 	StringSet(const std::unordered_set<std::string>& data, bool isBlob = false, bool isSymbol = false)
 		: AbstractSet<std::string>(isBlob ? DT_BLOB : isSymbol ? DT_SYMBOL : DT_STRING, data), isBlob_(isBlob), isSymbol_(isSymbol){}
+	StringSet(const FlatHashSet<std::string>& data, bool isBlob = false, bool isSymbol = false)
+		: AbstractSet<std::string>(isBlob ? DT_BLOB : isSymbol ? DT_SYMBOL : DT_STRING, data), isBlob_(isBlob), isSymbol_(isSymbol){}
 	virtual ConstantSP getInstance() const { return new StringSet(0, isBlob_, isSymbol_);}
 	virtual ConstantSP getValue() const { return new StringSet(data_, isBlob_, isSymbol_);}
 	virtual void contain(const ConstantSP& target, const ConstantSP& resultSP) const;
@@ -196,6 +207,7 @@ class Int128Set : public AbstractSet<Guid> {
 public:
 	Int128Set(DATA_TYPE type = DT_INT128, INDEX capacity = 0) : AbstractSet<Guid>(type, capacity){}
 	Int128Set(DATA_TYPE type, const std::unordered_set<Guid>& data) : AbstractSet<Guid>(type, data){}
+	Int128Set(DATA_TYPE type, const FlatHashSet<Guid>& data) : AbstractSet<Guid>(type, data){}
 	virtual ConstantSP getInstance() const { return new Int128Set(type_);}
 	virtual ConstantSP getValue() const { return new Int128Set(type_, data_);}
 	virtual void contain(const ConstantSP& target, const ConstantSP& resultSP) const;
@@ -27,13 +27,18 @@ public:
     virtual ~StreamingClient();
 	bool isExit();
 	void exit();
+	//Decode the messages of each subscription connection on decodeThreads threads while the connection keeps reading,
+	//with at most pipelineCapacity messages in flight. With 0 decode threads, the default, messages are decoded on
+	//the reader thread. Applies to connections opened afterwards.
+	void setParseThreads(int decodeThreads, int pipelineCapacity = 64);
 
 protected:
     SubscribeQueue subscribeInternal(std::string host, int port, std::string tableName, std::string actionName = DEFAULT_ACTION_NAME,
                                      int64_t offset = -1, bool resubscribe = true, const VectorSP &filter = nullptr,
                                      bool msgAsTable = false, bool allowExists = false, int batchSize  = 1,
 									 std::string userName="", std::string password="",
-									 const StreamDeserializerSP &blobDeserializer = nullptr, const std::vector<std::string>& backupSites = std::vector<std::string>(), bool isEvent = false, int resubTimeout = 100, bool subOnce = false);
+									 const StreamDeserializerSP &blobDeserializer = nullptr, const std::vector<std::string>& backupSites = std::vector<std::string>(), bool isEvent = false, int resubTimeout = 100, bool subOnce = false,
+									 bool symbolTable = false);
     void unsubscribeInternal(std::string host, int port, std::string tableName, std::string actionName = DEFAULT_ACTION_NAME);
 
 protected:
@@ -45,10 +50,22 @@ public:
     EventClient(const std::vector<EventSchema>& eventSchema, const std::vector<std::string>& eventTimeFields, const std::vector<std::string>& commonFields);
     ThreadSP subscribe(const std::string& host, int port, const EventMessageHandler &handler, const std::string& tableName, const std::string& actionName = DEFAULT_ACTION_NAME, int64_t offset = -1,
         bool resub = true, const std::string& userName="", const std::string& password="");
+    //Deliver consecutive events of the same type as reusable attribute columns, see EventHandler::deserializeEvent.
+    ThreadSP subscribe(const std::string& host, int port, const EventBatchMessageHandler &handler, const std::string& tableName, const std::string& actionName = DEFAULT_ACTION_NAME, int64_t offset = -1,
+        bool resub = true, const std::string& userName="", const std::string& password="");
     void unsubscribe(const std::string& host, int port, const std::string& tableName, const std::string& actionName = DEFAULT_ACTION_NAME);
 
+private:
+    //decode is called on the handler thread for every message, it returns false on a deserialization error.
+    ThreadSP subscribeEvents(const std::string& host, int port, const std::string& tableName, const std::string& actionName, int64_t offset,
+        bool resub, const std::string& userName, const std::string& password, const std::function<bool(const ConstantSP&, ErrorCodeInfo&)>& decode);
+
 private:
     EventHandler      eventHandler_;
+    //Kept to give every batch subscription a decoder of its own.
+    std::vector<EventSchema>    eventSchemas_;
+    std::vector<std::string>    eventTimeKeys_;
+    std::vector<std::string>    commonKeys_;
 };
 
 class EXPORT_DECL ThreadedClient : public StreamingClient {
@@ -68,6 +85,16 @@ public:
 						double throttle = 1,bool msgAsTable = false,
 						std::string userName = "", std::string password = "",
 						const StreamDeserializerSP &blobDeserializer = nullptr, const std::vector<std::string>& backupSites = std::vector<std::string>(),int resubTimeout = 100,bool subOnce = false);
+    /**
+     * Subscribe to a heterogeneous stream table and receive its rows as one table per symbol. Rows are deserialized
+     * by blobDeserializer, which is required, and a symbol's table is delivered once it holds batchSize rows or its
+     * oldest row has waited throttle seconds. See SymbolTableAccumulator.
+     */
+    ThreadSP subscribe(std::string host, int port, const SymbolTableHandler &handler, std::string tableName,
+                       std::string actionName, int64_t offset, bool resub, const VectorSP &filter, bool allowExists,
+                       int batchSize, double throttle, std::string userName, std::string password,
+                       const StreamDeserializerSP &blobDeserializer, const std::vector<std::string>& backupSites = std::vector<std::string>(),
+                       int resubTimeout = 100, bool subOnce = false);
 	size_t getQueueDepth(const ThreadSP &thread);
     void unsubscribe(std::string host, int port, std::string tableName, std::string actionName = DEFAULT_ACTION_NAME);
 };
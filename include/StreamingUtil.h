@@ -4,8 +4,11 @@
 #include "Constant.h"
 #include "Concurrent.h"
 #include "Dictionary.h"
+#include "Table.h"
 #include "Vector.h"
 #include "ErrorCodeInfo.h"
+#include <memory>
+#include <deque>
 
 namespace dolphindb {
 
@@ -20,8 +23,12 @@ using MessageQueueSP = SmartPointer<MessageQueue>;
 using MessageHandler = std::function<void(Message)>;
 using MessageBatchHandler = std::function<void(std::vector<Message>)>;
 using EventMessageHandler = std::function<void(const std::string&, std::vector<ConstantSP>&)>;
+//Receives consecutive events of one type as one column per attribute and the number of rows. The columns are reused after the call returns.
+using EventBatchMessageHandler = std::function<void(const std::string&, const std::vector<VectorSP>&, INDEX)>;
 using IPCInMemoryTableReadHandler = std::function<void(ConstantSP)>;
 using MessageBatchHandlerUDP = std::function<void(MessageQueue)>;
+//Receives the accumulated rows of one symbol of a heterogeneous stream table as a table.
+using SymbolTableHandler = std::function<void(const std::string&, const TableSP&)>;
 
 #define DEFAULT_ACTION_NAME "cppStreamingAPI"
 
@@ -34,14 +41,47 @@ public:
     StreamDeserializer(const std::unordered_map<std::string, std::vector<DATA_TYPE>> &symbol2col);
     virtual ~StreamDeserializer() = default;
     bool parseBlob(const ConstantSP &src, std::vector<VectorSP> &rows, std::vector<std::string> &symbols, ErrorCodeInfo &errorInfo);
+    /**
+     * Columnar variant of parseBlob. The rows of each symbol are appended to columns[symbol], one vector per
+     * column of that symbol's table. Missing entries are created, existing ones are appended to, so the same
+     * map can accumulate several blocks.
+     */
+    bool parseBlob(const ConstantSP &src, std::unordered_map<std::string, std::vector<VectorSP>> &columns, ErrorCodeInfo &errorInfo);
+    /**
+     * Decode blocks of at least PARALLEL_MIN_ROWS rows on up to the given number of threads. The default is 1,
+     * which decodes on the calling thread only. The extra threads are started here and kept for the life of the
+     * deserializer, so call this before subscribing.
+     */
+    void setParallelism(int threads);
+    static const int PARALLEL_MIN_ROWS = 1024;
+
+    std::vector<std::string> getSymbols() const;
+    /**
+     * Create empty column vectors for the table of the given symbol, in the layout the columnar parseBlob
+     * produces. Tables registered with types only get the column names col1, col2, ...
+     * Returns false if the symbol is unknown.
+     */
+    bool newColumns(const std::string &symbol, INDEX capacity, std::vector<VectorSP> &columns, std::vector<std::string> &colNames) const;
 private:
     class TableInfo{
     public:
         TableInfo(std::vector<DATA_TYPE> cols) : cols_(cols), scales_(cols.size()), queuelimit_(65535){
+            for (size_t i = 0; i < cols_.size(); ++i)
+                names_.push_back("col" + std::to_string(i + 1));
+            initFieldKinds();
         }
-        TableInfo(std::vector<DATA_TYPE> cols, std::vector<int> scales) : cols_(cols), scales_(scales), queuelimit_(65535){
+        TableInfo(std::vector<DATA_TYPE> cols, std::vector<int> scales, std::vector<std::string> names)
+            : cols_(cols), scales_(scales), names_(names), queuelimit_(65535){
+            initFieldKinds();
         }
         ConstantSP newTuple();
+        std::vector<VectorSP> newColumns(INDEX capacity) const;
+        const std::vector<std::string>& getColumnNames() const { return names_; }
+        //Decode one row blob of size bytes. stream is a scratch stream over an external buffer used for variable-length fields.
+        bool decodeTuple(const char *blob, size_t size, const VectorSP &tuple, DataInputStream &stream, ErrorCodeInfo &errorInfo) const;
+        bool decodeColumns(const char *blob, size_t size, std::vector<VectorSP> &columns, const VectorSP &scratch,
+                           std::vector<std::string> &fixedBuffers, DataInputStream &stream, ErrorCodeInfo &errorInfo) const;
+        void flushColumns(std::vector<VectorSP> &columns, std::vector<std::string> &fixedBuffers) const;
         void setLimit(INDEX limit){
             queuelimit_ = limit;
         }
@@ -52,18 +92,38 @@ private:
             }
         }
     private:
+        void initFieldKinds();
         std::vector<DATA_TYPE> cols_;
         std::vector<int> scales_;
+        std::vector<std::string> names_;
+        //How each field is laid out in a blob, see FIELD_KIND in StreamingUtil.cpp
+        std::vector<char> kinds_;
         INDEX queuelimit_;
         std::vector<ConstantSP> queue_;
         Mutex mutex_;
     };
+    typedef std::unordered_map<std::string, SmartPointer<TableInfo>> TableInfoMap;
+    typedef std::shared_ptr<const TableInfoMap> TableInfoMapSP;
+    //Copy-on-write snapshot, readers never lock.
+    TableInfoMapSP getTableInfos() const { return std::atomic_load(&symbol2tableInfo_); }
+    bool parseRows(const TableInfoMapSP &infos, const ConstantSP &src, INDEX begin, INDEX end, std::vector<VectorSP> &rows,
+                   std::vector<std::string> &symbols, ErrorCodeInfo &errorInfo);
+    bool parseColumns(const TableInfoMapSP &infos, const ConstantSP &src, INDEX begin, INDEX end,
+                      std::unordered_map<std::string, std::vector<VectorSP>> &columns, ErrorCodeInfo &errorInfo);
+    class ChunkWorkers;
+    int getChunkCount(INDEX rows) const;
+    //Split [0, rows) into chunkCount chunks and run task on each of them, the first one on the calling thread.
+    bool runChunks(int chunkCount, INDEX rows, const std::function<bool(int, INDEX, INDEX, ErrorCodeInfo&)> &task, ErrorCodeInfo &errorInfo);
     void setTupleLimit(INDEX limit);
     void returnMessage(Message *msg);
     void create(DBConnection &conn);
     void parseSchema(const std::unordered_map<std::string, DictionarySP> &sym2schema);
     std::unordered_map<std::string, std::pair<std::string, std::string>> sym2tableName_;
-    std::unordered_map<std::string, SmartPointer<TableInfo>> symbol2tableInfo_;
+    TableInfoMapSP symbol2tableInfo_;
+    int parallelism_;
+    //The threads that decode all chunks but the first, shared by concurrent parseBlob calls.
+    std::shared_ptr<ChunkWorkers> workers_;
+    //Serializes writers of symbol2tableInfo_
     Mutex mutex_;
     friend class StreamingClientImpl;
     friend class Message;
@@ -103,4 +163,43 @@ private:
     StreamDeserializerSP sd_;
     int offset_;
 };
+
+/**
+ * Accumulates the rows of a heterogeneous stream table into one table per symbol. A symbol's table is handed
+ * to the handler once it holds batchSize rows or its oldest row has waited throttle milliseconds. Like the
+ * tuples of StreamDeserializer, the column vectors are recycled: they are cleared and refilled once the handler
+ * no longer holds a reference to the table it received.
+ */
+class EXPORT_DECL SymbolTableAccumulator {
+public:
+    SymbolTableAccumulator(const StreamDeserializerSP &deserializer, const SymbolTableHandler &handler, int batchSize, int throttle);
+    //Deserialize a block of the stream table, i.e. the [timestamp, symbol, blob] columns sent by the publisher.
+    bool append(const ConstantSP &block, ErrorCodeInfo &errorInfo);
+    //Flush the tables whose oldest row is at least throttle milliseconds older than now (epoch milliseconds).
+    //Returns the milliseconds until the next pending table expires, or throttle if no rows are pending.
+    int flushExpired(long long now);
+    void flushAll();
+
+private:
+    struct SymbolState {
+        SymbolState() : firstTime(-1) {}
+        std::vector<std::string> colNames;
+        //Epoch milliseconds of the oldest buffered row, -1 if the table is empty.
+        long long firstTime;
+        //Column sets handed to the handler that are still referenced.
+        std::deque<std::vector<VectorSP>> lent;
+        //Cleared column sets ready for reuse.
+        std::vector<std::vector<VectorSP>> pool;
+    };
+    void flush(const std::string &symbol, std::vector<VectorSP> &columns, SymbolState &state);
+
+    static const size_t MAX_LENT = 16;
+    StreamDeserializerSP deserializer_;
+    SymbolTableHandler handler_;
+    int batchSize_;
+    int throttle_;
+    //The tables being filled, appended to by StreamDeserializer::parseBlob directly.
+    std::unordered_map<std::string, std::vector<VectorSP>> columns_;
+    std::unordered_map<std::string, SymbolState> states_;
+};
 }
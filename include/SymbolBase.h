@@ -16,6 +16,8 @@ public:
 
     SymbolBase(int id, const DataInputStreamSP& in, IO_ERR& ret);
 
+    SymbolBase(int id, std::vector<std::string>&& syms):id_(id), syms_(std::move(syms)){}
+
     const std::string& getSymbol(int index) const { return syms_[index];}
 
     int serialize(char* buf, int bufSize, INDEX indexStart, int offset, int& numElement, int& partial) const;
@@ -24,7 +26,7 @@ public:
 
     int findAndInsert(const std::string& symbol);
 
-    std::size_t size() const {return  symMap_.size();}
+    std::size_t size() const {return  syms_.size();}
 
     const int& getID(){return id_;}
 private:
@@ -34,4 +36,30 @@ private:
 };
 
 typedef SmartPointer<SymbolBase> SymbolBaseSP;
+
+/**
+ * Symbol bases received over one session or subscription socket, keyed by the id the server assigned.
+ * A base that arrives again with the same id and content, or with an empty body, resolves to the cached
+ * instance. The cached bases are never handed out: every decoded vector gets a copy of its own, so symbols
+ * inserted into one result never show up in another. Not thread-safe, it belongs to the thread reading the socket.
+ */
+class EXPORT_DECL SymbolBaseCache {
+public:
+    SymbolBaseCache() : hits_(0), misses_(0) {}
+    SymbolBaseSP get(int id) const;
+    void put(int id, const SymbolBaseSP& base);
+    void clear() { bases_.clear(); }
+    void recordHit();
+    void recordMiss();
+    long long getHits() const { return hits_; }
+    long long getMisses() const { return misses_; }
+    std::size_t size() const { return bases_.size(); }
+
+private:
+    std::unordered_map<int, SymbolBaseSP> bases_;
+    long long hits_;
+    long long misses_;
+};
+
+typedef SmartPointer<SymbolBaseCache> SymbolBaseCacheSP;
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include "Exports.h"
+#include "SymbolBase.h"
+#include "Vector.h"
+#include "Table.h"
+
+namespace dolphindb {
+
+/**
+ * Dictionary-encodes string columns bound for SYMBOL targets into FastSymbolVectors. Values are interned
+ * into one long-lived dictionary, and every encode call then re-codes the columns it is given into a
+ * dictionary of its own that holds only the symbols those columns use. VectorMarshall sends that small
+ * dictionary followed by int codes, so a batch never carries the symbols of earlier batches.
+ *
+ * The long-lived dictionary is not thread-safe, so an encoder must be owned by a single sending thread.
+ */
+class EXPORT_DECL SymbolEncoder {
+public:
+    //The dictionary is dropped and restarted once it holds more than maxSymbols entries.
+    explicit SymbolEncoder(int maxSymbols = DEFAULT_MAX_SYMBOLS);
+
+    //An empty symbol vector backed by the long-lived dictionary. Encode it before sending.
+    VectorSP createVector(INDEX capacity);
+    //Returns col unchanged unless it is a STRING or SYMBOL vector, otherwise a symbol vector with the symbols of col only.
+    VectorSP encode(const VectorSP &col);
+    //Encode the columns whose target type is DT_SYMBOL into one dictionary. Returns the input table if nothing has to change.
+    TableSP encode(const TableSP &table, const std::vector<DATA_TYPE> &targetTypes);
+    //Encode in place the columns whose target type is DT_SYMBOL into one dictionary.
+    void encode(std::vector<ConstantSP> &columns, const std::vector<DATA_TYPE> &targetTypes);
+
+    SymbolBaseSP getSymbolBase() const { return base_; }
+    void clear();
+
+    static const int DEFAULT_MAX_SYMBOLS = 1 << 16;
+
+private:
+    struct Pending {
+        int *codes;
+        INDEX rows;
+        bool containNull;
+    };
+
+    void prepare();
+    //Translate the codes of another dictionary into codes of the long-lived one.
+    const int* remap(const SymbolBaseSP &base);
+    //Whether col is a STRING or SYMBOL vector.
+    bool needsEncoding(const VectorSP &col) const;
+    void beginBatch();
+    //Codes of col in the dictionary of the current batch.
+    Pending encodeCodes(const VectorSP &col);
+    int batchCode(int code);
+    //The dictionary of the current batch, with its symbols in the order of their batch codes.
+    SymbolBaseSP endBatch();
+    static VectorSP createVector(const SymbolBaseSP &base, const Pending &pending);
+
+    int maxSymbols_;
+    SymbolBaseSP base_;
+    //remap_[i] is the shared code of symbol i of remapBase_, which had remapSize_ entries when remap_ was built.
+    SymbolBaseSP remapBase_;
+    std::size_t remapSize_;
+    std::vector<int> remap_;
+    //batchCodes_[code] is the batch code of a long-lived code, or -1; batchSymbols_ is its inverse.
+    std::vector<int> batchCodes_;
+    std::vector<int> batchSymbols_;
+};
+
+}
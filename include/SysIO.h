@@ -209,6 +209,11 @@ public:
 	 * Reset the size of an external buffer. The cursor moves to the beginning of the buffer.
 	 */
 	bool reset(int size);
+
+	/**
+	 * Point a stream created over an external buffer at another buffer. The cursor moves to the beginning of the buffer.
+	 */
+	bool reset(const char* data, std::size_t size);
 protected:
 	/**
 	 * Read up to number of bytes specified by the length. If the underlying device doesn't have even one byte
@@ -52,6 +52,13 @@ public:
     virtual void checkout() const {}
     virtual long long getAllocatedMemory() const = 0;
     virtual ConstantSP getSubTable(std::vector<int> indices) const = 0;
+    /**
+     * The rows at indices, or the rows [start, start + length), as a read-only table whose columns
+     * share the storage of this table's columns (see Util::createGatherView and Util::createSliceView).
+     * Call getValue() on it for a modifiable copy.
+     */
+    virtual ConstantSP getSubTableView(std::vector<int> indices) const {throw RuntimeException("getSubTableView method not supported");}
+    virtual ConstantSP getSubTableView(INDEX start, INDEX length) const {throw RuntimeException("getSubTableView method not supported");}
     virtual COMPRESS_METHOD getColumnCompressMethod(INDEX index) = 0;
     virtual void setColumnCompressMethods(const std::vector<COMPRESS_METHOD> &methods) = 0;
     virtual bool clear()=0;
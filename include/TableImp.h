@@ -107,6 +107,8 @@ public:
 	virtual bool clear();
 	virtual void updateSize();
 	virtual ConstantSP getSubTable(std::vector<int> indices) const;
+	virtual ConstantSP getSubTableView(std::vector<int> indices) const;
+	virtual ConstantSP getSubTableView(INDEX start, INDEX length) const;
 
 private:
 	bool increaseCapacity(long long newCapacity, std::string& errMsg);
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Exports.h"
+#include "Types.h"
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+namespace dolphindb {
+
+namespace kernels {
+
+/**
+ * Unsigned 64-bit division by a divisor fixed at run time, replaced by a multiply-high and two
+ * shifts (the "branchfree" scheme of libdivide). Building it costs one long division; every
+ * divide() afterwards avoids the hardware divider, which dominates per-row temporal rescaling.
+ */
+class EXPORT_DECL Divisor {
+public:
+    explicit Divisor(unsigned long long divisor);
+
+    unsigned long long divisor() const { return divisor_; }
+
+    unsigned long long divide(unsigned long long n) const {
+        if (divisor_ == 1)
+            return n;
+        unsigned long long q = mulhi(magic_, n);
+        return (((n - q) >> 1) + q) >> shift_;
+    }
+
+    //Division rounding towards negative infinity: floorDivide(-1) is -1 for any divisor.
+    long long floorDivide(long long n) const {
+        //For negative n, n ^ sign is -n-1 >= 0, and floor(n/d) == ~((-n-1)/d).
+        unsigned long long sign = (unsigned long long)(n >> 63);
+        return (long long)(divide((unsigned long long)n ^ sign) ^ sign);
+    }
+
+    //Remainder of floorDivide, always in [0, divisor).
+    long long floorMod(long long n) const {
+        return (long long)((unsigned long long)n - (unsigned long long)floorDivide(n) * divisor_);
+    }
+
+private:
+    static unsigned long long mulhi(unsigned long long a, unsigned long long b) {
+#if defined(__SIZEOF_INT128__)
+        return (unsigned long long)(((unsigned __int128)a * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return __umulh(a, b);
+#else
+        unsigned long long aLo = a & 0xFFFFFFFFULL, aHi = a >> 32, bLo = b & 0xFFFFFFFFULL, bHi = b >> 32;
+        unsigned long long lo = aLo * bLo, mid1 = aHi * bLo, mid2 = aLo * bHi;
+        unsigned long long carry = ((lo >> 32) + (mid1 & 0xFFFFFFFFULL) + (mid2 & 0xFFFFFFFFULL)) >> 32;
+        return aHi * bHi + (mid1 >> 32) + (mid2 >> 32) + carry;
+#endif
+    }
+
+    unsigned long long divisor_;
+    unsigned long long magic_;
+    int shift_;
+};
+
+//Whether a vector of temporal type from can be cast to type to (Vector::castTemporal rules).
+EXPORT_DECL bool canConvertTemporal(DATA_TYPE from, DATA_TYPE to);
+
+/**
+ * Convert n values of temporal type from at src to type to at dst; nulls stay null. Finer to
+ * coarser units round towards negative infinity, so values before 1970 land in the right day,
+ * hour or month. src and dst may be the same buffer when both types have the same width
+ * (e.g. TIMESTAMP to NANOTIMESTAMP or DATETIME to DATE), which converts in place.
+ */
+EXPORT_DECL void convertTemporal(DATA_TYPE from, const void* src, DATA_TYPE to, void* dst, INDEX n);
+
+//Month index (year * 12 + month - 1) of a day count since 1970.01.01, without branches.
+inline int civilMonth(int days) {
+    //Days since 0000.03.01, split into 400-year eras of 146097 days (H. Hinnant's civil_from_days).
+    int z = days + 719468;
+    int era = (z - (z < 0) * 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    //mp counts months from March; January and February belong to the next civil year.
+    int afterFebruary = mp >= 10;
+    return (yoe + era * 400 + afterFebruary) * 12 + mp + 2 - afterFebruary * 12;
+}
+
+/**
+ * Shift epoch times (seconds, or unitsPerSecond units per second) to local wall-clock time in
+ * place, skipping nulls. The UTC offset is looked up with localtime once per hour of input and
+ * reused while the values stay within that hour.
+ */
+EXPORT_DECL void toLocalTime(int* epochTimes, INDEX n);
+EXPORT_DECL void toLocalTime(long long* epochTimes, INDEX n, long long unitsPerSecond);
+
+}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Exports.h"
+#include "Types.h"
+#include "SmartPointer.h"
+#include "Dictionary.h"
+#include "Table.h"
+
+namespace dolphindb {
+
+class MappedFile;
+
+struct TextReaderOptions {
+    //Field separator. Fields may be enclosed in double quotes, with "" standing for one quote.
+    char delimiter = ',';
+    //Skip the first line of the file.
+    bool header = true;
+    //Threads parsing one batch; 0 means one per core.
+    int workerCount = 0;
+    //Bytes of input parsed per call of next(); read() ignores it.
+    long long batchBytes = 64LL << 20;
+};
+
+/**
+ * Parse a delimited text file straight into the typed columns of a table. The file is memory
+ * mapped and every batch is cut at line breaks into one piece per worker. Workers count the rows
+ * of their piece, the columns are allocated once for the whole batch, and then each worker
+ * parses its piece directly into its own rows of those columns, so numeric and temporal values
+ * never go through Constant objects or Util::parseConstant.
+ *
+ * Columns are matched to the schema by position: extra fields on a line are ignored and missing
+ * or unparseable fields become null. Blank lines are skipped. Dates may be written as
+ * 2024.01.31, 2024-01-31, 2024/01/31 or 20240131, and times of day as 09:30, 09:30m, 09:30:00
+ * or 09:30:00.123456789; a temporal field combines both, separated by a space or 'T'. Quoted fields
+ * may contain delimiters but not line breaks, since the file is split at every '\n'.
+ *
+ * STRING and BLOB columns are returned in arena layout. SYMBOL columns are encoded against
+ * per-thread dictionaries first, so each distinct value reaches the SymbolBase once per piece.
+ * UUID, IPADDR, INT128 and DECIMAL columns are parsed by the vectors' appendString.
+ */
+class EXPORT_DECL TextTableReader {
+public:
+    TextTableReader(const std::string& path, const std::vector<std::string>& colNames, const std::vector<DATA_TYPE>& colTypes,
+                    const TextReaderOptions& options = TextReaderOptions(), const std::vector<int>& extraParams = {});
+    //Take the columns from colDefs of schema() on the target table, including the DECIMAL scales in extra.
+    TextTableReader(const std::string& path, const DictionarySP& schema, const TextReaderOptions& options = TextReaderOptions());
+    ~TextTableReader();
+
+    //Parse the rest of the file into one table.
+    TableSP read();
+    //Parse the next batch of about options.batchBytes of input, or return a null TableSP at the end of the file.
+    TableSP next();
+    bool hasNext() const;
+
+    const std::vector<std::string>& getColumnNames() const { return colNames_; }
+    const std::vector<DATA_TYPE>& getColumnTypes() const { return colTypes_; }
+
+private:
+    void init(const std::string& path);
+    TableSP parse(size_t end);
+
+    std::vector<std::string> colNames_;
+    std::vector<DATA_TYPE> colTypes_;
+    std::vector<int> extraParams_;
+    TextReaderOptions options_;
+    std::shared_ptr<MappedFile> file_;
+    size_t offset_;
+};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Exports.h"
+#include "Types.h"
+#include "SmartPointer.h"
+#include "Table.h"
+
+namespace dolphindb {
+
+class BlockReader;
+
+struct TextWriterOptions {
+    //Field separator.
+    char delimiter = ',';
+    //Write the column names before the first table.
+    bool header = true;
+    //Threads formatting one table; 0 means one per core.
+    int workerCount = 1;
+    //Rows a thread formats at a time when workerCount isn't 1.
+    int chunkRows = 65536;
+};
+
+/**
+ * Stream tables to a file descriptor as delimited text that TextTableReader reads back. Cells
+ * read exactly like Constant::getString (2024.01.31T09:30:00.123, 1.5, nulls as empty fields),
+ * but no std::string is created per cell: each column is formatted a block of rows at a time from
+ * its typed buffer, with the char* overloads of TemporalFormat and NumberFormat, into buffers
+ * reused for the whole stream. Fields containing the delimiter, a quote or a line break are
+ * quoted, with quotes doubled.
+ *
+ * With several workers a table is cut into chunks of chunkRows rows, the chunks are formatted in
+ * parallel and written in order.
+ *
+ * Output is buffered: call flush() to write it out and to see write errors, which the destructor
+ * can only swallow.
+ */
+class EXPORT_DECL TextTableWriter {
+public:
+    //Write to an open file descriptor, which the writer doesn't close.
+    explicit TextTableWriter(int fd, const TextWriterOptions& options = TextWriterOptions());
+    //Create or truncate the file at path.
+    explicit TextTableWriter(const std::string& path, const TextWriterOptions& options = TextWriterOptions());
+    ~TextTableWriter();
+
+    void write(const TableSP& table);
+    //Write every block of a query run with fetchSize.
+    void write(BlockReader& reader);
+    void flush();
+    long long getRowsWritten() const { return rowsWritten_; }
+
+private:
+    void init();
+    void writeHeader(const TableSP& table);
+    void writeOut(const char* data, size_t length);
+
+    int fd_;
+    bool ownsFd_;
+    TextWriterOptions options_;
+    int columns_;
+    long long rowsWritten_;
+    //Formatted text not written yet, and the chunk buffers of the other workers.
+    std::vector<char> pending_;
+    size_t pendingSize_;
+    std::vector<std::vector<char>> chunks_;
+    std::vector<size_t> chunkSizes_;
+};
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "Exports.h"
+
+namespace dolphindb {
+
+/**
+ * Low-overhead span tracing.
+ *
+ * Every call site registers a static id once (DDB_TRACE/DDB_TRACE_SITE). A span records its
+ * start/end timestamp (TSC where available), its own id and the id of the enclosing span
+ * into a ring buffer owned by the current thread, so recording never takes a lock. When
+ * tracing is disabled a span costs one relaxed atomic load. Tick rates are calibrated once,
+ * by the first export or summary, which takes 10ms.
+ */
+class EXPORT_DECL Tracer {
+public:
+    struct Event {
+        int siteId;
+        unsigned long threadId;
+        unsigned long long spanId;
+        unsigned long long parentId;
+        unsigned long long startTick;
+        unsigned long long endTick;
+    };
+
+    static void enable(bool enabled = true) { enabled_.store(enabled, std::memory_order_relaxed); }
+    static void disable() { enable(false); }
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+    //Number of events kept per thread, rounded up to a power of two. Only affects threads traced afterwards.
+    static void setBufferCapacity(size_t capacity);
+    //Number of thread buffers held. A thread's buffer is reused by the next thread traced after it exits.
+    static size_t bufferCount();
+
+    //Return a process-wide id for the call site. Registering the same name twice returns the same id.
+    static int registerSite(const char *name);
+    static std::string getSiteName(int siteId);
+
+    static unsigned long long now();
+    static double ticksPerNanosecond();
+
+    //Copy the events currently held by all thread buffers.
+    static void collect(std::vector<Event> &events);
+    //Export all recorded spans in Chrome trace event format (chrome://tracing, Perfetto).
+    static std::string exportChromeTrace();
+    static bool writeChromeTrace(const std::string &path);
+    //Per call site count, total and latency percentiles in microseconds.
+    static std::string summary();
+    static void clear();
+
+private:
+    friend class TraceSpan;
+    static void record(int siteId, unsigned long long spanId, unsigned long long parentId, unsigned long long startTick, unsigned long long endTick);
+    static unsigned long long nextSpanId();
+
+    static std::atomic<bool> enabled_;
+};
+
+class EXPORT_DECL TraceSpan {
+public:
+    explicit TraceSpan(int siteId) : siteId_(siteId), spanId_(0) {
+        if (Tracer::isEnabled())
+            begin();
+    }
+    ~TraceSpan() {
+        end();
+    }
+    //Close the span before the end of the scope. Calling it again has no effect.
+    void end() {
+        if (spanId_ != 0)
+            finish();
+    }
+    unsigned long long getSpanId() const { return spanId_; }
+
+private:
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan& operator=(const TraceSpan &) = delete;
+    void begin();
+    void finish();
+
+    int siteId_;
+    unsigned long long spanId_;
+    unsigned long long parentId_;
+    unsigned long long startTick_;
+};
+
+}
+
+#define DDB_TRACE_CONCAT_IMPL(a, b) a##b
+#define DDB_TRACE_CONCAT(a, b) DDB_TRACE_CONCAT_IMPL(a, b)
+//Evaluates to the static id of the call site, registering it on first use.
+#define DDB_TRACE_SITE(name) ([]() -> int { static const int site = ::dolphindb::Tracer::registerSite(name); return site; }())
+//Trace the rest of the enclosing scope.
+#define DDB_TRACE(name) ::dolphindb::TraceSpan DDB_TRACE_CONCAT(ddbTraceSpan_, __LINE__)(DDB_TRACE_SITE(name))
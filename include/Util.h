@@ -15,6 +15,8 @@
 #include <cassert>
 #include <random>
 #include <chrono>
+#include <functional>
+#include <memory>
 #include "Exports.h"
 #include "WideInteger.h"
 #include "Constant.h"
@@ -102,6 +104,17 @@ public:
 	static Set* createSet(DATA_TYPE keyType, INDEX capacity);
 	static Dictionary* createDictionary(DATA_TYPE keyType, DATA_TYPE valueType);
 	static Vector* createVector(DATA_TYPE type, INDEX size, INDEX capacity = 0, bool fast = true, int extraParam = 0, void* data = 0, bool containNull = false);
+	/**
+	 * Vector of size values in data, a buffer the vector doesn't own: it is kept alive by owner, or
+	 * freed by deleter once the vector and all its read-only sub vectors are gone. The vector copies
+	 * the values into a buffer of its own before it grows. With readOnly, data is never written:
+	 * the vector is flagged read-only and its sub vectors share data. Only types stored as plain
+	 * fixed-width values are supported, i.e. not STRING, SYMBOL, BLOB, ANY, INT128, UUID or IPADDR.
+	 */
+	static Vector* createVector(DATA_TYPE type, INDEX size, void* data, const std::shared_ptr<void>& owner, bool readOnly = false, int extraParam = 0, bool containNull = false);
+	static Vector* createVector(DATA_TYPE type, INDEX size, void* data, const std::function<void(void*)>& deleter, bool readOnly = false, int extraParam = 0, bool containNull = false);
+	//Empty DT_STRING/DT_BLOB vector in arena mode: elements share one byte buffer instead of one std::string each.
+	static Vector* createArenaStringVector(DATA_TYPE type, INDEX capacity = 0);
 	static Vector* createArrayVector(VectorSP index, VectorSP value);
 	static Vector* createArrayVector(DATA_TYPE type, INDEX size, INDEX capacity = 0, bool fast = true, int extraParam = 0, void *data = NULL, INDEX *pindex = NULL, bool containNull = false);
 	static Vector* createMatrix(DATA_TYPE type, int cols, int rows, int colCapacity, int extraParam = 0, void* data = 0, bool containNull = false);
@@ -212,6 +225,15 @@ public:
 	static std::string getPartitionTypeString(PARTITION_TYPE type);
 	static Domain* createDomain(PARTITION_TYPE type, DATA_TYPE partitionColType, const ConstantSP& partitionSchema);
 	static Vector* createSubVector(const VectorSP& source, std::vector<int> indices);
+	/**
+	 * Rows [start, start + length) of source without a copy. A plain fixed-width or SYMBOL vector
+	 * gives a read-only vector over its buffer, which the source shares from then on so the slice
+	 * stays valid if the source grows; changes made in place show through. STRING, BLOB, INT128,
+	 * UUID and IPADDR vectors give a VectorView. Other vectors are copied.
+	 */
+	static Vector* createSliceView(const VectorSP& source, INDEX start, INDEX length);
+	//The rows of source at indices as a VectorView, or a copy for ANY vectors and array vectors.
+	static Vector* createGatherView(const VectorSP& source, const std::shared_ptr<const std::vector<int>>& indices);
 	static std::string getCategoryString(DATA_CATEGORY type);
 	static Vector* createSymbolVector(const SymbolBaseSP& symbolBase, INDEX size, INDEX capacity = 0, bool fast = true,
 		void* data = 0, void** dataSegment = 0, int segmentSizeInBit = 0, bool containNull = false);
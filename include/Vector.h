@@ -5,6 +5,16 @@
 
 namespace dolphindb {
 
+//Summary of a numeric or temporal vector in one pass, see Vector::stats().
+struct VectorStats {
+    INDEX count;        //non-null values
+    INDEX nullCount;
+    ConstantSP min;     //scalars of the vector's type, null when count is 0
+    ConstantSP max;
+    double sum;         //sum of the non-null values, 0 when count is 0
+    double avg;         //DBL_NMIN when count is 0
+};
+
 class EXPORT_DECL Vector:public Constant{
 public:
     Vector(): Constant(259){}
@@ -40,6 +50,7 @@ public:
     virtual std::string getString(INDEX index) const = 0;
     virtual VECTOR_TYPE getVectorType() const{return VECTOR_TYPE::ARRAY;}
     virtual bool isSorted(bool asc, bool strict = false) const {throw RuntimeException("Vector::isSorted method not supported"); return false;}
+    virtual VectorStats stats() const {throw RuntimeException("Vector::stats method not supported");}
     virtual ConstantSP getInstance() const {return getInstance(size());}
     virtual ConstantSP getInstance(INDEX size) const = 0;
     virtual ConstantSP getValue(INDEX capacity) const {throw RuntimeException("Vector::getValue method not supported");}
@@ -65,6 +76,8 @@ public:
     virtual long long getAllocatedMemory(INDEX sz) const {return Constant::getAllocatedMemory();}
     virtual int asof(const ConstantSP& value) const {throw RuntimeException("asof not supported.");}
     virtual ConstantSP castTemporal(DATA_TYPE expectType){throw RuntimeException("castTemporal not supported");}
+    //Like castTemporal, but temporal vectors may convert in place when the element width is unchanged; the result then takes over the buffer and this vector is left empty.
+    virtual ConstantSP castTemporalInPlace(DATA_TYPE expectType){return castTemporal(expectType);}
 
 protected:
     using Constant::get;
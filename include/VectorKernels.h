@@ -0,0 +1,128 @@
+#pragma once
+
+#include <type_traits>
+#include "Exports.h"
+#include "Types.h"
+
+namespace dolphindb {
+
+/**
+ * Scan and reduction kernels over the raw storage of fast vectors. Nulls are the type's null
+ * sentinel (INT_MIN, LLONG_MIN, DBL_NMIN, ...), compared by value as everywhere else in the API.
+ *
+ * The int, long long, float and double overloads are implemented with AVX2 and pick the AVX2 or
+ * the portable code path at run time, depending on the CPU. The other element types (char,
+ * short, decimal128) use the portable templates in kernels::scalar.
+ */
+namespace kernels {
+
+//Integral values are summed exactly in 64 bits (wrapping like the scalar loop), the others in double.
+template<class T>
+struct SumType {
+    typedef typename std::conditional<std::is_integral<T>::value, long long, double>::type type;
+};
+
+template<class T>
+struct Reduction {
+    INDEX nullCount;
+    //Smallest and largest non-null value; both are the null value when there is none.
+    T min;
+    T max;
+    typename SumType<T>::type sum;
+};
+
+//Whether the running CPU and OS support the AVX2 kernels.
+EXPORT_DECL bool hasAvx2();
+
+namespace scalar {
+
+template<class T>
+INDEX findNull(const T* data, INDEX n, T nullVal) {
+    INDEX i = 0;
+    for (; i < n && data[i] != nullVal; ++i);
+    return i;
+}
+
+template<class T>
+INDEX countNull(const T* data, INDEX n, T nullVal) {
+    INDEX count = 0;
+    for (INDEX i = 0; i < n; ++i)
+        count += data[i] == nullVal;
+    return count;
+}
+
+template<class T>
+void reduce(const T* data, INDEX n, T nullVal, Reduction<T>& result) {
+    typedef typename SumType<T>::type S;
+    INDEX nulls = 0;
+    S sum = S();
+    T min = nullVal, max = nullVal;
+    bool found = false;
+    for (INDEX i = 0; i < n; ++i) {
+        const T& x = data[i];
+        if (x == nullVal) {
+            ++nulls;
+            continue;
+        }
+        if (!found) {
+            min = max = x;
+            found = true;
+        } else {
+            if (x < min) min = x;
+            if (max < x) max = x;
+        }
+        sum += static_cast<S>(x);
+    }
+    result.nullCount = nulls;
+    result.min = min;
+    result.max = max;
+    result.sum = sum;
+}
+
+template<class T>
+bool isSorted(const T* data, INDEX n, bool asc, bool strict) {
+    for (INDEX i = 1; i < n; ++i) {
+        const T& prev = data[i - 1];
+        const T& cur = data[i];
+        if (asc ? (strict ? cur <= prev : cur < prev) : (strict ? cur >= prev : cur > prev))
+            return false;
+    }
+    return true;
+}
+
+}
+
+//Index of the first null in data[0, n), or n if there is none.
+template<class T>
+inline INDEX findNull(const T* data, INDEX n, T nullVal) { return scalar::findNull(data, n, nullVal); }
+template<class T>
+inline INDEX countNull(const T* data, INDEX n, T nullVal) { return scalar::countNull(data, n, nullVal); }
+template<class T>
+inline void reduce(const T* data, INDEX n, T nullVal, Reduction<T>& result) { scalar::reduce(data, n, nullVal, result); }
+//Whether data[0, n) is ordered; strict rejects equal neighbours. Nulls compare as ordinary values.
+template<class T>
+inline bool isSorted(const T* data, INDEX n, bool asc, bool strict) { return scalar::isSorted(data, n, asc, strict); }
+
+EXPORT_DECL INDEX findNull(const int* data, INDEX n, int nullVal);
+EXPORT_DECL INDEX findNull(const long long* data, INDEX n, long long nullVal);
+EXPORT_DECL INDEX findNull(const float* data, INDEX n, float nullVal);
+EXPORT_DECL INDEX findNull(const double* data, INDEX n, double nullVal);
+
+EXPORT_DECL INDEX countNull(const int* data, INDEX n, int nullVal);
+EXPORT_DECL INDEX countNull(const long long* data, INDEX n, long long nullVal);
+EXPORT_DECL INDEX countNull(const float* data, INDEX n, float nullVal);
+EXPORT_DECL INDEX countNull(const double* data, INDEX n, double nullVal);
+
+EXPORT_DECL void reduce(const int* data, INDEX n, int nullVal, Reduction<int>& result);
+EXPORT_DECL void reduce(const long long* data, INDEX n, long long nullVal, Reduction<long long>& result);
+EXPORT_DECL void reduce(const float* data, INDEX n, float nullVal, Reduction<float>& result);
+EXPORT_DECL void reduce(const double* data, INDEX n, double nullVal, Reduction<double>& result);
+
+EXPORT_DECL bool isSorted(const int* data, INDEX n, bool asc, bool strict);
+EXPORT_DECL bool isSorted(const long long* data, INDEX n, bool asc, bool strict);
+EXPORT_DECL bool isSorted(const float* data, INDEX n, bool asc, bool strict);
+EXPORT_DECL bool isSorted(const double* data, INDEX n, bool asc, bool strict);
+
+}
+
+}
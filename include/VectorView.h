@@ -0,0 +1,139 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Exports.h"
+#include "SmartPointer.h"
+#include "Types.h"
+#include "Vector.h"
+
+namespace dolphindb {
+
+class StringVector;
+
+/**
+ * A read-only vector over rows of another vector, without a copy of their values: either the
+ * rows [offset, offset + size) or, with indices, the rows indices[offset], ..., indices[offset + size - 1].
+ * The indices may be shared by the views of all columns of a table. Create views through
+ * Util::createSliceView and Util::createGatherView, which return plain vectors where no view is
+ * needed or possible.
+ *
+ * Views serialize straight from the source, so marshalling one costs no intermediate vector.
+ * Reads go through the source row by row, with raw fixed-width values gathered in bulk. Any
+ * operation that needs a regular vector works on getValue(), a copy.
+ */
+class EXPORT_DECL VectorView : public Vector {
+public:
+    //The source must be a regular vector of any type but ANY.
+    VectorView(const VectorSP& source, INDEX offset, INDEX size);
+    VectorView(const VectorSP& source, const std::shared_ptr<const std::vector<int>>& indices, INDEX offset, INDEX size);
+    virtual ~VectorView(){}
+
+    const VectorSP& getSource() const { return source_; }
+    //The row of the source at index.
+    INDEX sourceIndex(INDEX index) const { return indices_ ? (*indices_)[offset_ + index] : offset_ + index; }
+    //A view of count rows of this view from start, over the same source.
+    VectorView* getView(INDEX start, INDEX count) const;
+    //A view of the given rows of this view, over the same source.
+    VectorView* getView(const std::vector<int>& rows) const;
+
+    virtual DATA_TYPE getType() const { return source_->getType(); }
+    virtual DATA_TYPE getRawType() const { return source_->getRawType(); }
+    virtual DATA_CATEGORY getCategory() const { return source_->getCategory(); }
+    virtual int getExtraParamForType() const { return source_->getExtraParamForType(); }
+    virtual SymbolBaseSP getSymbolBase() const { return source_->getSymbolBase(); }
+    virtual INDEX size() const { return size_; }
+    virtual INDEX getCapacity() const { return size_; }
+    virtual short getUnitLength() const { return source_->getUnitLength(); }
+    virtual bool isFastMode() const { return false; }
+    virtual void* getDataArray() const { return NULL; }
+    virtual long long getAllocatedMemory() const;
+    virtual bool getNullFlag() const { return source_->getNullFlag(); }
+    virtual void setNullFlag(bool containNull) {}
+    virtual bool hasNull() { return hasNull(0, size_); }
+    virtual bool hasNull(INDEX start, INDEX length);
+
+    virtual ConstantSP getInstance() const { return getInstance(size_); }
+    virtual ConstantSP getInstance(INDEX size) const { return source_->getInstance(size); }
+    virtual ConstantSP getValue() const { return getValue(size_); }
+    virtual ConstantSP getValue(INDEX capacity) const;
+    virtual ConstantSP get(INDEX index) const { return source_->get(sourceIndex(index)); }
+    virtual ConstantSP get(const ConstantSP& index) const { return getValue()->get(index); }
+    virtual ConstantSP getSubVector(INDEX start, INDEX length) const;
+    virtual ConstantSP getSubVector(INDEX start, INDEX length, INDEX capacity) const { return getSubVector(start, length); }
+    virtual ConstantSP castTemporal(DATA_TYPE expectType) { return VectorSP(getValue())->castTemporal(expectType); }
+
+    virtual char getBool(INDEX index) const { return source_->getBool(sourceIndex(index)); }
+    virtual char getChar(INDEX index) const { return source_->getChar(sourceIndex(index)); }
+    virtual short getShort(INDEX index) const { return source_->getShort(sourceIndex(index)); }
+    virtual int getInt(INDEX index) const { return source_->getInt(sourceIndex(index)); }
+    virtual long long getLong(INDEX index) const { return source_->getLong(sourceIndex(index)); }
+    virtual INDEX getIndex(INDEX index) const { return source_->getIndex(sourceIndex(index)); }
+    virtual float getFloat(INDEX index) const { return source_->getFloat(sourceIndex(index)); }
+    virtual double getDouble(INDEX index) const { return source_->getDouble(sourceIndex(index)); }
+    virtual std::string getString(INDEX index) const { return source_->getString(sourceIndex(index)); }
+    virtual const std::string& getStringRef(INDEX index) const { return source_->getStringRef(sourceIndex(index)); }
+    virtual bool isNull(INDEX index) const { return source_->isNull(sourceIndex(index)); }
+    virtual int32_t getDecimal32(INDEX index, int scale) const { return source_->getDecimal32(sourceIndex(index), scale); }
+    virtual int64_t getDecimal64(INDEX index, int scale) const { return source_->getDecimal64(sourceIndex(index), scale); }
+    virtual wide_integer::int128 getDecimal128(INDEX index, int scale) const { return source_->getDecimal128(sourceIndex(index), scale); }
+    virtual std::string getString() const { return Vector::getString(); }
+
+    virtual bool isNull(INDEX start, int len, char* buf) const;
+    virtual bool isValid(INDEX start, int len, char* buf) const;
+    virtual bool getBool(INDEX start, int len, char* buf) const;
+    virtual bool getChar(INDEX start, int len, char* buf) const;
+    virtual bool getShort(INDEX start, int len, short* buf) const;
+    virtual bool getInt(INDEX start, int len, int* buf) const;
+    virtual bool getLong(INDEX start, int len, long long* buf) const;
+    virtual bool getIndex(INDEX start, int len, INDEX* buf) const;
+    virtual bool getFloat(INDEX start, int len, float* buf) const;
+    virtual bool getDouble(INDEX start, int len, double* buf) const;
+    virtual bool getSymbol(INDEX start, int len, int* buf, SymbolBase* symBase, bool insertIfNotThere) const;
+    virtual bool getString(INDEX start, int len, std::string** buf) const;
+    virtual bool getString(INDEX start, int len, char** buf) const;
+    virtual bool getBinary(INDEX start, int len, int unitLength, unsigned char* buf) const;
+    virtual bool getDecimal32(INDEX start, int len, int scale, int32_t* buf) const;
+    virtual bool getDecimal64(INDEX start, int len, int scale, int64_t* buf) const;
+    virtual bool getDecimal128(INDEX start, int len, int scale, wide_integer::int128* buf) const;
+
+    virtual const char* getBoolConst(INDEX start, int len, char* buf) const;
+    virtual const char* getCharConst(INDEX start, int len, char* buf) const;
+    virtual const short* getShortConst(INDEX start, int len, short* buf) const;
+    virtual const int* getIntConst(INDEX start, int len, int* buf) const;
+    virtual const long long* getLongConst(INDEX start, int len, long long* buf) const;
+    virtual const INDEX* getIndexConst(INDEX start, int len, INDEX* buf) const;
+    virtual const float* getFloatConst(INDEX start, int len, float* buf) const;
+    virtual const double* getDoubleConst(INDEX start, int len, double* buf) const;
+    virtual const int* getSymbolConst(INDEX start, int len, int* buf, SymbolBase* symBase, bool insertIfNotThere) const;
+    virtual std::string** getStringConst(INDEX start, int len, std::string** buf) const;
+    virtual char** getStringConst(INDEX start, int len, char** buf) const;
+    virtual const unsigned char* getBinaryConst(INDEX start, int len, int unitLength, unsigned char* buf) const;
+
+    virtual int serialize(char* buf, int bufSize, INDEX indexStart, int offset, int cellCountToSerialize, int& numElement, int& partial) const;
+    virtual int serialize(char* buf, int bufSize, INDEX indexStart, int offset, int& numElement, int& partial) const {
+        return serialize(buf, bufSize, indexStart, offset, size_ - indexStart, numElement, partial);
+    }
+
+    virtual void clear() { throwReadOnly(); }
+    virtual void fill(INDEX start, INDEX length, const ConstantSP& value) { throwReadOnly(); }
+    virtual void next(INDEX steps) { throwReadOnly(); }
+    virtual void prev(INDEX steps) { throwReadOnly(); }
+    virtual void reverse() { throwReadOnly(); }
+    virtual void reverse(INDEX start, INDEX length) { throwReadOnly(); }
+    virtual void neg() { throwReadOnly(); }
+
+private:
+    void throwReadOnly() const;
+    template<class T>
+    bool gather(INDEX start, int len, T* buf, DATA_TYPE nativeType) const;
+
+    VectorSP source_;
+    std::shared_ptr<const std::vector<int>> indices_;
+    INDEX offset_;
+    INDEX size_;
+    //The source as a string vector, for serializing STRING and BLOB views; null otherwise.
+    const StringVector* strings_;
+};
+
+}
@@ -0,0 +1,658 @@
+#include "ArrowInterop.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ConstantImp.h"
+#include "Exceptions.h"
+#include "SymbolBase.h"
+#include "Util.h"
+#include "WideInteger.h"
+
+namespace dolphindb {
+
+namespace {
+
+typedef wide_integer::int128 int128;
+
+//Owns everything an exported ArrowArray points to.
+struct ExportedArray {
+    ExportedArray() : dictionary(nullptr) {}
+
+    char* allocate(size_t bytes) {
+        owned.emplace_back(new char[std::max<size_t>(bytes, 1)]);
+        return owned.back().get();
+    }
+
+    //Keeps the vector alive while its own buffer is exported.
+    ConstantSP source;
+    std::vector<std::unique_ptr<char[]>> owned;
+    std::vector<const void*> buffers;
+    std::vector<ArrowArray*> children;
+    ArrowArray* dictionary;
+};
+
+struct ExportedSchema {
+    ExportedSchema() : dictionary(nullptr) {}
+
+    std::string format;
+    std::string name;
+    std::vector<ArrowSchema*> children;
+    ArrowSchema* dictionary;
+};
+
+void releaseArray(ArrowArray* array) {
+    ExportedArray* data = (ExportedArray*)array->private_data;
+    for (ArrowArray* child : data->children) {
+        //A consumer may have moved a child out, which leaves its release NULL.
+        if (child->release != nullptr)
+            child->release(child);
+        delete child;
+    }
+    if (data->dictionary != nullptr) {
+        if (data->dictionary->release != nullptr)
+            data->dictionary->release(data->dictionary);
+        delete data->dictionary;
+    }
+    delete data;
+    array->release = nullptr;
+}
+
+void releaseSchema(ArrowSchema* schema) {
+    ExportedSchema* data = (ExportedSchema*)schema->private_data;
+    for (ArrowSchema* child : data->children) {
+        if (child->release != nullptr)
+            child->release(child);
+        delete child;
+    }
+    if (data->dictionary != nullptr) {
+        if (data->dictionary->release != nullptr)
+            data->dictionary->release(data->dictionary);
+        delete data->dictionary;
+    }
+    delete data;
+    schema->release = nullptr;
+}
+
+//Fill array from data, which it takes over; the buffers and children must be complete.
+void finishArray(ArrowArray* array, ExportedArray* data, INDEX length, INDEX nullCount) {
+    array->length = length;
+    array->null_count = nullCount;
+    array->offset = 0;
+    array->n_buffers = (int64_t)data->buffers.size();
+    array->n_children = (int64_t)data->children.size();
+    array->buffers = data->buffers.data();
+    array->children = data->children.empty() ? nullptr : data->children.data();
+    array->dictionary = data->dictionary;
+    array->release = releaseArray;
+    array->private_data = data;
+}
+
+void finishSchema(ArrowSchema* schema, ExportedSchema* data, int64_t flags) {
+    schema->format = data->format.c_str();
+    schema->name = data->name.c_str();
+    schema->metadata = nullptr;
+    schema->flags = flags;
+    schema->n_children = (int64_t)data->children.size();
+    schema->children = data->children.empty() ? nullptr : data->children.data();
+    schema->dictionary = data->dictionary;
+    schema->release = releaseSchema;
+    schema->private_data = data;
+}
+
+template<class T>
+const T* getConst(Vector* vec, INDEX start, int count, T* buf);
+template<>
+const char* getConst(Vector* vec, INDEX start, int count, char* buf) { return vec->getCharConst(start, count, buf); }
+template<>
+const short* getConst(Vector* vec, INDEX start, int count, short* buf) { return vec->getShortConst(start, count, buf); }
+template<>
+const int* getConst(Vector* vec, INDEX start, int count, int* buf) { return vec->getIntConst(start, count, buf); }
+template<>
+const long long* getConst(Vector* vec, INDEX start, int count, long long* buf) { return vec->getLongConst(start, count, buf); }
+template<>
+const float* getConst(Vector* vec, INDEX start, int count, float* buf) { return vec->getFloatConst(start, count, buf); }
+template<>
+const double* getConst(Vector* vec, INDEX start, int count, double* buf) { return vec->getDoubleConst(start, count, buf); }
+
+//The raw values of a fixed-width vector: its own buffer when contiguous, which the exported array
+//keeps alive through its source, otherwise a copy.
+template<class T>
+const T* rawValues(Vector* vec, ExportedArray* data) {
+    if (vec->isFastMode() && vec->getDataArray() != nullptr) {
+        return (const T*)vec->getDataArray();
+    }
+    INDEX n = vec->size();
+    T* values = (T*)data->allocate((size_t)n * sizeof(T));
+    for (INDEX start = 0; start < n; start += Util::BUF_SIZE) {
+        int count = (int)std::min((INDEX)Util::BUF_SIZE, n - start);
+        const T* block = getConst(vec, start, count, values + start);
+        if (block != values + start)
+            memcpy(values + start, block, count * sizeof(T));
+    }
+    return values;
+}
+
+//The decimal values of a DECIMAL vector, whose getXConst methods convert rather than return the raw values.
+template<class T>
+const T* rawDecimals(Vector* vec, ExportedArray* data) {
+    if (vec->isFastMode() && vec->getDataArray() != nullptr) {
+        return (const T*)vec->getDataArray();
+    }
+    INDEX n = vec->size();
+    T* values = (T*)data->allocate((size_t)n * sizeof(T));
+    for (INDEX start = 0; start < n; start += Util::BUF_SIZE) {
+        int count = (int)std::min((INDEX)Util::BUF_SIZE, n - start);
+        const unsigned char* block = vec->getBinaryConst(start, count, sizeof(T), (unsigned char*)(values + start));
+        if (block != (const unsigned char*)(values + start))
+            memcpy(values + start, block, count * sizeof(T));
+    }
+    return values;
+}
+
+//Append the validity bitmap, or NULL without nulls, and return the null count.
+INDEX exportValidity(Vector* vec, ExportedArray* data) {
+    INDEX n = vec->size();
+    if (!vec->hasNull()) {
+        data->buffers.push_back(nullptr);
+        return 0;
+    }
+    unsigned char* bits = (unsigned char*)data->allocate((size_t)(n + 7) / 8);
+    memset(bits, 0, (size_t)(n + 7) / 8);
+    char nulls[Util::BUF_SIZE];
+    INDEX nullCount = 0;
+    for (INDEX start = 0; start < n; start += Util::BUF_SIZE) {
+        int count = (int)std::min((INDEX)Util::BUF_SIZE, n - start);
+        vec->isNull(start, count, nulls);
+        for (int i = 0; i < count; ++i) {
+            INDEX row = start + i;
+            if (nulls[i])
+                ++nullCount;
+            else
+                bits[row >> 3] |= (unsigned char)(1 << (row & 7));
+        }
+    }
+    data->buffers.push_back(bits);
+    return nullCount;
+}
+
+//Values converted one by one into a new buffer of type To.
+template<class From, class To, class Convert>
+const To* convertValues(Vector* vec, ExportedArray* data, From nullValue, Convert convert) {
+    INDEX n = vec->size();
+    To* values = (To*)data->allocate((size_t)n * sizeof(To));
+    From buf[Util::BUF_SIZE];
+    for (INDEX start = 0; start < n; start += Util::BUF_SIZE) {
+        int count = (int)std::min((INDEX)Util::BUF_SIZE, n - start);
+        const From* block = getConst(vec, start, count, buf);
+        for (int i = 0; i < count; ++i)
+            values[start + i] = block[i] == nullValue ? To() : convert(block[i]);
+    }
+    return values;
+}
+
+template<class T>
+const int128* widenDecimals(Vector* vec, ExportedArray* data) {
+    const T* values = rawDecimals<T>(vec, data);
+    INDEX n = vec->size();
+    int128* wide = (int128*)data->allocate((size_t)n * sizeof(int128));
+    for (INDEX i = 0; i < n; ++i)
+        wide[i] = values[i] == std::numeric_limits<T>::min() ? int128(0) : int128(values[i]);
+    return wide;
+}
+
+//Offsets and bytes of utf8/binary data for count strings produced by view(i).
+template<class View>
+void exportStrings(INDEX n, View view, ExportedArray* data, std::string& format, bool binary) {
+    long long total = 0;
+    for (INDEX i = 0; i < n; ++i)
+        total += (long long)view(i).length;
+    bool large = total > INT_MAX;
+    format = binary ? (large ? "Z" : "z") : (large ? "U" : "u");
+    char* bytes = data->allocate((size_t)total);
+    char* offsets = data->allocate((size_t)(n + 1) * (large ? sizeof(long long) : sizeof(int)));
+    long long offset = 0;
+    for (INDEX i = 0; i <= n; ++i) {
+        if (large)
+            ((long long*)offsets)[i] = offset;
+        else
+            ((int*)offsets)[i] = (int)offset;
+        if (i == n)
+            break;
+        StringView str = view(i);
+        memcpy(bytes + offset, str.data, str.length);
+        offset += (long long)str.length;
+    }
+    data->buffers.push_back(offsets);
+    data->buffers.push_back(bytes);
+}
+
+void exportStringColumn(Vector* vec, ExportedArray* data, std::string& format, bool binary) {
+    StringVector* strings = dynamic_cast<StringVector*>(vec);
+    if (strings != nullptr) {
+        exportStrings(vec->size(), [strings](INDEX i) { return strings->getStringView(i); }, data, format, binary);
+        return;
+    }
+    std::vector<std::string> values(vec->size());
+    for (INDEX i = 0; i < vec->size(); ++i)
+        values[i] = vec->getString(i);
+    exportStrings(vec->size(), [&values](INDEX i) { return StringView{values[i].data(), values[i].size()}; }, data, format, binary);
+}
+
+void exportVector(const ConstantSP& col, const std::string& name, ArrowSchema* schema, ArrowArray* array) {
+    if (!col->isVector() || col->getType() >= ARRAY_TYPE_BASE)
+        throw RuntimeException("Only regular vectors can be exported to Arrow.");
+    Vector* vec = (Vector*)col.get();
+    DATA_TYPE type = vec->getType();
+    INDEX n = vec->size();
+    std::unique_ptr<ExportedArray> data(new ExportedArray());
+    std::unique_ptr<ExportedSchema> meta(new ExportedSchema());
+    data->source = col;
+    meta->name = name;
+    INDEX nullCount = exportValidity(vec, data.get());
+    const void* values = nullptr;
+    switch (type) {
+        case DT_BOOL: {
+            meta->format = "b";
+            unsigned char* bits = (unsigned char*)data->allocate((size_t)(n + 7) / 8);
+            memset(bits, 0, (size_t)(n + 7) / 8);
+            char buf[Util::BUF_SIZE];
+            for (INDEX start = 0; start < n; start += Util::BUF_SIZE) {
+                int count = (int)std::min((INDEX)Util::BUF_SIZE, n - start);
+                const char* block = vec->getBoolConst(start, count, buf);
+                for (int i = 0; i < count; ++i) {
+                    if (block[i] != CHAR_MIN && block[i] != 0)
+                        bits[(start + i) >> 3] |= (unsigned char)(1 << ((start + i) & 7));
+                }
+            }
+            values = bits;
+            break;
+        }
+        case DT_CHAR: meta->format = "c"; values = rawValues<char>(vec, data.get()); break;
+        case DT_SHORT: meta->format = "s"; values = rawValues<short>(vec, data.get()); break;
+        case DT_INT: meta->format = "i"; values = rawValues<int>(vec, data.get()); break;
+        case DT_LONG: meta->format = "l"; values = rawValues<long long>(vec, data.get()); break;
+        case DT_FLOAT: meta->format = "f"; values = rawValues<float>(vec, data.get()); break;
+        case DT_DOUBLE: meta->format = "g"; values = rawValues<double>(vec, data.get()); break;
+        case DT_DATE: meta->format = "tdD"; values = rawValues<int>(vec, data.get()); break;
+        case DT_TIME: meta->format = "ttm"; values = rawValues<int>(vec, data.get()); break;
+        case DT_SECOND: meta->format = "tts"; values = rawValues<int>(vec, data.get()); break;
+        case DT_NANOTIME: meta->format = "ttn"; values = rawValues<long long>(vec, data.get()); break;
+        case DT_TIMESTAMP: meta->format = "tsm:"; values = rawValues<long long>(vec, data.get()); break;
+        case DT_NANOTIMESTAMP: meta->format = "tsn:"; values = rawValues<long long>(vec, data.get()); break;
+        case DT_MONTH:
+            meta->format = "tdD";
+            values = convertValues<int, int>(vec, data.get(), INT_MIN, [](int month) {
+                int year = month / 12 - (month % 12 < 0);
+                return Util::countDays(year, month - year * 12 + 1, 1);
+            });
+            break;
+        case DT_MINUTE:
+            meta->format = "tts";
+            values = convertValues<int, int>(vec, data.get(), INT_MIN, [](int minute) { return minute * 60; });
+            break;
+        case DT_DATETIME:
+            meta->format = "tss:";
+            values = convertValues<int, long long>(vec, data.get(), INT_MIN, [](int seconds) { return (long long)seconds; });
+            break;
+        case DT_DATEHOUR:
+            meta->format = "tss:";
+            values = convertValues<int, long long>(vec, data.get(), INT_MIN, [](int hours) { return hours * 3600LL; });
+            break;
+        case DT_DECIMAL32:
+            meta->format = "d:9," + std::to_string(vec->getExtraParamForType());
+            values = widenDecimals<int>(vec, data.get());
+            break;
+        case DT_DECIMAL64:
+            meta->format = "d:18," + std::to_string(vec->getExtraParamForType());
+            values = widenDecimals<long long>(vec, data.get());
+            break;
+        case DT_DECIMAL128:
+            meta->format = "d:38," + std::to_string(vec->getExtraParamForType());
+            values = rawDecimals<int128>(vec, data.get());
+            break;
+        case DT_STRING:
+        case DT_BLOB:
+            exportStringColumn(vec, data.get(), meta->format, type == DT_BLOB);
+            break;
+        case DT_SYMBOL: {
+            SymbolBaseSP base = vec->getSymbolBase();
+            if (base.isNull() || !vec->isFastMode() || vec->getDataArray() == nullptr) {
+                exportStringColumn(vec, data.get(), meta->format, false);
+                break;
+            }
+            //The codes are the dictionary indices; code 0 is the empty string, i.e. null.
+            meta->format = "i";
+            values = rawValues<int>(vec, data.get());
+            std::unique_ptr<ExportedArray> dictData(new ExportedArray());
+            std::unique_ptr<ExportedSchema> dictMeta(new ExportedSchema());
+            dictData->buffers.push_back(nullptr);
+            INDEX symbols = (INDEX)base->size();
+            exportStrings(symbols, [&base](INDEX i) {
+                const std::string& symbol = base->getSymbol(i);
+                return StringView{symbol.data(), symbol.size()};
+            }, dictData.get(), dictMeta->format, false);
+            data->dictionary = new ArrowArray();
+            finishArray(data->dictionary, dictData.release(), symbols, 0);
+            meta->dictionary = new ArrowSchema();
+            finishSchema(meta->dictionary, dictMeta.release(), 0);
+            break;
+        }
+        default:
+            throw RuntimeException("Can't export a vector of type " + Util::getDataTypeString(type) + " to Arrow.");
+    }
+    if (values != nullptr)
+        data->buffers.push_back(values);
+    finishArray(array, data.release(), n, nullCount);
+    finishSchema(schema, meta.release(), ARROW_FLAG_NULLABLE);
+}
+
+//Releases a schema when the import is done with it.
+class SchemaGuard {
+public:
+    explicit SchemaGuard(ArrowSchema* schema) : schema_(schema) {}
+    ~SchemaGuard() {
+        if (schema_ != nullptr && schema_->release != nullptr)
+            schema_->release(schema_);
+    }
+
+private:
+    ArrowSchema* schema_;
+};
+
+struct ImportedColumn {
+    const ArrowSchema* schema;
+    const ArrowArray* array;
+    INDEX length;
+    INDEX nullCount;
+
+    bool isValid(INDEX i) const {
+        const unsigned char* bits = (const unsigned char*)array->buffers[0];
+        if (bits == nullptr)
+            return true;
+        INDEX bit = (INDEX)array->offset + i;
+        return (bits[bit >> 3] >> (bit & 7)) & 1;
+    }
+
+    template<class T>
+    const T* buffer(int index) const {
+        return (const T*)array->buffers[index] + array->offset;
+    }
+};
+
+//A vector of type over the Arrow values when they have no nulls, otherwise a copy with null values written in.
+template<class T>
+VectorSP importFixed(const ImportedColumn& col, DATA_TYPE type, int extra, T nullValue, const std::shared_ptr<void>& owner) {
+    const T* values = col.buffer<T>(1);
+    if (col.nullCount == 0)
+        return Util::createVector(type, col.length, (void*)values, owner, true, extra);
+    VectorSP vec = Util::createVector(type, col.length, col.length, true, extra);
+    T* data = (T*)vec->getDataArray();
+    memcpy(data, values, (size_t)col.length * sizeof(T));
+    for (INDEX i = 0; col.nullCount != 0 && i < col.length; ++i) {
+        if (!col.isValid(i))
+            data[i] = nullValue;
+    }
+    vec->setNullFlag(col.nullCount != 0);
+    return vec;
+}
+
+template<class From, class To, class Convert>
+VectorSP importConverted(const ImportedColumn& col, DATA_TYPE type, int extra, To nullValue, Convert convert) {
+    const From* values = col.buffer<From>(1);
+    VectorSP vec = Util::createVector(type, col.length, col.length, true, extra);
+    To* data = (To*)vec->getDataArray();
+    bool hasNull = false;
+    for (INDEX i = 0; i < col.length; ++i) {
+        data[i] = col.isValid(i) ? convert(values[i]) : nullValue;
+        hasNull |= data[i] == nullValue;
+    }
+    vec->setNullFlag(hasNull);
+    return vec;
+}
+
+template<class Offset>
+VectorSP importStrings(const ImportedColumn& col, DATA_TYPE type) {
+    const Offset* offsets = col.buffer<Offset>(1);
+    const char* bytes = (const char*)col.array->buffers[2];
+    VectorSP vec = Util::createArenaStringVector(type, col.length);
+    StringView buf[Util::BUF_SIZE];
+    for (INDEX start = 0; start < col.length; start += Util::BUF_SIZE) {
+        int count = (int)std::min((INDEX)Util::BUF_SIZE, col.length - start);
+        for (int i = 0; i < count; ++i) {
+            INDEX row = start + i;
+            if (col.isValid(row))
+                buf[i] = StringView{bytes + offsets[row], (size_t)(offsets[row + 1] - offsets[row])};
+            else
+                buf[i] = StringView{"", 0};
+        }
+        ((StringVector*)vec.get())->appendStringView(buf, count);
+    }
+    return vec;
+}
+
+//Values of a utf8 or binary array, nulls as empty strings.
+std::vector<std::string> readStrings(const ArrowSchema* schema, const ArrowArray* array);
+
+template<class Index>
+VectorSP importSymbols(const ImportedColumn& col, const std::vector<std::string>& dictionary) {
+    const Index* indices = col.buffer<Index>(1);
+    VectorSP vec = Util::createVector(DT_SYMBOL, col.length, col.length);
+    SymbolBaseSP base = vec->getSymbolBase();
+    std::vector<int> remap(dictionary.size());
+    for (size_t i = 0; i < dictionary.size(); ++i)
+        remap[i] = base->findAndInsert(dictionary[i]);
+    int* codes = (int*)vec->getDataArray();
+    for (INDEX i = 0; i < col.length; ++i) {
+        long long index = (long long)indices[i];
+        if (!col.isValid(i))
+            codes[i] = 0;
+        else if (index < 0 || index >= (long long)remap.size())
+            throw RuntimeException("Dictionary index " + std::to_string(index) + " is out of range.");
+        else
+            codes[i] = remap[(size_t)index];
+    }
+    vec->setNullFlag(col.nullCount != 0 || base->find("") >= 0);
+    return vec;
+}
+
+INDEX countNulls(const ArrowArray* array) {
+    if (array->buffers == nullptr || array->n_buffers == 0 || array->buffers[0] == nullptr)
+        return 0;
+    if (array->null_count >= 0)
+        return (INDEX)array->null_count;
+    const unsigned char* bits = (const unsigned char*)array->buffers[0];
+    INDEX nulls = 0;
+    for (int64_t i = 0; i < array->length; ++i) {
+        int64_t bit = array->offset + i;
+        nulls += ((bits[bit >> 3] >> (bit & 7)) & 1) == 0;
+    }
+    return nulls;
+}
+
+//Scale and bit width of a decimal format "d:precision,scale[,bitWidth]".
+void parseDecimal(const std::string& format, int& scale, int& bitWidth) {
+    size_t comma = format.find(',');
+    if (comma == std::string::npos)
+        throw RuntimeException("Invalid Arrow decimal format " + format);
+    scale = atoi(format.c_str() + comma + 1);
+    size_t second = format.find(',', comma + 1);
+    bitWidth = second == std::string::npos ? 128 : atoi(format.c_str() + second + 1);
+}
+
+VectorSP importVector(const ArrowSchema* schema, const ArrowArray* array, const std::shared_ptr<void>& owner) {
+    if (array->length > INT_MAX)
+        throw RuntimeException("Arrow arrays longer than " + std::to_string(INT_MAX) + " can't be imported.");
+    ImportedColumn col = {schema, array, (INDEX)array->length, countNulls(array)};
+    std::string format = schema->format;
+    if (schema->dictionary != nullptr) {
+        std::vector<std::string> dictionary = readStrings(schema->dictionary, array->dictionary);
+        switch (format[0]) {
+            case 'c': return importSymbols<char>(col, dictionary);
+            case 's': return importSymbols<short>(col, dictionary);
+            case 'i': return importSymbols<int>(col, dictionary);
+            case 'l': return importSymbols<long long>(col, dictionary);
+            default: throw RuntimeException("Unsupported Arrow dictionary index format " + format);
+        }
+    }
+    if (format == "b") {
+        const unsigned char* bits = (const unsigned char*)array->buffers[1];
+        VectorSP vec = Util::createVector(DT_BOOL, col.length, col.length);
+        char* data = (char*)vec->getDataArray();
+        for (INDEX i = 0; i < col.length; ++i) {
+            INDEX bit = (INDEX)array->offset + i;
+            data[i] = col.isValid(i) ? (char)((bits[bit >> 3] >> (bit & 7)) & 1) : CHAR_MIN;
+        }
+        vec->setNullFlag(col.nullCount != 0);
+        return vec;
+    }
+    if (format == "c")
+        return importFixed<char>(col, DT_CHAR, 0, CHAR_MIN, owner);
+    if (format == "s")
+        return importFixed<short>(col, DT_SHORT, 0, SHRT_MIN, owner);
+    if (format == "i")
+        return importFixed<int>(col, DT_INT, 0, INT_MIN, owner);
+    if (format == "l")
+        return importFixed<long long>(col, DT_LONG, 0, LLONG_MIN, owner);
+    if (format == "f")
+        return importFixed<float>(col, DT_FLOAT, 0, FLT_NMIN, owner);
+    if (format == "g")
+        return importFixed<double>(col, DT_DOUBLE, 0, DBL_NMIN, owner);
+    if (format == "tdD")
+        return importFixed<int>(col, DT_DATE, 0, INT_MIN, owner);
+    if (format == "tdm")
+        return importFixed<long long>(col, DT_TIMESTAMP, 0, LLONG_MIN, owner);
+    if (format == "ttm")
+        return importFixed<int>(col, DT_TIME, 0, INT_MIN, owner);
+    if (format == "tts")
+        return importFixed<int>(col, DT_SECOND, 0, INT_MIN, owner);
+    if (format == "ttn")
+        return importFixed<long long>(col, DT_NANOTIME, 0, LLONG_MIN, owner);
+    if (format == "ttu")
+        return importConverted<long long, long long>(col, DT_NANOTIME, 0, LLONG_MIN, [](long long us) { return us * 1000; });
+    if (format.compare(0, 4, "tsm:") == 0)
+        return importFixed<long long>(col, DT_TIMESTAMP, 0, LLONG_MIN, owner);
+    if (format.compare(0, 4, "tsn:") == 0)
+        return importFixed<long long>(col, DT_NANOTIMESTAMP, 0, LLONG_MIN, owner);
+    if (format.compare(0, 4, "tsu:") == 0)
+        return importConverted<long long, long long>(col, DT_NANOTIMESTAMP, 0, LLONG_MIN, [](long long us) { return us * 1000; });
+    if (format.compare(0, 4, "tss:") == 0) {
+        return importConverted<long long, int>(col, DT_DATETIME, 0, INT_MIN, [](long long seconds) {
+            return seconds > INT_MAX || seconds <= INT_MIN ? INT_MIN : (int)seconds;
+        });
+    }
+    if (format.compare(0, 2, "d:") == 0) {
+        int scale, bitWidth;
+        parseDecimal(format, scale, bitWidth);
+        if (bitWidth == 32)
+            return importFixed<int>(col, DT_DECIMAL32, scale, INT_MIN, owner);
+        if (bitWidth == 64)
+            return importFixed<long long>(col, DT_DECIMAL64, scale, LLONG_MIN, owner);
+        if (bitWidth == 128)
+            return importFixed<int128>(col, DT_DECIMAL128, scale, std::numeric_limits<int128>::min(), owner);
+        throw RuntimeException("Unsupported Arrow decimal format " + format);
+    }
+    if (format == "u" || format == "z")
+        return importStrings<int>(col, format == "u" ? DT_STRING : DT_BLOB);
+    if (format == "U" || format == "Z")
+        return importStrings<long long>(col, format == "U" ? DT_STRING : DT_BLOB);
+    throw RuntimeException("Unsupported Arrow format " + format);
+}
+
+std::vector<std::string> readStrings(const ArrowSchema* schema, const ArrowArray* array) {
+    std::string format = schema->format;
+    if (array == nullptr || (format != "u" && format != "U" && format != "z" && format != "Z"))
+        throw RuntimeException("Only string dictionaries can be imported from Arrow, not " + format);
+    VectorSP vec = importVector(schema, array, nullptr);
+    std::vector<std::string> values(vec->size());
+    for (INDEX i = 0; i < vec->size(); ++i)
+        values[i] = vec->getString(i);
+    return values;
+}
+
+}
+
+void exportToArrow(const TableSP& table, ArrowSchema* schema, ArrowArray* array) {
+    if (table.isNull())
+        throw RuntimeException("Can't export a null table to Arrow.");
+    std::unique_ptr<ExportedArray> data(new ExportedArray());
+    std::unique_ptr<ExportedSchema> meta(new ExportedSchema());
+    meta->format = "+s";
+    data->buffers.push_back(nullptr);
+    //Children are released with their parent, including those done before an exception.
+    struct Cleanup {
+        ExportedArray* data;
+        ExportedSchema* meta;
+        ~Cleanup() {
+            if (data != nullptr) {
+                ArrowArray array;
+                array.private_data = data;
+                releaseArray(&array);
+            }
+            if (meta != nullptr) {
+                ArrowSchema schema;
+                schema.private_data = meta;
+                releaseSchema(&schema);
+            }
+        }
+    } cleanup = {data.release(), meta.release()};
+    for (int c = 0; c < table->columns(); ++c) {
+        ArrowArray* childArray = new ArrowArray();
+        ArrowSchema* childSchema = new ArrowSchema();
+        childArray->release = nullptr;
+        childSchema->release = nullptr;
+        cleanup.data->children.push_back(childArray);
+        cleanup.meta->children.push_back(childSchema);
+        exportVector(table->getColumn(c), table->getColumnName(c), childSchema, childArray);
+    }
+    finishArray(array, cleanup.data, table->rows(), 0);
+    finishSchema(schema, cleanup.meta, 0);
+    cleanup.data = nullptr;
+    cleanup.meta = nullptr;
+}
+
+void exportToArrow(const VectorSP& vector, ArrowSchema* schema, ArrowArray* array) {
+    if (vector.isNull())
+        throw RuntimeException("Can't export a null vector to Arrow.");
+    exportVector(vector, "", schema, array);
+}
+
+ConstantSP importFromArrow(ArrowSchema* schema, ArrowArray* array) {
+    SchemaGuard guard(schema);
+    if (array->release == nullptr)
+        throw RuntimeException("The Arrow array has already been released.");
+    ArrowArray* moved = new ArrowArray(*array);
+    array->release = nullptr;
+    std::shared_ptr<ArrowArray> owner(moved, [](ArrowArray* a) {
+        if (a->release != nullptr)
+            a->release(a);
+        delete a;
+    });
+    if (std::string(schema->format) != "+s")
+        return importVector(schema, moved, owner);
+    if (schema->n_children != moved->n_children)
+        throw RuntimeException("The Arrow schema and array have different numbers of children.");
+    std::vector<std::string> names;
+    std::vector<ConstantSP> cols;
+    for (int64_t c = 0; c < schema->n_children; ++c) {
+        const ArrowSchema* childSchema = schema->children[c];
+        ArrowArray* childArray = moved->children[c];
+        if (childArray->length < moved->offset + moved->length)
+            throw RuntimeException("Column " + std::string(childSchema->name) + " of the Arrow struct array is too short.");
+        //The struct's own offset shifts every child.
+        ArrowArray sliced = *childArray;
+        sliced.offset += moved->offset;
+        sliced.length = moved->length;
+        if (sliced.offset != childArray->offset || sliced.length != childArray->length)
+            sliced.null_count = -1;
+        names.push_back(childSchema->name != nullptr && childSchema->name[0] != 0 ? childSchema->name : "col" + std::to_string(c));
+        cols.push_back(importVector(childSchema, &sliced, owner));
+    }
+    return Util::createTable(names, cols);
+}
+
+}
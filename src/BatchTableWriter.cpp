@@ -1,29 +1,81 @@
 #include "BatchTableWriter.h"
 #include "ScalarImp.h"
 #include "DolphinDB.h"
+#include "Metrics.h"
 namespace dolphindb{
 
-BatchTableWriter::BatchTableWriter(const std::string& hostName, int port, const std::string& userId, const std::string& password, bool acquireLock):
+namespace {
+
+std::string queueDepthLabels(const std::string& dbName, const std::string& tableName){
+    return MetricsRegistry::label("table", tableName.empty() ? dbName : dbName + "/" + tableName);
+}
+
+std::vector<VectorSP> createBufferColumns(const std::vector<DATA_TYPE>& colTypes, INDEX capacity){
+    std::vector<VectorSP> columns;
+    columns.reserve(colTypes.size());
+    for(DATA_TYPE type : colTypes)
+        columns.push_back(Util::createVector(type == DT_SYMBOL ? DT_STRING : type, 0, capacity));
+    return columns;
+}
+
+}
+
+BatchTableWriter::BatchTableWriter(const std::string& hostName, int port, const std::string& userId, const std::string& password, bool acquireLock,
+                                   int batchSize, long long batchBytes, int throttle, int workerCount):
     hostName_(hostName),
     port_(port),
     userId_(userId),
     password_(password),
-    acquireLock_(acquireLock)
-    {}
+    acquireLock_(acquireLock),
+    batchSize_(std::max(1, batchSize)),
+    batchBytes_(std::max(0LL, batchBytes)),
+    throttle_(std::max(0, throttle)),
+    workerCount_(std::max(0, workerCount)),
+    stopping_(false)
+{
+    for(int i = 0; i < workerCount_; ++i){
+        SmartPointer<DBConnection> conn = new DBConnection(false, false);
+        if(!conn->connect(hostName_, port_, userId_, password_))
+            throw RuntimeException("Failed to connect to server.");
+        workerConns_.push_back(conn);
+    }
+    for(int i = 0; i < workerCount_; ++i){
+        DBConnection* conn = workerConns_[i].get();
+        workers_.push_back(new Thread(new Executor([=](){
+            runWorker(conn);
+        })));
+        workers_.back()->start();
+    }
+}
 
 BatchTableWriter::~BatchTableWriter(){
     std::vector<SmartPointer<DestTable>> dt;
     for(auto& i: destTables_){
         if(i.second->destroy == false){
             dt.push_back(i.second);
+            LockGuard<Mutex> guard(&i.second->writeMutex);
             i.second->destroy = true;
             i.second->writeNotifier.notify();
         }
     }
+    for(auto& i: destTables_)
+        MetricsRegistry::instance().unregisterGauge("ddb_btw_queue_depth", queueDepthLabels(i.first.first, i.first.second));
     for(auto& i: dt){
-        i->writeThread->join();
-		i->conn->close();
+        if(!i->writeThread.isNull()){
+            i->writeThread->join();
+            i->conn->close();
+        }
+    }
+    if(workerCount_ > 0){
+        LockGuard<Mutex> guard(&scheduleMutex_);
+        //Workers flush what is left of the removed tables before they stop.
+        scheduleNotifier_.notifyAll();
+        stopping_ = true;
     }
+    for(auto& worker : workers_)
+        worker->join();
+    for(auto& conn : workerConns_)
+        conn->close();
 }
 
 void BatchTableWriter::addTable(const std::string& dbName, const std::string& tableName, bool partitioned){
@@ -73,7 +125,11 @@ void BatchTableWriter::addTable(const std::string& dbName, const std::string& ta
     }
     destTable->dbName = dbName;
     destTable->tableName = tableName;
-    destTable->conn = new DBConnection(std::move(conn));
+    if(workerCount_ == 0)
+        destTable->conn = new DBConnection(std::move(conn));
+    else
+        conn.close();
+    destTable->partitioned = partitioned;
     destTable->tableInsert = std::move(tableInsert);
     destTable->saveTable = std::move(saveTable);
     destTable->colDefs = colDefs;
@@ -90,6 +146,13 @@ void BatchTableWriter::addTable(const std::string& dbName, const std::string& ta
     }
     destTable->colNames = std::move(colNames);
     destTable->colTypes = std::move(colTypes);
+    INDEX capacity = std::max(batchSize_, 1024);
+    destTable->activeColumns = createBufferColumns(destTable->colTypes, capacity);
+    destTable->flushColumns = createBufferColumns(destTable->colTypes, capacity);
+    for(DATA_TYPE type : destTable->colTypes){
+        if(Util::getCategory(type) != LITERAL)
+            destTable->fixedRowBytes += std::max(0, Util::getDataTypeSize(type));
+    }
 
     if(tmpDiskGlobal.empty() == false){//update need temp table
         std::string colName;
@@ -103,90 +166,232 @@ void BatchTableWriter::addTable(const std::string& dbName, const std::string& ta
     }
 
     DestTable *destTableRawPtr = destTable.get();
-    destTable->writeThread = new Thread(new Executor([=](){
-        while(destTableRawPtr->destroy==false){
-            while(true){
-                if(writeTableAllData(destTable,partitioned)==false)
-                    break;
-            }
-			destTableRawPtr->writeMutex.lock();
-			destTableRawPtr->writeNotifier.wait(destTableRawPtr->writeMutex);
+    if(workerCount_ == 0){
+        destTable->writeThread = new Thread(new Executor([=](){
+            while(writeTableAllData(destTable,partitioned));
+        }));
+        destTable->writeThread->start();
+    }
+    else{
+        LockGuard<Mutex> guard(&scheduleMutex_);
+        pooledTables_.push_back(destTable);
+    }
+    MetricsRegistry::instance().registerGauge("ddb_btw_queue_depth", queueDepthLabels(dbName, tableName), [=](){
+        return (double)destTableRawPtr->pendingRows.load();
+    });
+}
+
+void BatchTableWriter::appendRow(DestTable* destTable, const std::vector<ConstantSP>& row){
+    long long bytes = destTable->fixedRowBytes;
+    for(std::size_t i = 0; i < row.size(); ++i){
+        if(row[i]->getCategory() == LITERAL)
+            bytes += row[i]->getStringRef().size() + 1;
+    }
+    bool wake;
+    {
+    LockGuard<Mutex> guard(&destTable->writeMutex);
+    for(std::size_t i = 0; i < row.size(); ++i){
+        if(!destTable->activeColumns[i]->append(row[i])){
+            //Roll back the columns already appended so that the buffer stays rectangular.
+            for(std::size_t j = 0; j < i; ++j)
+                destTable->activeColumns[j]->remove(1);
+            throw RuntimeException("Failed to insert data, the value at column " + std::to_string(i) + " can't be appended.");
         }
-        //write incomplete data
-        while(destTableRawPtr->writeQueue.size()>0&&writeTableAllData(destTable,partitioned));
-    }));
-    destTable->writeThread->start();
+    }
+    if(destTable->activeRows++ == 0)
+        destTable->activeSince = Util::getEpochTime();
+    destTable->activeBytes += bytes;
+    ++destTable->pendingRows;
+    //The write thread sleeps without a deadline while the buffer is empty, so wake it for the first row and for the size triggers.
+    wake = destTable->activeRows == 1 || destTable->activeRows >= batchSize_ || (batchBytes_ > 0 && destTable->activeBytes >= batchBytes_);
+    if(wake && workerCount_ == 0)
+        destTable->writeNotifier.notify();
+    }
+    if(wake && workerCount_ > 0){
+        //Workers lock scheduleMutex_ before writeMutex, so notify only after the table lock is released.
+        LockGuard<Mutex> guard(&scheduleMutex_);
+        scheduleNotifier_.notify();
+    }
+}
+
+bool BatchTableWriter::readyToFlush(const DestTable* destTable, long long now) const {
+    if(destTable->activeRows == 0)
+        return false;
+    return destTable->destroy || destTable->activeRows >= batchSize_ || (batchBytes_ > 0 && destTable->activeBytes >= batchBytes_) ||
+        now - destTable->activeSince >= throttle_;
 }
 
 bool BatchTableWriter::writeTableAllData(SmartPointer<DestTable> destTable,bool partitioned){
     DestTable *destTableRawPtr = destTable.get();
-    if(destTableRawPtr->finished)
-        return false;
-    bool ret;
-    auto size = destTableRawPtr->writeQueue.size();
-    if (size < 1)
-        return false;
-    std::vector<std::vector<ConstantSP>> items;
-    while (true)
+    int size;
     {
-        try
-        {
-            items.reserve(size);
-            break;
-        }
-        catch (...)
-        {
-            std::cerr << "Failed to reserve memory for std::vector." << std::endl;
-            Util::sleep(20);
+        LockGuard<Mutex> guard(&destTableRawPtr->writeMutex);
+        while(true){
+            if(destTableRawPtr->finished){
+                //Nothing is sent after a failure, the rows are kept for getUnwrittenData.
+                if(destTableRawPtr->destroy)
+                    return false;
+                destTableRawPtr->writeNotifier.wait(destTableRawPtr->writeMutex);
+                continue;
+            }
+            long long now = Util::getEpochTime();
+            if(readyToFlush(destTableRawPtr, now))
+                break;
+            if(destTableRawPtr->destroy)
+                return false;
+            if(destTableRawPtr->activeRows == 0)
+                destTableRawPtr->writeNotifier.wait(destTableRawPtr->writeMutex);
+            else
+                destTableRawPtr->writeNotifier.wait(destTableRawPtr->writeMutex, static_cast<int>(std::max(1LL, destTableRawPtr->activeSince + throttle_ - now)));
         }
+        size = takeBatch(destTableRawPtr);
     }
-    destTableRawPtr->writeQueue.pop(items, static_cast<int>(size));
+    std::vector<bool> succeeded;
+    sendBatches(*destTableRawPtr->conn, {destTableRawPtr}, {size}, succeeded);
+    LockGuard<Mutex> guard(&destTableRawPtr->writeMutex);
+    finishBatch(destTableRawPtr, size, succeeded[0]);
+    return true;
+}
 
-    size = items.size();
+int BatchTableWriter::takeBatch(DestTable* destTable){
+    std::swap(destTable->activeColumns, destTable->flushColumns);
+    int rows = destTable->activeRows;
+    destTable->activeRows = 0;
+    destTable->activeBytes = 0;
+    destTable->activeSince = -1;
+    return rows;
+}
 
-    bool writedataok = true;
-    {
-        destTableRawPtr->writeTable = Util::createTable(destTableRawPtr->colNames, destTableRawPtr->colTypes, 0, static_cast<int>(size));
-        INDEX insertedRows;
-        std::string errMsg;
-        for (std::size_t i = 0; i < size; i++)
-        {
-            ret = destTableRawPtr->writeTable->append(items[i], insertedRows, errMsg);
-            if (!ret)
-            {
-                std::cerr << Util::createTimestamp(Util::getEpochTime())->getString() << " Backgroud thread of table (" << destTableRawPtr->dbName << " " << destTableRawPtr->tableName << "). Failed to create table, with error: " << errMsg << std::endl;
-                writedataok = false;
-                break;
-            }
+void BatchTableWriter::finishBatch(DestTable* destTable, int rows, bool succeeded){
+    if(succeeded){
+        destTable->sendedRows += rows;
+        destTable->pendingRows -= rows;
+        for(auto& column : destTable->flushColumns)
+            column->clear();
+    }
+    else{
+        destTable->finished = true;
+        destTable->failedColumns = std::move(destTable->flushColumns);
+        destTable->flushColumns = createBufferColumns(destTable->colTypes, 0);
+    }
+}
+
+void BatchTableWriter::sendBatches(DBConnection& conn, const std::vector<DestTable*>& tables, const std::vector<int>& rows, std::vector<bool>& succeeded){
+    DDB_TRACE("BatchTableWriter::sendBatches");
+    std::size_t count = tables.size();
+    succeeded.assign(count, false);
+    std::vector<ConstantSP> args(count);
+    for(std::size_t i = 0; i < count; ++i){
+        DestTable* destTable = tables[i];
+        std::vector<ConstantSP> columns(destTable->flushColumns.begin(), destTable->flushColumns.end());
+        //BasicTable adopts temporary vectors instead of copying them.
+        for(auto& column : columns)
+            column->setTemporary(true);
+        destTable->symbolEncoder.encode(columns, destTable->colTypes);
+        args[i] = Util::createTable(destTable->colNames, columns);
+    }
+    auto logError = [](const DestTable* destTable, const std::string& error){
+        std::cerr << Util::createTimestamp(Util::getEpochTime())->getString() << " Backgroud thread of table (" << destTable->dbName << " " << destTable->tableName << "). Failed to send data to server, with exception: " << error << std::endl;
+    };
+    //Tables written through a temporary shared table need several scripts and are sent one by one.
+    std::vector<std::size_t> plain;
+    for(std::size_t i = 0; i < count; ++i){
+        DestTable* destTable = tables[i];
+        if(destTable->createTmpSharedTable.empty() && destTable->partitioned && count > 1){
+            plain.push_back(i);
+            continue;
+        }
+        try{
+            if (destTable->createTmpSharedTable.empty() == false)
+                conn.run(destTable->createTmpSharedTable);
+            std::vector<ConstantSP> one{args[i]};
+            conn.run(destTable->tableInsert, one);
+            if (!destTable->partitioned)
+                conn.run(destTable->saveTable);
+            succeeded[i] = true;
+        }
+        catch (std::exception &e){
+            logError(destTable, e.what());
         }
     }
-    if (writedataok)
-    {
-        try
-        {
-            std::vector<ConstantSP> args;
-            args.reserve(1);
-            if (destTableRawPtr->createTmpSharedTable.empty() == false)
-                destTableRawPtr->conn->run(destTableRawPtr->createTmpSharedTable);
-            args.push_back(destTableRawPtr->writeTable);
-            destTableRawPtr->conn->run(destTableRawPtr->tableInsert, args);
-            if (!partitioned)
-                destTableRawPtr->conn->run(destTableRawPtr->saveTable);
-            destTableRawPtr->sendedRows += static_cast<int>(size);
+    if(plain.empty())
+        return;
+    //One anonymous function inserts every table and reports the error of each insert separately.
+    std::string params, body;
+    std::vector<ConstantSP> plainArgs;
+    for(std::size_t k = 0; k < plain.size(); ++k){
+        std::string arg = "t" + std::to_string(k);
+        params += (k == 0 ? "" : ",") + arg;
+        body += "try{" + tables[plain[k]]->tableInsert + "(" + arg + ")}catch(ex){errs[" + std::to_string(k) + "]=ex};";
+        plainArgs.push_back(args[plain[k]]);
+    }
+    std::string function = "def(" + params + "){errs=array(ANY," + std::to_string(plain.size()) + ");" + body + "return errs}";
+    try{
+        ConstantSP errors = conn.run(function, plainArgs);
+        for(std::size_t k = 0; k < plain.size(); ++k){
+            ConstantSP error = errors->get(static_cast<INDEX>(k));
+            succeeded[plain[k]] = error->isNull();
+            if(!succeeded[plain[k]])
+                logError(tables[plain[k]], error->getString());
         }
-        catch (std::exception &e)
+    }
+    catch (std::exception &e){
+        for(std::size_t index : plain)
+            logError(tables[index], e.what());
+    }
+}
+
+void BatchTableWriter::runWorker(DBConnection* conn){
+    std::vector<SmartPointer<DestTable>> tables;
+    std::vector<DestTable*> batch;
+    std::vector<int> rows;
+    std::vector<bool> succeeded;
+    while(true){
         {
-            writedataok = false;
-            std::cerr << Util::createTimestamp(Util::getEpochTime())->getString() << " Backgroud thread of table (" << destTableRawPtr->dbName << " " << destTableRawPtr->tableName << "). Failed to send data to server, with exception: " << e.what() << std::endl;
+            LockGuard<Mutex> guard(&scheduleMutex_);
+            while(true){
+                long long now = Util::getEpochTime();
+                long long wait = -1;
+                for(auto& destTable : pooledTables_){
+                    if(batch.size() >= (std::size_t)MAX_TABLES_PER_REQUEST)
+                        break;
+                    LockGuard<Mutex> tableGuard(&destTable->writeMutex);
+                    if(destTable->flushing || destTable->finished)
+                        continue;
+                    if(readyToFlush(destTable.get(), now)){
+                        destTable->flushing = true;
+                        tables.push_back(destTable);
+                        batch.push_back(destTable.get());
+                        rows.push_back(takeBatch(destTable.get()));
+                    }
+                    else if(destTable->activeRows > 0){
+                        long long left = std::max(1LL, destTable->activeSince + throttle_ - now);
+                        wait = wait < 0 ? left : std::min(wait, left);
+                    }
+                }
+                if(!batch.empty())
+                    break;
+                if(stopping_)
+                    return;
+                if(wait < 0)
+                    scheduleNotifier_.wait(scheduleMutex_);
+                else
+                    scheduleNotifier_.wait(scheduleMutex_, static_cast<int>(wait));
+            }
         }
+        sendBatches(*conn, batch, rows, succeeded);
+        for(std::size_t i = 0; i < batch.size(); ++i){
+            LockGuard<Mutex> tableGuard(&batch[i]->writeMutex);
+            finishBatch(batch[i], rows[i], succeeded[i]);
+            batch[i]->flushing = false;
+        }
+        tables.clear();
+        batch.clear();
+        rows.clear();
+        //Rows may have piled up while the batch was sent, and removeTable waits for the flushing flag.
+        LockGuard<Mutex> guard(&scheduleMutex_);
+        scheduleNotifier_.notifyAll();
     }
-    if (writedataok == false)
-    {
-        destTableRawPtr->finished = true;
-        for (std::size_t i = 0; i < size; i++)
-            destTableRawPtr->saveQueue.push(items[i]);
-    }
-    return writedataok;
 }
 
 std::tuple<int,bool,bool> BatchTableWriter::getStatus(const std::string& dbName, const std::string& tableName){
@@ -194,7 +399,7 @@ std::tuple<int,bool,bool> BatchTableWriter::getStatus(const std::string& dbName,
     if(destTables_.find(std::make_pair(dbName, tableName)) == destTables_.end())
         throw RuntimeException("Failed to get queue depth. Please use addTable to add infomation of database and table first.");
     SmartPointer<DestTable> destTable = destTables_[std::make_pair(dbName, tableName)];
-    return std::make_tuple(static_cast<int>(destTable->writeQueue.size()), destTable->destroy, destTable->finished);
+    return std::make_tuple(destTable->pendingRows.load(), destTable->destroy, destTable->finished);
 }
 
 TableSP BatchTableWriter::getAllStatus(){
@@ -214,7 +419,7 @@ TableSP BatchTableWriter::getAllStatus(){
     for(auto &destTable: destTables_){
         columnVecs[0]->set(i, Util::createString(destTable.second->dbName));
         columnVecs[1]->set(i, Util::createString(destTable.second->tableName));
-        columnVecs[2]->set(i, Util::createInt(static_cast<int>(destTable.second->writeQueue.size())));
+        columnVecs[2]->set(i, Util::createInt(destTable.second->pendingRows.load()));
         columnVecs[3]->set(i, Util::createInt(destTable.second->sendedRows));
         columnVecs[4]->set(i, Util::createBool(destTable.second->destroy));
         columnVecs[5]->set(i, Util::createBool(destTable.second->finished));
@@ -229,26 +434,26 @@ TableSP BatchTableWriter::getUnwrittenData(const std::string& dbName, const std:
         throw RuntimeException("Failed to get unwritten data. Please use addTable to add infomation of database and table first.");
     SmartPointer<DestTable> destTable = destTables_[std::make_pair(dbName, tableName)];
 
-    int saveQueueSize = static_cast<int>(destTable->saveQueue.size());
-    int writeQueueSize = static_cast<int>(destTable->writeQueue.size());
-    int size = saveQueueSize + writeQueueSize;
-    TableSP table = Util::createTable(destTable->colNames, destTable->colTypes, 0, size);
-
-    std::vector<std::vector<ConstantSP>> items;
-    items.reserve(size);
-    destTable->saveQueue.pop(items, saveQueueSize);
-    destTable->writeQueue.pop(items, writeQueueSize);
-
-    size = static_cast<int>(items.size());
-
-    INDEX insertedRows;
-    std::string errMsg;
-    for(int i = 0; i < size; i++){
-        bool ret = table->append(items[i], insertedRows, errMsg);
-        if(!ret)
-            throw RuntimeException("Failed to create table, with error: " + errMsg);
+    LockGuard<Mutex> guard(&destTable->writeMutex);
+    std::vector<ConstantSP> columns;
+    int size = 0;
+    for(std::size_t i = 0; i < destTable->colTypes.size(); i++){
+        INDEX failedRows = destTable->failedColumns.empty() ? 0 : destTable->failedColumns[i]->size();
+        VectorSP column = Util::createVector(destTable->colTypes[i], 0, failedRows + destTable->activeRows);
+        if(failedRows > 0)
+            column->append(destTable->failedColumns[i]);
+        if(destTable->activeRows > 0)
+            column->append(destTable->activeColumns[i]);
+        destTable->activeColumns[i]->clear();
+        size = column->size();
+        columns.push_back(column);
     }
-    return table;
+    destTable->failedColumns.clear();
+    destTable->pendingRows -= size;
+    destTable->activeRows = 0;
+    destTable->activeBytes = 0;
+    destTable->activeSince = -1;
+    return Util::createTable(destTable->colNames, columns);
 }
 
 void BatchTableWriter::removeTable(const std::string& dbName, const std::string& tableName){
@@ -260,14 +465,34 @@ void BatchTableWriter::removeTable(const std::string& dbName, const std::string&
             if(destTable->destroy)
                 return;
             else{
+                LockGuard<Mutex> guard(&destTable->writeMutex);
                 destTable->destroy = true;
                 destTable->writeNotifier.notify();
             }
         }
     }
     if(!destTable.isNull()){
-        destTable->writeThread->join();
-        destTable->conn->close();
+        MetricsRegistry::instance().unregisterGauge("ddb_btw_queue_depth", queueDepthLabels(dbName, tableName));
+        if(workerCount_ == 0){
+            destTable->writeThread->join();
+            destTable->conn->close();
+        }
+        else{
+            //Let the workers send what is left, then stop scheduling the table.
+            LockGuard<Mutex> guard(&scheduleMutex_);
+            scheduleNotifier_.notifyAll();
+            while(true){
+                bool drained;
+                {
+                    LockGuard<Mutex> tableGuard(&destTable->writeMutex);
+                    drained = !destTable->flushing && (destTable->activeRows == 0 || destTable->finished);
+                }
+                if(drained)
+                    break;
+                scheduleNotifier_.wait(scheduleMutex_, 100);
+            }
+            pooledTables_.erase(std::remove(pooledTables_.begin(), pooledTables_.end(), destTable), pooledTables_.end());
+        }
 
         RWLockGuard<RWLock> _(&rwLock, true, acquireLock_);
         destTables_.erase(std::make_pair(dbName, tableName));
@@ -0,0 +1,328 @@
+#include "ColumnarFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include "Concurrent.h"
+#include "ConstantImp.h"
+#include "ConstantMarshall.h"
+#include "Exceptions.h"
+#include "MappedFile.h"
+#include "SysIO.h"
+#include "Util.h"
+
+#ifdef WINDOWS
+#include <winsock2.h>
+#include <windows.h>
+#endif
+
+namespace dolphindb {
+
+namespace {
+
+const char MAGIC[8] = {'D', 'D', 'B', 'C', 'O', 'L', 'F', '1'};
+const int FORMAT_VERSION = 1;
+//Sections start at multiples of this, so raw columns are aligned for any element type and for SIMD loads.
+const long long SECTION_ALIGNMENT = 64;
+//The last bytes of the file: the footer offset, then the magic again.
+const long long TRAILER_SIZE = sizeof(long long) + sizeof(MAGIC);
+
+//Types stored as their raw values when uncompressed, which load as vectors over the mapping.
+bool isRawType(DATA_TYPE type) {
+    switch (type) {
+        case DT_BOOL:
+        case DT_CHAR:
+        case DT_SHORT:
+        case DT_INT:
+        case DT_LONG:
+        case DT_FLOAT:
+        case DT_DOUBLE:
+        case DT_DATE:
+        case DT_MONTH:
+        case DT_TIME:
+        case DT_MINUTE:
+        case DT_SECOND:
+        case DT_DATETIME:
+        case DT_TIMESTAMP:
+        case DT_NANOTIME:
+        case DT_NANOTIMESTAMP:
+        case DT_DATEHOUR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//The checks of AbstractTable::setColumnCompressMethods.
+void checkCompressMethod(COMPRESS_METHOD method, const ConstantSP& col, const std::string& name) {
+    if (method == COMPRESS_NONE || method == COMPRESS_LZ4)
+        return;
+    if (method != COMPRESS_DELTA)
+        throw RuntimeException("Unsupported compression method at column " + name);
+    DATA_TYPE type = col->getRawType();
+    if (type != DT_SHORT && type != DT_INT && type != DT_LONG && type != DT_DECIMAL32 && type != DT_DECIMAL64)
+        throw RuntimeException("Cannot apply compression method DELTA to column " + name +
+                               ", Only integral and temporal and Decimal32/Decimal64 data supports DELTA compression");
+    if (((Vector*)col.get())->getVectorType() == VECTOR_TYPE::ARRAYVECTOR)
+        throw RuntimeException("Cannot apply compression method DELTA to array vector at column " + name);
+}
+
+//Run func(0) .. func(count - 1) on at most workerCount threads.
+void forEachInParallel(size_t count, int workerCount, const std::function<void(size_t)>& func) {
+    size_t workers = std::min(count, (size_t)std::max(1, workerCount));
+    runInParallel(workers, [&](size_t worker) {
+        for (size_t i = worker; i < count; i += workers)
+            func(i);
+    });
+}
+
+//A file written under a temporary name, removed again unless it is committed.
+class TempFile {
+public:
+    explicit TempFile(const std::string& path) : path_(path), file_(fopen(path.c_str(), "wb")), size_(0) {
+        if (file_ == nullptr)
+            throw RuntimeException("Failed to create file " + path + ": " + strerror(errno));
+    }
+
+    ~TempFile() {
+        if (file_ != nullptr) {
+            fclose(file_);
+            std::remove(path_.c_str());
+        }
+    }
+
+    long long size() const { return size_; }
+
+    void write(const char* data, size_t length) {
+        if (length > 0 && fwrite(data, 1, length, file_) != length)
+            throw RuntimeException("Failed to write file " + path_ + ": " + strerror(errno));
+        size_ += (long long)length;
+    }
+
+    void alignSection() {
+        static const char zeros[SECTION_ALIGNMENT] = {};
+        write(zeros, (size_t)((SECTION_ALIGNMENT - size_ % SECTION_ALIGNMENT) % SECTION_ALIGNMENT));
+    }
+
+    //Close the file and rename it to path, replacing any file there.
+    void commit(const std::string& path) {
+        int ret = fclose(file_);
+        file_ = nullptr;
+        std::string error;
+        if (ret != 0)
+            error = "Failed to write file " + path_ + ": " + strerror(errno);
+#ifdef WINDOWS
+        else if (!MoveFileExA(path_.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING))
+            error = "Failed to rename " + path_ + " to " + path + ", error code " + std::to_string(GetLastError());
+#else
+        else if (rename(path_.c_str(), path.c_str()) != 0)
+            error = "Failed to rename " + path_ + " to " + path + ": " + strerror(errno);
+#endif
+        if (!error.empty()) {
+            std::remove(path_.c_str());
+            throw RuntimeException(error);
+        }
+    }
+
+private:
+    std::string path_;
+    FILE* file_;
+    long long size_;
+};
+
+}
+
+void ColumnarFile::write(const std::string& path, const TableSP& table, const std::vector<COMPRESS_METHOD>& compressMethods, int workerCount) {
+    if (table.isNull())
+        throw RuntimeException("Can't write a null table.");
+    int columns = table->columns();
+    if (!compressMethods.empty() && (int)compressMethods.size() != columns)
+        throw RuntimeException("The number of elements in parameter compressMethods does not match the column size " + std::to_string(columns) + ".");
+    INDEX rows = table->rows();
+    std::vector<Column> meta(columns);
+    std::vector<ConstantSP> cols(columns);
+    for (int c = 0; c < columns; ++c) {
+        Column& column = meta[c];
+        cols[c] = table->getColumn(c);
+        column.name = table->getColumnName(c);
+        column.type = cols[c]->getType();
+        column.extra = cols[c]->getExtraParamForType();
+        column.compressMethod = compressMethods.empty() ? table->getColumnCompressMethod(c) : compressMethods[c];
+        checkCompressMethod(column.compressMethod, cols[c], column.name);
+        column.raw = column.compressMethod == COMPRESS_NONE && isRawType(column.type) && cols[c]->isFastMode() &&
+                     cols[c]->getDataArray() != nullptr;
+        column.containNull = false;
+    }
+
+    //Encode every column that isn't written raw, and find out whether the raw ones have nulls.
+    std::vector<DataOutputStreamSP> encoded(columns);
+    forEachInParallel(columns, workerCount > 0 ? workerCount : Util::getCoreCount(), [&](size_t c) {
+        if (meta[c].raw) {
+            meta[c].containNull = ((Vector*)cols[c].get())->hasNull();
+            return;
+        }
+        DataOutputStreamSP out = new DataOutputStream(1 << 16);
+        VectorMarshall marshall(out);
+        marshall.setCompressMethod(meta[c].compressMethod);
+        IO_ERR ret = OK;
+        if (!marshall.start(cols[c], true, meta[c].compressMethod != COMPRESS_NONE, ret) || (ret = marshall.flush()) != OK)
+            throw RuntimeException("Failed to encode column " + meta[c].name + ", error code " + std::to_string(ret));
+        encoded[c] = out;
+    });
+
+    //Write to a temporary file and rename it, so readers that mapped the old file keep it intact.
+    TempFile file(path + ".tmp");
+    file.write(MAGIC, sizeof(MAGIC));
+    for (int c = 0; c < columns; ++c) {
+        file.alignSection();
+        meta[c].offset = file.size();
+        if (meta[c].raw) {
+            file.write((const char*)cols[c]->getDataArray(), (size_t)rows * Util::getDataTypeSize(meta[c].type));
+        } else {
+            file.write(encoded[c]->getBuffer(), encoded[c]->size());
+            encoded[c].clear();
+        }
+        meta[c].length = file.size() - meta[c].offset;
+    }
+
+    DataOutputStream footer(1024);
+    footer.write(FORMAT_VERSION);
+    footer.write((char)Util::isLittleEndian());
+    footer.write((long long)rows);
+    footer.write(columns);
+    for (const Column& column : meta) {
+        footer.write(column.name);
+        footer.write((int)column.type);
+        footer.write(column.extra);
+        footer.write((char)column.compressMethod);
+        footer.write((char)column.raw);
+        footer.write((char)column.containNull);
+        footer.write(column.offset);
+        footer.write(column.length);
+    }
+    long long footerOffset = file.size();
+    file.write(footer.getBuffer(), footer.size());
+    file.write((const char*)&footerOffset, sizeof(footerOffset));
+    file.write(MAGIC, sizeof(MAGIC));
+    file.commit(path);
+}
+
+ColumnarFile::ColumnarFile(const std::string& path) : path_(path), file_(std::make_shared<MappedFile>(path, true)), rows_(0) {
+    const char* data = file_->data();
+    long long size = (long long)file_->size();
+    long long footerOffset = -1;
+    if (size >= (long long)sizeof(MAGIC) + TRAILER_SIZE && memcmp(data, MAGIC, sizeof(MAGIC)) == 0 &&
+        memcmp(data + size - sizeof(MAGIC), MAGIC, sizeof(MAGIC)) == 0)
+        memcpy(&footerOffset, data + size - TRAILER_SIZE, sizeof(footerOffset));
+    if (footerOffset < (long long)sizeof(MAGIC) || footerOffset > size - TRAILER_SIZE)
+        throw RuntimeException(path + " is not a columnar table file.");
+
+    DataInputStream footer(data + footerOffset, (size_t)(size - TRAILER_SIZE - footerOffset), false);
+    int version = 0, columns = 0;
+    char littleEndian = 0;
+    long long rows = 0;
+    bool ok = footer.readInt(version) == OK && footer.readChar(littleEndian) == OK && footer.readLong(rows) == OK &&
+              footer.readInt(columns) == OK;
+    if (ok && version != FORMAT_VERSION)
+        throw RuntimeException(path + " has columnar format version " + std::to_string(version) + ", which isn't supported.");
+    if (ok && (bool)littleEndian != Util::isLittleEndian())
+        throw RuntimeException(path + " was written on a machine of the other byte order.");
+    ok = ok && rows >= 0 && rows <= INT_MAX && columns >= 0;
+    for (int c = 0; ok && c < columns; ++c) {
+        Column column;
+        int type = 0;
+        char compressMethod = 0, raw = 0, containNull = 0;
+        ok = footer.readString(column.name) == OK && footer.readInt(type) == OK && footer.readInt(column.extra) == OK &&
+             footer.readChar(compressMethod) == OK && footer.readChar(raw) == OK && footer.readChar(containNull) == OK &&
+             footer.readLong(column.offset) == OK && footer.readLong(column.length) == OK;
+        column.type = (DATA_TYPE)type;
+        column.compressMethod = (COMPRESS_METHOD)compressMethod;
+        column.raw = raw != 0;
+        column.containNull = containNull != 0;
+        ok = ok && column.offset >= (long long)sizeof(MAGIC) && column.length >= 0 && column.offset + column.length <= footerOffset;
+        if (ok && column.raw)
+            ok = isRawType(column.type) && column.length == rows * Util::getDataTypeSize(column.type);
+        if (ok) {
+            nameIndex_[column.name] = c;
+            columns_.push_back(column);
+        }
+    }
+    if (!ok)
+        throw RuntimeException("The footer of " + path + " is corrupt.");
+    rows_ = (INDEX)rows;
+}
+
+ColumnarFile::~ColumnarFile() {}
+
+int ColumnarFile::getColumnIndex(const std::string& name) const {
+    auto it = nameIndex_.find(name);
+    return it == nameIndex_.end() ? -1 : it->second;
+}
+
+VectorSP ColumnarFile::load(const Column& column) const {
+    char* data = file_->data() + column.offset;
+    if (column.raw) {
+        //The mapping is copy-on-write, so the vector may be written to.
+        return Util::createVector(column.type, rows_, data, file_, false, column.extra, column.containNull);
+    }
+    DataInputStreamSP in = new DataInputStream(data, (size_t)column.length, false);
+    short flag = 0;
+    IO_ERR ret = in->readShort(flag);
+    VectorUnmarshall unmarshall(in);
+    if (ret == OK && unmarshall.start(flag, true, ret)) {
+        ConstantSP obj = unmarshall.getConstant();
+        if (obj->isVector() && obj->size() == rows_)
+            return obj;
+        ret = INVALIDDATA;
+    }
+    throw RuntimeException("Failed to load column " + column.name + " of " + path_ + ", error code " + std::to_string(ret));
+}
+
+VectorSP ColumnarFile::getColumn(int index) {
+    if (index < 0 || index >= columns())
+        throw RuntimeException("Column index " + std::to_string(index) + " is out of range.");
+    Column& column = columns_[index];
+    if (column.vector.isNull())
+        column.vector = load(column);
+    return column.vector;
+}
+
+VectorSP ColumnarFile::getColumn(const std::string& name) {
+    int index = getColumnIndex(name);
+    if (index < 0)
+        throw RuntimeException("Column " + name + " doesn't exist in " + path_ + ".");
+    return getColumn(index);
+}
+
+TableSP ColumnarFile::getTable() {
+    std::vector<std::string> names;
+    for (const Column& column : columns_)
+        names.push_back(column.name);
+    return getTable(names);
+}
+
+TableSP ColumnarFile::getTable(const std::vector<std::string>& colNames) {
+    std::vector<int> indices;
+    std::vector<size_t> pending;
+    for (const std::string& name : colNames) {
+        int index = getColumnIndex(name);
+        if (index < 0)
+            throw RuntimeException("Column " + name + " doesn't exist in " + path_ + ".");
+        indices.push_back(index);
+        if (columns_[index].vector.isNull() && std::find(pending.begin(), pending.end(), (size_t)index) == pending.end())
+            pending.push_back(index);
+    }
+    //Compressed and marshalled columns take real work to decode, so load them side by side.
+    forEachInParallel(pending.size(), Util::getCoreCount(), [&](size_t i) {
+        Column& column = columns_[pending[i]];
+        column.vector = load(column);
+    });
+    std::vector<ConstantSP> cols;
+    for (int index : indices)
+        cols.push_back(columns_[index].vector);
+    return Util::createTable(colNames, cols);
+}
+
+}
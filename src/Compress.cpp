@@ -2,6 +2,7 @@
 #include "Util.h"
 #include "LZ4.h"
 #include "DolphinDB.h"
+#include "Metrics.h"
 
 const int MAX_DECOMPRESSED_SIZE = 1 << 16;
 const int MAX_COMPRESSED_SIZE = LZ4_compressBound(1 << 16);
@@ -23,19 +24,63 @@ CompressEncoderDecoderSP CompressionFactory::GetEncodeDecoder(COMPRESS_METHOD ty
 	}
 }
 
+namespace {
+
+struct CompressMetrics {
+	MetricHistogram* encodeTime;
+	MetricHistogram* decodeTime;
+	MetricCounter* rawBytes;
+	MetricCounter* compressedBytes;
+};
+
+CompressMetrics& compressMetrics(COMPRESS_METHOD method) {
+	static CompressMetrics metrics[2];
+	static bool initialized = [](){
+		MetricsRegistry& registry = MetricsRegistry::instance();
+		for (int i = 0; i < 2; ++i) {
+			std::string labels = MetricsRegistry::label("method", i == 0 ? "lz4" : "delta");
+			metrics[i].encodeTime = registry.histogram("ddb_compress_encode_microseconds", labels);
+			metrics[i].decodeTime = registry.histogram("ddb_compress_decode_microseconds", labels);
+			metrics[i].rawBytes = registry.counter("ddb_compress_raw_bytes_total", labels);
+			metrics[i].compressedBytes = registry.counter("ddb_compress_compressed_bytes_total", labels);
+			MetricCounter* raw = metrics[i].rawBytes;
+			MetricCounter* compressed = metrics[i].compressedBytes;
+			registry.registerGauge("ddb_compress_ratio", labels, [raw, compressed]() {
+				long long compressedBytes = compressed->get();
+				return compressedBytes == 0 ? 0.0 : (double)raw->get() / compressedBytes;
+			});
+		}
+		return true;
+	}();
+	(void)initialized;
+	return metrics[method == COMPRESS_DELTA ? 1 : 0];
+}
+
+}
+
 IO_ERR CompressionFactory::decode(DataInputStreamSP compressSrc, DataOutputStreamSP &uncompressResult, Header &header) {
 	CompressEncoderDecoderSP decoder=GetEncodeDecoder((COMPRESS_METHOD)header.compressedType);
 	if (decoder.isNull()) {
 		return INVALIDDATA;
 	}
-	return decoder->decode(compressSrc, uncompressResult, header);
+	long long startTime = Util::getNanoBenchmark();
+	IO_ERR ret = decoder->decode(compressSrc, uncompressResult, header);
+	compressMetrics((COMPRESS_METHOD)header.compressedType).decodeTime->record((Util::getNanoBenchmark() - startTime) / 1000);
+	return ret;
 }
 IO_ERR CompressionFactory::encodeContent(const VectorSP &vec, const DataOutputStreamSP &compressResult, Header &header, bool checkSum) {
 	CompressEncoderDecoderSP decoder = GetEncodeDecoder((COMPRESS_METHOD)header.compressedType);
 	if (decoder.isNull()) {
 		return INVALIDDATA;
 	}
+	long long startTime = Util::getNanoBenchmark();
 	IO_ERR ret = decoder->encodeContent(vec, compressResult, header, checkSum);
+	CompressMetrics& metrics = compressMetrics((COMPRESS_METHOD)header.compressedType);
+	metrics.encodeTime->record((Util::getNanoBenchmark() - startTime) / 1000);
+	if (ret == OK && header.unitLength > 0) {
+		metrics.rawBytes->increment((long long)header.elementCount * header.unitLength);
+		metrics.compressedBytes->increment(header.byteSize);
+	}
 	return ret;
 }
 
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <chrono>
+#include <string>
 
 #ifdef MAC
 	#include <errno.h>
@@ -487,6 +488,41 @@ void Thread::join(){
 #endif
 }
 
+void runInParallel(size_t count, const std::function<void(size_t)>& func){
+	if(count == 0)
+		return;
+	if(count == 1){
+		func(0);
+		return;
+	}
+	std::vector<std::string> errors(count);
+	std::vector<ThreadSP> threads;
+	for(size_t i = 1; i < count; ++i){
+		ThreadSP thread = new Thread(new Executor([&func, &errors, i](){
+			try{
+				func(i);
+			}
+			catch(std::exception& ex){
+				errors[i] = ex.what();
+			}
+		}));
+		thread->start();
+		threads.push_back(thread);
+	}
+	try{
+		func(0);
+	}
+	catch(std::exception& ex){
+		errors[0] = ex.what();
+	}
+	for(ThreadSP& thread : threads)
+		thread->join();
+	for(const std::string& error : errors){
+		if(!error.empty())
+			throw RuntimeException(error);
+	}
+}
+
 void Thread::sleep(int milliSeconds){
 #ifdef WINDOWS
 	Sleep(milliSeconds);
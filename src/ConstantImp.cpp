@@ -10,14 +10,21 @@ using std::deque;
 
 namespace dolphindb {
 
-StringVector::StringVector(INDEX sz, INDEX capacity, bool blob) : blob_(blob){
+StringVector::StringVector(INDEX sz, INDEX capacity, bool blob, bool arena) : arenaMode_(arena), blob_(blob){
+	containNull_ = false;
+	if(arena){
+		offsets_.reserve((std::max)(sz, capacity) + 1);
+		offsets_.push_back(0);
+		for(INDEX i = 0; i < sz; ++i)
+			appendArena("", 0);
+		return;
+	}
 	data_.reserve((std::max)(sz, capacity));
 	if(sz > 0)
 		data_.resize(sz);
-	containNull_ = false;
 }
 
-StringVector::StringVector(const std::vector<std::string>& data, INDEX capacity, bool containNull, bool blob) : blob_(blob) {
+StringVector::StringVector(const std::vector<std::string>& data, INDEX capacity, bool containNull, bool blob) : arenaMode_(false), blob_(blob) {
 	for(const auto& val : data){
 		checkString(val);
 	}
@@ -27,10 +34,47 @@ StringVector::StringVector(const std::vector<std::string>& data, INDEX capacity,
 }
 
 INDEX StringVector::reserve(INDEX capacity){
+	if(arenaMode_){
+		offsets_.reserve(capacity + 1);
+		return static_cast<INDEX>(offsets_.capacity() - 1);
+	}
 	data_.reserve(capacity);
 	return static_cast<INDEX>(data_.capacity());
 }
 
+void StringVector::clear(){
+	data_.clear();
+	if(arenaMode_){
+		//Keep the buffers so that a reused decoding column does not allocate again.
+		offsets_.resize(1);
+		arena_.clear();
+	}
+	else{
+		releaseArena();
+	}
+	containNull_ = false;
+}
+
+int StringVector::compare(INDEX index, const ConstantSP& target) const {
+	return compareView(view(index), target->getString());
+}
+
+void StringVector::materialize() const {
+	if(!arenaMode_)
+		return;
+	std::lock_guard<std::mutex> guard(materializeMutex_);
+	if(!arenaMode_)
+		return;
+	INDEX sz = static_cast<INDEX>(offsets_.size() - 1);
+	std::vector<std::string> data;
+	data.reserve(offsets_.capacity() - 1);
+	for(INDEX i = 0; i < sz; ++i)
+		data.emplace_back(arena_.data() + offsets_[i], static_cast<size_t>(offsets_[i + 1] - offsets_[i] - 1));
+	data_.swap(data);
+	//Other threads may still be reading the arena; the next modification releases it.
+	arenaMode_ = false;
+}
+
 IO_ERR StringVector::deserialize(DataInputStream* in, INDEX indexStart, INDEX targetNumElement, INDEX& numElement){
     auto readBlob = [&](std::string& value) -> IO_ERR {
         IO_ERR ret;
@@ -45,8 +89,22 @@ IO_ERR StringVector::deserialize(DataInputStream* in, INDEX indexStart, INDEX ta
         return ret;
     };
     
-	//read string
 	numElement = 0;
+	if(arenaMode_ && indexStart == size()){
+		//Decode into a reused scratch string and copy it into the arena, no allocation per element.
+		std::string value;
+		while(numElement < targetNumElement){
+			IO_ERR ret = blob_ ? readBlob(value) : in->readString(value);
+			if(ret != OK)
+				return ret;
+			appendArena(value.data(), value.size());
+			++numElement;
+		}
+		return OK;
+	}
+	materializeForWrite();
+
+	//read string
 	INDEX firstTarget = ((std::min))(size() - indexStart, targetNumElement);
 	while(numElement < firstTarget){
 		IO_ERR ret;
@@ -77,6 +135,7 @@ IO_ERR StringVector::deserialize(DataInputStream* in, INDEX indexStart, INDEX ta
 }
 
 void StringVector::upper(){
+	materializeForWrite();
 	std::vector<std::string>::iterator it = data_.begin();
 	std::vector<std::string>::iterator end = data_.end();
 	while(it != end){
@@ -91,6 +150,7 @@ void StringVector::upper(){
 }
 
 void StringVector::lower(){
+	materializeForWrite();
 	std::vector<std::string>::iterator it = data_.begin();
 	std::vector<std::string>::iterator end = data_.end();
 	while(it != end){
@@ -113,6 +173,7 @@ void StringVector::checkString(const std::string& val){
 }
 
 void StringVector::trim(){
+	materializeForWrite();
 	std::vector<std::string>::iterator it = data_.begin();
 	std::vector<std::string>::iterator end = data_.end();
 	while(it != end){
@@ -125,6 +186,7 @@ void StringVector::trim(){
 }
 
 void StringVector::strip(){
+	materializeForWrite();
 	std::vector<std::string>::iterator it = data_.begin();
 	std::vector<std::string>::iterator end = data_.end();
 	while(it != end){
@@ -137,6 +199,7 @@ void StringVector::strip(){
 }
 
 bool StringVector::set(const ConstantSP& index, const ConstantSP& value){
+	materializeForWrite();
 	if(index->isVector()){
 		bool literal=value->getCategory()==LITERAL;
 		INDEX len=index->size();
@@ -181,25 +244,47 @@ bool StringVector::assign(const ConstantSP& value){
 }
 
 INDEX StringVector::search(const std::string& val){
-	std::vector<std::string>::iterator it=std::find(data_.begin(),data_.end(),val);
-	if(it!=data_.end())
-		return static_cast<INDEX>(it-data_.begin());
-	else
-		return -1;
+	INDEX sz = size();
+	for(INDEX i = 0; i < sz; ++i){
+		if(compareView(view(i), val) == 0)
+			return i;
+	}
+	return -1;
 }
 
 ConstantSP StringVector::getValue() const {
-	Vector* copy = new StringVector(data_, static_cast<INDEX>(data_.size()), containNull_, blob_);
+	ConstantSP copy = getValue(size());
 	copy->setForm(getForm());
 	return copy;
 }
 
+ConstantSP StringVector::getValue(INDEX capacity) const {
+	if(!arenaMode_)
+		return ConstantSP(new StringVector(data_, capacity, containNull_, blob_));
+	StringVector* copy = new StringVector(0, 0, blob_, true);
+	copy->offsets_.reserve((std::max)(capacity, size()) + 1);
+	copy->offsets_.assign(offsets_.begin(), offsets_.end());
+	copy->arena_.assign(arena_.begin(), arena_.end());
+	copy->containNull_ = containNull_;
+	return copy;
+}
+
 ConstantSP StringVector::getSubVector(INDEX start, INDEX length, INDEX capacity) const {
-	StringVector* vec=new StringVector(0, capacity, blob_);
+	StringVector* vec=new StringVector(0, capacity, blob_, arenaMode_);
 	ConstantSP result(vec);
 	if(start<0 || start>=size() || std::abs(length)>size())
 		return result;
 
+	if(arenaMode_){
+		INDEX step = length > 0 ? 1 : -1;
+		for(INDEX i = 0, cur = start; i < std::abs(length); ++i, cur += step){
+			StringView str = view(cur);
+			vec->appendArena(str.data, str.length);
+		}
+		result->setNullFlag(containNull_);
+		return result;
+	}
+
 	if(length>0)
 		vec->data_.insert(vec->data_.begin(),data_.begin()+start,data_.begin()+(start+length));
 	else
@@ -209,7 +294,7 @@ ConstantSP StringVector::getSubVector(INDEX start, INDEX length, INDEX capacity)
 }
 
 ConstantSP StringVector::get(const ConstantSP& index) const {
-	UINDEX sz=static_cast<UINDEX>(data_.size());
+	UINDEX sz=static_cast<UINDEX>(size());
 	if(index->isVector()){
 		INDEX len=index->size();
 		StringVector* p=new StringVector(len, len, blob_);
@@ -217,7 +302,8 @@ ConstantSP StringVector::get(const ConstantSP& index) const {
 		if(index->isIndexArray()){
 			UINDEX* bufIndex=(UINDEX*)index->getIndexArray();
 			for(INDEX i=0;i<len;++i)
-				p->data_[i]=bufIndex[i]<sz?data_[bufIndex[i]]:"";
+				if(bufIndex[i]<sz)
+					assignTo(p->data_[i], bufIndex[i]);
 		}
 		else{
 			const int bufSize=Util::BUF_SIZE;
@@ -230,7 +316,8 @@ ConstantSP StringVector::get(const ConstantSP& index) const {
 				count=((std::min))(len-start,bufSize);
 				index->getIndex(start,count,(INDEX*)bufIndex);
 				for(i=0;i<count;i++){
-					p->data_[start+i]=bufIndex[i]<sz?data_[bufIndex[i]]:"";
+					if(bufIndex[i]<sz)
+						assignTo(p->data_[start+i], bufIndex[i]);
 				}
 				start+=count;
 			}
@@ -240,11 +327,43 @@ ConstantSP StringVector::get(const ConstantSP& index) const {
 	}
 	else{
 		UINDEX idx=(UINDEX)index->getIndex();
-		return ConstantSP(new String(idx<sz?data_[idx]:"", blob_));
+		return ConstantSP(new String(idx<sz?getString(idx):"", blob_));
 	}
 }
 
 bool StringVector::append(const ConstantSP& value, INDEX len){
+	if(arenaMode_){
+		offsets_.reserve(offsets_.size() + len);
+		if(value->getCategory()==LITERAL){
+			if(value->isScalar()){
+				const std::string& str = value->getStringRef();
+				appendArena(str.data(), str.size());
+			}
+			else{
+				char* bufVal[Util::BUF_SIZE];
+				char** pval;
+				INDEX start=0;
+				int count;
+				while(start<len){
+					count=((std::min))(len-start,Util::BUF_SIZE);
+					pval=value->getStringConst(start,count,bufVal);
+					for(int i=0;i<count;++i)
+						appendArena(pval[i], strlen(pval[i]));
+					start+=count;
+				}
+			}
+		}
+		else{
+			for(INDEX i=0;i<len;i++){
+				std::string str = value->getString(i);
+				appendArena(str.data(), str.size());
+			}
+		}
+		if(value->getNullFlag())
+			containNull_=true;
+		return true;
+	}
+	releaseArena();
 	size_t newSize;
 	if((newSize = data_.size() + len) > data_.capacity())
 		data_.reserve(newSize);
@@ -279,6 +398,12 @@ bool StringVector::appendString(std::string* buf, int len){
 	for(int i = 0; i < len; ++i){
 		checkString(buf[i]);
 	}
+	if(arenaMode_){
+		for(int i=0;i<len;i++)
+			appendArena(buf[i].data(), buf[i].size());
+		return true;
+	}
+	releaseArena();
 	size_t newSize;
 	if((newSize = data_.size() + len) > data_.capacity())
 		data_.reserve(newSize);
@@ -289,6 +414,12 @@ bool StringVector::appendString(std::string* buf, int len){
 }
 
 bool StringVector::appendString(char** buf, int len){
+	if(arenaMode_){
+		for(int i=0;i<len;i++)
+			appendArena(buf[i], strlen(buf[i]));
+		return true;
+	}
+	releaseArena();
 	size_t newSize;
 	if((newSize = data_.size() + len) > data_.capacity())
 		data_.reserve(newSize);
@@ -301,6 +432,12 @@ bool StringVector::appendString(char** buf, int len){
 bool StringVector::remove(INDEX count){
 	bool fromHead=(count<0);
 	count=((std::min))(size(),abs(count));
+	if(arenaMode_ && !fromHead){
+		offsets_.resize(offsets_.size() - count);
+		arena_.resize(static_cast<size_t>(offsets_.back()));
+		return true;
+	}
+	materializeForWrite();
 	if(fromHead)
 		data_.erase(data_.begin(),data_.begin()+count);
 	else
@@ -309,6 +446,7 @@ bool StringVector::remove(INDEX count){
 }
 
 bool StringVector::remove(const ConstantSP& index){
+	materializeForWrite();
 	INDEX sz = index->size();
 	INDEX invSize = static_cast<INDEX>(data_.size() - sz);
 	if(invSize <= 0){
@@ -355,6 +493,7 @@ bool StringVector::remove(const ConstantSP& index){
 }
 
 void StringVector::next(INDEX steps){
+	materializeForWrite();
 	steps=((std::min))(steps,size());
 	data_.erase(data_.begin(),data_.begin() + steps);
 	data_.insert(data_.end(),steps,"");
@@ -362,6 +501,7 @@ void StringVector::next(INDEX steps){
 }
 
 void StringVector::prev(INDEX steps){
+	materializeForWrite();
 	INDEX len=size();
 	steps=((std::min))(steps,size());
 	data_.erase(data_.begin() + (len - steps),data_.end());
@@ -370,6 +510,7 @@ void StringVector::prev(INDEX steps){
 }
 
 void StringVector::fill(INDEX start, INDEX length, const ConstantSP& value){
+	materializeForWrite();
 	if(value->isScalar() || length!=value->size()){
 		std::string fillVal=value->getString(0);
 		fill_n(data_.begin()+start,length,fillVal);
@@ -400,6 +541,7 @@ void StringVector::fill(INDEX start, INDEX length, const ConstantSP& value){
 }
 
 void StringVector::nullFill(const ConstantSP& val){
+	materializeForWrite();
 	std::string rep=val->getString();
 	int len=size();
 	for(int i=0;i<len;++i)
@@ -409,7 +551,11 @@ void StringVector::nullFill(const ConstantSP& val){
 }
 
 bool StringVector::isNull(INDEX start, int len, char* buf) const {
-	if(containNull_){
+	if(containNull_ && arenaMode_){
+		for(int i=0;i<len;++i)
+			buf[i] = offsets_[start + i + 1] - offsets_[start + i] == 1;
+	}
+	else if(containNull_){
 		std::vector<std::string>::const_iterator it = data_.begin() + start;
 		for(int i=0;i<len;++i){
 			buf[i]= it->empty();
@@ -423,6 +569,13 @@ bool StringVector::isNull(INDEX start, int len, char* buf) const {
 }
 
 bool StringVector::hasNullInRange(INDEX start, INDEX end){
+	if(arenaMode_){
+		for(INDEX i=start; i<end; ++i){
+			if(offsets_[i + 1] - offsets_[i] == 1)
+				return true;
+		}
+		return false;
+	}
 	std::vector<std::string>::const_iterator it = data_.begin() + start;
 	for(INDEX i=start; i<end; ++i){
 		if(it->empty())
@@ -442,19 +595,19 @@ int StringVector::serialize(char* buf, int bufSize, INDEX indexStart, int offset
 
     if (!blob_) {
         while (bufSize > 0 && indexStart < size_) {
-            const std::string& str = data_[indexStart];
-            if(str.size() >= 262144){
+            StringView str = view(indexStart);
+            if(str.length >= 262144){
                 throw RuntimeException("String in vector too long, Serialization failed, length must be less than 256K bytes");
             }
-            int len = static_cast<int>(str.size() + 1 - offset);
+            int len = static_cast<int>(str.length + 1 - offset);
             if (bufSize >= len) {
-                memcpy(buf, str.c_str() + offset, len);
+                memcpy(buf, str.data + offset, len);
                 buf += len;
                 bufSize -= len;
                 ++indexStart;
                 offset = 0;
             } else {
-                memcpy(buf, str.c_str() + offset, bufSize);
+                memcpy(buf, str.data + offset, bufSize);
                 partial = offset + bufSize;
                 bufSize = 0;
             }
@@ -462,8 +615,8 @@ int StringVector::serialize(char* buf, int bufSize, INDEX indexStart, int offset
     } else {
         const int lenBytes = sizeof(int);
         while (bufSize > 0 && indexStart < size_) {
-            const std::string& str = data_[indexStart];
-            int len = static_cast<int>(str.size());
+            StringView str = view(indexStart);
+            int len = static_cast<int>(str.length);
             if (LIKELY(offset == 0)) {
                 if (UNLIKELY(bufSize < lenBytes)) {
                     partial = 0;
@@ -477,13 +630,13 @@ int StringVector::serialize(char* buf, int bufSize, INDEX indexStart, int offset
             }
 
             if (bufSize >= len - offset) {
-                memcpy(buf, str.data() + offset, len - offset);
+                memcpy(buf, str.data + offset, len - offset);
                 buf += len - offset;
                 bufSize -= len - offset;
                 ++indexStart;
                 offset = 0;
             } else {
-                memcpy(buf, str.data() + offset, bufSize);
+                memcpy(buf, str.data + offset, bufSize);
                 partial = lenBytes + offset + bufSize;
                 bufSize = 0;
             }
@@ -495,6 +648,7 @@ int StringVector::serialize(char* buf, int bufSize, INDEX indexStart, int offset
 }
 
 bool StringVector::getString(INDEX start, int len, std::string** buf) const {
+	materialize();
 	std::vector<std::string>::iterator it=data_.begin()+start;
 	for(int i=0;i<len;++i)
 		buf[i]=&(*it++);
@@ -502,6 +656,11 @@ bool StringVector::getString(INDEX start, int len, std::string** buf) const {
 }
 
 bool StringVector::getString(INDEX start, int len, char** buf) const {
+	if(arenaMode_){
+		for(int i=0;i<len;++i)
+			buf[i]=arena_.data()+offsets_[start+i];
+		return true;
+	}
 	std::vector<std::string>::iterator it=data_.begin()+start;
 	for(int i=0;i<len;++i)
 		buf[i]=(char*)((*it++).c_str());
@@ -509,6 +668,7 @@ bool StringVector::getString(INDEX start, int len, char** buf) const {
 }
 
 std::string** StringVector::getStringConst(INDEX start, int len, std::string** buf) const {
+	materialize();
 	std::vector<std::string>::iterator it=data_.begin()+start;
 	for(int i=0;i<len;++i)
 		buf[i]=&(*it++);
@@ -516,6 +676,11 @@ std::string** StringVector::getStringConst(INDEX start, int len, std::string** b
 }
 
 char** StringVector::getStringConst(INDEX start, int len, char** buf) const {
+	if(arenaMode_){
+		for(int i=0;i<len;++i)
+			buf[i]=arena_.data()+offsets_[start+i];
+		return buf;
+	}
 	std::vector<std::string>::iterator it=data_.begin()+start;
 	for(int i=0;i<len;++i)
 		buf[i]=(char*)((*it++).c_str());
@@ -523,14 +688,18 @@ char** StringVector::getStringConst(INDEX start, int len, char** buf) const {
 }
 
 void StringVector::replace(const ConstantSP& oldVal, const ConstantSP& newVal){
+	materializeForWrite();
 	std::string ov=oldVal->getString(0);
 	std::string nv=newVal->getString(0);
 	std::replace(data_.begin(),data_.end(),ov,nv);
 }
 
 long long StringVector::getAllocatedMemory() const{
+	if(arenaMode_)
+		return sizeof(StringVector) + offsets_.capacity() * sizeof(long long) + arena_.capacity();
 	INDEX sz = static_cast<INDEX>(data_.size());
-	long long bytes =sizeof(StringVector)+sizeof(std::string)*sz;
+	//An arena kept alive after a const conversion until the next modification.
+	long long bytes =sizeof(StringVector)+sizeof(std::string)*sz + offsets_.capacity() * sizeof(long long) + arena_.capacity();
 	if(sz <= 0)
 		return bytes;
 	INDEX len= ((std::min))(10, sz);
@@ -541,6 +710,10 @@ long long StringVector::getAllocatedMemory() const{
 }
 
 long long StringVector::getAllocatedMemory(INDEX sz) const {
+	if(arenaMode_){
+		long long bytes = sizeof(StringVector) + (sz + 1) * sizeof(long long);
+		return size() > 0 ? bytes + static_cast<long long>((double)arena_.size() / size() * sz) : bytes;
+	}
 	long long bytes =sizeof(StringVector)+sizeof(std::string)*sz;
 	if(sz <= 0)
 		return bytes;
@@ -1648,52 +1821,6 @@ ConstantSP FastDateVector::get(const ConstantSP& index) const {
 	}
 }
 
-ConstantSP FastDateVector::castTemporal(DATA_TYPE expectType){
-	if(expectType != DT_DATEHOUR && (expectType < DT_DATE || expectType > DT_NANOTIMESTAMP)){
-		throw RuntimeException("castTemporal from DATE to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType != DT_DATE && expectType != DT_TIMESTAMP && expectType != DT_NANOTIMESTAMP && expectType != DT_MONTH && expectType != DT_DATETIME && expectType != DT_DATEHOUR){
-		throw RuntimeException("castTemporal from DATE to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType == DT_DATE)
-		return getValue();
-
-	VectorSP res = Util::createVector(expectType, size_);
-	if(expectType == DT_DATEHOUR){
-        int *pbuf = (int*)res->getDataArray();
-        for(int i = 0; i < size_; i++){
-            data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = data_[i] * 24;
-        }
-        return res;
-	}
-	long long ratio = Util::getTemporalConversionRatio(DT_DATE, expectType);
-	if(expectType == DT_NANOTIMESTAMP ||  expectType  == DT_TIMESTAMP){
-		long long *pbuf = (long long*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == INT_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = (long long)data_[i] * ratio;
-		}
-	}
-	else if(expectType == DT_DATETIME){
-		int *pbuf = (int*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] * ratio);
-		}
-	}
-	else{
-		int *pbuf = (int*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			if(data_[i] == INT_MIN){
-				pbuf[i] = INT_MIN;
-				continue;
-			}
-			int year, month, day;
-			Util::parseDate(data_[i], year, month, day);
-			pbuf[i] = year*12+month-1;
-		}
-	}
-	return res;
-}
-
 ConstantSP FastDateTimeVector::get(const ConstantSP& index) const {
 	if(index->isVector()){
 		return retrieve((Vector*)index.get());
@@ -1704,76 +1831,6 @@ ConstantSP FastDateTimeVector::get(const ConstantSP& index) const {
 	}
 }
 
-ConstantSP FastDateTimeVector::castTemporal(DATA_TYPE expectType){
-	if(expectType != DT_DATEHOUR && (expectType < DT_DATE || expectType > DT_NANOTIMESTAMP)){
-		throw RuntimeException("castTemporal from DATETIME to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType == DT_DATETIME)
-		return getValue();
-
-	VectorSP res = Util::createVector(expectType, size_);
-	if(expectType == DT_DATEHOUR){
-        int *pbuf = (int*)res->getDataArray();
-        for(int i = 0; i < size_; i++){
-			int tail = (data_[i] < 0) && (data_[i] % 3600);
-            data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = data_[i] / 3600 - tail;
-        }
-        return res;
-	}
-	long long ratio = Util::getTemporalConversionRatio(DT_DATETIME, expectType);
-	if(expectType == DT_NANOTIMESTAMP ||  expectType  == DT_TIMESTAMP){
-		long long *pbuf = (long long*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == INT_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = (long long)data_[i] * ratio;
-		}
-	}
-	else if(expectType == DT_DATE){
-		int *pbuf = (int*)res->getDataArray();
-		ratio = -ratio;
-		for(int i = 0; i < size_; i++){
-			int tail = (data_[i] < 0) && (data_[i] % ratio);
-			data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] / ratio - tail);
-		}
-	}
-	else if(expectType == DT_MONTH){
-		int *pbuf = (int*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			if(data_[i] == INT_MIN){
-				pbuf[i] = INT_MIN;
-				continue;
-			}
-			int year, month, day;
-			Util::parseDate(data_[i] / 86400, year, month, day);
-			pbuf[i] = year*12+month-1;
-		}
-	}
-	else if(expectType == DT_NANOTIME){
-		long long *pbuf = (long long*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			int remainder = data_[i] % 86400;
-			data_[i] == INT_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = (long long)(remainder + ((data_[i] < 0) && remainder) * 86400) * 1000000000LL;
-		}
-	}
-	else{
-		ratio = Util::getTemporalConversionRatio(DT_SECOND, expectType);
-		int *pbuf = (int*)res->getDataArray();
-		if(ratio > 0){
-			for(int i = 0; i < size_; i++){
-				int remainder = data_[i] % 86400;
-				data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>((remainder + ((data_[i] < 0) && remainder) * 86400) * ratio);
-			}
-		}
-		else{
-			ratio = -ratio;
-			for(int i = 0; i < size_; i++){
-				int remainder = data_[i] % 86400;
-				data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>((remainder + ((data_[i] < 0) && remainder) * 86400) / ratio);
-			}
-		}
-	}
-	return res;
-}
-
 ConstantSP FastDateHourVector::get(const ConstantSP& index) const {
     if(index->isVector()){
         return retrieve((Vector*)index.get());
@@ -1784,68 +1841,6 @@ ConstantSP FastDateHourVector::get(const ConstantSP& index) const {
     }
 }
 
-ConstantSP FastDateHourVector::castTemporal(DATA_TYPE expectType){
-    if(expectType != DT_DATEHOUR && (expectType < DT_DATE || expectType > DT_NANOTIMESTAMP)){
-        throw RuntimeException("castTemporal from DATEHOUR to "+ Util::getDataTypeString(expectType)+" not supported ");
-    }
-    if(expectType == DT_DATEHOUR)
-        return getValue();
-
-    VectorSP res = Util::createVector(expectType, size_);
-    long long ratio = Util::getTemporalConversionRatio(DT_DATETIME, expectType);
-    if(expectType == DT_NANOTIMESTAMP ||  expectType  == DT_TIMESTAMP){
-        long long *pbuf = (long long*)res->getDataArray();
-        for(int i = 0; i < size_; i++){
-            data_[i] == INT_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = (long long)data_[i] * ratio * 3600;
-        }
-    }
-    else if(expectType == DT_DATETIME){
-        int *pbuf = (int*)res->getDataArray();
-        for(int i = 0; i < size_; i++){
-            data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = data_[i] * 3600;
-        }
-    }
-    else if(expectType == DT_DATE){
-        int *pbuf = (int*)res->getDataArray();
-        for(int i = 0; i < size_; i++){
-            data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] * 3600 / (-ratio));
-        }
-    }
-    else if(expectType == DT_MONTH){
-        int *pbuf = (int*)res->getDataArray();
-        for(int i = 0; i < size_; i++){
-            if(data_[i] == INT_MIN){
-                pbuf[i] = INT_MIN;
-                continue;
-            }
-            int year, month, day;
-            Util::parseDate(data_[i] * 3600 / 86400, year, month, day);
-            pbuf[i] = year*12+month-1;
-        }
-    }
-    else if(expectType == DT_NANOTIME){
-        long long *pbuf = (long long*)res->getDataArray();
-        for(int i = 0; i < size_; i++){
-            data_[i] == INT_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = (long long)data_[i] * 3600 % 86400 * 1000000000LL;
-        }
-    }
-    else{
-        ratio = Util::getTemporalConversionRatio(DT_SECOND, expectType);
-        int *pbuf = (int*)res->getDataArray();
-        if(ratio > 0){
-            for(int i = 0; i < size_; i++){
-                data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] * 3600 % 86400 * ratio);
-            }
-        }
-        else{
-            for(int i = 0; i < size_; i++){
-                data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] * 3600 % 86400 / (-ratio));
-            }
-        }
-    }
-    return res;
-}
-
 ConstantSP FastMonthVector::get(const ConstantSP& index) const {
 	if(index->isVector()){
 		return retrieve((Vector*)index.get());
@@ -1876,33 +1871,6 @@ void FastTimeVector::validate(){
 	}
 }
 
-ConstantSP FastTimeVector::castTemporal(DATA_TYPE expectType){
-	if(expectType < DT_DATE || expectType > DT_NANOTIMESTAMP){
-		throw RuntimeException("castTemporal from TIME to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType != DT_TIME && expectType != DT_NANOTIME && expectType != DT_SECOND && expectType != DT_MINUTE){
-		throw RuntimeException("castTemporal from TIME to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType == DT_TIME)
-		return getValue();
-
-	VectorSP res = Util::createVector(expectType, size_);
-	long long ratio = Util::getTemporalConversionRatio(DT_TIME, expectType);
-	if(expectType == DT_NANOTIME){
-		long long *pbuf = (long long*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == INT_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = (long long)data_[i] * ratio;
-		}
-	}
-	else{
-		int *pbuf = (int*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] / (-ratio));
-		}
-	}
-	return res;
-}
-
 ConstantSP FastMinuteVector::get(const ConstantSP& index) const {
 	if(index->isVector()){
 		return retrieve((Vector*)index.get());
@@ -1923,33 +1891,6 @@ void FastMinuteVector::validate(){
 	}
 }
 
-ConstantSP FastMinuteVector::castTemporal(DATA_TYPE expectType){
-	if(expectType < DT_DATE || expectType > DT_NANOTIMESTAMP){
-		throw RuntimeException("castTemporal from MINUTE to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType != DT_TIME && expectType != DT_NANOTIME && expectType != DT_SECOND && expectType != DT_MINUTE){
-		throw RuntimeException("castTemporal from MINUTE to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType == DT_MINUTE)
-		return getValue();
-
-	VectorSP res = Util::createVector(expectType, size_);
-	long long ratio = Util::getTemporalConversionRatio(DT_MINUTE, expectType);
-	if(expectType == DT_NANOTIME){
-		long long *pbuf = (long long*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == INT_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = (long long)data_[i] * ratio;
-		}
-	}
-	else{
-		int *pbuf = (int*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] * ratio);
-		}
-	}
-	return res;
-}
-
 ConstantSP FastSecondVector::get(const ConstantSP& index) const {
 	if(index->isVector()){
 		return retrieve((Vector*)index.get());
@@ -1970,39 +1911,6 @@ void FastSecondVector::validate(){
 	}
 }
 
-ConstantSP FastSecondVector::castTemporal(DATA_TYPE expectType){
-	if(expectType < DT_DATE || expectType > DT_NANOTIMESTAMP){
-		throw RuntimeException("castTemporal from SECOND to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType != DT_TIME && expectType != DT_NANOTIME && expectType != DT_SECOND && expectType != DT_MINUTE){
-		throw RuntimeException("castTemporal from SECOND to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType == DT_SECOND)
-		return getValue();
-
-	VectorSP res = Util::createVector(expectType, size_);
-	long long ratio = Util::getTemporalConversionRatio(DT_SECOND, expectType);
-	if(expectType == DT_NANOTIME){
-		long long *pbuf = (long long*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == INT_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = data_[i] * ratio;
-		}
-	}
-	else if(expectType == DT_TIME){
-		int *pbuf = (int*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] * ratio);
-		}
-	}
-	else{
-		int *pbuf = (int*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == INT_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] / (-ratio));
-		}
-	}
-	return res;
-}
-
 ConstantSP FastNanoTimeVector::get(const ConstantSP& index) const {
 	if(index->isVector()){
 		return retrieve((Vector*)index.get());
@@ -2023,26 +1931,6 @@ void FastNanoTimeVector::validate(){
 	}
 }
 
-ConstantSP FastNanoTimeVector::castTemporal(DATA_TYPE expectType){
-	if(expectType < DT_DATE || expectType > DT_NANOTIMESTAMP){
-		throw RuntimeException("castTemporal from NANOTIME to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType != DT_TIME && expectType != DT_NANOTIME && expectType != DT_SECOND && expectType != DT_MINUTE){
-		throw RuntimeException("castTemporal from NANOTIME to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType == DT_NANOTIME)
-		return getValue();
-
-	VectorSP res = Util::createVector(expectType, size_);
-	long long ratio = Util::getTemporalConversionRatio(DT_NANOTIME, expectType);
-
-	int *pbuf = (int*)res->getDataArray();
-	for(int i = 0; i < size_; i++){
-		data_[i] == LLONG_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] / (-ratio));
-	}
-	return res;
-}
-
 ConstantSP FastTimestampVector::get(const ConstantSP& index) const {
 	if(index->isVector()){
 		return retrieve((Vector*)index.get());
@@ -2053,68 +1941,6 @@ ConstantSP FastTimestampVector::get(const ConstantSP& index) const {
 	}
 }
 
-ConstantSP FastTimestampVector::castTemporal(DATA_TYPE expectType){
-	if(expectType != DT_DATEHOUR && (expectType < DT_DATE || expectType > DT_NANOTIMESTAMP)){
-		throw RuntimeException("castTemporal from TIMESTAMP to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType == DT_TIMESTAMP)
-		return getValue();
-
-	VectorSP res = Util::createVector(expectType, size_);
-	if(expectType == DT_DATEHOUR){
-        int *pbuf = (int*)res->getDataArray();
-        for(int i = 0; i < size_; i++){
-			int tail = (data_[i] < 0) && (data_[i] % 3600);
-            data_[i] == LLONG_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] / 3600000LL - tail);
-        }
-        return res;
-	}
-	long long ratio = Util::getTemporalConversionRatio(DT_TIMESTAMP, expectType);
-	if(expectType == DT_NANOTIMESTAMP){
-		long long *pbuf = (long long*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			data_[i] == LLONG_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = data_[i] * ratio;
-		}
-	}
-	else if(expectType == DT_DATE || expectType == DT_DATETIME){
-		int *pbuf = (int*)res->getDataArray();
-		ratio = -ratio;
-		for(int i = 0; i < size_; i++){
-			int tail = (data_[i] < 0) && (data_[i] % ratio);
-			data_[i] == LLONG_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] / ratio - tail);		
-		}
-	}
-	else if(expectType == DT_MONTH){
-		int *pbuf = (int*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			if(data_[i] == LLONG_MIN){
-				pbuf[i] = INT_MIN;
-				continue;
-			}
-			int year, month, day;
-			Util::parseDate(static_cast<int>(data_[i] / 86400000), year, month, day);
-			pbuf[i] = year*12+month-1;
-		}
-	}
-	else if(expectType == DT_NANOTIME){
-		long long *pbuf = (long long*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			int remainder = data_[i] % 86400000;
-			data_[i] == LLONG_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = (remainder + ((data_[i] < 0) && remainder) * 86400000) * 1000000ll;
-		}
-	}
-	else{
-		ratio = Util::getTemporalConversionRatio(DT_TIME, expectType);
-		int *pbuf = (int*)res->getDataArray();
-		if(ratio < 0) ratio = -ratio;
-		for(int i = 0; i < size_; i++){
-			int remainder = data_[i] % 86400000;
-			data_[i] == LLONG_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>((remainder + ((data_[i] < 0) && remainder) * 86400000) / ratio);
-		}
-	}
-	return res;
-}
-
 ConstantSP FastNanoTimestampVector::get(const ConstantSP& index) const {
 	if(index->isVector()){
 		return retrieve((Vector*)index.get());
@@ -2125,68 +1951,6 @@ ConstantSP FastNanoTimestampVector::get(const ConstantSP& index) const {
 	}
 }
 
-ConstantSP FastNanoTimestampVector::castTemporal(DATA_TYPE expectType){
-	if(expectType != DT_DATEHOUR && (expectType < DT_DATE || expectType > DT_NANOTIMESTAMP)){
-		throw RuntimeException("castTemporal from NANOTIMESTAMP to "+ Util::getDataTypeString(expectType)+" not supported ");
-	}
-	if(expectType == DT_NANOTIMESTAMP)
-		return getValue();
-
-	VectorSP res = Util::createVector(expectType, size_);
-	if(expectType == DT_DATEHOUR){
-        int *pbuf = (int*)res->getDataArray();
-        for(int i = 0; i < size_; i++){
-			int tail = (data_[i] < 0) && (data_[i] % 3600000000000ll);
-            data_[i] == LLONG_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] / 3600000000000ll - tail);
-        }
-        return res;
-	}
-	long long ratio = -Util::getTemporalConversionRatio(DT_NANOTIMESTAMP, expectType);
-	if(expectType == DT_TIMESTAMP){
-		long long *pbuf = (long long*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			int tail = (data_[i] < 0) && (data_[i] % ratio);
-			data_[i] == LLONG_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = data_[i] / ratio - tail;
-		}
-	}
-	else if(expectType == DT_DATE || expectType == DT_DATETIME){
-		int *pbuf = (int*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			int tail = (data_[i] < 0) && (data_[i] % ratio);
-			data_[i] == LLONG_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>(data_[i] / ratio - tail);
-		}
-	}
-	else if(expectType == DT_MONTH){
-		int *pbuf = (int*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			if(data_[i]  == LLONG_MIN){
-				pbuf[i] = INT_MIN;
-				continue;
-			}
-			int year, month, day;
-			Util::parseDate(static_cast<int>(data_[i] / 86400000000000ll), year, month, day);
-			pbuf[i] = year*12+month-1;
-		}
-	}
-	else if(expectType == DT_NANOTIME){
-		long long *pbuf = (long long*)res->getDataArray();
-		for(int i = 0; i < size_; i++){
-			long long remainder = data_[i] % 86400000000000ll;
-			data_[i] == LLONG_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = (remainder + (data_[i] < 0 && remainder) * 86400000000000ll);
-		}
-	}
-	else{
-		ratio = Util::getTemporalConversionRatio(DT_NANOTIME, expectType);
-		int *pbuf = (int*)res->getDataArray();
-		ratio = -ratio;
-		for(int i = 0; i < size_; i++){
-			long long remainder = data_[i] % 86400000000000ll;
-			data_[i] == LLONG_MIN ? pbuf[i] = INT_MIN : pbuf[i] = static_cast<int>((remainder + (data_[i] < 0 && remainder) * 86400000000000ll) / ratio);
-		}
-	}
-	return res;
-}
-
 ConstantSP FastArrayVector::castTemporal(DATA_TYPE expectType){
 	if(expectType < ARRAY_TYPE_BASE){
 		throw RuntimeException("castTemporal from "+ Util::getDataTypeString(dataType_) + " to " + Util::getDataTypeString(expectType) + " not supported.");
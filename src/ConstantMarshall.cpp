@@ -161,6 +161,15 @@ bool VectorMarshall::writeMetaValues(BufferWriter<DataOutputStreamSP> &output, c
 				++nextStart_;
 		}
 	}
+	else if (vec->isFastMode() && vec->getDataArray() != NULL && vec->getType() != DT_SYMBOL && vec->getType() != DT_VOID) {
+		//Contiguous fixed-width values, such as a vector over an external buffer, are written
+		//straight from the vector rather than copied through buf_ first.
+		if (ret == OK && nextStart_ < size) {
+			int unitLength = vec->getUnitLength();
+			ret = output.start((const char*)vec->getDataArray() + (size_t)nextStart_ * unitLength, (size_t)(size - nextStart_) * unitLength);
+			nextStart_ = size;
+		}
+	}
 	else {
 		while (ret == OK && nextStart_ < size) {
 			actualSize = vec->serialize(buf_, MARSHALL_BUFFER_SIZE, nextStart_, partial_, numElement, partial_);
@@ -635,21 +644,53 @@ bool SymbolBaseUnmarshall::start(bool blocking, IO_ERR& ret){
 		ret = INVALIDDATA;
 		return false;
 	}
-	SymbolBaseSP cache = new SymbolBase(symbaseId_, in_, ret);
-	if(ret != OK)	return false;
-	if(dict_.find(symbaseId_) != dict_.end() && cache->size() == 0){
-		obj_ = dict_[symbaseId_];
+	if((ret = in_->readInt(size_)) != OK)
+		return false;
+	else if(size_ < 0){
+		ret = INVALIDDATA;
+		return false;
+	}
+	//Every result gets a copy of the cached base, since symbol vectors insert into their base.
+	SymbolBaseSP cached = cache_->get(symbaseId_);
+	//An empty body refers to a base sent earlier under the same id.
+	if(!cached.isNull() && size_ == 0){
+		obj_ = new SymbolBase(*cached);
+		cache_->recordHit();
+		return true;
+	}
+	//Resending the same symbols under the same id also hits.
+	bool same = !cached.isNull() && cached->size() == (std::size_t)size_;
+	std::vector<std::string> syms;
+	std::string symbol;
+	for(int i = 0; i < size_; ++i){
+		if((ret = in_->readString(symbol)) != OK)
+			return false;
+		if(same && symbol == cached->getSymbol(i))
+			continue;
+		if(same){
+			same = false;
+			syms.reserve(size_);
+			for(int j = 0; j < i; ++j)
+				syms.push_back(cached->getSymbol(j));
+		}
+		syms.push_back(symbol);
+	}
+	if(same){
+		obj_ = new SymbolBase(*cached);
+		cache_->recordHit();
 	}
 	else{
-		obj_ = cache;
-		dict_[symbaseId_] = obj_;
+		cache_->put(symbaseId_, new SymbolBase(symbaseId_, std::vector<std::string>(syms)));
+		obj_ = new SymbolBase(symbaseId_, std::move(syms));
+		cache_->recordMiss();
 	}
-	return ret == OK;
+	return true;
 }
 
 void SymbolBaseUnmarshall::reset(){
 	obj_.clear();
-	dict_.clear();
+	if(ownCache_)
+		cache_->clear();
 }
 
 void VectorUnmarshall::resetSymbolBaseUnmarshall(DataInputStreamSP in, bool createIfNotExist){
@@ -657,10 +698,15 @@ void VectorUnmarshall::resetSymbolBaseUnmarshall(DataInputStreamSP in, bool crea
 		symbaseUnmarshall_->reset();
 	}
 	else if(createIfNotExist){
-		symbaseUnmarshall_ = new SymbolBaseUnmarshall(in);
+		symbaseUnmarshall_ = new SymbolBaseUnmarshall(in, symbaseCache_);
 	}
 }
 
+void VectorUnmarshall::setSymbolBaseCache(const SymbolBaseCacheSP& cache){
+	symbaseCache_ = cache;
+	symbaseUnmarshall_.clear();
+}
+
 bool VectorUnmarshall::start(short flag, bool blocking, IO_ERR& ret){
 	flag_ = flag;
 	DATA_FORM form;
@@ -722,11 +768,16 @@ bool VectorUnmarshall::start(short flag, bool blocking, IO_ERR& ret){
 	}
 
 	//If above part modified, remember to modify Compress.writeVectorMetaValue function
+	bool arena = false;
 	if(form == DF_PAIR)
 		obj_ = Util::createPair(actualType, scale_);
 	else if(form == DF_VECTOR){
 		if (actualType == 128 + DT_SYMBOL)
 			obj_ = Util::createSymbolVector(sym, rows_);
+		else if (actualType == DT_STRING || actualType == DT_BLOB) {
+			obj_ = Util::createArenaStringVector(actualType, rows_);
+			arena = true;
+		}
 		else if (actualType <= 64)
 			obj_ = Util::createVector(actualType, rows_, rows_, true, scale_);
 		else {
@@ -781,7 +832,8 @@ bool VectorUnmarshall::start(short flag, bool blocking, IO_ERR& ret){
 		nextStart_ = numElements;
 #else
 		INDEX numElements = 0;
-		INDEX leftSize = obj_->size() - nextStart_;
+		//Arena string vectors start empty and grow as they are decoded.
+		INDEX leftSize = (arena ? rows_ : obj_->size()) - nextStart_;
 		while(leftSize > 0){
 			ret = obj_->deserialize(input.get(), nextStart_, std::min(leftSize, 8192), numElements);
 			if(ret != OK)
@@ -1102,14 +1154,24 @@ ConstantMarshallFactory::~ConstantMarshallFactory(){
 	delete arrMarshall[DF_CHUNK];
 }
 
-ConstantUnmarshallFactory::ConstantUnmarshallFactory(const DataInputStreamSP& in){
+ConstantUnmarshallFactory::ConstantUnmarshallFactory(const DataInputStreamSP& in, const SymbolBaseCacheSP& symbolBaseCache){
+	VectorUnmarshall* vector = new VectorUnmarshall(in);
+	VectorUnmarshall* pair = new VectorUnmarshall(in);
+	MatrixUnmarshall* matrix = new MatrixUnmarshall(in);
+	TableUnmarshall* table = new TableUnmarshall(in);
+	if(!symbolBaseCache.isNull()){
+		vector->setSymbolBaseCache(symbolBaseCache);
+		pair->setSymbolBaseCache(symbolBaseCache);
+		matrix->setSymbolBaseCache(symbolBaseCache);
+		table->setSymbolBaseCache(symbolBaseCache);
+	}
 	arrUnmarshall[DF_SCALAR] = new ScalarUnmarshall(in);
-	arrUnmarshall[DF_VECTOR] = new VectorUnmarshall(in);
-	arrUnmarshall[DF_PAIR] = new VectorUnmarshall(in);
-	arrUnmarshall[DF_MATRIX] = new MatrixUnmarshall(in);
+	arrUnmarshall[DF_VECTOR] = vector;
+	arrUnmarshall[DF_PAIR] = pair;
+	arrUnmarshall[DF_MATRIX] = matrix;
 	arrUnmarshall[DF_SET] = new SetUnmarshall(in);
 	arrUnmarshall[DF_DICTIONARY] = new DictionaryUnmarshall(in);
-	arrUnmarshall[DF_TABLE] = new TableUnmarshall(in);
+	arrUnmarshall[DF_TABLE] = table;
 	arrUnmarshall[DF_CHART] = new DictionaryUnmarshall(in);
 	arrUnmarshall[DF_CHUNK] = new ChunkUnmarshall(in);
 }
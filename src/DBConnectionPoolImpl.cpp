@@ -5,8 +5,8 @@
 namespace dolphindb {
 
 DBConnectionPoolImpl::DBConnectionPoolImpl(const std::string& hostName, int port, int threadNum, const std::string& userId, const std::string& password,
-    bool loadBalance, bool highAvailability, bool compress,bool reConnect, bool python) :shutDownFlag_(
-        false), queue_(new SynchronizedQueue<Task>){
+    bool loadBalance, bool highAvailability, bool compress,bool reConnect, bool python) :hostName_(hostName), port_(port),
+        shutDownFlag_(false), queue_(new SynchronizedQueue<Task>){
     latch_ = new CountDownLatch(threadNum);
     if(!loadBalance){
         for(int i = 0 ;i < threadNum; i++){
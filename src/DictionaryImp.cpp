@@ -275,12 +275,12 @@ ConstantSP AbstractDictionary::createValues(const ConstantSP& key) const{
 		return Util::createVector(type_,key->size());
 }
 
-IntDictionary::IntDictionary(const unordered_map<int,U8>& dict, DATA_TYPE keyType,DATA_TYPE type)
+IntDictionary::IntDictionary(const FlatHashMap<int,U8>& dict, DATA_TYPE keyType,DATA_TYPE type)
 	:AbstractDictionary(keyType,type),dict_(dict){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<int,U8>::iterator it=dict_.begin();
-	unordered_map<int,U8>::iterator end=dict_.end();
+	FlatHashMap<int,U8>::iterator it=dict_.begin();
+	FlatHashMap<int,U8>::iterator end=dict_.end();
 	size_t len;
 	char* tmp;
 	while(it!=end){
@@ -295,8 +295,8 @@ IntDictionary::IntDictionary(const unordered_map<int,U8>& dict, DATA_TYPE keyTyp
 IntDictionary::~IntDictionary(){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<int,U8>::const_iterator it=dict_.begin();
-	unordered_map<int,U8>::const_iterator end=dict_.end();
+	FlatHashMap<int,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<int,U8>::const_iterator end=dict_.end();
 	while(it!=end){
 		delete[] it->second.pointer;
 		++it;
@@ -384,7 +384,7 @@ ConstantSP IntDictionary::getMember(const ConstantSP& key) const{
 
 	ConstantSP result=createValues(newKey);
 	if(newKey->isScalar()){
-		unordered_map<int,U8>::const_iterator it=dict_.find(newKey->getInt());
+		FlatHashMap<int,U8>::const_iterator it=dict_.find(newKey->getInt());
 		if(it==dict_.end())
 			(*swriter_)(nullVal_,result);
 		else
@@ -398,15 +398,13 @@ ConstantSP IntDictionary::getMember(const ConstantSP& key) const{
 		U8 value[bufSize];
 		int start=0;
 		int counts;
-		unordered_map<int,U8>::const_iterator it;
-		unordered_map<int,U8>::const_iterator end=dict_.end();
+		const std::pair<int,U8>* found[bufSize];
 		while(start<len){
 			counts=((std::min))(len-start,bufSize);
 			pbuf=newKey->getIntConst(start,counts,buf);
-			for(int i=0;i<counts;++i){
-				it=dict_.find(pbuf[i]);
-				value[i]=it==end?nullVal_:it->second;
-			}
+			dict_.findBatch(pbuf,counts,found);
+			for(int i=0;i<counts;++i)
+				value[i]=found[i]==nullptr?nullVal_:found[i]->second;
 			(*vwriter_)(value,result,start,counts);
 			start+=counts;
 		}
@@ -429,14 +427,14 @@ void IntDictionary::contain(const ConstantSP& target, const ConstantSP& resultSP
 		int start=0;
 		int counts;
 
-		unordered_map<int,U8>::const_iterator it;
-		unordered_map<int,U8>::const_iterator end=dict_.end();
+		const std::pair<int,U8>* found[bufSize];
 		while(start<len){
 			counts=((std::min))(len-start,bufSize);
 			pbuf=target->getIntConst(start,counts,buf);
 			pret=resultSP->getBoolBuffer(start,counts,ret);
+			dict_.findBatch(pbuf,counts,found);
 			for(int i=0;i<counts;++i)
-				pret[i]=dict_.find(pbuf[i])!=end;
+				pret[i]=found[i]!=nullptr;
 			resultSP->setBool(start,counts,pret);
 			start+=counts;
 		}
@@ -444,7 +442,7 @@ void IntDictionary::contain(const ConstantSP& target, const ConstantSP& resultSP
 }
 
 ConstantSP IntDictionary::keys() const {
-	unordered_map<int,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<int,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP=Util::createVector(keyType_,len);
 	int start=0;
@@ -467,7 +465,7 @@ ConstantSP IntDictionary::keys() const {
 }
 
 ConstantSP IntDictionary::values() const {
-	unordered_map<int,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<int,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP= Util::createVector(type_,len);
 
@@ -492,7 +490,7 @@ string IntDictionary::getString() const {
 	string content;
 	int len=((std::min))(Util::DISPLAY_ROWS,(int)dict_.size());
 	int counts=0;
-	unordered_map<int,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<int,U8>::const_iterator it=dict_.begin();
 	ConstantSP key=Util::createConstant(keyType_);
 	ConstantSP value=Util::createConstant(type_);
 	while(counts<len){
@@ -511,10 +509,10 @@ string IntDictionary::getString() const {
 }
 
 long long IntDictionary::getAllocatedMemory() const {
-	long long bytes=sizeof(IntDictionary)+size()*12;
+	long long bytes=sizeof(IntDictionary)+dict_.getAllocatedMemory();
 	if(getType()==DT_STRING){
-		unordered_map<int,U8>::const_iterator it=dict_.begin();
-		unordered_map<int,U8>::const_iterator end=dict_.end();
+		FlatHashMap<int,U8>::const_iterator it=dict_.begin();
+		FlatHashMap<int,U8>::const_iterator end=dict_.end();
 		while(it!=end){
 			bytes += strlen(it->second.pointer);
 			++it;
@@ -523,12 +521,12 @@ long long IntDictionary::getAllocatedMemory() const {
 	return bytes;
 }
 
-CharDictionary::CharDictionary(const unordered_map<char,U8>& dict, DATA_TYPE keyType,DATA_TYPE type)
+CharDictionary::CharDictionary(const FlatHashMap<char,U8>& dict, DATA_TYPE keyType,DATA_TYPE type)
 	:AbstractDictionary(keyType,type),dict_(dict){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<char,U8>::iterator it=dict_.begin();
-	unordered_map<char,U8>::iterator end=dict_.end();
+	FlatHashMap<char,U8>::iterator it=dict_.begin();
+	FlatHashMap<char,U8>::iterator end=dict_.end();
 	size_t len;
 	char* tmp;
 	while(it!=end){
@@ -543,8 +541,8 @@ CharDictionary::CharDictionary(const unordered_map<char,U8>& dict, DATA_TYPE key
 CharDictionary::~CharDictionary(){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<char,U8>::const_iterator it=dict_.begin();
-	unordered_map<char,U8>::const_iterator end=dict_.end();
+	FlatHashMap<char,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<char,U8>::const_iterator end=dict_.end();
 	while(it!=end){
 		delete[] it->second.pointer;
 		++it;
@@ -620,7 +618,7 @@ bool CharDictionary::set(const ConstantSP& key, const ConstantSP& value){
 ConstantSP CharDictionary::getMember(const ConstantSP& key) const {
 	ConstantSP result=createValues(key);
 	if(key->isScalar()){
-		unordered_map<char,U8>::const_iterator it=dict_.find(key->getChar());
+		FlatHashMap<char,U8>::const_iterator it=dict_.find(key->getChar());
 		if(it==dict_.end())
 			(*swriter_)(nullVal_,result);
 		else
@@ -634,8 +632,8 @@ ConstantSP CharDictionary::getMember(const ConstantSP& key) const {
 		U8 value[bufSize];
 		int start=0;
 		int counts;
-		unordered_map<char,U8>::const_iterator it;
-		unordered_map<char,U8>::const_iterator end=dict_.end();
+		FlatHashMap<char,U8>::const_iterator it;
+		FlatHashMap<char,U8>::const_iterator end=dict_.end();
 		while(start<len){
 			counts=((std::min))(len-start,bufSize);
 			pbuf=key->getCharConst(start,counts,buf);
@@ -665,8 +663,8 @@ void CharDictionary::contain(const ConstantSP& target, const ConstantSP& resultS
 		int start=0;
 		int counts;
 
-		unordered_map<char,U8>::const_iterator it;
-		unordered_map<char,U8>::const_iterator end=dict_.end();
+		FlatHashMap<char,U8>::const_iterator it;
+		FlatHashMap<char,U8>::const_iterator end=dict_.end();
 		while(start<len){
 			counts=((std::min))(len-start,bufSize);
 			pbuf=target->getCharConst(start,counts,buf);
@@ -680,7 +678,7 @@ void CharDictionary::contain(const ConstantSP& target, const ConstantSP& resultS
 }
 
 ConstantSP CharDictionary::keys() const {
-	unordered_map<char,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<char,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP=Util::createVector(keyType_,len);
 	int start=0;
@@ -703,7 +701,7 @@ ConstantSP CharDictionary::keys() const {
 }
 
 ConstantSP CharDictionary::values() const {
-	unordered_map<char,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<char,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP= Util::createVector(type_,len);
 
@@ -728,7 +726,7 @@ string CharDictionary::getString() const{
 	string content;
 	int len=((std::min))(Util::DISPLAY_ROWS,(int)dict_.size());
 	int counts=0;
-	unordered_map<char,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<char,U8>::const_iterator it=dict_.begin();
 	ConstantSP key=Util::createConstant(keyType_);
 	ConstantSP value=Util::createConstant(type_);
 	while(counts<len){
@@ -747,10 +745,10 @@ string CharDictionary::getString() const{
 }
 
 long long CharDictionary::getAllocatedMemory() const {
-	long long bytes=sizeof(CharDictionary)+size()*9;
+	long long bytes=sizeof(CharDictionary)+dict_.getAllocatedMemory();
 	if(getType()==DT_STRING){
-		unordered_map<char,U8>::const_iterator it=dict_.begin();
-		unordered_map<char,U8>::const_iterator end=dict_.end();
+		FlatHashMap<char,U8>::const_iterator it=dict_.begin();
+		FlatHashMap<char,U8>::const_iterator end=dict_.end();
 		while(it!=end){
 			bytes += strlen(it->second.pointer);
 			++it;
@@ -759,12 +757,12 @@ long long CharDictionary::getAllocatedMemory() const {
 	return bytes;
 }
 
-ShortDictionary::ShortDictionary(const unordered_map<short,U8>& dict, DATA_TYPE keyType, DATA_TYPE type)
+ShortDictionary::ShortDictionary(const FlatHashMap<short,U8>& dict, DATA_TYPE keyType, DATA_TYPE type)
 	:AbstractDictionary(keyType,type),dict_(dict){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<short,U8>::iterator it=dict_.begin();
-	unordered_map<short,U8>::iterator end=dict_.end();
+	FlatHashMap<short,U8>::iterator it=dict_.begin();
+	FlatHashMap<short,U8>::iterator end=dict_.end();
 	size_t len;
 	char* tmp;
 	while(it!=end){
@@ -779,8 +777,8 @@ ShortDictionary::ShortDictionary(const unordered_map<short,U8>& dict, DATA_TYPE
 ShortDictionary::~ShortDictionary(){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<short,U8>::const_iterator it=dict_.begin();
-	unordered_map<short,U8>::const_iterator end=dict_.end();
+	FlatHashMap<short,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<short,U8>::const_iterator end=dict_.end();
 	while(it!=end){
 		delete[] it->second.pointer;
 		++it;
@@ -856,7 +854,7 @@ bool ShortDictionary::set(const ConstantSP& key, const ConstantSP& value){
 ConstantSP ShortDictionary::getMember(const ConstantSP& key) const {
 	ConstantSP result=createValues(key);
 	if(key->isScalar()){
-		unordered_map<short,U8>::const_iterator it=dict_.find(key->getShort());
+		FlatHashMap<short,U8>::const_iterator it=dict_.find(key->getShort());
 		if(it==dict_.end())
 			(*swriter_)(nullVal_,result);
 		else
@@ -870,8 +868,8 @@ ConstantSP ShortDictionary::getMember(const ConstantSP& key) const {
 		U8 value[bufSize];
 		int start=0;
 		int counts;
-		unordered_map<short,U8>::const_iterator it;
-		unordered_map<short,U8>::const_iterator end=dict_.end();
+		FlatHashMap<short,U8>::const_iterator it;
+		FlatHashMap<short,U8>::const_iterator end=dict_.end();
 		while(start<len){
 			counts=((std::min))(len-start,bufSize);
 			pbuf=key->getShortConst(start,counts,buf);
@@ -901,8 +899,8 @@ void ShortDictionary::contain(const ConstantSP& target, const ConstantSP& result
 		int start=0;
 		int counts;
 
-		unordered_map<short,U8>::const_iterator it;
-		unordered_map<short,U8>::const_iterator end=dict_.end();
+		FlatHashMap<short,U8>::const_iterator it;
+		FlatHashMap<short,U8>::const_iterator end=dict_.end();
 		while(start<len){
 			counts=((std::min))(len-start,bufSize);
 			pbuf=target->getShortConst(start,counts,buf);
@@ -916,7 +914,7 @@ void ShortDictionary::contain(const ConstantSP& target, const ConstantSP& result
 }
 
 ConstantSP ShortDictionary::keys() const {
-	unordered_map<short,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<short,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP=Util::createVector(keyType_,len);
 	int start=0;
@@ -939,7 +937,7 @@ ConstantSP ShortDictionary::keys() const {
 }
 
 ConstantSP ShortDictionary::values() const {
-	unordered_map<short,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<short,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP= Util::createVector(type_,len);
 
@@ -964,7 +962,7 @@ string ShortDictionary::getString() const{
 	string content;
 	int len=(std::min)(Util::DISPLAY_ROWS,(int)dict_.size());
 	int counts=0;
-	unordered_map<short,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<short,U8>::const_iterator it=dict_.begin();
 	ConstantSP key=Util::createConstant(keyType_);
 	ConstantSP value=Util::createConstant(type_);
 	while(counts<len){
@@ -983,10 +981,10 @@ string ShortDictionary::getString() const{
 }
 
 long long ShortDictionary::getAllocatedMemory() const {
-	long long bytes=sizeof(ShortDictionary)+size()*10;
+	long long bytes=sizeof(ShortDictionary)+dict_.getAllocatedMemory();
 	if(getType()==DT_STRING){
-		unordered_map<short,U8>::const_iterator it=dict_.begin();
-		unordered_map<short,U8>::const_iterator end=dict_.end();
+		FlatHashMap<short,U8>::const_iterator it=dict_.begin();
+		FlatHashMap<short,U8>::const_iterator end=dict_.end();
 		while(it!=end){
 			bytes += strlen(it->second.pointer);
 			++it;
@@ -995,12 +993,12 @@ long long ShortDictionary::getAllocatedMemory() const {
 	return bytes;
 }
 
-LongDictionary::LongDictionary(const unordered_map<long long,U8>& dict, DATA_TYPE keyType, DATA_TYPE type)
+LongDictionary::LongDictionary(const FlatHashMap<long long,U8>& dict, DATA_TYPE keyType, DATA_TYPE type)
 	:AbstractDictionary(keyType,type),dict_(dict){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<long long,U8>::iterator it=dict_.begin();
-	unordered_map<long long,U8>::iterator end=dict_.end();
+	FlatHashMap<long long,U8>::iterator it=dict_.begin();
+	FlatHashMap<long long,U8>::iterator end=dict_.end();
 	size_t len;
 	char* tmp;
 	while(it!=end){
@@ -1015,8 +1013,8 @@ LongDictionary::LongDictionary(const unordered_map<long long,U8>& dict, DATA_TYP
 LongDictionary::~LongDictionary(){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<long long,U8>::const_iterator it=dict_.begin();
-	unordered_map<long long,U8>::const_iterator end=dict_.end();
+	FlatHashMap<long long,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<long long,U8>::const_iterator end=dict_.end();
 	while(it!=end){
 		delete[] it->second.pointer;
 		++it;
@@ -1104,7 +1102,7 @@ ConstantSP LongDictionary::getMember(const ConstantSP& key) const {
 
 	ConstantSP result=createValues(newKey);
 	if(newKey->isScalar()){
-		unordered_map<long long,U8>::const_iterator it=dict_.find(newKey->getLong());
+		FlatHashMap<long long,U8>::const_iterator it=dict_.find(newKey->getLong());
 		if(it==dict_.end())
 			(*swriter_)(nullVal_,result);
 		else
@@ -1118,15 +1116,13 @@ ConstantSP LongDictionary::getMember(const ConstantSP& key) const {
 		U8 value[bufSize];
 		int start=0;
 		int counts;
-		unordered_map<long long,U8>::const_iterator it;
-		unordered_map<long long,U8>::const_iterator end=dict_.end();
+		const std::pair<long long,U8>* found[bufSize];
 		while(start<len){
 			counts=(std::min)(len-start,bufSize);
 			pbuf=newKey->getLongConst(start,counts,buf);
-			for(int i=0;i<counts;++i){
-				it=dict_.find(pbuf[i]);
-				value[i]=it==end?nullVal_:it->second;
-			}
+			dict_.findBatch(pbuf,counts,found);
+			for(int i=0;i<counts;++i)
+				value[i]=found[i]==nullptr?nullVal_:found[i]->second;
 			(*vwriter_)(value,result,start,counts);
 			start+=counts;
 		}
@@ -1149,14 +1145,14 @@ void LongDictionary::contain(const ConstantSP& target, const ConstantSP& resultS
 		int start=0;
 		int counts;
 
-		unordered_map<long long,U8>::const_iterator it;
-		unordered_map<long long,U8>::const_iterator end=dict_.end();
+		const std::pair<long long,U8>* found[bufSize];
 		while(start<len){
 			counts=(std::min)(len-start,bufSize);
 			pbuf=target->getLongConst(start,counts,buf);
 			pret=resultSP->getBoolBuffer(start,counts,ret);
+			dict_.findBatch(pbuf,counts,found);
 			for(int i=0;i<counts;++i)
-				pret[i]=dict_.find(pbuf[i])!=end;
+				pret[i]=found[i]!=nullptr;
 			resultSP->setBool(start,counts,pret);
 			start+=counts;
 		}
@@ -1164,7 +1160,7 @@ void LongDictionary::contain(const ConstantSP& target, const ConstantSP& resultS
 }
 
 ConstantSP LongDictionary::keys() const {
-	unordered_map<long long,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<long long,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP=Util::createVector(keyType_,len);
 	int start=0;
@@ -1187,7 +1183,7 @@ ConstantSP LongDictionary::keys() const {
 }
 
 ConstantSP LongDictionary::values() const {
-	unordered_map<long long,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<long long,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP= Util::createVector(type_,len);
 
@@ -1212,7 +1208,7 @@ string LongDictionary::getString() const {
 	string content;
 	int len=(std::min)(Util::DISPLAY_ROWS,(int)dict_.size());
 	int counts=0;
-	unordered_map<long long,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<long long,U8>::const_iterator it=dict_.begin();
 	ConstantSP key=Util::createConstant(keyType_);
 	ConstantSP value=Util::createConstant(type_);
 	while(counts<len){
@@ -1231,10 +1227,10 @@ string LongDictionary::getString() const {
 }
 
 long long LongDictionary::getAllocatedMemory() const {
-	long long bytes=sizeof(LongDictionary)+size()*16;
+	long long bytes=sizeof(LongDictionary)+dict_.getAllocatedMemory();
 	if(getType()==DT_STRING){
-		unordered_map<long long,U8>::const_iterator it=dict_.begin();
-		unordered_map<long long,U8>::const_iterator end=dict_.end();
+		FlatHashMap<long long,U8>::const_iterator it=dict_.begin();
+		FlatHashMap<long long,U8>::const_iterator end=dict_.end();
 		while(it!=end){
 			bytes += strlen(it->second.pointer);
 			++it;
@@ -1243,12 +1239,12 @@ long long LongDictionary::getAllocatedMemory() const {
 	return bytes;
 }
 
-FloatDictionary::FloatDictionary(const unordered_map<float,U8>& dict, DATA_TYPE type)
+FloatDictionary::FloatDictionary(const FlatHashMap<float,U8>& dict, DATA_TYPE type)
 	:AbstractDictionary(DT_FLOAT,type),dict_(dict){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<float,U8>::iterator it=dict_.begin();
-	unordered_map<float,U8>::iterator end=dict_.end();
+	FlatHashMap<float,U8>::iterator it=dict_.begin();
+	FlatHashMap<float,U8>::iterator end=dict_.end();
 	size_t len;
 	char* tmp;
 	while(it!=end){
@@ -1263,8 +1259,8 @@ FloatDictionary::FloatDictionary(const unordered_map<float,U8>& dict, DATA_TYPE
 FloatDictionary::~FloatDictionary(){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<float,U8>::const_iterator it=dict_.begin();
-	unordered_map<float,U8>::const_iterator end=dict_.end();
+	FlatHashMap<float,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<float,U8>::const_iterator end=dict_.end();
 	while(it!=end){
 		delete[] it->second.pointer;
 		++it;
@@ -1340,7 +1336,7 @@ bool FloatDictionary::set(const ConstantSP& key, const ConstantSP& value){
 ConstantSP FloatDictionary::getMember(const ConstantSP& key) const {
 	ConstantSP result=createValues(key);
 	if(key->isScalar()){
-		unordered_map<float,U8>::const_iterator it=dict_.find(key->getFloat());
+		FlatHashMap<float,U8>::const_iterator it=dict_.find(key->getFloat());
 		if(it==dict_.end())
 			(*swriter_)(nullVal_,result);
 		else
@@ -1354,8 +1350,8 @@ ConstantSP FloatDictionary::getMember(const ConstantSP& key) const {
 		U8 value[bufSize];
 		int start=0;
 		int counts;
-		unordered_map<float,U8>::const_iterator it;
-		unordered_map<float,U8>::const_iterator end=dict_.end();
+		FlatHashMap<float,U8>::const_iterator it;
+		FlatHashMap<float,U8>::const_iterator end=dict_.end();
 		while(start<len){
 			counts=(std::min)(len-start,bufSize);
 			pbuf=key->getFloatConst(start,counts,buf);
@@ -1385,8 +1381,8 @@ void FloatDictionary::contain(const ConstantSP& target, const ConstantSP& result
 		int start=0;
 		int counts;
 
-		unordered_map<float,U8>::const_iterator it;
-		unordered_map<float,U8>::const_iterator end=dict_.end();
+		FlatHashMap<float,U8>::const_iterator it;
+		FlatHashMap<float,U8>::const_iterator end=dict_.end();
 		while(start<len){
 			counts=(std::min)(len-start,bufSize);
 			pbuf=target->getFloatConst(start,counts,buf);
@@ -1400,7 +1396,7 @@ void FloatDictionary::contain(const ConstantSP& target, const ConstantSP& result
 }
 
 ConstantSP FloatDictionary::keys() const {
-	unordered_map<float,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<float,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP=Util::createVector(keyType_,len);
 	int start=0;
@@ -1423,7 +1419,7 @@ ConstantSP FloatDictionary::keys() const {
 }
 
 ConstantSP FloatDictionary::values() const {
-	unordered_map<float,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<float,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP= Util::createVector(type_,len);
 
@@ -1448,7 +1444,7 @@ string FloatDictionary::getString() const {
 	string content;
 	int len=(std::min)(Util::DISPLAY_ROWS,(int)dict_.size());
 	int counts=0;
-	unordered_map<float,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<float,U8>::const_iterator it=dict_.begin();
 	ConstantSP key=Util::createConstant(keyType_);
 	ConstantSP value=Util::createConstant(type_);
 	while(counts<len){
@@ -1467,10 +1463,10 @@ string FloatDictionary::getString() const {
 }
 
 long long FloatDictionary::getAllocatedMemory() const {
-	long long bytes=sizeof(FloatDictionary)+size()*12;
+	long long bytes=sizeof(FloatDictionary)+dict_.getAllocatedMemory();
 	if(getType()==DT_STRING){
-		unordered_map<float,U8>::const_iterator it=dict_.begin();
-		unordered_map<float,U8>::const_iterator end=dict_.end();
+		FlatHashMap<float,U8>::const_iterator it=dict_.begin();
+		FlatHashMap<float,U8>::const_iterator end=dict_.end();
 		while(it!=end){
 			bytes += strlen(it->second.pointer);
 			++it;
@@ -1479,12 +1475,12 @@ long long FloatDictionary::getAllocatedMemory() const {
 	return bytes;
 }
 
-DoubleDictionary::DoubleDictionary(const unordered_map<double,U8>& dict, DATA_TYPE type)
+DoubleDictionary::DoubleDictionary(const FlatHashMap<double,U8>& dict, DATA_TYPE type)
 	:AbstractDictionary(DT_DOUBLE,type),dict_(dict){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<double,U8>::iterator it=dict_.begin();
-	unordered_map<double,U8>::iterator end=dict_.end();
+	FlatHashMap<double,U8>::iterator it=dict_.begin();
+	FlatHashMap<double,U8>::iterator end=dict_.end();
 	size_t len;
 	char* tmp;
 	while(it!=end){
@@ -1499,8 +1495,8 @@ DoubleDictionary::DoubleDictionary(const unordered_map<double,U8>& dict, DATA_TY
 DoubleDictionary::~DoubleDictionary(){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<double,U8>::const_iterator it=dict_.begin();
-	unordered_map<double,U8>::const_iterator end=dict_.end();
+	FlatHashMap<double,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<double,U8>::const_iterator end=dict_.end();
 	while(it!=end){
 		delete[] it->second.pointer;
 		++it;
@@ -1576,7 +1572,7 @@ bool DoubleDictionary::set(const ConstantSP& key, const ConstantSP& value){
 ConstantSP DoubleDictionary::getMember(const ConstantSP& key) const {
 	ConstantSP result=createValues(key);
 	if(key->isScalar()){
-		unordered_map<double,U8>::const_iterator it=dict_.find(key->getDouble());
+		FlatHashMap<double,U8>::const_iterator it=dict_.find(key->getDouble());
 		if(it==dict_.end())
 			(*swriter_)(nullVal_,result);
 		else
@@ -1590,8 +1586,8 @@ ConstantSP DoubleDictionary::getMember(const ConstantSP& key) const {
 		U8 value[bufSize];
 		int start=0;
 		int counts;
-		unordered_map<double,U8>::const_iterator it;
-		unordered_map<double,U8>::const_iterator end=dict_.end();
+		FlatHashMap<double,U8>::const_iterator it;
+		FlatHashMap<double,U8>::const_iterator end=dict_.end();
 		while(start<len){
 			counts=(std::min)(len-start,bufSize);
 			pbuf=key->getDoubleConst(start,counts,buf);
@@ -1621,8 +1617,8 @@ void DoubleDictionary::contain(const ConstantSP& target, const ConstantSP& resul
 		int start=0;
 		int counts;
 
-		unordered_map<double,U8>::const_iterator it;
-		unordered_map<double,U8>::const_iterator end=dict_.end();
+		FlatHashMap<double,U8>::const_iterator it;
+		FlatHashMap<double,U8>::const_iterator end=dict_.end();
 		while(start<len){
 			counts=(std::min)(len-start,bufSize);
 			pbuf=target->getDoubleConst(start,counts,buf);
@@ -1636,7 +1632,7 @@ void DoubleDictionary::contain(const ConstantSP& target, const ConstantSP& resul
 }
 
 ConstantSP DoubleDictionary::keys() const {
-	unordered_map<double,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<double,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP=Util::createVector(keyType_,len);
 	int start=0;
@@ -1659,7 +1655,7 @@ ConstantSP DoubleDictionary::keys() const {
 }
 
 ConstantSP DoubleDictionary::values() const {
-	unordered_map<double,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<double,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP= Util::createVector(type_,len);
 
@@ -1684,7 +1680,7 @@ string DoubleDictionary::getString() const {
 	string content;
 	int len=(std::min)(Util::DISPLAY_ROWS,(int)dict_.size());
 	int counts=0;
-	unordered_map<double,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<double,U8>::const_iterator it=dict_.begin();
 	ConstantSP key=Util::createConstant(keyType_);
 	ConstantSP value=Util::createConstant(type_);
 	while(counts<len){
@@ -1703,10 +1699,10 @@ string DoubleDictionary::getString() const {
 }
 
 long long DoubleDictionary::getAllocatedMemory() const {
-	long long bytes=sizeof(DoubleDictionary)+size()*16;
+	long long bytes=sizeof(DoubleDictionary)+dict_.getAllocatedMemory();
 	if(getType()==DT_STRING){
-		unordered_map<double,U8>::const_iterator it=dict_.begin();
-		unordered_map<double,U8>::const_iterator end=dict_.end();
+		FlatHashMap<double,U8>::const_iterator it=dict_.begin();
+		FlatHashMap<double,U8>::const_iterator end=dict_.end();
 		while(it!=end){
 			bytes += strlen(it->second.pointer);
 			++it;
@@ -1715,12 +1711,12 @@ long long DoubleDictionary::getAllocatedMemory() const {
 	return bytes;
 }
 
-StringDictionary::StringDictionary(const unordered_map<string,U8>& dict, DATA_TYPE keyType,DATA_TYPE type)
+StringDictionary::StringDictionary(const FlatHashMap<string,U8>& dict, DATA_TYPE keyType,DATA_TYPE type)
 	:AbstractDictionary(keyType,type),dict_(dict){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<string,U8>::iterator it=dict_.begin();
-	unordered_map<string,U8>::iterator end=dict_.end();
+	FlatHashMap<string,U8>::iterator it=dict_.begin();
+	FlatHashMap<string,U8>::iterator end=dict_.end();
 	size_t len;
 	char* tmp;
 	while(it!=end){
@@ -1735,8 +1731,8 @@ StringDictionary::StringDictionary(const unordered_map<string,U8>& dict, DATA_TY
 StringDictionary::~StringDictionary(){
 	if(type_!=DT_STRING)
 		return;
-	unordered_map<string,U8>::const_iterator it=dict_.begin();
-	unordered_map<string,U8>::const_iterator end=dict_.end();
+	FlatHashMap<string,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<string,U8>::const_iterator end=dict_.end();
 	while(it!=end){
 		delete[] it->second.pointer;
 		++it;
@@ -1822,7 +1818,7 @@ bool StringDictionary::set(const ConstantSP& key, const ConstantSP& value){
 
 ConstantSP StringDictionary::getMember(const string& key) const {
 	ConstantSP result = Util::createConstant(type_);
-	unordered_map<string,U8>::const_iterator it=dict_.find(key);
+	FlatHashMap<string,U8>::const_iterator it=dict_.find(key);
 	if(it==dict_.end())
 		(*swriter_)(nullVal_,result);
 	else
@@ -1835,7 +1831,7 @@ ConstantSP StringDictionary::getMember(const ConstantSP& key) const {
 		throw RuntimeException("Key data type incompatible. Expecting literal/BLOB data");
 	ConstantSP result=createValues(key);
 	if(key->isScalar()){
-		unordered_map<string,U8>::const_iterator it=dict_.find(key->getStringRef());
+		FlatHashMap<string,U8>::const_iterator it=dict_.find(key->getStringRef());
 		if(it==dict_.end())
 			(*swriter_)(nullVal_,result);
 		else
@@ -1849,8 +1845,8 @@ ConstantSP StringDictionary::getMember(const ConstantSP& key) const {
 		U8 value[bufSize];
 		int start=0;
 		int counts;
-		unordered_map<string,U8>::const_iterator it;
-		unordered_map<string,U8>::const_iterator end=dict_.end();
+		FlatHashMap<string,U8>::const_iterator it;
+		FlatHashMap<string,U8>::const_iterator end=dict_.end();
 		while(start<len){
 			counts=(std::min)(len-start,bufSize);
 			pbuf=key->getStringConst(start,counts,buf);
@@ -1882,8 +1878,8 @@ void StringDictionary::contain(const ConstantSP& target, const ConstantSP& resul
 		int start=0;
 		int counts;
 
-		unordered_map<string,U8>::const_iterator it;
-		unordered_map<string,U8>::const_iterator end=dict_.end();
+		FlatHashMap<string,U8>::const_iterator it;
+		FlatHashMap<string,U8>::const_iterator end=dict_.end();
 		while(start<len){
 			counts=(std::min)(len-start,bufSize);
 			pbuf=target->getStringConst(start,counts,buf);
@@ -1897,7 +1893,7 @@ void StringDictionary::contain(const ConstantSP& target, const ConstantSP& resul
 }
 
 ConstantSP StringDictionary::keys() const {
-	unordered_map<string,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<string,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP=Util::createVector(keyType_,len);
 	int start=0;
@@ -1918,7 +1914,7 @@ ConstantSP StringDictionary::keys() const {
 }
 
 ConstantSP StringDictionary::values() const {
-	unordered_map<string,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<string,U8>::const_iterator it=dict_.begin();
 	int len=size();
 	ConstantSP resultSP= Util::createVector(type_,len);
 
@@ -1943,7 +1939,7 @@ string StringDictionary::getString() const {
 	string content;
 	int len=(std::min)(Util::DISPLAY_ROWS,(int)dict_.size());
 	int counts=0;
-	unordered_map<string,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<string,U8>::const_iterator it=dict_.begin();
 	ConstantSP value=Util::createConstant(type_);
 	while(counts<len){
 		content.append(it->first);
@@ -1960,10 +1956,10 @@ string StringDictionary::getString() const {
 }
 
 long long StringDictionary::getAllocatedMemory() const {
-	long long bytes=sizeof(StringDictionary)+size()*(8+sizeof(string));
+	long long bytes=sizeof(StringDictionary)+dict_.getAllocatedMemory();
 
-	unordered_map<string,U8>::const_iterator it=dict_.begin();
-	unordered_map<string,U8>::const_iterator end=dict_.end();
+	FlatHashMap<string,U8>::const_iterator it=dict_.begin();
+	FlatHashMap<string,U8>::const_iterator end=dict_.end();
 	if(getType()==DT_STRING){
 		while(it!=end){
 			bytes += strlen(it->second.pointer)+it->first.size();
@@ -25,6 +25,8 @@
 #include "Logger.h"
 #include "Domain.h"
 #include "DBConnectionPoolImpl.h"
+#include "Metrics.h"
+#include "RadixScatter.h"
 using std::ifstream;
 using std::string;
 using std::vector;
@@ -44,7 +46,6 @@ int min(INDEX a, int b) {
 
 
 
-#define RECORDTIME(name) //RecordTime _recordTime(name)
 
 
 
@@ -540,6 +541,10 @@ DataInputStreamSP DBConnection::getDataInputStream()
     return conn_->getDataInputStream();
 }
 
+void DBConnection::getHostPort(std::string& host, int& port) const {
+    conn_->getHostPort(host, port);
+}
+
 void DBConnection::setInitScript(const std::string & script) {
     initialScript_ = script;
 }
@@ -625,6 +630,68 @@ int DBConnectionPool::getConnectionCount(){
     return pool_->getConnectionCount();
 }
 
+TableSchemaCache& TableSchemaCache::instance() {
+    static TableSchemaCache cache;
+    return cache;
+}
+
+DictionarySP TableSchemaCache::get(const string& key, const std::function<DictionarySP()>& loader) {
+    static MetricCounter* hits = MetricsRegistry::instance().counter("ddb_table_schema_cache_hits_total");
+    static MetricCounter* misses = MetricsRegistry::instance().counter("ddb_table_schema_cache_misses_total");
+    long long ttl = ttl_.load();
+    if (key.empty() || ttl <= 0)
+        return loader();
+    long long now = Util::getEpochTime();
+    {
+        LockGuard<Mutex> guard(&mutex_);
+        auto iter = entries_.find(key);
+        if (iter != entries_.end()) {
+            if (now - iter->second.loadTime < ttl) {
+                hits->increment();
+                return iter->second.schema;
+            }
+            entries_.erase(iter);
+        }
+    }
+    misses->increment();
+    //Load outside the lock, concurrent misses on the same key just load twice.
+    DictionarySP schema = loader();
+    LockGuard<Mutex> guard(&mutex_);
+    Entry &entry = entries_[key];
+    entry.schema = schema;
+    entry.loadTime = now;
+    return schema;
+}
+
+void TableSchemaCache::invalidate(const string& key) {
+    if (key.empty())
+        return;
+    LockGuard<Mutex> guard(&mutex_);
+    entries_.erase(key);
+}
+
+void TableSchemaCache::clear() {
+    LockGuard<Mutex> guard(&mutex_);
+    entries_.clear();
+}
+
+std::size_t TableSchemaCache::size() {
+    LockGuard<Mutex> guard(&mutex_);
+    return entries_.size();
+}
+
+void TableSchemaCache::setTTL(long long ttl) {
+    ttl_.store(ttl);
+    if (ttl <= 0)
+        clear();
+}
+
+string TableSchemaCache::makeKey(const string& host, int port, const string& dbUrl, const string& tableName) {
+    if (dbUrl.empty())
+        return "";
+    return host + ":" + std::to_string(port) + "/" + dbUrl + "/" + tableName;
+}
+
 PartitionedTableAppender::PartitionedTableAppender(string dbUrl, string tableName, string partitionColName, DBConnectionPool& pool) {
     pool_ = pool.pool_;
     init(dbUrl, tableName, partitionColName, "");
@@ -637,7 +704,6 @@ PartitionedTableAppender::PartitionedTableAppender(string dbUrl, string tableNam
 PartitionedTableAppender::~PartitionedTableAppender(){}
 void PartitionedTableAppender::init(string dbUrl, string tableName, string partitionColName, string appendFunction){
     threadCount_ = pool_->getConnectionCount();
-    chunkIndices_.resize(threadCount_);
     ConstantSP partitionSchema;
     TableSP colDefs;
     VectorSP typeInts;
@@ -658,14 +724,16 @@ void PartitionedTableAppender::init(string dbUrl, string tableName, string parti
             appendScript_ = appendFunction;
         }
         
-        pool_->run(task,identity_);
-
-        while(!pool_->isFinished(identity_)){
-            Util::sleep(10);
-        }
-        
-        tableInfo_ = pool_->getData(identity_);
-        identity_ --;
+        schemaKey_ = TableSchemaCache::makeKey(pool_->getHostName(), pool_->getPort(), dbUrl, tableName);
+        tableInfo_ = TableSchemaCache::instance().get(schemaKey_, [&]() {
+            pool_->run(task,identity_);
+            while(!pool_->isFinished(identity_)){
+                Util::sleep(10);
+            }
+            DictionarySP info = pool_->getData(identity_);
+            identity_ --;
+            return info;
+        });
         ConstantSP partColNames = tableInfo_->getMember("partitionColumnName");
         if(partColNames->isNull())
             throw RuntimeException("Can't find specified partition column name.");
@@ -718,30 +786,31 @@ int PartitionedTableAppender::append(TableSP table){
         VectorSP curCol = table->getColumn(i);
         checkColumnType(i, curCol->getCategory(), curCol->getType());
 		if (columnCategories_[i] == TEMPORAL && curCol->getType() != columnTypes_[i]) {
-			curCol = curCol->castTemporal(columnTypes_[i]);
+			//The column is replaced in the table anyway; when nothing else holds it, convert its buffer in place.
+			curCol = curCol.count() <= 2 ? curCol->castTemporalInPlace(columnTypes_[i]) : curCol->castTemporal(columnTypes_[i]);
 			table->setColumn(i, curCol);
 		}
     }
     
-    for(int i=0; i<threadCount_; ++i)
-        chunkIndices_[i].clear();
     vector<int> keys = domain_->getPartitionKeys(table->getColumn(partitionColumnIdx_));
     vector<int> tasks;
     int rows = static_cast<int>(keys.size());
     for(int i=0; i<rows; ++i){
         int key = keys[i];
         if(key >= 0)
-            chunkIndices_[key % threadCount_].emplace_back(i);
+            keys[i] = key % threadCount_;
 		else {
 			throw RuntimeException("A value-partition column contain null value at row " + std::to_string(i) + ".");
 		}
     }
+    RadixScatter scatter(std::move(keys), threadCount_);
+    //When all rows go to one connection, the table is sent as it is.
+    vector<TableSP> subTables = rows > 0 && scatter.count(scatter.partitionIds()[0]) == rows ? vector<TableSP>(threadCount_, table) : scatter.scatter(table);
     for(int i=0; i<threadCount_; ++i){
-        if(chunkIndices_[i].size() == 0)
+        if(scatter.count(i) == 0)
             continue;
-        TableSP subTable = table->getSubTable(chunkIndices_[i]);
         tasks.push_back(identity_);
-        vector<ConstantSP> args = {subTable};
+        vector<ConstantSP> args = {subTables[i]};
         pool_->run(appendScript_, args, identity_--); 
         
     }
@@ -750,7 +819,13 @@ int PartitionedTableAppender::append(TableSP table){
         while(!pool_->isFinished(task)){
             Util::sleep(100);
         }
-        ConstantSP res = pool_->getData(task);
+        ConstantSP res;
+        try {
+            res = pool_->getData(task);
+        } catch (...) {
+            TableSchemaCache::instance().invalidate(schemaKey_);
+            throw;
+        }
         if(res->isNull()){
             affected = 0;
         }
@@ -791,7 +866,11 @@ AutoFitTableAppender::AutoFitTableAppender(string dbUrl, string tableName, DBCon
             appendScript_ = "tableInsert{loadTable('" + dbUrl + "', '" + tableName + "')}";
         }
         
-        tableInfo =  conn_.run(task);
+        string host;
+        int port;
+        conn_.getHostPort(host, port);
+        schemaKey_ = TableSchemaCache::makeKey(host, port, dbUrl, tableName);
+        tableInfo = TableSchemaCache::instance().get(schemaKey_, [&]() { return DictionarySP(conn_.run(task)); });
         colDefs = tableInfo->getMember("colDefs");
         cols_ = colDefs->rows();
         typeInts = colDefs->getColumn("typeInt");
@@ -814,19 +893,36 @@ int AutoFitTableAppender::append(TableSP table){
     if(cols_ != table->columns())
         throw RuntimeException("The input table columns doesn't match the columns of the target table.");
     
-    vector<ConstantSP> columns;
-    for(int i = 0; i < cols_; i++){
-        VectorSP curCol = table->getColumn(i);
-        checkColumnType(i, curCol->getCategory(), curCol->getType());
-        if(columnCategories_[i] == TEMPORAL && curCol->getType() != columnTypes_[i]){
-            columns.push_back(curCol->castTemporal(columnTypes_[i]));
-        }else{
-            columns.push_back(curCol);
+    bool typesMatch = true;
+    for(int i = 0; i < cols_ && typesMatch; i++)
+        typesMatch = table->getColumnType(i) == columnTypes_[i];
+    TableSP tableInput;
+    LockGuard<Mutex> lock(&encoderMutex_);
+    if(typesMatch){
+        //tableInsert matches columns by position, so the caller's table is sent as it is.
+        tableInput = symbolEncoder_.encode(table, columnTypes_);
+    }else{
+        vector<ConstantSP> columns;
+        for(int i = 0; i < cols_; i++){
+            VectorSP curCol = table->getColumn(i);
+            checkColumnType(i, curCol->getCategory(), curCol->getType());
+            if(columnCategories_[i] == TEMPORAL && curCol->getType() != columnTypes_[i]){
+                columns.push_back(curCol->castTemporal(columnTypes_[i]));
+            }else{
+                columns.push_back(curCol);
+            }
         }
+        symbolEncoder_.encode(columns, columnTypes_);
+        tableInput = Util::createTable(columnNames_, columns);
     }
-    TableSP tableInput = Util::createTable(columnNames_, columns);
     vector<ConstantSP> arg = {tableInput};
-    ConstantSP res =  conn_.run(appendScript_, arg);
+    ConstantSP res;
+    try {
+        res = conn_.run(appendScript_, arg);
+    } catch (...) {
+        TableSchemaCache::instance().invalidate(schemaKey_);
+        throw;
+    }
     if(res->isNull())
         return 0;
     else
@@ -843,8 +939,8 @@ void AutoFitTableAppender::checkColumnType(int col, DATA_CATEGORY category, DATA
 }
 
 AutoFitTableUpsert::AutoFitTableUpsert(string dbUrl, string tableName, DBConnection& conn,bool ignoreNull,
-                                        vector<string> *pkeyColNames,vector<string> *psortColumns)
-                        : conn_(conn){
+                                        vector<string> *pkeyColNames,vector<string> *psortColumns, int batchSize, int throttle)
+                        : conn_(conn), batchSize_(batchSize), throttle_(throttle){
     ConstantSP schema;
     TableSP colDefs;
     VectorSP typeInts;
@@ -894,7 +990,11 @@ AutoFitTableUpsert::AutoFitTableUpsert(string dbUrl, string tableName, DBConnect
         }
         upsertScript_+="}";
         
-        tableInfo =  conn_.run(task);
+        string host;
+        int port;
+        conn_.getHostPort(host, port);
+        schemaKey_ = TableSchemaCache::makeKey(host, port, dbUrl, tableName);
+        tableInfo = TableSchemaCache::instance().get(schemaKey_, [&]() { return DictionarySP(conn_.run(task)); });
         colDefs = tableInfo->getMember("colDefs");
         cols_ = colDefs->rows();
         typeInts = colDefs->getColumn("typeInt");
@@ -907,16 +1007,52 @@ AutoFitTableUpsert::AutoFitTableUpsert(string dbUrl, string tableName, DBConnect
             columnCategories_[i] = Util::getCategory(columnTypes_[i]);
             columnNames_[i] = colNames->getString(i);
         }
+        //With ignoreNull a later row doesn't fully replace an earlier one, so rows aren't merged.
+        if(!ignoreNull && pkeyColNames != nullptr){
+            for(auto &one : *pkeyColNames){
+                auto iter = std::find(columnNames_.begin(), columnNames_.end(), one);
+                if(iter == columnNames_.end()){
+                    keyColumns_.clear();
+                    break;
+                }
+                keyColumns_.push_back(static_cast<int>(iter - columnNames_.begin()));
+            }
+        }
         
     } catch (std::exception& e) {
         throw e;
     } 
 }
 
+AutoFitTableUpsert::~AutoFitTableUpsert(){
+    {
+        LockGuard<Mutex> guard(&asyncMutex_);
+        stopping_ = true;
+        asyncNotifier_.notifyAll();
+    }
+    //The background thread sends the buffered rows before it exits.
+    if(!asyncThread_.isNull())
+        asyncThread_->join();
+}
+
 int AutoFitTableUpsert::upsert(TableSP table){
+    TableSP fitted = fitTable(table);
+    std::future<int> buffered = requestFlush();
+    if(buffered.valid())
+        buffered.wait();
+    return runUpsert(fitted);
+}
+
+TableSP AutoFitTableUpsert::fitTable(const TableSP& table){
     if(cols_ != table->columns())
         throw RuntimeException("The input table columns doesn't match the columns of the target table.");
     
+    //upsert! resolves key and sort columns by name, so the caller's table is only sent as it is when names match too.
+    bool schemaMatch = true;
+    for(int i = 0; i < cols_ && schemaMatch; i++)
+        schemaMatch = table->getColumnType(i) == columnTypes_[i] && table->getColumnName(i) == columnNames_[i];
+    if(schemaMatch)
+        return table;
     vector<ConstantSP> columns;
     for(int i = 0; i < cols_; i++){
         VectorSP curCol = table->getColumn(i);
@@ -927,15 +1063,184 @@ int AutoFitTableUpsert::upsert(TableSP table){
             columns.push_back(curCol);
         }
     }
-    TableSP tableInput = Util::createTable(columnNames_, columns);
-    vector<ConstantSP> arg = {tableInput};
-    ConstantSP res =  conn_.run(upsertScript_, arg);
+    return Util::createTable(columnNames_, columns);
+}
+
+int AutoFitTableUpsert::runUpsert(const TableSP& table){
+    vector<ConstantSP> arg = {table};
+    ConstantSP res;
+    try {
+        LockGuard<Mutex> guard(&connMutex_);
+        res = conn_.run(upsertScript_, arg);
+    } catch (...) {
+        TableSchemaCache::instance().invalidate(schemaKey_);
+        throw;
+    }
     if(res->getType() == DT_INT && res->getForm() == DF_SCALAR)
         return res->getInt();
     else
         return 0;
 }
 
+std::future<int> AutoFitTableUpsert::upsertAsync(TableSP table){
+    TableSP fitted = fitTable(table);
+    INDEX rows = fitted->rows();
+    //Key strings are built before taking the lock, each value is terminated by a 0 byte.
+    vector<string> keys;
+    if(!keyColumns_.empty()){
+        vector<VectorSP> keyCols;
+        for(int col : keyColumns_)
+            keyCols.push_back(fitted->getColumn(col));
+        keys.resize(rows);
+        for(INDEX i = 0; i < rows; ++i){
+            for(auto &keyCol : keyCols){
+                keys[i].append(keyCol->getString(i));
+                keys[i].push_back('\0');
+            }
+        }
+    }
+    std::promise<int> promise;
+    std::future<int> future = promise.get_future();
+    LockGuard<Mutex> guard(&asyncMutex_);
+    if(asyncThread_.isNull()){
+        asyncThread_ = new Thread(new Executor([this](){
+            runAsync();
+        }));
+        asyncThread_->start();
+    }
+    INDEX base = static_cast<INDEX>(rowAlive_.size());
+    rowAlive_.resize(base + rows, 1);
+    for(INDEX i = 0; i < (INDEX)keys.size(); ++i){
+        auto ret = pendingKeys_.emplace(std::move(keys[i]), base + i);
+        if(!ret.second){
+            rowAlive_[ret.first->second] = 0;
+            ret.first->second = base + i;
+            ++deadRows_;
+        }
+    }
+    if(rows > 0)
+        pendingTables_.push_back(fitted);
+    if(pendingPromises_.empty())
+        pendingSince_ = Util::getEpochTime();
+    pendingPromises_.push_back(std::move(promise));
+    pendingRows_.push_back(rows);
+    //The background thread sleeps without a deadline while nothing is buffered.
+    if(pendingPromises_.size() == 1 || (INDEX)rowAlive_.size() - deadRows_ >= batchSize_)
+        asyncNotifier_.notify();
+    return future;
+}
+
+std::future<int> AutoFitTableUpsert::requestFlush(){
+    LockGuard<Mutex> guard(&asyncMutex_);
+    if(asyncThread_.isNull())
+        return std::future<int>();
+    std::promise<int> promise;
+    std::future<int> future = promise.get_future();
+    if(pendingPromises_.empty())
+        pendingSince_ = Util::getEpochTime();
+    pendingPromises_.push_back(std::move(promise));
+    pendingRows_.push_back(0);
+    flushRequested_ = true;
+    asyncNotifier_.notify();
+    return future;
+}
+
+void AutoFitTableUpsert::flush(){
+    std::future<int> future = requestFlush();
+    if(future.valid())
+        future.get();
+}
+
+namespace {
+
+//Concatenate the rows of tables whose flag in alive is set.
+TableSP concatAliveRows(const vector<TableSP>& tables, const vector<char>& alive, INDEX deadRows){
+    if(tables.empty())
+        return TableSP();
+    if(tables.size() == 1 && deadRows == 0)
+        return tables[0];
+    int cols = tables[0]->columns();
+    vector<string> names(cols);
+    vector<VectorSP> columns(cols);
+    for(int i = 0; i < cols; ++i){
+        names[i] = tables[0]->getColumnName(i);
+        columns[i] = VectorSP(tables[0]->getColumn(i))->getInstance(0);
+    }
+    INDEX base = 0;
+    vector<int> indices;
+    for(auto &table : tables){
+        INDEX rows = table->rows();
+        TableSP piece = table;
+        if(deadRows > 0){
+            indices.clear();
+            for(INDEX r = 0; r < rows; ++r){
+                if(alive[base + r])
+                    indices.push_back(r);
+            }
+            if((INDEX)indices.size() < rows)
+                piece = table->getSubTable(indices);
+        }
+        for(int i = 0; i < cols; ++i)
+            columns[i]->append(piece->getColumn(i));
+        base += rows;
+    }
+    return Util::createTable(names, vector<ConstantSP>(columns.begin(), columns.end()));
+}
+
+}
+
+void AutoFitTableUpsert::runAsync(){
+    while(true){
+        vector<TableSP> tables;
+        vector<char> alive;
+        INDEX deadRows;
+        vector<std::promise<int>> promises;
+        vector<INDEX> requestRows;
+        {
+            LockGuard<Mutex> guard(&asyncMutex_);
+            while(true){
+                if(pendingPromises_.empty()){
+                    if(stopping_)
+                        return;
+                    asyncNotifier_.wait(asyncMutex_);
+                    continue;
+                }
+                long long now = Util::getEpochTime();
+                if(stopping_ || flushRequested_ || (INDEX)rowAlive_.size() - deadRows_ >= batchSize_ || now - pendingSince_ >= throttle_)
+                    break;
+                asyncNotifier_.wait(asyncMutex_, static_cast<int>(std::max(1LL, pendingSince_ + throttle_ - now)));
+            }
+            tables.swap(pendingTables_);
+            alive.swap(rowAlive_);
+            promises.swap(pendingPromises_);
+            requestRows.swap(pendingRows_);
+            deadRows = deadRows_;
+            deadRows_ = 0;
+            pendingKeys_.clear();
+            flushRequested_ = false;
+        }
+        try {
+            TableSP batch = concatAliveRows(tables, alive, deadRows);
+            if(!batch.isNull())
+                runUpsert(batch);
+        } catch (...) {
+            std::exception_ptr ex = std::current_exception();
+            for(auto &promise : promises)
+                promise.set_exception(ex);
+            continue;
+        }
+        //Every request resolves with its own rows that survived key merging.
+        INDEX base = 0;
+        for(size_t i = 0; i < promises.size(); ++i){
+            int sent = 0;
+            for(INDEX r = base; r < base + requestRows[i]; ++r)
+                sent += alive[r];
+            base += requestRows[i];
+            promises[i].set_value(sent);
+        }
+    }
+}
+
 void AutoFitTableUpsert::checkColumnType(int col, DATA_CATEGORY category, DATA_TYPE type) {
     if(columnTypes_[col] != type){
         DATA_CATEGORY expectCategory = columnCategories_[col];
@@ -2,16 +2,35 @@
 #include "DolphinDB.h"
 #include "Logger.h"
 #include "ConstantMarshall.h"
+#include "Tracing.h"
+#include "Metrics.h"
 
 #define APIMinVersionRequirement 300
 
 using std::string;
 namespace dolphindb {
 
+namespace {
+
+class LatencyRecorder {
+public:
+    LatencyRecorder(MetricHistogram* histogram) : histogram_(histogram), startTime_(Util::getNanoBenchmark()) {}
+    ~LatencyRecorder() {
+        if (histogram_ != nullptr)
+            histogram_->record((Util::getNanoBenchmark() - startTime_) / 1000);
+    }
+private:
+    MetricHistogram* histogram_;
+    long long startTime_;
+};
+
+}
+
 DdbInit DBConnectionImpl::ddbInit_;
 DBConnectionImpl::DBConnectionImpl(bool sslEnable, bool asynTask, int keepAliveTime, bool compress, bool python, bool isReverseStreaming)
     : port_(0), encrypted_(false), isConnected_(false), littleEndian_(Util::isLittleEndian()), sslEnable_(sslEnable),asynTask_(asynTask)
-    , keepAliveTime_(keepAliveTime), compress_(compress), enablePickle_(false), python_(python), isReverseStreaming_(isReverseStreaming)
+    , keepAliveTime_(keepAliveTime), compress_(compress), enablePickle_(false), python_(python), isReverseStreaming_(isReverseStreaming), rpcLatency_(nullptr)
+    , symbolBaseCache_(new SymbolBaseCache())
 {
 }
 
@@ -110,6 +129,9 @@ bool DBConnectionImpl::connect() {
 
     conn_ = conn;
     inputStream_ = new DataInputStream(conn_);
+    //Symbol base ids are only meaningful within one session.
+    symbolBaseCache_->clear();
+    rpcLatency_ = MetricsRegistry::instance().histogram("ddb_rpc_latency_microseconds", MetricsRegistry::label("site", hostName_ + ":" + std::to_string(port_)));
     sessionId_ = sessionId;
     isConnected_ = true;
     littleEndian_ = remoteLittleEndian;
@@ -237,6 +259,9 @@ ConstantSP DBConnectionImpl::run(const string& script, const string& scriptType,
 
     if(fetchSize < 8192 && fetchSize != 0)
         throw IOException("fetchSize must be greater than 8192 and not less than 0");
+    DDB_TRACE("DBConnection::run");
+    LatencyRecorder latencyRecorder(rpcLatency_);
+    TraceSpan serializeSpan(DDB_TRACE_SITE("DBConnection::run.serialize"));
     string body;
     size_t argCount = args.size();
     if (scriptType == "script")
@@ -280,12 +305,16 @@ ConstantSP DBConnectionImpl::run(const string& script, const string& scriptType,
                 throw IOException("Couldn't send function argument to the remote host with IO error type " + std::to_string(ret));
             }
         }
+        serializeSpan.end();
+        DDB_TRACE("DBConnection::run.send");
         ret = outStream->flush();
         if (ret != OK) {
             close();
             throw IOException("Failed to marshall code with IO error type " + std::to_string(ret));
         }
     } else {
+        serializeSpan.end();
+        DDB_TRACE("DBConnection::run.send");
         size_t actualLength;
         ret = conn_->write(out.c_str(), out.size(), actualLength);
         if (ret != OK) {
@@ -300,11 +329,13 @@ ConstantSP DBConnectionImpl::run(const string& script, const string& scriptType,
     if (littleEndian_ != (char)Util::isLittleEndian())
         inputStream_->enableReverseIntegerByteOrder();
 
+    TraceSpan waitSpan(DDB_TRACE_SITE("DBConnection::run.wait"));
     string line;
     if ((ret = inputStream_->readLine(line)) != OK) {
         close();
         throw IOException("Failed to read response header from the socket with IO error type " + std::to_string(ret));
     }
+    waitSpan.end();
     while (line == "MSG") {
         if ((ret = inputStream_->readString(line)) != OK) {
             close();
@@ -338,6 +369,7 @@ ConstantSP DBConnectionImpl::run(const string& script, const string& scriptType,
         return new Void();
     }
     
+    DDB_TRACE("DBConnection::run.parse");
     short flag;
     if ((ret = inputStream_->readShort(flag)) != OK) {
         close();
@@ -348,7 +380,7 @@ ConstantSP DBConnectionImpl::run(const string& script, const string& scriptType,
     DATA_TYPE type = static_cast<DATA_TYPE >(flag & 0xff);
     if(fetchSize > 0 && form == DF_VECTOR && type == DT_ANY)
         return new BlockReader(inputStream_);
-    ConstantUnmarshallFactory factory(inputStream_);
+    ConstantUnmarshallFactory factory(inputStream_, symbolBaseCache_);
     ConstantUnmarshall* unmarshall = factory.getConstantUnmarshall(form);
     if(unmarshall == NULL){
         DLogger::Error("Unknow incoming object form",form,"of type",type);
@@ -6,6 +6,7 @@
 #include "Exceptions.h"
 #include "Types.h"
 #include "Util.h"
+#include <algorithm>
 #include <iterator>
 #include <unordered_map>
 namespace dolphindb {
@@ -257,6 +258,47 @@ EventHandler::EventHandler(const std::vector<EventSchema>& eventSchemas, const s
         throw IllegalArgumentException(funcName, errMsg);
     }
     commonKeySize_ = commonKeys.size();
+    initDecoders();
+}
+
+void EventHandler::initDecoders(){
+    decoders_.resize(eventInfos_.size());
+    int id = 0;
+    for(auto& one : eventInfos_){
+        EventBatchDecoder& decoder = decoders_[id];
+        const EventSchema& schema = one.second.eventSchema_->schema_;
+        decoder.eventType_ = one.first;
+        decoder.schema_ = &schema;
+        unsigned attrCount = schema.fieldTypes_.size();
+        decoder.kinds_.resize(attrCount);
+        decoder.columns_.resize(attrCount);
+        decoder.arrayIndex_.resize(attrCount);
+        decoder.arrayValues_.resize(attrCount);
+        for(unsigned i = 0; i < attrCount; ++i){
+            DATA_FORM form = schema.fieldForms_[i];
+            DATA_TYPE type = schema.fieldTypes_[i];
+            int extraParam = schema.fieldExtraParams_[i];
+            if(form == DF_SCALAR && type != DT_ANY){
+                //Symbol attributes are serialized as strings.
+                decoder.kinds_[i] = EventBatchDecoder::RAW_VALUE;
+                if(type == DT_STRING || type == DT_SYMBOL || type == DT_BLOB)
+                    decoder.columns_[i] = Util::createArenaStringVector(type, 1024);
+                else
+                    decoder.columns_[i] = Util::createVector(type, 0, 1024, true, extraParam);
+            }
+            else if(form == DF_VECTOR && type < ARRAY_TYPE_BASE && Util::getCategory(type) != LITERAL){
+                decoder.kinds_[i] = EventBatchDecoder::FAST_ARRAY;
+                decoder.arrayIndex_[i] = Util::createVector(DT_INDEX, 0, 1024);
+                decoder.arrayValues_[i] = Util::createVector(type, 0, 1024, true, extraParam);
+            }
+            else{
+                decoder.kinds_[i] = EventBatchDecoder::OBJECT;
+                decoder.columns_[i] = Util::createVector(DT_ANY, 0, 1024);
+                decoder.hasObject_ = true;
+            }
+        }
+        eventIds_[one.first] = id++;
+    }
 }
 
 bool EventHandler::deserializeEvent(ConstantSP obj, std::vector<std::string>& eventTypes, std::vector<std::vector<ConstantSP>>& attributes, ErrorCodeInfo& errorInfo){
@@ -264,6 +306,8 @@ bool EventHandler::deserializeEvent(ConstantSP obj, std::vector<std::string>& ev
     int blobIndex = isNeedEventTime_ ? 2 : 1;
     const VectorSP& eventTypeVec = obj->get(eventTypeIndex);
     const VectorSP& blobVec = obj->get(blobIndex);
+    //Blobs are read in place, so an arena vector is not converted to std::string.
+    const StringVector* blobs = dynamic_cast<const StringVector*>(blobVec.get());
     int rowSize = eventTypeVec->size();
     IO_ERR ioError;
     for(int rowIndex = 0; rowIndex < rowSize; ++rowIndex){
@@ -273,8 +317,8 @@ bool EventHandler::deserializeEvent(ConstantSP obj, std::vector<std::string>& ev
             errorInfo.set(ErrorCodeInfo::EC_InvalidParameter, "UnKnown eventType" + eventType);
             return false;
         }
-        const std::string &blob = blobVec->getStringRef(rowIndex);
-        DataInputStreamSP input = new DataInputStream(blob.data(), blob.size(), false);
+        StringView blob = StringVector::getStringView(blobVec.get(), blobs, rowIndex);
+        DataInputStreamSP input = new DataInputStream(blob.data, blob.length, false);
 
         EventSchema& schema = iter->second.eventSchema_->schema_;
         unsigned attrCount = schema.fieldTypes_.size();
@@ -309,16 +353,194 @@ bool EventHandler::deserializeEvent(ConstantSP obj, std::vector<std::string>& ev
     return true;
 }
 
-bool EventHandler::serializeEvent(const std::string& eventType, const std::vector<ConstantSP>& attributes, std::vector<ConstantSP>& serializedEvent, std::string& errMsg){
+int EventHandler::findEventId(const VectorSP& eventTypeVec, INDEX row){
+    if(eventTypeVec->getType() == DT_SYMBOL){
+        //Map each symbol of the dictionary to an event id once, later rows only read their code.
+        SymbolBaseSP base = eventTypeVec->getSymbolBase();
+        if(base.get() != symbolBase_.get()){
+            symbolBase_ = base;
+            symbolIds_.clear();
+        }
+        for(std::size_t i = symbolIds_.size(); i < base->size(); ++i){
+            auto iter = eventIds_.find(base->getSymbol((int)i));
+            symbolIds_.push_back(iter == eventIds_.end() ? -1 : iter->second);
+        }
+        int code = eventTypeVec->getInt(row);
+        return code >= 0 && code < (int)symbolIds_.size() ? symbolIds_[code] : -1;
+    }
+    const std::string& eventType = eventTypeVec->getStringRef(row);
+    if(lastEventId_ >= 0 && decoders_[lastEventId_].eventType_ == eventType){
+        return lastEventId_;
+    }
+    auto iter = eventIds_.find(eventType);
+    if(iter == eventIds_.end()){
+        return -1;
+    }
+    lastEventId_ = iter->second;
+    return lastEventId_;
+}
+
+IO_ERR EventHandler::decodeAttributes(EventBatchDecoder& decoder, DataInputStream* input, const DataInputStreamSP& sharedInput){
+    IO_ERR ret = OK;
+    unsigned attrCount = decoder.kinds_.size();
+    for(unsigned i = 0; i < attrCount && ret == OK; ++i){
+        INDEX numElement = 0;
+        switch(decoder.kinds_[i]){
+        case EventBatchDecoder::RAW_VALUE: {
+            const VectorSP& column = decoder.columns_[i];
+            ret = column->deserialize(input, column->size(), 1, numElement);
+            if(ret == OK && numElement != 1){
+                ret = INVALIDDATA;
+            }
+            break;
+        }
+        case EventBatchDecoder::FAST_ARRAY: {
+            //Layout of FastArrayAttributeSerializer: a single row block, or a 0 short for an empty array.
+            const VectorSP& values = decoder.arrayValues_[i];
+            unsigned short arrayRows = 0;
+            unsigned int count = 0;
+            if((ret = input->readUnsignedShort(arrayRows)) != OK){
+                break;
+            }
+            if(arrayRows != 0){
+                unsigned char countBytes;
+                char reserved;
+                if((ret = input->readUnsignedChar(countBytes)) != OK || (ret = input->readChar(reserved)) != OK){
+                    break;
+                }
+                if(countBytes == 1){
+                    unsigned char c;
+                    ret = input->readUnsignedChar(c);
+                    count = c;
+                }
+                else if(countBytes == 2){
+                    unsigned short c;
+                    ret = input->readUnsignedShort(c);
+                    count = c;
+                }
+                else{
+                    ret = input->readUnsignedInt(count);
+                }
+                if(ret != OK){
+                    break;
+                }
+                if(count > 0){
+                    ret = values->deserialize(input, values->size(), count, numElement);
+                    if(ret == OK && numElement != (INDEX)count){
+                        ret = INVALIDDATA;
+                    }
+                }
+            }
+            if(ret == OK){
+                INDEX end = values->size();
+                decoder.arrayIndex_[i]->appendIndex(&end, 1);
+            }
+            break;
+        }
+        default: {
+            ConstantSP value = deserializeAny(decoder.schema_->fieldTypes_[i], decoder.schema_->fieldForms_[i], sharedInput, ret);
+            if(ret == OK){
+                VectorSP any = decoder.columns_[i];
+                any->append(value);
+            }
+        }
+        }
+    }
+    return ret;
+}
+
+void EventHandler::deliver(EventBatchDecoder& decoder, const EventBatchMessageHandler& handler){
+    if(decoder.rows_ == 0){
+        return;
+    }
+    unsigned attrCount = decoder.kinds_.size();
+    for(unsigned i = 0; i < attrCount; ++i){
+        if(decoder.kinds_[i] == EventBatchDecoder::FAST_ARRAY){
+            decoder.columns_[i] = Util::createArrayVector(decoder.arrayIndex_[i], decoder.arrayValues_[i]);
+        }
+    }
+    handler(decoder.eventType_, decoder.columns_, decoder.rows_);
+    for(unsigned i = 0; i < attrCount; ++i){
+        if(decoder.kinds_[i] == EventBatchDecoder::FAST_ARRAY){
+            decoder.columns_[i].clear();
+            decoder.arrayIndex_[i]->clear();
+            decoder.arrayValues_[i]->clear();
+        }
+        else{
+            decoder.columns_[i]->clear();
+        }
+    }
+    decoder.rows_ = 0;
+}
+
+bool EventHandler::deserializeEvent(ConstantSP obj, const EventBatchMessageHandler& handler, ErrorCodeInfo& errorInfo){
+    int eventTypeIndex = isNeedEventTime_ ? 1 : 0;
+    int blobIndex = isNeedEventTime_ ? 2 : 1;
+    VectorSP eventTypeVec = obj->get(eventTypeIndex);
+    VectorSP blobVec = obj->get(blobIndex);
+    const StringVector* blobs = dynamic_cast<const StringVector*>(blobVec.get());
+    INDEX rowSize = eventTypeVec->size();
+    int current = -1;
+    for(INDEX rowIndex = 0; rowIndex < rowSize; ++rowIndex){
+        int id = findEventId(eventTypeVec, rowIndex);
+        if(id < 0){
+            if(current >= 0){
+                deliver(decoders_[current], handler);
+            }
+            errorInfo.set(ErrorCodeInfo::EC_InvalidParameter, "UnKnown eventType" + eventTypeVec->getString(rowIndex));
+            return false;
+        }
+        if(id != current){
+            if(current >= 0){
+                deliver(decoders_[current], handler);
+            }
+            current = id;
+        }
+        EventBatchDecoder& decoder = decoders_[id];
+        StringView blob = StringVector::getStringView(blobVec.get(), blobs, rowIndex);
+        IO_ERR ioError;
+        if(decoder.hasObject_){
+            //ConstantUnmarshall needs a shared stream.
+            DataInputStreamSP input = new DataInputStream(blob.data, blob.length, false);
+            ioError = decodeAttributes(decoder, input.get(), input);
+        }
+        else{
+            DataInputStream input(blob.data, blob.length, false);
+            ioError = decodeAttributes(decoder, &input, nullptr);
+        }
+        if(ioError != OK){
+            //The columns may hold a partial row, drop the whole run.
+            for(unsigned i = 0; i < decoder.kinds_.size(); ++i){
+                if(decoder.kinds_[i] == EventBatchDecoder::FAST_ARRAY){
+                    decoder.arrayIndex_[i]->clear();
+                    decoder.arrayValues_[i]->clear();
+                }
+                else{
+                    decoder.columns_[i]->clear();
+                }
+            }
+            decoder.rows_ = 0;
+            errorInfo.set(ErrorCodeInfo::EC_InvalidObject, "Deserialize blob error " + std::to_string(ioError));
+            return false;
+        }
+        ++decoder.rows_;
+    }
+    if(current >= 0){
+        deliver(decoders_[current], handler);
+    }
+    return true;
+}
+
+const EventInfo* EventHandler::checkAttributes(const std::string& eventType, const std::vector<ConstantSP>& attributes, std::string& errMsg){
     auto iter = eventInfos_.find(eventType);
     if(iter == eventInfos_.end()){
         errMsg = "unknown eventType " + eventType;
-        return false;
+        return nullptr;
     }
     const EventInfo& info = iter->second;
     if(attributes.size() != info.attributeSerializers_.size()){
         errMsg = "the number of event values does not match " + eventType;
-        return false;
+        return nullptr;
     }
 
     for(unsigned i = 0; i < attributes.size(); ++i){
@@ -329,21 +551,41 @@ bool EventHandler::serializeEvent(const std::string& eventType, const std::vecto
             }
             errMsg = "Expected type for the field " + info.eventSchema_->schema_.fieldNames_[i] + " of " + eventType + " : " + Util::getDataTypeString(info.eventSchema_->schema_.fieldTypes_[i]) +
             ", but now it is " + Util::getDataTypeString(attributes[i]->getType());
-            return false;
+            return nullptr;
         }
         if(info.eventSchema_->schema_.fieldForms_[i] != attributes[i]->getForm()){
             errMsg = "Expected form for the field " + info.eventSchema_->schema_.fieldNames_[i] + " of " + eventType + " : " + Util::getDataFormString(info.eventSchema_->schema_.fieldForms_[i]) +
             ", but now it is " + Util::getDataFormString(attributes[i]->getForm());
-            return false;
+            return nullptr;
         }
         if(Util::getCategory(attributes[i]->getRawType()) == DENARY){
             if(info.eventSchema_->schema_.fieldExtraParams_[i] != attributes[i]->getExtraParamForType()){
                 errMsg = "Expected extraParams for the field " + info.eventSchema_->schema_.fieldNames_[i] + " of " + eventType + " : " + std::to_string(info.eventSchema_->schema_.fieldExtraParams_[i]) +
                 ", but now it is " + std::to_string(attributes[i]->getExtraParamForType());
-                return false;
+                return nullptr;
             }
         }
     }
+    return &info;
+}
+
+bool EventHandler::serializeAttributes(const EventInfo& info, const std::vector<ConstantSP>& attributes, const DataOutputStreamSP& outStream, std::string& errMsg){
+    for(unsigned i = 0; i < attributes.size(); ++i){
+        IO_ERR ret = info.attributeSerializers_[i]->serialize(attributes[i], outStream);
+        if(ret != IO_ERR::OK){
+            errMsg = "Failed to serialize the field " + info.eventSchema_->schema_.fieldNames_[i] + ", errorCode " + std::to_string(ret);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EventHandler::serializeEvent(const std::string& eventType, const std::vector<ConstantSP>& attributes, std::vector<ConstantSP>& serializedEvent, std::string& errMsg){
+    const EventInfo* infoPtr = checkAttributes(eventType, attributes, errMsg);
+    if(infoPtr == nullptr){
+        return false;
+    }
+    const EventInfo& info = *infoPtr;
 
     //std::vector<ConstantSP> oneLineContent;
     VectorSP oneLineContent = Util::createVector(dolphindb::DT_ANY, 0, outputColNums_);
@@ -353,12 +595,8 @@ bool EventHandler::serializeEvent(const std::string& eventType, const std::vecto
     oneLineContent->append(Util::createString(eventType));
     //serialize all attribute to a blob
     DataOutputStreamSP outStream = new DataOutputStream(1024);
-    for(unsigned i = 0; i < attributes.size(); ++i){
-        IO_ERR ret = info.attributeSerializers_[i]->serialize(attributes[i], outStream);
-        if(ret != IO_ERR::OK){
-            errMsg = "Failed to serialize the field " + info.eventSchema_->schema_.fieldNames_[i] + ", errorCode " + std::to_string(ret);
-            return false;
-        }
+    if(!serializeAttributes(info, attributes, outStream, errMsg)){
+        return false;
     }
     oneLineContent->append(Util::createBlob(std::string(outStream->getBuffer(), outStream->size())));
 
@@ -376,6 +614,74 @@ bool EventHandler::serializeEvent(const std::string& eventType, const std::vecto
     return true;
 }
 
+bool EventHandler::appendEvent(const std::string& eventType, const std::vector<ConstantSP>& attributes, std::vector<VectorSP>& columns, std::string& errMsg){
+    const EventInfo* infoPtr = checkAttributes(eventType, attributes, errMsg);
+    if(infoPtr == nullptr){
+        return false;
+    }
+    const EventInfo& info = *infoPtr;
+    if(appendBuffer_.isNull()){
+        appendBuffer_ = new EventBufferStream(1024);
+    }
+    appendBuffer_->reset();
+    DataOutputStreamSP outStream = appendBuffer_;
+    if(!serializeAttributes(info, attributes, outStream, errMsg)){
+        return false;
+    }
+
+    //Same layout as serializeEvent: [eventTime], eventType, blob, common fields. Casts run before anything is appended.
+    ConstantSP eventTime;
+    std::size_t colIdx = 0;
+    if(isNeedEventTime_){
+        eventTime = attributes[info.eventSchema_->timeIndex_];
+        if(eventTime->getType() != columns[colIdx]->getType()){
+            eventTime = eventTime->castTemporal(columns[colIdx]->getType());
+        }
+        colIdx++;
+    }
+    colIdx += 2;
+    std::vector<ConstantSP> commons;
+    for(auto commonIndex : info.eventSchema_->commonKeyIndex_){
+        ConstantSP value = attributes[commonIndex];
+        if(info.eventSchema_->schema_.fieldForms_[commonIndex] == DF_VECTOR){
+            VectorSP any = Util::createVector(DT_ANY, 0, 1);
+            any->append(value);
+            value = any;
+        }
+        else if(Util::getCategory(value->getType()) == TEMPORAL && value->getType() != columns[colIdx]->getType()){
+            value = value->castTemporal(columns[colIdx]->getType());
+        }
+        commons.push_back(value);
+        colIdx++;
+    }
+
+    colIdx = 0;
+    bool ok = true;
+    if(isNeedEventTime_){
+        ok = columns[colIdx++]->append(eventTime);
+    }
+    if(ok){
+        std::string type = eventType;
+        ok = columns[colIdx++]->appendString(&type, 1);
+    }
+    if(ok){
+        std::string blob(outStream->getBuffer(), outStream->size());
+        ok = columns[colIdx++]->appendString(&blob, 1);
+    }
+    for(std::size_t k = 0; ok && k < commons.size(); ++k){
+        ok = columns[colIdx++]->append(commons[k]);
+    }
+    if(!ok){
+        //Roll back the columns already appended so that the buffer stays rectangular.
+        for(std::size_t j = 0; j + 1 < colIdx; ++j){
+            columns[j]->remove(1);
+        }
+        errMsg = "Failed to append the event " + eventType + " to column " + std::to_string(colIdx - 1) + " of the output table";
+        return false;
+    }
+    return true;
+}
+
 bool EventHandler::checkOutputTable(TableSP outputTable, std::string& errMsg){
     outputColNums_ = isNeedEventTime_ ? (3 + commonKeySize_) : (2 + commonKeySize_);
     if(outputColNums_ != outputTable->columns()){
@@ -406,28 +712,173 @@ bool EventHandler::checkOutputTable(TableSP outputTable, std::string& errMsg){
 }
 
 
-EventSender::EventSender(DBConnectionSP conn, const std::string& tableName, const std::vector<EventSchema>& eventSchema, const std::vector<std::string>& eventTimeFields, const std::vector<std::string>& commonFields)
-    : eventHandler_(eventSchema, eventTimeFields, commonFields), conn_(conn)
+EventSender::EventSender(DBConnectionSP conn, const std::string& tableName, const std::vector<EventSchema>& eventSchema, const std::vector<std::string>& eventTimeFields, const std::vector<std::string>& commonFields,
+                         int batchSize, int throttle, int maxPending)
+    : eventHandler_(eventSchema, eventTimeFields, commonFields), conn_(conn), batchSize_(batchSize), throttle_(throttle),
+      maxPending_(maxPending > 0 ? maxPending : 4 * batchSize)
 {
     if(tableName.empty()){
         throw RuntimeException("tableName must not be empty.");
     }
     std::string sql = "select top 0 * from " + tableName;
     std::string errMsg;
-    ConstantSP outputTable = conn_->run(sql);
+    TableSP outputTable = conn_->run(sql);
     if(!eventHandler_.checkOutputTable(outputTable, errMsg)){
         throw RuntimeException(errMsg);
     }
     insertScript_ = "tableInsert{" + tableName + "}";
+    if(batchSize_ <= 0){
+        return;
+    }
+    if(maxPending_ < batchSize_){
+        throw RuntimeException("maxPending must not be less than batchSize.");
+    }
+    for(int i = 0; i < outputTable->columns(); ++i){
+        columnNames_.push_back(outputTable->getColumnName(i));
+        VectorSP column = outputTable->getColumn(i);
+        activeColumns_.push_back(column->getInstance(0));
+        flushColumns_.push_back(column->getInstance(0));
+    }
+    sendThread_ = new Thread(new Executor([this](){
+        runSender();
+    }));
+    sendThread_->start();
+}
+
+EventSender::~EventSender(){
+    if(sendThread_.isNull()){
+        return;
+    }
+    {
+        LockGuard<Mutex> guard(&mutex_);
+        stopping_ = true;
+        sendNotifier_.notify();
+    }
+    //The buffered events are inserted before the thread exits.
+    sendThread_->join();
 }
 
 void EventSender::sendEvent(const std::string& eventType, const std::vector<ConstantSP>& attributes){
-    std::vector<ConstantSP> args;
     std::string errMsg;
-    if(!eventHandler_.serializeEvent(eventType, attributes, args, errMsg)){
+    if(batchSize_ <= 0){
+        std::vector<ConstantSP> args;
+        if(!eventHandler_.serializeEvent(eventType, attributes, args, errMsg)){
+            throw RuntimeException("serialize event Fail for " + errMsg);
+        }
+        conn_->run(insertScript_, args);
+        return;
+    }
+    LockGuard<Mutex> guard(&mutex_);
+    while(activeRows_ + sendingRows_ >= maxPending_){
+        spaceNotifier_.wait(mutex_);
+    }
+    if(!eventHandler_.appendEvent(eventType, attributes, activeColumns_, errMsg)){
         throw RuntimeException("serialize event Fail for " + errMsg);
     }
-    conn_->run(insertScript_, args);
+    if(activeRows_++ == 0){
+        activeSince_ = Util::getEpochTime();
+    }
+    //The sender sleeps without a deadline while the buffer is empty, so wake it for the first event and a full batch.
+    if(activeRows_ == 1 || activeRows_ >= batchSize_){
+        sendNotifier_.notify();
+    }
 }
 
-}
\ No newline at end of file
+void EventSender::flush(){
+    if(sendThread_.isNull()){
+        return;
+    }
+    LockGuard<Mutex> guard(&mutex_);
+    if(activeRows_ > 0){
+        flushRequested_ = true;
+        sendNotifier_.notify();
+    }
+    while(activeRows_ + sendingRows_ > 0){
+        spaceNotifier_.wait(mutex_);
+    }
+    if(lastError_.hasError()){
+        std::string errMsg = lastError_.errorInfo;
+        lastError_.clearError();
+        throw RuntimeException("Failed to send events: " + errMsg);
+    }
+}
+
+void EventSender::setSendFailureHandler(const std::function<void(const ErrorCodeInfo&, int)>& handler){
+    LockGuard<Mutex> guard(&mutex_);
+    failureHandler_ = handler;
+}
+
+long long EventSender::getPendingEvents(){
+    LockGuard<Mutex> guard(&mutex_);
+    return activeRows_ + sendingRows_;
+}
+
+long long EventSender::getSentEvents(){
+    LockGuard<Mutex> guard(&mutex_);
+    return sentEvents_;
+}
+
+long long EventSender::getFailedEvents(){
+    LockGuard<Mutex> guard(&mutex_);
+    return failedEvents_;
+}
+
+void EventSender::runSender(){
+    while(true){
+        std::function<void(const ErrorCodeInfo&, int)> handler;
+        {
+            LockGuard<Mutex> guard(&mutex_);
+            while(true){
+                if(activeRows_ == 0){
+                    if(stopping_){
+                        return;
+                    }
+                    sendNotifier_.wait(mutex_);
+                    continue;
+                }
+                long long now = Util::getEpochTime();
+                if(stopping_ || flushRequested_ || activeRows_ >= batchSize_ || now - activeSince_ >= throttle_){
+                    break;
+                }
+                sendNotifier_.wait(mutex_, static_cast<int>(std::max(1LL, activeSince_ + throttle_ - now)));
+            }
+            std::swap(activeColumns_, flushColumns_);
+            sendingRows_ = activeRows_;
+            activeRows_ = 0;
+            flushRequested_ = false;
+            handler = failureHandler_;
+        }
+        ErrorCodeInfo error;
+        try{
+            std::vector<ConstantSP> columns(flushColumns_.begin(), flushColumns_.end());
+            //BasicTable adopts temporary vectors instead of copying them.
+            for(auto& column : columns){
+                column->setTemporary(true);
+            }
+            std::vector<ConstantSP> args = {Util::createTable(columnNames_, columns)};
+            conn_->run(insertScript_, args);
+        }
+        catch(std::exception& e){
+            error.set(ErrorCodeInfo::EC_Server, e.what());
+        }
+        int rows = sendingRows_;
+        if(error.hasError() && handler){
+            handler(error, rows);
+        }
+        LockGuard<Mutex> guard(&mutex_);
+        for(auto& column : flushColumns_){
+            column->clear();
+        }
+        if(error.hasError()){
+            failedEvents_ += rows;
+            lastError_.set(error);
+        }
+        else{
+            sentEvents_ += rows;
+        }
+        sendingRows_ = 0;
+        spaceNotifier_.notifyAll();
+    }
+}
+
+}
@@ -6,6 +6,7 @@
  */
 
 #include <climits>
+#include <cstring>
 
 #include "Format.h"
 #include "Exceptions.h"
@@ -173,8 +174,22 @@ void NumberFormat::initialize(const string& form) {
 	tail_ = form.substr(lastSymPos + 1, tailSize_);
 }
 
+int NumberFormat::getMaxLength() const{
+	//Sign, integer digits with separators, point, fraction digits, exponent with sign, percent sign.
+	return headSize_ + tailSize_ + 1 + 2 * (std::max)(integerMinDigits_, 16) + 1 + fractionMinDigits_ + fractionOptionalDigits_ + 2 + (std::max)(science_, 4) + 1;
+}
+
 string NumberFormat::format(double x) const{
-	char buf[128];
+	int maxLength = getMaxLength();
+	if(maxLength <= 128){
+		char buf[128];
+		return string(buf, format(x, buf));
+	}
+	vector<char> buf(maxLength);
+	return string(buf.data(), format(x, buf.data()));
+}
+
+int NumberFormat::format(double x, char* buf) const{
 	int cursor = 0;
 
    for(int i=0; i<headSize_; ++i)
@@ -284,18 +299,23 @@ string NumberFormat::format(double x) const{
         buf[cursor++] = '%';
     for(int i=0; i<tailSize_; ++i)
     	buf[cursor++] = tail_[i];
-    buf[cursor] = 0;
-    return buf;
+    return cursor;
 }
 
 string NumberFormat::toString(long long x){
-	char buf[30];
+	char buf[24];
+	return string(buf, toString(x, buf));
+}
+
+int NumberFormat::toString(long long val, char* buf){
 	int cursor = 0;
 	int start = 0;
-	if(x < 0){
+	//Unsigned, so that LLONG_MIN negates without overflow.
+	unsigned long long x = static_cast<unsigned long long>(val);
+	if(val < 0){
 		buf[cursor++] = '-';
 		start = 1;
-		x = -x;
+		x = 0 - x;
 	}
 	while (x) {
 		buf[cursor++] = x % 10 + '0';
@@ -310,8 +330,7 @@ string NumberFormat::toString(long long x){
 		buf[start + i] = buf[cursor - 1 - i];
 		buf[cursor - 1 - i] = tmp;
 	}
-	buf[cursor] = 0;
-	return buf;
+	return cursor;
 }
 
 DecimalFormat::DecimalFormat(const string& form) : format_(0), negFormat_(0){
@@ -410,6 +429,11 @@ void TemporalFormat::initialize(const string& form) {
 }
 
 string TemporalFormat::format(long long nowtime, DATA_TYPE dtype) const{
+	char buf[MAX_OUTPUT_LENGTH];
+	return string(buf, format(nowtime, dtype, buf));
+}
+
+int TemporalFormat::format(long long nowtime, DATA_TYPE dtype, char* buf) const{
 	int timeNumber[10];
 	memset(timeNumber, 0, sizeof(timeNumber));
 	timeNumber[0] = 1970;
@@ -523,74 +547,75 @@ string TemporalFormat::format(long long nowtime, DATA_TYPE dtype) const{
 	}
 
 	if (quickFormat_) {
-		string templateString(format_);
+		int length = static_cast<int>(format_.size());
+		memcpy(buf, format_.data(), length);
 		for (int i = 0; i < segmentCount_; ++i) {
 			int leftPos = segments_[i].startPos_;
 			int rightPos = segments_[i].endPos_;
 			int id = segments_[i].timeUnitIndex_;
 			if (id == 5) {
 				for (int j = leftPos, cnt = 0; j <= rightPos; ++j, ++cnt) {
-					templateString[j] = cnt < 2 ? (timeNumber[5] ? pmString[cnt] : amString[cnt]) : ' ';
+					buf[j] = cnt < 2 ? (timeNumber[5] ? pmString[cnt] : amString[cnt]) : ' ';
 				}
 			} else if (id == 1 && rightPos - leftPos + 1 == 3) {
 				const char* month = monthName[timeNumber[1] - 1];
 				for (int j = leftPos; j <= rightPos; ++j) {
-					templateString[j] = month[j - leftPos];
+					buf[j] = month[j - leftPos];
 				}
 			} else {
 				int tmp = timeNumber[id];
 				for (int j = rightPos; j >= leftPos; --j) {
-					templateString[j] = tmp % 10 + '0';
+					buf[j] = tmp % 10 + '0';
 					tmp /= 10;
 				}
 			}
 		}
-		return templateString;
+		return length;
 	}
 	else {
-		string resultString;
+		int cursor = 0;
 		int prePos = 0;
 		for (int i = 0; i < segmentCount_; ++i) {
-			string tmpString;
 			int leftPos = segments_[i].startPos_;
 			int rightPos = segments_[i].endPos_;
 			int index = segments_[i].timeUnitIndex_;
 			int unitDemandlength = segments_[i].maxLength_;
 			int formatDemandLength = rightPos - leftPos + 1;
 
-			resultString += format_.substr(prePos, leftPos - prePos);
+			memcpy(buf + cursor, format_.data() + prePos, leftPos - prePos);
+			cursor += leftPos - prePos;
 			if (index == 5) {
 				for (int j = 0; j < formatDemandLength; ++j) {
-					tmpString += (j < 2) ? (timeNumber[5] ? pmString[j] : amString[j]) : ' ';
+					buf[cursor++] = (j < 2) ? (timeNumber[5] ? pmString[j] : amString[j]) : ' ';
 				}
 			} else if (index == 1 && formatDemandLength == 3) {
 				const char* month = monthName[timeNumber[1] - 1];
 				for (int j = 0; j < 3; ++j) {
-					tmpString += month[j];
+					buf[cursor++] = month[j];
 				}
 			} else if (index == 0 && formatDemandLength == 2) {
-				resultString += (timeNumber[0] / 10) % 10 + '0';
-				resultString += timeNumber[0] % 10 + '0';
+				buf[cursor++] = (timeNumber[0] / 10) % 10 + '0';
+				buf[cursor++] = timeNumber[0] % 10 + '0';
 			} else {
 				int tmpNumber = timeNumber[index];
+				int start = cursor;
 				int cntDigits = 0;
 
 				for (int j = 0; j < unitDemandlength; ++j) {
 					cntDigits++;
-					tmpString += tmpNumber % 10 + '0';
+					buf[cursor++] = tmpNumber % 10 + '0';
 					tmpNumber /= 10;
 					if (cntDigits >= formatDemandLength && tmpNumber == 0)
 						break;
 				}
 				for (int j = 0; j < formatDemandLength - cntDigits; ++j)
-					tmpString += '0';
-				std::reverse(tmpString.begin(), tmpString.end());
+					buf[cursor++] = '0';
+				std::reverse(buf + start, buf + cursor);
 			}
-			resultString += tmpString;
 			prePos = rightPos + 1;
 		}
-		resultString += format_.substr(prePos, format_.length() - prePos);
-		return resultString;
+		memcpy(buf + cursor, format_.data() + prePos, format_.length() - prePos);
+		return cursor + static_cast<int>(format_.length()) - prePos;
 	}
 }
 
@@ -0,0 +1,88 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include "Exceptions.h"
+
+#ifdef WINDOWS
+#include <winsock2.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dolphindb {
+
+MappedFile::MappedFile(const std::string& path, bool writable, bool sequential) : data_(nullptr), size_(0) {
+#ifdef WINDOWS
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        throw RuntimeException("Failed to open file " + path + ", error code " + std::to_string(GetLastError()));
+    file_ = file;
+    mapping_ = NULL;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw RuntimeException("Failed to get the size of file " + path);
+    }
+    size_ = (size_t)size.QuadPart;
+    if (size_ == 0)
+        return;
+    HANDLE mapping = CreateFileMappingA(file, NULL, writable ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    if (mapping != NULL)
+        data_ = (char*)MapViewOfFile(mapping, writable ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    if (data_ == nullptr) {
+        DWORD err = GetLastError();
+        if (mapping != NULL)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        throw RuntimeException("Failed to map file " + path + ", error code " + std::to_string(err));
+    }
+    mapping_ = mapping;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw RuntimeException("Failed to open file " + path + ": " + strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int err = errno;
+        close(fd);
+        throw RuntimeException("Failed to get the size of file " + path + ": " + strerror(err));
+    }
+    size_ = (size_t)st.st_size;
+    if (size_ > 0) {
+        void* addr = mmap(NULL, size_, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            int err = errno;
+            close(fd);
+            throw RuntimeException("Failed to map file " + path + ": " + strerror(err));
+        }
+        data_ = (char*)addr;
+#ifdef MADV_SEQUENTIAL
+        if (sequential)
+            madvise(addr, size_, MADV_SEQUENTIAL);
+#endif
+    }
+    //The mapping keeps the file referenced.
+    close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef WINDOWS
+    if (data_ != nullptr)
+        UnmapViewOfFile(data_);
+    if (mapping_ != NULL)
+        CloseHandle((HANDLE)mapping_);
+    CloseHandle((HANDLE)file_);
+#else
+    if (data_ != nullptr)
+        munmap(data_, size_);
+#endif
+}
+
+}
@@ -0,0 +1,265 @@
+#include "Metrics.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <map>
+
+namespace dolphindb {
+
+namespace {
+
+int highestBit(unsigned long long value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+const char* typeName(METRIC_TYPE type) {
+    switch (type) {
+    case METRIC_COUNTER: return "counter";
+    case METRIC_GAUGE: return "gauge";
+    default: return "summary";
+    }
+}
+
+}
+
+MetricHistogram::MetricHistogram() : buckets_(new std::atomic<long long>[BUCKET_COUNT]) {
+    reset();
+}
+
+int MetricHistogram::bucketIndex(long long value) {
+    if (value < (1LL << SUB_BUCKET_BITS))
+        return value < 0 ? 0 : (int)value;
+    int msb = highestBit((unsigned long long)value);
+    int shift = msb - (SUB_BUCKET_BITS - 1);
+    int mantissa = (int)(value >> shift) - (1 << (SUB_BUCKET_BITS - 1));
+    return (1 << SUB_BUCKET_BITS) + (shift - 1) * (1 << (SUB_BUCKET_BITS - 1)) + mantissa;
+}
+
+long long MetricHistogram::bucketLowerBound(int index) {
+    if (index < (1 << SUB_BUCKET_BITS))
+        return index;
+    int k = index - (1 << SUB_BUCKET_BITS);
+    int shift = k / (1 << (SUB_BUCKET_BITS - 1)) + 1;
+    long long mantissa = k % (1 << (SUB_BUCKET_BITS - 1)) + (1 << (SUB_BUCKET_BITS - 1));
+    return mantissa << shift;
+}
+
+void MetricHistogram::record(long long value) {
+    if (value < 0)
+        value = 0;
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    long long old = min_.load(std::memory_order_relaxed);
+    while (value < old && !min_.compare_exchange_weak(old, value, std::memory_order_relaxed)) {}
+    old = max_.load(std::memory_order_relaxed);
+    while (value > old && !max_.compare_exchange_weak(old, value, std::memory_order_relaxed)) {}
+}
+
+long long MetricHistogram::min() const {
+    long long value = min_.load(std::memory_order_relaxed);
+    return value == LLONG_MAX ? 0 : value;
+}
+
+long long MetricHistogram::percentile(double q) const {
+    long long total = count();
+    if (total == 0)
+        return 0;
+    q = std::max(0.0, std::min(1.0, q));
+    long long rank = (long long)(q * total + 0.5);
+    if (rank < 1)
+        rank = 1;
+    long long seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            //Report the middle of the bucket, clamped by the exact extremes.
+            long long lower = bucketLowerBound(i);
+            long long upper = i + 1 < BUCKET_COUNT ? bucketLowerBound(i + 1) - 1 : LLONG_MAX;
+            long long value = lower + (upper - lower) / 2;
+            return std::max(min(), std::min(max(), value));
+        }
+    }
+    return max();
+}
+
+void MetricHistogram::reset() {
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+        buckets_[i].store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(LLONG_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+std::string MetricsRegistry::label(const std::string &key, const std::string &value) {
+    std::string out = key + "=\"";
+    for (char ch : value) {
+        if (ch == '"' || ch == '\\')
+            out.append(1, '\\');
+        if (ch == '\n')
+            out.append("\\n");
+        else
+            out.append(1, ch);
+    }
+    out.append(1, '"');
+    return out;
+}
+
+MetricsRegistry::Entry* MetricsRegistry::findOrCreate(const std::string &name, const std::string &labels, METRIC_TYPE type) {
+    std::string key = name + "{" + labels + "}";
+    auto iter = index_.find(key);
+    if (iter != index_.end()) {
+        if (iter->second->type != type)
+            throw RuntimeException("Metric " + key + " is already registered with type " + typeName(iter->second->type));
+        return iter->second;
+    }
+    Entry *entry = new Entry();
+    entry->type = type;
+    entry->name = name;
+    entry->labels = labels;
+    entries_.emplace_back(entry);
+    index_[key] = entry;
+    return entry;
+}
+
+MetricCounter* MetricsRegistry::counter(const std::string &name, const std::string &labels) {
+    LockGuard<Mutex> guard(&mutex_);
+    Entry *entry = findOrCreate(name, labels, METRIC_COUNTER);
+    if (!entry->counter)
+        entry->counter.reset(new MetricCounter());
+    return entry->counter.get();
+}
+
+MetricGauge* MetricsRegistry::gauge(const std::string &name, const std::string &labels) {
+    LockGuard<Mutex> guard(&mutex_);
+    Entry *entry = findOrCreate(name, labels, METRIC_GAUGE);
+    if (!entry->gauge)
+        entry->gauge.reset(new MetricGauge());
+    return entry->gauge.get();
+}
+
+MetricHistogram* MetricsRegistry::histogram(const std::string &name, const std::string &labels) {
+    LockGuard<Mutex> guard(&mutex_);
+    Entry *entry = findOrCreate(name, labels, METRIC_HISTOGRAM);
+    if (!entry->histogram)
+        entry->histogram.reset(new MetricHistogram());
+    return entry->histogram.get();
+}
+
+void MetricsRegistry::registerGauge(const std::string &name, const std::string &labels, const std::function<double()> &func) {
+    LockGuard<Mutex> guard(&mutex_);
+    Entry *entry = findOrCreate(name, labels, METRIC_GAUGE);
+    entry->func = func;
+}
+
+void MetricsRegistry::unregisterGauge(const std::string &name, const std::string &labels) {
+    LockGuard<Mutex> guard(&mutex_);
+    auto iter = index_.find(name + "{" + labels + "}");
+    if (iter == index_.end() || iter->second->type != METRIC_GAUGE)
+        return;
+    Entry *entry = iter->second;
+    if (entry->gauge) {
+        //Plain gauges may be cached by callers, only drop the callback.
+        entry->func = nullptr;
+        return;
+    }
+    index_.erase(iter);
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(), [&](const std::unique_ptr<Entry> &one) {
+        return one.get() == entry;
+    }), entries_.end());
+}
+
+void MetricsRegistry::snapshot(std::vector<MetricSample> &samples) {
+    static const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+    LockGuard<Mutex> guard(&mutex_);
+    for (auto &entry : entries_) {
+        MetricSample sample;
+        sample.name = entry->name;
+        sample.labels = entry->labels;
+        sample.type = entry->type;
+        sample.value = 0;
+        sample.count = 0;
+        sample.sum = 0;
+        switch (entry->type) {
+        case METRIC_COUNTER:
+            sample.value = (double)entry->counter->get();
+            break;
+        case METRIC_GAUGE:
+            if (entry->func)
+                sample.value = entry->func();
+            else if (entry->gauge)
+                sample.value = entry->gauge->get();
+            break;
+        case METRIC_HISTOGRAM:
+            sample.count = entry->histogram->count();
+            sample.sum = entry->histogram->sum();
+            for (double q : quantiles)
+                sample.quantiles.emplace_back(q, entry->histogram->percentile(q));
+            break;
+        }
+        samples.push_back(std::move(sample));
+    }
+}
+
+std::string MetricsRegistry::toPrometheusText() {
+    std::vector<MetricSample> samples;
+    snapshot(samples);
+    //Group samples of the same metric so that each family has a single TYPE line.
+    std::map<std::string, std::vector<const MetricSample*>> families;
+    for (auto &sample : samples)
+        families[sample.name].push_back(&sample);
+    std::string out;
+    char buf[64];
+    for (auto &family : families) {
+        out.append("# TYPE ").append(family.first).append(" ").append(typeName(family.second[0]->type)).append("\n");
+        for (const MetricSample *sample : family.second) {
+            std::string labels = sample->labels;
+            if (sample->type != METRIC_HISTOGRAM) {
+                out.append(sample->name);
+                if (!labels.empty())
+                    out.append("{").append(labels).append("}");
+                snprintf(buf, sizeof(buf), " %.17g\n", sample->value);
+                out.append(buf);
+                continue;
+            }
+            for (auto &q : sample->quantiles) {
+                snprintf(buf, sizeof(buf), "quantile=\"%g\"", q.first);
+                out.append(sample->name).append("{").append(labels);
+                if (!labels.empty())
+                    out.append(",");
+                out.append(buf).append("} ").append(std::to_string(q.second)).append("\n");
+            }
+            std::string suffix = labels.empty() ? std::string() : "{" + labels + "}";
+            out.append(sample->name).append("_sum").append(suffix).append(" ").append(std::to_string(sample->sum)).append("\n");
+            out.append(sample->name).append("_count").append(suffix).append(" ").append(std::to_string(sample->count)).append("\n");
+        }
+    }
+    return out;
+}
+
+void MetricsRegistry::reset() {
+    LockGuard<Mutex> guard(&mutex_);
+    for (auto &entry : entries_) {
+        if (entry->counter)
+            entry->counter->increment(-entry->counter->get());
+        if (entry->gauge)
+            entry->gauge->set(0);
+        if (entry->histogram)
+            entry->histogram->reset();
+    }
+}
+
+}
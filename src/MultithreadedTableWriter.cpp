@@ -3,6 +3,9 @@
 #include "Domain.h"
 #include "Logger.h"
 #include "DolphinDB.h"
+#include "Tracing.h"
+#include "Metrics.h"
+#include "RadixScatter.h"
 #include <thread>
 //#include "DdbPythonUtil.h"
 
@@ -224,9 +227,21 @@ MultithreadedTableWriter::MultithreadedTableWriter(const std::string& hostName,
         writerThread.writeThread = new Thread(new SendExecutor(*this, writerThread));
         writerThread.writeThread->start();
     }
+    static std::atomic<int> writerSeq(0);
+    metricsLabels_ = MetricsRegistry::label("table", dbName_.empty() ? tableName_ : dbName_ + "/" + tableName_) + "," +
+                     MetricsRegistry::label("writer", std::to_string(writerSeq.fetch_add(1)));
+    MetricsRegistry::instance().registerGauge("ddb_mtw_unsent_rows", metricsLabels_, [this]() {
+        double rows = 0;
+        for (auto& writerThread : threads_) {
+            LockGuard<Mutex> _(&writerThread.writeQueueMutex_);
+            rows += (double)(writerThread.writeQueue_.size() - 1) * perBlockSize_ + writerThread.writeQueue_.back()->front()->size();
+        }
+        return rows;
+    });
 }
 
 MultithreadedTableWriter::~MultithreadedTableWriter() {
+    MetricsRegistry::instance().unregisterGauge("ddb_mtw_unsent_rows", metricsLabels_);
     waitForThreadCompletion();
     {
         std::vector<ConstantSP>* pitem = nullptr;
@@ -309,28 +324,39 @@ bool MultithreadedTableWriter::insert(std::vector<ConstantSP>** records, int rec
     }
     */
     if (threads_.size() > 1) {
+        int threadCount = static_cast<int>(threads_.size());
+        vector<int> threadindexes;
         if (isPartionedTable_) {
             VectorSP pvector = Util::createVector(getColDataType(partitionColumnIdx_), recordCount, 0);
             for (int i = 0; i < recordCount; i++) {
                 pvector->set(i, records[i]->at(partitionColumnIdx_));
             }
-            vector<int> threadindexes = partitionDomain_->getPartitionKeys(pvector);
-            for (unsigned int row = 0; row < threadindexes.size(); row++) {
-                insertThreadWrite(threadindexes[row], records[row]);
-            }
+            threadindexes = partitionDomain_->getPartitionKeys(pvector);
         }
         else {
-            int threadindex;
+            threadindexes.resize(recordCount);
             for (int i = 0; i < recordCount; i++) {
-                threadindex = records[i]->at(threadByColIndexForNonPartion_)->getHash(static_cast<int>(threads_.size()));
-                insertThreadWrite(threadindex, records[i]);
+                threadindexes[i] = records[i]->at(threadByColIndexForNonPartion_)->getHash(threadCount);
+            }
+        }
+        for (int& threadindex : threadindexes) {
+            threadindex = threadindex < 0 ? 0 : threadindex % threadCount;
+        }
+        if (recordCount == 1) {
+            insertThreadWrite(threadindexes[0], records, nullptr, 1);
+        }
+        else {
+            //Group the rows by thread, so each thread's queue is locked and signalled once per call.
+            RadixScatter scatter(std::move(threadindexes), threadCount);
+            vector<int> order = scatter.rowOrder();
+            for (int i = 0; i < threadCount; i++) {
+                if (scatter.count(i) > 0)
+                    insertThreadWrite(i, records, order.data() + scatter.offset(i), static_cast<int>(scatter.count(i)));
             }
         }
     }
     else {
-        for (int i = 0; i < recordCount; i++) {
-            insertThreadWrite(0, records[i]);
-        }
+        insertThreadWrite(0, records, nullptr, recordCount);
     }
     if(isNeedReleaseMemory){
         for (int i = 0; i < recordCount; i++) {
@@ -384,21 +410,20 @@ void MultithreadedTableWriter::getUnwrittenData(std::vector<std::vector<Constant
     }
 }
 
-void MultithreadedTableWriter::insertThreadWrite(int threadhashkey, std::vector<ConstantSP>* prow) {
-    if (threadhashkey < 0) {
-        threadhashkey = 0;
-    }
-    int threadIndex = threadhashkey % threads_.size();
+void MultithreadedTableWriter::insertThreadWrite(int threadIndex, std::vector<ConstantSP>** records, const int* rows, int count) {
     WriterThread& writerThread = threads_[threadIndex];
     {
         LockGuard<Mutex> _(&writerThread.writeQueueMutex_);
-        if(writerThread.writeQueue_.back()->front()->size() > perBlockSize_){
-            writerThread.writeQueue_.push_back(createColumnBlock());
-        }
-        std::vector<ConstantSP>* q = writerThread.writeQueue_.back();
-        size_t size = prow->size();
-        for(size_t i = 0; i < size; ++i){
-            dynamic_cast<Vector*>(q->at(i).get())->append(prow->at(i));
+        for (int r = 0; r < count; ++r) {
+            if(writerThread.writeQueue_.back()->front()->size() > perBlockSize_){
+                writerThread.writeQueue_.push_back(createColumnBlock());
+            }
+            std::vector<ConstantSP>* q = writerThread.writeQueue_.back();
+            std::vector<ConstantSP>* prow = records[rows == nullptr ? r : rows[r]];
+            size_t size = prow->size();
+            for(size_t i = 0; i < size; ++i){
+                dynamic_cast<Vector*>(q->at(i).get())->append(prow->at(i));
+            }
         }
     }
     writerThread.nonemptySignal.set();
@@ -472,6 +497,7 @@ void MultithreadedTableWriter::SendExecutor::run(){
 }
 
 bool MultithreadedTableWriter::SendExecutor::writeAllData(){
+    DDB_TRACE("MultithreadedTableWriter::SendExecutor::writeAllData");
     //reset idle
     LockGuard<Mutex> _(&writeThread_.mutex_);
     std::vector<ConstantSP>* items = nullptr;
@@ -492,18 +518,23 @@ bool MultithreadedTableWriter::SendExecutor::writeAllData(){
     try{
         TableSP writeTable;
         //create table
+        std::vector<ConstantSP> columns;
         if(tableWriter_.callbackFunc_ != nullptr){
-            writeTable = Util::createTable(tableWriter_.saveColNames_, {items->begin() + 1, items->end()});
+            columns.assign(items->begin() + 1, items->end());
         }
         else{
-            writeTable = Util::createTable(tableWriter_.saveColNames_, *items);
+            columns = *items;
         }
+        writeThread_.symbolEncoder.encode(columns, tableWriter_.saveColTypes_);
+        writeTable = Util::createTable(tableWriter_.saveColNames_, columns);
         writeTable->setColumnCompressMethods(tableWriter_.saveCompressMethods_);
 
         std::vector<ConstantSP> args(1);
         args[0] = writeTable;
         runscript = tableWriter_.scriptTableInsert_;
+        TraceSpan sendSpan(DDB_TRACE_SITE("MultithreadedTableWriter::SendExecutor::send"));
         ConstantSP constsp = writeThread_.conn->run(runscript, args);
+        sendSpan.end();
         writeThread_.sentRows += size;
         MultithreadedTableWriter::callBack(tableWriter_.callbackFunc_, true, items);
         if (tableWriter_.unusedQueue_.size() < 10) {
@@ -0,0 +1,120 @@
+#include "RadixScatter.h"
+
+#include "ConstantImp.h"
+#include "Exceptions.h"
+#include "Util.h"
+#include "VectorView.h"
+#include "WideInteger.h"
+
+namespace dolphindb {
+
+namespace {
+
+//Each destination's values are written in order behind a cursor of its own.
+template<class T>
+void scatterValues(const T* values, const int* ids, INDEX rows, std::vector<T*> cursors) {
+    for (INDEX i = 0; i < rows; ++i)
+        *cursors[ids[i]]++ = values[i];
+}
+
+template<class T>
+void scatterColumn(const VectorSP& column, const int* ids, const std::vector<VectorSP>& out) {
+    std::vector<T*> outputs(out.size());
+    for (size_t dest = 0; dest < out.size(); ++dest)
+        outputs[dest] = (T*)out[dest]->getDataArray();
+    scatterValues((const T*)column->getDataArray(), ids, column->size(), outputs);
+}
+
+void scatterStrings(const StringVector* column, const int* ids, const std::vector<VectorSP>& out) {
+    INDEX rows = column->size();
+    for (INDEX i = 0; i < rows; ++i) {
+        StringView value = column->getStringView(i);
+        ((StringVector*)out[ids[i]].get())->appendStringView(&value, 1);
+    }
+}
+
+}
+
+RadixScatter::RadixScatter(std::vector<int> partitionIds, int destinations) : ids_(std::move(partitionIds)), destinations_(destinations),
+        offsets_(destinations + 1, 0) {
+    if (destinations <= 0)
+        throw RuntimeException("The number of destinations must be positive.");
+    INDEX rows = (INDEX)ids_.size();
+    for (INDEX i = 0; i < rows; ++i) {
+        int dest = ids_[i];
+        if (dest < 0 || dest >= destinations)
+            throw RuntimeException("The partition id " + std::to_string(dest) + " at row " + std::to_string(i) + " is out of range [0, " + std::to_string(destinations) + ").");
+        ++offsets_[dest + 1];
+    }
+    for (int dest = 0; dest < destinations; ++dest)
+        offsets_[dest + 1] += offsets_[dest];
+}
+
+std::vector<int> RadixScatter::rowOrder() const {
+    std::vector<int> order(ids_.size());
+    std::vector<INDEX> cursors(offsets_.begin(), offsets_.end() - 1);
+    INDEX rows = (INDEX)ids_.size();
+    for (INDEX i = 0; i < rows; ++i)
+        order[cursors[ids_[i]]++] = (int)i;
+    return order;
+}
+
+std::vector<VectorSP> RadixScatter::scatter(const VectorSP& column) const {
+    if (column->size() != rows())
+        throw RuntimeException("The vector to scatter has " + std::to_string(column->size()) + " rows, expect " + std::to_string(rows()) + ".");
+    std::vector<VectorSP> out(destinations_);
+    DATA_TYPE type = column->getType();
+    bool fixedWidth = column->isArray() && column->getVectorType() == VECTOR_TYPE::ARRAY && column->isFastMode()
+                      && column->getDataArray() != NULL && type != DT_VOID && dynamic_cast<const VectorView*>(column.get()) == NULL;
+    const StringVector* strings = dynamic_cast<const StringVector*>(column.get());
+    if (fixedWidth) {
+        for (int dest = 0; dest < destinations_; ++dest) {
+            INDEX size = count(dest);
+            out[dest] = type == DT_SYMBOL ? Util::createSymbolVector(column->getSymbolBase(), size, size)
+                                          : Util::createVector(type, size, size, true, column->getExtraParamForType());
+            out[dest]->setNullFlag(column->getNullFlag());
+        }
+        switch (column->getUnitLength()) {
+            case 1: scatterColumn<char>(column, ids_.data(), out); break;
+            case 2: scatterColumn<short>(column, ids_.data(), out); break;
+            case 4: scatterColumn<int>(column, ids_.data(), out); break;
+            case 8: scatterColumn<long long>(column, ids_.data(), out); break;
+            case 16: scatterColumn<wide_integer::int128>(column, ids_.data(), out); break;
+            default: throw RuntimeException("Can't scatter values of " + std::to_string(column->getUnitLength()) + " bytes.");
+        }
+    }
+    else if (strings != NULL) {
+        for (int dest = 0; dest < destinations_; ++dest)
+            out[dest] = Util::createArenaStringVector(type, count(dest));
+        scatterStrings(strings, ids_.data(), out);
+        for (int dest = 0; dest < destinations_; ++dest)
+            out[dest]->setNullFlag(column->getNullFlag());
+    }
+    else {
+        std::vector<int> order = rowOrder();
+        for (int dest = 0; dest < destinations_; ++dest) {
+            std::shared_ptr<std::vector<int>> indices = std::make_shared<std::vector<int>>(order.begin() + offsets_[dest], order.begin() + offsets_[dest + 1]);
+            VectorSP rows = Util::createGatherView(column, indices);
+            out[dest] = dynamic_cast<VectorView*>(rows.get()) != NULL ? VectorSP(((ConstantSP)rows)->getValue()) : rows;
+        }
+    }
+    return out;
+}
+
+std::vector<TableSP> RadixScatter::scatter(const TableSP& table) const {
+    int columns = table->columns();
+    std::vector<std::string> names(columns);
+    std::vector<std::vector<ConstantSP>> cols(destinations_, std::vector<ConstantSP>(columns));
+    for (int i = 0; i < columns; ++i) {
+        names[i] = table->getColumnName(i);
+        std::vector<VectorSP> parts = scatter(VectorSP(table->getColumn(i)));
+        for (int dest = 0; dest < destinations_; ++dest)
+            cols[dest][i] = parts[dest];
+    }
+    std::vector<TableSP> tables(destinations_);
+    for (int dest = 0; dest < destinations_; ++dest)
+        tables[dest] = Util::createTable(names, cols[dest]);
+    return tables;
+}
+
+}
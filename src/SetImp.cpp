@@ -26,7 +26,7 @@ void CharSet::contain(const ConstantSP& target, const ConstantSP& resultSP) cons
 		INDEX start=0;
 		int count;
 
-		unordered_set<char>::const_iterator end=data_.end();
+		FlatHashSet<char>::const_iterator end=data_.end();
 		while(start<len){
 			count=(std::min)(len-start,bufSize);
 			pbuf=source->getCharConst(start,count,buf);
@@ -84,12 +84,12 @@ bool CharSet::inverse(const ConstantSP& value){
 	INDEX start = 0;
 	int count;
 
-	unordered_set<char>::iterator end = data_.end();
+	FlatHashSet<char>::iterator end = data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getCharConst(start,count,buf);
 		for(int i=0; i<count; ++i){
-			unordered_set<char>::iterator  it = data_.find(pbuf[i]);
+			FlatHashSet<char>::iterator  it = data_.find(pbuf[i]);
 			if(it != end)
 				data_.erase(it);
 			else
@@ -109,7 +109,7 @@ bool CharSet::isSuperset(const ConstantSP& target) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<char>::const_iterator end=data_.end();
+	FlatHashSet<char>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getCharConst(start,count,buf);
@@ -134,7 +134,7 @@ ConstantSP CharSet::interaction(const ConstantSP& value) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<char>::const_iterator end=data_.end();
+	FlatHashSet<char>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getCharConst(start,count,buf);
@@ -148,7 +148,7 @@ ConstantSP CharSet::interaction(const ConstantSP& value) const {
 }
 
 ConstantSP CharSet::getSubVector(INDEX start, INDEX length) const {
-	unordered_set<char>::const_iterator it = data_.begin();
+	FlatHashSet<char>::const_iterator it = data_.begin();
 	for(int i=0; i<start; ++i) ++it;
 	ConstantSP result = Util::createVector(type_, length, 0,true);
 
@@ -185,7 +185,7 @@ void ShortSet::contain(const ConstantSP& target, const ConstantSP& resultSP) con
 		INDEX start=0;
 		int count;
 
-		unordered_set<short>::const_iterator end=data_.end();
+		FlatHashSet<short>::const_iterator end=data_.end();
 		while(start<len){
 			count=(std::min)(len-start,bufSize);
 			pbuf=source->getShortConst(start,count,buf);
@@ -243,12 +243,12 @@ bool ShortSet::inverse(const ConstantSP& value){
 	INDEX start = 0;
 	int count;
 
-	unordered_set<short>::iterator end = data_.end();
+	FlatHashSet<short>::iterator end = data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getShortConst(start,count,buf);
 		for(int i=0; i<count; ++i){
-			unordered_set<short>::iterator  it = data_.find(pbuf[i]);
+			FlatHashSet<short>::iterator  it = data_.find(pbuf[i]);
 			if(it != end)
 				data_.erase(it);
 			else
@@ -268,7 +268,7 @@ bool ShortSet::isSuperset(const ConstantSP& target) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<short>::const_iterator end=data_.end();
+	FlatHashSet<short>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getShortConst(start,count,buf);
@@ -293,7 +293,7 @@ ConstantSP ShortSet::interaction(const ConstantSP& value) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<short>::const_iterator end=data_.end();
+	FlatHashSet<short>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getShortConst(start,count,buf);
@@ -307,7 +307,7 @@ ConstantSP ShortSet::interaction(const ConstantSP& value) const {
 }
 
 ConstantSP ShortSet::getSubVector(INDEX start, INDEX length) const {
-	unordered_set<short>::const_iterator it = data_.begin();
+	FlatHashSet<short>::const_iterator it = data_.begin();
 	for(int i=0; i<start; ++i) ++it;
 	ConstantSP result = Util::createVector(type_, length, 0,true);
 
@@ -344,13 +344,11 @@ void IntSet::contain(const ConstantSP& target, const ConstantSP& resultSP) const
 		INDEX start=0;
 		int count;
 
-		unordered_set<int>::const_iterator end=data_.end();
 		while(start<len){
 			count=(std::min)(len-start,bufSize);
 			pbuf=source->getIntConst(start,count,buf);
 			pret=resultSP->getBoolBuffer(start,count,ret);
-			for(int i=0;i<count;++i)
-				pret[i]=data_.find(pbuf[i])!=end;
+			data_.containBatch(pbuf,count,pret);
 			resultSP->setBool(start,count,pret);
 			start+=count;
 		}
@@ -402,12 +400,12 @@ bool IntSet::inverse(const ConstantSP& value){
 	INDEX start = 0;
 	int count;
 
-	unordered_set<int>::iterator end = data_.end();
+	FlatHashSet<int>::iterator end = data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getIntConst(start,count,buf);
 		for(int i=0; i<count; ++i){
-			unordered_set<int>::iterator  it = data_.find(pbuf[i]);
+			FlatHashSet<int>::iterator  it = data_.find(pbuf[i]);
 			if(it != end)
 				data_.erase(it);
 			else
@@ -427,7 +425,7 @@ bool IntSet::isSuperset(const ConstantSP& target) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<int>::const_iterator end=data_.end();
+	FlatHashSet<int>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getIntConst(start,count,buf);
@@ -452,7 +450,7 @@ ConstantSP IntSet::interaction(const ConstantSP& value) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<int>::const_iterator end=data_.end();
+	FlatHashSet<int>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getIntConst(start,count,buf);
@@ -466,7 +464,7 @@ ConstantSP IntSet::interaction(const ConstantSP& value) const {
 }
 
 ConstantSP IntSet::getSubVector(INDEX start, INDEX length) const {
-	unordered_set<int>::const_iterator it = data_.begin();
+	FlatHashSet<int>::const_iterator it = data_.begin();
 	for(int i=0; i<start; ++i) ++it;
 	ConstantSP result = Util::createVector(type_, length, 0,true);
 
@@ -503,13 +501,11 @@ void LongSet::contain(const ConstantSP& target, const ConstantSP& resultSP) cons
 		INDEX start=0;
 		int count;
 
-		unordered_set<long long>::const_iterator end=data_.end();
 		while(start<len){
 			count=(std::min)(len-start,bufSize);
 			pbuf=source->getLongConst(start,count,buf);
 			pret=resultSP->getBoolBuffer(start,count,ret);
-			for(int i=0;i<count;++i)
-				pret[i]=data_.find(pbuf[i])!=end;
+			data_.containBatch(pbuf,count,pret);
 			resultSP->setBool(start,count,pret);
 			start+=count;
 		}
@@ -561,12 +557,12 @@ bool LongSet::inverse(const ConstantSP& value){
 	INDEX start = 0;
 	int count;
 
-	unordered_set<long long>::iterator end = data_.end();
+	FlatHashSet<long long>::iterator end = data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getLongConst(start,count,buf);
 		for(int i=0; i<count; ++i){
-			unordered_set<long long>::iterator  it = data_.find(pbuf[i]);
+			FlatHashSet<long long>::iterator  it = data_.find(pbuf[i]);
 			if(it != end)
 				data_.erase(it);
 			else
@@ -586,7 +582,7 @@ bool LongSet::isSuperset(const ConstantSP& target) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<long long>::const_iterator end=data_.end();
+	FlatHashSet<long long>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getLongConst(start,count,buf);
@@ -611,7 +607,7 @@ ConstantSP LongSet::interaction(const ConstantSP& value) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<long long>::const_iterator end=data_.end();
+	FlatHashSet<long long>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getLongConst(start,count,buf);
@@ -625,7 +621,7 @@ ConstantSP LongSet::interaction(const ConstantSP& value) const {
 }
 
 ConstantSP LongSet::getSubVector(INDEX start, INDEX length) const {
-	unordered_set<long long>::const_iterator it = data_.begin();
+	FlatHashSet<long long>::const_iterator it = data_.begin();
 	for(int i=0; i<start; ++i) ++it;
 	ConstantSP result = Util::createVector(type_, length, 0,true);
 
@@ -662,7 +658,7 @@ void FloatSet::contain(const ConstantSP& target, const ConstantSP& resultSP) con
 		INDEX start=0;
 		int count;
 
-		unordered_set<float>::const_iterator end=data_.end();
+		FlatHashSet<float>::const_iterator end=data_.end();
 		while(start<len){
 			count=(std::min)(len-start,bufSize);
 			pbuf=source->getFloatConst(start,count,buf);
@@ -720,12 +716,12 @@ bool FloatSet::inverse(const ConstantSP& value){
 	INDEX start = 0;
 	int count;
 
-	unordered_set<float>::iterator end = data_.end();
+	FlatHashSet<float>::iterator end = data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getFloatConst(start,count,buf);
 		for(int i=0; i<count; ++i){
-			unordered_set<float>::iterator  it = data_.find(pbuf[i]);
+			FlatHashSet<float>::iterator  it = data_.find(pbuf[i]);
 			if(it != end)
 				data_.erase(it);
 			else
@@ -745,7 +741,7 @@ bool FloatSet::isSuperset(const ConstantSP& target) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<float>::const_iterator end=data_.end();
+	FlatHashSet<float>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getFloatConst(start,count,buf);
@@ -770,7 +766,7 @@ ConstantSP FloatSet::interaction(const ConstantSP& value) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<float>::const_iterator end=data_.end();
+	FlatHashSet<float>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getFloatConst(start,count,buf);
@@ -784,7 +780,7 @@ ConstantSP FloatSet::interaction(const ConstantSP& value) const {
 }
 
 ConstantSP FloatSet::getSubVector(INDEX start, INDEX length) const {
-	unordered_set<float>::const_iterator it = data_.begin();
+	FlatHashSet<float>::const_iterator it = data_.begin();
 	for(int i=0; i<start; ++i) ++it;
 	ConstantSP result = Util::createVector(type_, length, 0,true);
 
@@ -821,7 +817,7 @@ void DoubleSet::contain(const ConstantSP& target, const ConstantSP& resultSP) co
 		INDEX start=0;
 		int count;
 
-		unordered_set<double>::const_iterator end=data_.end();
+		FlatHashSet<double>::const_iterator end=data_.end();
 		while(start<len){
 			count=(std::min)(len-start,bufSize);
 			pbuf=source->getDoubleConst(start,count,buf);
@@ -879,12 +875,12 @@ bool DoubleSet::inverse(const ConstantSP& value){
 	INDEX start = 0;
 	int count;
 
-	unordered_set<double>::iterator end = data_.end();
+	FlatHashSet<double>::iterator end = data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getDoubleConst(start,count,buf);
 		for(int i=0; i<count; ++i){
-			unordered_set<double>::iterator  it = data_.find(pbuf[i]);
+			FlatHashSet<double>::iterator  it = data_.find(pbuf[i]);
 			if(it != end)
 				data_.erase(it);
 			else
@@ -904,7 +900,7 @@ bool DoubleSet::isSuperset(const ConstantSP& target) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<double>::const_iterator end=data_.end();
+	FlatHashSet<double>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getDoubleConst(start,count,buf);
@@ -929,7 +925,7 @@ ConstantSP DoubleSet::interaction(const ConstantSP& value) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<double>::const_iterator end=data_.end();
+	FlatHashSet<double>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getDoubleConst(start,count,buf);
@@ -943,7 +939,7 @@ ConstantSP DoubleSet::interaction(const ConstantSP& value) const {
 }
 
 ConstantSP DoubleSet::getSubVector(INDEX start, INDEX length) const {
-	unordered_set<double>::const_iterator it = data_.begin();
+	FlatHashSet<double>::const_iterator it = data_.begin();
 	for(int i=0; i<start; ++i) ++it;
 	ConstantSP result = Util::createVector(type_, length, 0,true);
 
@@ -980,7 +976,7 @@ void StringSet::contain(const ConstantSP& target, const ConstantSP& resultSP) co
 		INDEX start=0;
 		int count;
 
-		unordered_set<std::string>::const_iterator end=data_.end();
+		FlatHashSet<std::string>::const_iterator end=data_.end();
 		while(start<len){
 			count=(std::min)(len-start,bufSize);
 			pbuf=source->getStringConst(start,count,buf);
@@ -1038,12 +1034,12 @@ bool StringSet::inverse(const ConstantSP& value){
 	INDEX start = 0;
 	int count;
 
-	unordered_set<std::string>::iterator end = data_.end();
+	FlatHashSet<std::string>::iterator end = data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getStringConst(start,count,buf);
 		for(int i=0; i<count; ++i){
-			unordered_set<std::string>::iterator  it = data_.find(pbuf[i]);
+			FlatHashSet<std::string>::iterator  it = data_.find(pbuf[i]);
 			if(it != end)
 				data_.erase(it);
 			else
@@ -1063,7 +1059,7 @@ bool StringSet::isSuperset(const ConstantSP& target) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<std::string>::const_iterator end=data_.end();
+	FlatHashSet<std::string>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getStringConst(start,count,buf);
@@ -1088,7 +1084,7 @@ ConstantSP StringSet::interaction(const ConstantSP& value) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<std::string>::const_iterator end=data_.end();
+	FlatHashSet<std::string>::const_iterator end=data_.end();
 	while(start<len){
 		count=(std::min)(len-start,bufSize);
 		pbuf=source->getStringConst(start,count,buf);
@@ -1102,7 +1098,7 @@ ConstantSP StringSet::interaction(const ConstantSP& value) const {
 }
 
 ConstantSP StringSet::getSubVector(INDEX start, INDEX length) const {
-	unordered_set<std::string>::const_iterator it = data_.begin();
+	FlatHashSet<std::string>::const_iterator it = data_.begin();
 	for(int i=0; i<start; ++i)
 		++it;
 	ConstantSP result = Util::createVector(type_, length, 0,true);
@@ -1137,7 +1133,7 @@ void Int128Set::contain(const ConstantSP& target, const ConstantSP& resultSP) co
 		INDEX start=0;
 		int count;
 
-		unordered_set<Guid>::const_iterator end=data_.end();
+		FlatHashSet<Guid>::const_iterator end=data_.end();
 		while(start<len){
 			count=std::min(len-start,bufSize);
 			pbuf=(const Guid*)source->getBinaryConst(start,count,16,buf.get());
@@ -1195,12 +1191,12 @@ bool Int128Set::inverse(const ConstantSP& value){
 	INDEX start = 0;
 	int count;
 
-	unordered_set<Guid>::iterator end = data_.end();
+	FlatHashSet<Guid>::iterator end = data_.end();
 	while(start<len){
 		count=std::min(len-start,bufSize);
 		pbuf=(const Guid*)source->getBinaryConst(start,count,16,buf.get());
 		for(int i=0; i<count; ++i){
-			unordered_set<Guid>::iterator  it = data_.find(pbuf[i]);
+			FlatHashSet<Guid>::iterator  it = data_.find(pbuf[i]);
 			if(it != end)
 				data_.erase(it);
 			else
@@ -1220,7 +1216,7 @@ bool Int128Set::isSuperset(const ConstantSP& target) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<Guid>::const_iterator end=data_.end();
+	FlatHashSet<Guid>::const_iterator end=data_.end();
 	while(start<len){
 		count=std::min(len-start,bufSize);
 		pbuf=(const Guid*)source->getBinaryConst(start,count,16,buf.get());
@@ -1245,7 +1241,7 @@ ConstantSP Int128Set::interaction(const ConstantSP& value) const {
 	INDEX start=0;
 	int count;
 
-	unordered_set<Guid>::const_iterator end=data_.end();
+	FlatHashSet<Guid>::const_iterator end=data_.end();
 	while(start<len){
 		count=std::min(len-start,bufSize);
 		pbuf=(const Guid*)source->getBinaryConst(start,count,16,buf.get());
@@ -1259,7 +1255,7 @@ ConstantSP Int128Set::interaction(const ConstantSP& value) const {
 }
 
 ConstantSP Int128Set::getSubVector(INDEX start, INDEX length) const {
-	unordered_set<Guid>::const_iterator it = data_.begin();
+	FlatHashSet<Guid>::const_iterator it = data_.begin();
 	for(int i=0; i<start; ++i) ++it;
 	ConstantSP result = Util::createVector(type_, length, 0,true);
 
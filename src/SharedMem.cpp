@@ -14,6 +14,12 @@ TableSP SharedMemStream::readData(TableSP& copy, const bool& overwrite, size_t&
         }
     }
 
+    //Rows are copied into the columns' buffers, which read-only columns must keep untouched.
+    for (int colIndex = 0; !copy.isNull() && colIndex < copy->columns(); colIndex++) {
+        if (copy->getColumn(colIndex)->isReadOnly())
+            throw RuntimeException("Can't read shared memory data into read-only column " + copy->getColumnName(colIndex));
+    }
+
     if (sem_wait(&shmpHeader_->readSem_) == -1) {
         throw RuntimeException("sem wait error!");
     }
@@ -7,6 +7,8 @@
 #include "ScalarImp.h"
 #include "Logger.h"
 #include "DolphinDB.h"
+#include "Tracing.h"
+#include "Metrics.h"
 #include <list>
 #ifndef WINDOWS
 #include <arpa/inet.h>
@@ -51,6 +53,7 @@ using std::string;
 using std::vector;
 
 constexpr int DEFAULT_QUEUE_CAPACITY = 65536;
+constexpr int DEFAULT_PARSE_PIPELINE_CAPACITY = 64;
 class Executor : public dolphindb::Runnable {
     using Func = std::function<void()>;
 
@@ -286,10 +289,12 @@ class StreamingClientImpl {
               resubTimeout_(100),
               subOnce_(false),
               lastSiteIndex_(-1),
-              batchSize_(1) {}
+              batchSize_(1),
+              symbolTable_(false) {}
         explicit SubscribeInfo(const string& id, const string &host, int port, const string &tableName, const string &actionName, long long offset, bool resub,
                                const VectorSP &filter, bool msgAsTable, bool allowExists, int batchSize,
-								const string &userName, const string &password, const StreamDeserializerSP &blobDeserializer, bool isEvent, int resubTimeout, bool subOnce)
+								const string &userName, const string &password, const StreamDeserializerSP &blobDeserializer, bool isEvent, int resubTimeout, bool subOnce,
+								bool symbolTable)
             : ID_(move(id)),
               host_(move(host)),
               port_(port),
@@ -312,6 +317,7 @@ class StreamingClientImpl {
 			  subOnce_(subOnce),
 			  lastSiteIndex_(-1),
               batchSize_(batchSize),
+              symbolTable_(symbolTable),
               stopped_(std::make_shared<std::atomic<bool>>(false))
         {
 		}
@@ -340,6 +346,8 @@ class StreamingClientImpl {
         bool subOnce_;
         int lastSiteIndex_;
         int batchSize_;
+        //Deliver whole blocks and let the handler thread deserialize them into per-symbol tables
+        bool symbolTable_;
         std::shared_ptr<std::atomic<bool>> stopped_;
 
 		void exit() {
@@ -412,6 +420,60 @@ class StreamingClientImpl {
 		ActivePublisherSP publisher;
 	};
 	
+    struct TopicMetrics {
+        MetricCounter* messages;
+        MetricHistogram* lag;
+    };
+
+    //One message read from the socket. The reader fills the header and the unmarshalled object,
+    //a decode worker converts it into per-topic messages, and the dispatcher pushes them to the queues.
+    struct ParseJob {
+        ParseJob() : done(1), offset(-1), sentTime(0), receiveTime(0), rowSize(0), failed(false) {}
+        CountDownLatch done;
+        vector<string> topics;
+        ConstantSP obj;
+        long long offset;
+        long long sentTime;
+        long long receiveTime;
+        int rowSize;
+        vector<pair<string, vector<Message>>> messages;
+        bool failed;
+        string errMsg;
+    };
+    typedef SmartPointer<ParseJob> ParseJobSP;
+
+    //Every job is pushed to the dispatch queue before the decode queue, so the dispatcher
+    //sees jobs in socket order and keeps the offsets of every topic in order.
+    struct ParsePipeline {
+        ParsePipeline(int id, int capacity)
+            : decodeQueue(capacity), dispatchQueue(capacity), stopped(false),
+              id(std::to_string(id)) {}
+        ~ParsePipeline() { stop(); }
+        void stop() {
+            if (dispatchThread.isNull())
+                return;
+            for (size_t i = 0; i < decodeThreads.size(); ++i)
+                decodeQueue.push(ParseJobSP());
+            for (auto &one : decodeThreads)
+                one->join();
+            dispatchQueue.push(ParseJobSP());
+            dispatchThread->join();
+            decodeThreads.clear();
+            dispatchThread.clear();
+            MetricsRegistry::instance().unregisterGauge("ddb_streaming_stage_depth", depthLabels("decode"));
+            MetricsRegistry::instance().unregisterGauge("ddb_streaming_stage_depth", depthLabels("dispatch"));
+        }
+        string depthLabels(const string &stage) const {
+            return MetricsRegistry::label("stage", stage) + "," + MetricsRegistry::label("pipeline", id);
+        }
+        BlockingQueue<ParseJobSP> decodeQueue;
+        BlockingQueue<ParseJobSP> dispatchQueue;
+        vector<ThreadSP> decodeThreads;
+        ThreadSP dispatchThread;
+        std::atomic<bool> stopped;
+        string id;
+    };
+
     struct KeepAliveAttr {
         int enabled = 1;             // default = 1 enabled
         int idleTime = 30;           // default = 30s idle time will trigger detection
@@ -420,7 +482,8 @@ class StreamingClientImpl {
     };
 
 public:
-    explicit StreamingClientImpl(int listeningPort) : listeningPort_(listeningPort), publishers_(5), isInitialized_(false){
+    explicit StreamingClientImpl(int listeningPort) : listeningPort_(listeningPort), publishers_(5), isInitialized_(false),
+            decodeThreads_(0), pipelineCapacity_(DEFAULT_PARSE_PIPELINE_CAPACITY), clientLabel_(MetricsRegistry::label("client", std::to_string(nextClientId()))){
 		if (listeningPort_ < 0) {
 			throw RuntimeException("Invalid listening port value " + std::to_string(listeningPort));
 		}
@@ -456,6 +519,7 @@ public:
 		}
 		topicSubInfos_.op([&](unordered_map<string, SubscribeInfo>& mp) {
 			for (auto &one : mp) {
+				MetricsRegistry::instance().unregisterGauge("ddb_streaming_queue_depth", queueDepthLabels(one.first));
 				one.second.exit();
 			}
 		});
@@ -469,7 +533,8 @@ public:
                                      bool resubscribe = true, const VectorSP &filter = nullptr, bool msgAsTable = false,
                                      bool allowExists = false, int batchSize  = 1,
 									const string &userName="", const string &password="",
-									const StreamDeserializerSP &sdsp = nullptr, const std::vector<std::string>& backupSites = std::vector<std::string>(), bool isEvent = false, int resubTimeout = 100, bool subOnce = false);
+									const StreamDeserializerSP &sdsp = nullptr, const std::vector<std::string>& backupSites = std::vector<std::string>(), bool isEvent = false, int resubTimeout = 100, bool subOnce = false,
+									bool symbolTable = false);
     string subscribeInternal(DBConnection &conn, SubscribeInfo &info);
     void insertMeta(SubscribeInfo &info, const string &topic);
     bool delMeta(const string &topic, bool exitFlag);
@@ -507,6 +572,14 @@ public:
 		});
 		return queue;
 	}
+    void setParseThreads(int decodeThreads, int pipelineCapacity) {
+        if (decodeThreads < 0)
+            throw RuntimeException("The number of decode threads must not be negative.");
+        if (pipelineCapacity <= 0)
+            throw RuntimeException("The parse pipeline capacity must be positive.");
+        decodeThreads_ = decodeThreads;
+        pipelineCapacity_ = pipelineCapacity;
+    }
 private:
     //if server support reverse connect, set the port to 0
     //if server Not support reverse connect and the port is 0, throw a RuntimeException
@@ -516,6 +589,11 @@ private:
 		return listeningPort_ > 0;
 	}
     void parseMessage(DataInputStreamSP in, ActivePublisherSP publisher);
+    void startPipeline(ParsePipeline &pipeline, int decodeThreads);
+    void runDecoder(ParsePipeline &pipeline);
+    void runDispatcher(ParsePipeline &pipeline);
+    void decodeMessage(ParseJob &job);
+    void dispatchMessage(ParseJob &job, unordered_map<string, TopicMetrics> &topicMetrics);
 	void sendPublishRequest(DBConnection &conn, SubscribeInfo &info);
     void reconnect();
 	static bool initSocket(const SocketSP &socket) {
@@ -632,6 +710,14 @@ private:
     }
 
 private:
+    static int nextClientId() {
+        static std::atomic<int> clientId(0);
+        return ++clientId;
+    }
+    string queueDepthLabels(const string &topic) const {
+        return clientLabel_ + "," + MetricsRegistry::label("topic", topic);
+    }
+
     SocketSP listenerSocket_;
     ThreadSP daemonThread_;
     ThreadSP reconnectThread_;
@@ -650,6 +736,11 @@ private:
     std::list<HAStreamTableInfo> haStreamTableInfo_;
     bool isInitialized_;
     std::map<std::string, std::string> topics_;     //ID -> current topic
+    //Read by every connection opened after setParseThreads, see StreamingClient::setParseThreads.
+    std::atomic<int> decodeThreads_;
+    std::atomic<int> pipelineCapacity_;
+    //Tells apart the metrics of clients subscribed to the same topic.
+    const string clientLabel_;
 #ifdef WINDOWS
     static bool WSAStarted_;
     static void WSAStart();
@@ -901,8 +992,183 @@ void StreamingClientImpl::reconnect() {
     }
 }
 
+void StreamingClientImpl::startPipeline(ParsePipeline &pipeline, int decodeThreads) {
+    for (int i = 0; i < decodeThreads; ++i) {
+        ThreadSP t = new Thread(new Executor(std::bind(&StreamingClientImpl::runDecoder, this, std::ref(pipeline))));
+        t->start();
+        pipeline.decodeThreads.push_back(t);
+    }
+    pipeline.dispatchThread = new Thread(new Executor(std::bind(&StreamingClientImpl::runDispatcher, this, std::ref(pipeline))));
+    pipeline.dispatchThread->start();
+    ParsePipeline *p = &pipeline;
+    MetricsRegistry::instance().registerGauge("ddb_streaming_stage_depth", pipeline.depthLabels("decode"),
+        [p]() { return (double)p->decodeQueue.size(); });
+    MetricsRegistry::instance().registerGauge("ddb_streaming_stage_depth", pipeline.depthLabels("dispatch"),
+        [p]() { return (double)p->dispatchQueue.size(); });
+}
+
+void StreamingClientImpl::runDecoder(ParsePipeline &pipeline) {
+    MetricCounter *busy = MetricsRegistry::instance().counter("ddb_streaming_stage_busy_nanoseconds_total", MetricsRegistry::label("stage", "decode"));
+    ParseJobSP job;
+    while (true) {
+        pipeline.decodeQueue.pop(job);
+        if (job.isNull())
+            break;
+        long long startTime = Util::getNanoBenchmark();
+        if (!pipeline.stopped) {
+            try {
+                decodeMessage(*job);
+            } catch (std::exception &e) {
+                job->failed = true;
+                job->errMsg = e.what();
+            }
+        }
+        job->done.countDown();
+        busy->increment(Util::getNanoBenchmark() - startTime);
+    }
+}
+
+void StreamingClientImpl::runDispatcher(ParsePipeline &pipeline) {
+    MetricCounter *busy = MetricsRegistry::instance().counter("ddb_streaming_stage_busy_nanoseconds_total", MetricsRegistry::label("stage", "dispatch"));
+    unordered_map<string, TopicMetrics> topicMetrics;
+    ParseJobSP job;
+    while (true) {
+        pipeline.dispatchQueue.pop(job);
+        if (job.isNull())
+            break;
+        job->done.wait();
+        //Keep draining after a failure so that the reader never blocks on a full queue.
+        if (pipeline.stopped)
+            continue;
+        if (job->failed) {
+            cerr << "[ERROR] " << job->errMsg << ", stopping this parse thread." << endl;
+            pipeline.stopped = true;
+            continue;
+        }
+        long long startTime = Util::getNanoBenchmark();
+        dispatchMessage(*job, topicMetrics);
+        busy->increment(Util::getNanoBenchmark() - startTime);
+    }
+}
+
+void StreamingClientImpl::decodeMessage(ParseJob &job) {
+    DDB_TRACE("StreamingClient::parseMessage.decode");
+    vector<pair<string, SubscribeInfo>> infos;
+    {
+        //wait for insertMeta() finish, or there is no topic in topicSubInfos_
+        LockGuard<Mutex> lock(&readyMutex_);
+        for (auto &t : job.topics) {
+            SubscribeInfo info;
+            if (topicSubInfos_.find(t, info) && !info.queue_.isNull())
+                infos.emplace_back(t, info);
+        }
+    }
+    if (infos.empty())
+        return;
+
+    ConstantSP obj = job.obj;
+    int colSize = obj->size();
+    int rowSize = obj->get(0)->size();
+    if (isListenMode() && rowSize == 1) {
+        // 1d array to 2d
+        VectorSP newObj = Util::createVector(DT_ANY, colSize);
+        for (int i = 0; i < colSize; ++i) {
+            ConstantSP val = obj->get(i);
+            VectorSP col = Util::createVector(val->getType(), 1);
+            if(val->getForm() == DF_VECTOR) {
+                col = Util::createArrayVector((DATA_TYPE)((int)val->getType()+ARRAY_TYPE_BASE), 1);
+            }
+            col->set(0, val);
+            newObj->set(i, col);
+        }
+        obj = newObj;
+    }
+    job.rowSize = rowSize;
+    vector<VectorSP> cache, rows;
+    vector<string> symbols;
+    ErrorCodeInfo errorInfo;
+    for (auto &one : infos) {
+        SubscribeInfo &info = one.second;
+        job.messages.emplace_back(one.first, vector<Message>());
+        vector<Message> &out = job.messages.back().second;
+        int startOffset = job.offset - rowSize + 1;
+        if (info.isEvent_) {
+            out.push_back(Message(obj));
+        }
+        else if (info.symbolTable_) {
+            out.push_back(Message(obj, startOffset));
+        }
+        else if (info.streamDeserializer_.isNull() == false) {
+            if (rows.empty()) {
+                if (!info.streamDeserializer_->parseBlob(obj, rows, symbols, errorInfo)) {
+                    job.failed = true;
+                    job.errMsg = "parse BLOB field failed: " + errorInfo.errorInfo;
+                    return;
+                }
+            }
+            out.reserve(rowSize);
+            for (int rowIdx = 0; rowIdx < rowSize; ++rowIdx)
+                out.push_back(Message(rows[rowIdx], symbols[rowIdx], info.streamDeserializer_, startOffset++));
+        }
+        else if (info.msgAsTable_) {
+            if (info.attributes_.empty()) {
+                std::cerr << "table colName is empty, can not convert to table" << std::endl;
+                out.push_back(Message(obj, startOffset));
+            }
+            else {
+                out.push_back(Message(convertTupleToTable(info.attributes_, obj), startOffset));
+            }
+        }
+        else {
+            if (UNLIKELY(cache.empty())) { // split once
+                cache.resize(rowSize);
+                for (int rowIdx = 0; rowIdx < rowSize; ++rowIdx) {
+                    VectorSP tmp = Util::createVector(DT_ANY, colSize, colSize);
+                    for (int colIdx = 0; colIdx < colSize; ++colIdx) {
+                        tmp->set(colIdx, obj->get(colIdx)->get(rowIdx));
+                    }
+                    cache[rowIdx] = tmp;
+                }
+            }
+            out.reserve(rowSize);
+            for (auto &row : cache)
+                out.push_back(Message(row, startOffset++));
+        }
+    }
+}
+
+void StreamingClientImpl::dispatchMessage(ParseJob &job, unordered_map<string, TopicMetrics> &topicMetrics) {
+    LockGuard<Mutex> lock(&readyMutex_);
+    DDB_TRACE("StreamingClient::parseMessage.dispatch");
+    for (auto &one : job.messages) {
+        const string &t = one.first;
+        SubscribeInfo info;
+        if (!topicSubInfos_.find(t, info) || info.queue_.isNull())
+            continue;
+        auto metricsIter = topicMetrics.find(t);
+        if (metricsIter == topicMetrics.end()) {
+            string labels = MetricsRegistry::label("topic", t);
+            TopicMetrics metrics{MetricsRegistry::instance().counter("ddb_streaming_messages_total", labels),
+                                 MetricsRegistry::instance().histogram("ddb_streaming_lag_milliseconds", labels)};
+            metricsIter = topicMetrics.emplace(t, metrics).first;
+        }
+        metricsIter->second.messages->increment(job.rowSize);
+        metricsIter->second.lag->record(job.receiveTime - job.sentTime);
+        for (auto &m : one.second)
+            info.queue_->push(m);
+        topicSubInfos_.op([&](unordered_map<string, SubscribeInfo>& mp){
+            if(mp.count(t) != 0)
+                mp[t].offset_ = job.offset + 1;
+        });
+    }
+}
+
+//With decode threads configured, the reader thread only frames messages off the socket. Blob
+//deserialization, row splitting and table conversion run on the decode workers, and queue pushes
+//run on the dispatcher, so a slow consumer or a slow StreamDeserializer no longer stalls socket reads.
 void StreamingClientImpl::parseMessage(DataInputStreamSP in, ActivePublisherSP publisher) {
-    auto factory = ConstantUnmarshallFactory(in);
+    //Symbol bases live as long as the subscription socket.
+    ConstantUnmarshallFactory factory(in, new SymbolBaseCache());
     ConstantUnmarshall *unmarshall = nullptr;
 
     IO_ERR ret = OK;
@@ -913,10 +1179,19 @@ void StreamingClientImpl::parseMessage(DataInputStreamSP in, ActivePublisherSP p
     string aliasTableName;
     string topicMsg;
     vector<string> topics;
-	vector<string> symbols;
-	
-    while (isExit() == false) {
+    MetricCounter *busy = MetricsRegistry::instance().counter("ddb_streaming_stage_busy_nanoseconds_total", MetricsRegistry::label("stage", "read"));
+    static std::atomic<int> pipelineSeq(0);
+    ParsePipeline pipeline(pipelineSeq.fetch_add(1), pipelineCapacity_);
+    //Without decode threads every message is decoded and dispatched on this thread.
+    bool pipelined = decodeThreads_ > 0;
+    unordered_map<string, TopicMetrics> topicMetrics;
+    if (pipelined)
+        startPipeline(pipeline, decodeThreads_);
+
+    while (isExit() == false && !pipeline.stopped) {
         if (ret != OK) {  // blocking mode, ret won't be NODATA
+            //Flush the messages already read so that resubscription starts from the right offset.
+            pipeline.stop();
             if (!actionCntOnTable_.count(aliasTableName) || actionCntOnTable_[aliasTableName] == 0) {
                 break;
             };
@@ -942,12 +1217,15 @@ void StreamingClientImpl::parseMessage(DataInputStreamSP in, ActivePublisherSP p
         char littleEndian;
         ret = in->readChar(littleEndian);
         if (ret != OK) continue;
+        DDB_TRACE("StreamingClient::parseMessage");
+        long long startTime = Util::getNanoBenchmark();
 
         ret = in->bufferBytes(16);
         if (ret != OK) continue;
 
 		ret = in->readLong(sentTime);
 		if (ret != OK) continue;
+		long long receiveTime = Util::getEpochTime();
 		ret = in->readLong(offset);
 		if (ret != OK) continue;
 
@@ -975,8 +1253,10 @@ void StreamingClientImpl::parseMessage(DataInputStreamSP in, ActivePublisherSP p
             previousDataFormFlag = flag;
         }
 
+        TraceSpan unmarshallSpan(DDB_TRACE_SITE("StreamingClient::parseMessage.unmarshall"));
         unmarshall->start(flag, true, ret);
         if (ret != OK) continue;
+        unmarshallSpan.end();
 
         ConstantSP obj = unmarshall->getConstant();
         if (obj->isTable()) {
@@ -988,85 +1268,31 @@ void StreamingClientImpl::parseMessage(DataInputStreamSP in, ActivePublisherSP p
                 topicReconn_.erase(t);
             }
         } else if (LIKELY(obj->isVector())) {
-			int colSize = obj->size();
-            int rowSize = obj->get(0)->size();
-//            offset += rowSize;
-			if (isListenMode() && rowSize == 1) {
-                // 1d array to 2d
-                VectorSP newObj = Util::createVector(DT_ANY, colSize);
-                for (int i = 0; i < colSize; ++i) {
-                    ConstantSP val = obj->get(i);
-                    VectorSP col = Util::createVector(val->getType(), 1);
-					if(val->getForm() == DF_VECTOR) {
-						col = Util::createArrayVector((DATA_TYPE)((int)val->getType()+ARRAY_TYPE_BASE), 1);
-					}
-                    col->set(0, val);
-                    newObj->set(i, col);
+            ParseJobSP job = new ParseJob();
+            job->topics = topics;
+            job->obj = obj;
+            job->offset = offset;
+            job->sentTime = sentTime;
+            job->receiveTime = receiveTime;
+            if (!pipelined) {
+                try {
+                    decodeMessage(*job);
+                } catch (std::exception &e) {
+                    job->failed = true;
+                    job->errMsg = e.what();
                 }
-                obj = newObj;
-            }
-            vector<VectorSP> cache, rows;
-			ErrorCodeInfo errorInfo;
-
-            //wait for insertMeta() finish, or there is no topic in topicSubInfos_
-            LockGuard<Mutex> lock(&readyMutex_);
-
-            for (auto &t : topics) {
-                SubscribeInfo info;
-                if (topicSubInfos_.find(t, info)) {
-                    if (info.queue_.isNull()) continue;
-                    int startOffset = offset - rowSize + 1;
-                    if (info.isEvent_){
-                        info.queue_->push(Message(obj));
-                    }
-					else if (info.streamDeserializer_.isNull()==false) {
-						if (rows.empty()) {
-							if (!info.streamDeserializer_->parseBlob(obj, rows, symbols, errorInfo)) {
-								cerr << "[ERROR] parse BLOB field failed: " << errorInfo.errorInfo << ", stopping this parse thread." << endl;
-								return;
-							}
-						}
-						for (int rowIdx = 0; rowIdx < rowSize; ++rowIdx) {
-							Message m(rows[rowIdx], symbols[rowIdx], info.streamDeserializer_, startOffset++);
-							rows[rowIdx].clear();
-							info.queue_->push(m);
-						}
-					}
-					else {
-						if (info.msgAsTable_) {
-							if (info.attributes_.empty()) {
-								std::cerr << "table colName is empty, can not convert to table" << std::endl;
-								info.queue_->push(Message(obj, startOffset));
-							}
-							else {
-								info.queue_->push(Message(convertTupleToTable(info.attributes_, obj), startOffset));
-							}
-						}
-						else {
-							if (UNLIKELY(cache.empty())) { // split once
-								cache.resize(rowSize);
-								for (int rowIdx = 0; rowIdx < rowSize; ++rowIdx) {
-									VectorSP tmp = Util::createVector(DT_ANY, colSize, colSize);
-									for (int colIdx = 0; colIdx < colSize; ++colIdx) {
-										tmp->set(colIdx, obj->get(colIdx)->get(rowIdx));
-									}
-									cache[rowIdx] = tmp;
-								}
-							}
-							for (auto &one : cache) {
-								info.queue_->push(Message(one, startOffset++));
-							}
-						}
-					}
-					topicSubInfos_.op([&](unordered_map<string, SubscribeInfo>& mp){
-						if(mp.count(t) != 0)
-                        	mp[t].offset_ = offset + 1;
-//                        cout << "set offset to " << offset << " add: " << &mp[t].offset << endl;
-                    });
-//                    topicSubInfos_.upsert(
-//                        t, [&](SubscribeInfo &info) { info.offset = offset; }, SubscribeInfo());
+                if (job->failed) {
+                    cerr << "[ERROR] " << job->errMsg << ", stopping this parse thread." << endl;
+                    break;
                 }
+                dispatchMessage(*job, topicMetrics);
+                busy->increment(Util::getNanoBenchmark() - startTime);
+                continue;
             }
+            busy->increment(Util::getNanoBenchmark() - startTime);
+            //Blocks when the pipeline is full, which leaves the backlog in the socket buffer.
+            pipeline.dispatchQueue.push(job);
+            pipeline.decodeQueue.push(job);
         } else {
 			cerr << "Message body has an invalid format. Vector is expected." << endl;
 			break;
@@ -1141,6 +1367,11 @@ void StreamingClientImpl::insertMeta(SubscribeInfo &info, const string &topic) {
     actionCntOnTable_.upsert(
         stripActionName(topic), [&](int &cnt) { ++cnt; }, 1);
     topics_[info.ID_] = topic;
+    MessageQueueSP queue = info.queue_;
+    if (!queue.isNull()) {
+        MetricsRegistry::instance().registerGauge("ddb_streaming_queue_depth", queueDepthLabels(topic),
+            [queue]() { return (double)queue->size(); });
+    }
 }
 
 bool StreamingClientImpl::delMeta(const string &topic, bool exitFlag) {
@@ -1152,6 +1383,7 @@ bool StreamingClientImpl::delMeta(const string &topic, bool exitFlag) {
 		mp.erase(topic);
 	});
     topics_.erase(oldinfo.ID_);
+    MetricsRegistry::instance().unregisterGauge("ddb_streaming_queue_depth", queueDepthLabels(topic));
     liveSubsOnSite_.upsert(getSite(topic), [&](set<string> &s) { s.erase(topic); }, {});
     actionCntOnTable_.upsert(
         stripActionName(topic), [&](int &cnt) { --cnt; }, 0);
@@ -1164,11 +1396,15 @@ SubscribeQueue StreamingClientImpl::subscribeInternal(const string &host, int po
                                                       const string &actionName, int64_t offset, bool resubscribe,
                                                       const VectorSP &filter, bool msgAsTable, bool allowExists, int batchSize,
 													  const string &userName, const string &password,
-													  const StreamDeserializerSP &blobDeserializer, const std::vector<std::string>& backupSites, bool isEvent, int resubTimeout, bool subOnce) {
+													  const StreamDeserializerSP &blobDeserializer, const std::vector<std::string>& backupSites, bool isEvent, int resubTimeout, bool subOnce,
+													  bool symbolTable) {
 
 	if (msgAsTable && !blobDeserializer.isNull()) {
 		throw RuntimeException("msgAsTable must be false when StreamDeserializer is set.");
 	}
+	if (symbolTable && blobDeserializer.isNull()) {
+		throw RuntimeException("A StreamDeserializer is required to receive tables by symbol.");
+	}
     string topic;
     int attempt = 0;
     string _host = host;
@@ -1183,7 +1419,7 @@ SubscribeQueue StreamingClientImpl::subscribeInternal(const string &host, int po
     while (isExit()==false) {
         ++attempt;
         SubscribeInfo info(_id, _host, _port, tableName, actionName, offset, resubscribe, filter, msgAsTable, allowExists,
-			batchSize, userName,password,blobDeserializer, isEvent, resubTimeout, subOnce);
+			batchSize, userName,password,blobDeserializer, isEvent, resubTimeout, subOnce, symbolTable);
         if(!backupSites.empty()){
             info.availableSites_.push_back({host, port});
             info.currentSiteIndex_ = 0;
@@ -1279,6 +1515,10 @@ void StreamingClientImpl::unsubscribeInternal(const string &host, int port, cons
 
 StreamingClient::StreamingClient(int listeningPort) : impl_(new StreamingClientImpl(listeningPort)) {}
 
+void StreamingClient::setParseThreads(int decodeThreads, int pipelineCapacity) {
+    impl_->setParseThreads(decodeThreads, pipelineCapacity);
+}
+
 StreamingClient::~StreamingClient() {
 	exit();
 }
@@ -1295,11 +1535,12 @@ SubscribeQueue StreamingClient::subscribeInternal(string host, int port, string
                                                   int64_t offset, bool resubscribe, const dolphindb::VectorSP &filter,
                                                   bool msgAsTable, bool allowExists, int batchSize,
 												  string userName, string password,
-												  const StreamDeserializerSP &blobDeserializer, const std::vector<std::string>& backupSites, bool isEvent, int resubTimeout, bool subOnce) {
+												  const StreamDeserializerSP &blobDeserializer, const std::vector<std::string>& backupSites, bool isEvent, int resubTimeout, bool subOnce,
+												  bool symbolTable) {
     return impl_->subscribeInternal(host, port, tableName, actionName, offset, resubscribe, filter, msgAsTable,
                                     allowExists, batchSize,
 									userName,password,
-									blobDeserializer, backupSites, isEvent, resubTimeout, subOnce);
+									blobDeserializer, backupSites, isEvent, resubTimeout, subOnce, symbolTable);
 }
 
 void StreamingClient::unsubscribeInternal(string host, int port, string tableName, string actionName) {
@@ -1387,6 +1628,51 @@ ThreadSP ThreadedClient::subscribe(string host, int port, const MessageBatchHand
     return thread;
 }
 
+ThreadSP ThreadedClient::subscribe(string host, int port, const SymbolTableHandler &handler, string tableName,
+                                   string actionName, int64_t offset, bool resub, const VectorSP &filter,
+                                   bool allowExists, int batchSize, double throttle,
+                                   string userName, string password,
+                                   const StreamDeserializerSP &blobDeserializer, const std::vector<std::string>& backupSites, int resubTimeout, bool subOnce) {
+    //Every message in the queue is a whole block, so the queue itself doesn't batch.
+    auto subscribeQueue = subscribeInternal(std::move(host), port, std::move(tableName), std::move(actionName), offset,
+                              resub, filter, false, allowExists, 1, userName, password, blobDeserializer,
+                              backupSites, false, resubTimeout, subOnce, true);
+    if (subscribeQueue.queue_.isNull()) {
+        cerr << "Subscription already made, handler loop not created." << endl;
+        ThreadSP t = new Thread(new Executor([]() {}));
+        t->start();
+        return t;
+    }
+    int throttleTime = std::max(1, (int)(throttle * 1000));
+	SmartPointer<StreamingClientImpl> impl=impl_;
+	ThreadSP thread = new Thread(new Executor([handler, subscribeQueue, blobDeserializer, batchSize, throttleTime, impl]() {
+        SymbolTableAccumulator accumulator(blobDeserializer, handler, batchSize, throttleTime);
+        vector<Message> msgs;
+        ErrorCodeInfo errorInfo;
+        MessageQueueSP queue{subscribeQueue.queue_};
+        std::shared_ptr<std::atomic<bool>> stopped{subscribeQueue.stopped_};
+        int waitTime = throttleTime;
+        while (impl->isExit() == false) {
+            if (queue->pop(msgs, waitTime)) {
+                if (*stopped)
+                    break;
+                for (auto &msg : msgs) {
+                    if (!accumulator.append(msg, errorInfo))
+                        cerr << "[ERROR] parse BLOB field failed: " << errorInfo.errorInfo << endl;
+                }
+                msgs.clear();
+            }
+            waitTime = std::max(1, accumulator.flushExpired(Util::getEpochTime()));
+        }
+        //Deliver the rows still waiting for batchSize or throttle.
+        accumulator.flushAll();
+		queue->push(Message());
+    }));
+	impl_->addHandleThread(subscribeQueue.queue_, thread);
+	thread->start();
+    return thread;
+}
+
 ThreadSP newHandleThread(const MessageHandler handler, SubscribeQueue subscribeQueue, bool msgAsTable, SmartPointer<StreamingClientImpl> impl) {
 	ThreadSP thread = new Thread(new Executor([handler, subscribeQueue, msgAsTable, impl]() {
 		vector<Message> tables;
@@ -1478,12 +1764,39 @@ vector<ThreadSP> ThreadPooledClient::subscribe(string host, int port, const Mess
 }
 
 EventClient::EventClient(const std::vector<EventSchema>& eventSchemas, const std::vector<std::string>& eventTimeKeys, const std::vector<std::string>& commonKeys)
-    : StreamingClient(0), eventHandler_(eventSchemas, eventTimeKeys, commonKeys)
+    : StreamingClient(0), eventHandler_(eventSchemas, eventTimeKeys, commonKeys), eventSchemas_(eventSchemas),
+      eventTimeKeys_(eventTimeKeys), commonKeys_(commonKeys)
 {
 
 }
 
 ThreadSP EventClient::subscribe(const string& host, int port, const EventMessageHandler &handler, const string& tableName, const string& actionName, int64_t offset, bool resub, const string& userName, const string& password){
+    std::shared_ptr<std::vector<std::string>> eventTypes = std::make_shared<std::vector<std::string>>();
+    std::shared_ptr<std::vector<std::vector<ConstantSP>>> attributes = std::make_shared<std::vector<std::vector<ConstantSP>>>();
+    return subscribeEvents(host, port, tableName, actionName, offset, resub, userName, password, [this, handler, eventTypes, attributes](const ConstantSP& msg, ErrorCodeInfo& errorInfo) {
+        eventTypes->clear();
+        attributes->clear();
+        if(!eventHandler_.deserializeEvent(msg, *eventTypes, *attributes, errorInfo)){
+            return false;
+        }
+        unsigned rowSize = eventTypes->size();
+        for(unsigned i = 0; i < rowSize; ++i){
+            handler((*eventTypes)[i], (*attributes)[i]);
+        }
+        return true;
+    });
+}
+
+ThreadSP EventClient::subscribe(const string& host, int port, const EventBatchMessageHandler &handler, const string& tableName, const string& actionName, int64_t offset, bool resub, const string& userName, const string& password){
+    //The batch decoding state isn't thread-safe, so every subscription thread decodes with a handler of its own.
+    std::shared_ptr<EventHandler> decoder = std::make_shared<EventHandler>(eventSchemas_, eventTimeKeys_, commonKeys_);
+    return subscribeEvents(host, port, tableName, actionName, offset, resub, userName, password, [decoder, handler](const ConstantSP& msg, ErrorCodeInfo& errorInfo) {
+        return decoder->deserializeEvent(msg, handler, errorInfo);
+    });
+}
+
+ThreadSP EventClient::subscribeEvents(const string& host, int port, const string& tableName, const string& actionName, int64_t offset, bool resub, const string& userName, const string& password,
+                                      const std::function<bool(const ConstantSP&, ErrorCodeInfo&)>& decode){
     if(tableName.empty()){
         throw RuntimeException("tableName must not be empty.");
     }
@@ -1507,12 +1820,9 @@ ThreadSP EventClient::subscribe(const string& host, int port, const EventMessage
     }
 
     SmartPointer<StreamingClientImpl> impl = impl_;
-    ThreadSP thread = new Thread(new Executor([this, handler, subscribeQueue, impl]() {
+    ThreadSP thread = new Thread(new Executor([decode, subscribeQueue, impl]() {
 		auto queue = subscribeQueue.queue_;
 		Message msg;
-		vector<Message> tables;
-        std::vector<std::string> eventTypes;
-        std::vector<std::vector<ConstantSP>> attributes;
         ErrorCodeInfo errorInfo;
 		while (impl->isExit() == false && !*subscribeQueue.stopped_) {
 			queue->pop(msg);
@@ -1520,17 +1830,10 @@ ThreadSP EventClient::subscribe(const string& host, int port, const EventMessage
 			if (UNLIKELY(*subscribeQueue.stopped_)){
 				break;
 			}
-            eventTypes.clear();
-            attributes.clear();
-            if(!eventHandler_.deserializeEvent(msg, eventTypes, attributes, errorInfo)){
+            if(!decode(msg, errorInfo)){
                 std::cout << "deserialize fail " << errorInfo.errorInfo << std::endl;
                 continue;
             }
-            unsigned rowSize = eventTypes.size();
-            for(unsigned i = 0; i < rowSize; ++i){
-                handler(eventTypes[i], attributes[i]);
-            }
-			//handler(msg);
 		}
 		queue->push(Message());
 	}));
@@ -1605,6 +1908,12 @@ SmartPointer<IPCInMemTable> loadIPCInMemoryTableAndCheckSchema(const string& tab
 		errMsg = "SharedStream readData, outputTable col types are not identical to table Data";
 		return nullptr;
 	}
+	for (int i = 0; !outputTable.isNull() && i < outputTable->columns(); i++) {
+		if (outputTable->getColumn(i)->isReadOnly()) {
+			errMsg = "SharedStream readData, outputTable column " + outputTable->getColumnName(i) + " is read-only";
+			return nullptr;
+		}
+	}
 
 	std::vector<ConstantSP> cols;
 	for (unsigned int i = 0; i < it->second.colTypes_.size(); i++) {
@@ -1,36 +1,167 @@
 #include "StreamingUtil.h"
+#include "ConstantImp.h"
 #include "Util.h"
 #include "DolphinDB.h"
+#include "TableImp.h"
+#include <cstring>
+#include <functional>
 
 namespace dolphindb {
 
+namespace {
+
+//Fixed-width fields are copied straight out of the blob, the rest go through Constant::deserialize.
+enum FIELD_KIND { FIELD_GENERIC, FIELD_BOOL, FIELD_CHAR, FIELD_SHORT, FIELD_INT, FIELD_LONG, FIELD_FLOAT, FIELD_DOUBLE, FIELD_BINARY16 };
+
+int fieldWidth(char kind) {
+    switch (kind) {
+    case FIELD_BOOL:
+    case FIELD_CHAR: return 1;
+    case FIELD_SHORT: return 2;
+    case FIELD_INT:
+    case FIELD_FLOAT: return 4;
+    case FIELD_LONG:
+    case FIELD_DOUBLE: return 8;
+    case FIELD_BINARY16: return 16;
+    default: return 0;
+    }
+}
+
+template<class T>
+inline T readRaw(const char *data) {
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+bool blobError(ErrorCodeInfo &errorInfo, IO_ERR ioError) {
+    errorInfo.set(ErrorCodeInfo::EC_InvalidObject, "Deserialize blob error " + std::to_string(ioError));
+    return false;
+}
+
+}
+
 StreamDeserializer::StreamDeserializer(const std::unordered_map<std::string, std::pair<std::string, std::string>> &sym2tableName, DBConnection *pconn)
-                    : sym2tableName_(sym2tableName) {
+                    : sym2tableName_(sym2tableName), symbol2tableInfo_(std::make_shared<TableInfoMap>()), parallelism_(1) {
     if (pconn != NULL) {
         create(*pconn);
     }
 }
 
-StreamDeserializer::StreamDeserializer(const std::unordered_map<std::string, DictionarySP> &sym2schema) {
+StreamDeserializer::StreamDeserializer(const std::unordered_map<std::string, DictionarySP> &sym2schema)
+                    : symbol2tableInfo_(std::make_shared<TableInfoMap>()), parallelism_(1) {
     parseSchema(sym2schema);
 }
 
-StreamDeserializer::StreamDeserializer(const std::unordered_map<std::string, std::vector<DATA_TYPE>> &symbol2col){
+StreamDeserializer::StreamDeserializer(const std::unordered_map<std::string, std::vector<DATA_TYPE>> &symbol2col) : parallelism_(1) {
+    std::shared_ptr<TableInfoMap> infos = std::make_shared<TableInfoMap>();
     for(auto one : symbol2col){
-        symbol2tableInfo_[one.first] = new TableInfo(one.second);
+        (*infos)[one.first] = new TableInfo(one.second);
     }
+    symbol2tableInfo_ = infos;
 }
 
 void StreamDeserializer::returnMessage(Message *msg){
-    symbol2tableInfo_[msg->getSymbol()]->returnTuple(*msg);
+    TableInfoMapSP infos = getTableInfos();
+    auto iter = infos->find(msg->getSymbol());
+    if (iter != infos->end())
+        iter->second->returnTuple(*msg);
 }
 
 void StreamDeserializer::setTupleLimit(INDEX limit){
-    for(auto one : symbol2tableInfo_){
+    TableInfoMapSP infos = getTableInfos();
+    for(auto &one : *infos){
         one.second->setLimit(limit);
     }
 }
 
+class StreamDeserializer::ChunkWorkers {
+public:
+    explicit ChunkWorkers(int threads) : tasks_(1024) {
+        for (int i = 0; i < threads; ++i) {
+            ThreadSP thread = new Thread(new Executor(std::bind(&ChunkWorkers::run, this)));
+            thread->start();
+            threads_.push_back(thread);
+        }
+    }
+    ~ChunkWorkers() {
+        for (size_t i = 0; i < threads_.size(); ++i)
+            tasks_.push(std::function<void()>());
+        for (auto &thread : threads_)
+            thread->join();
+    }
+    void submit(const std::function<void()> &task) { tasks_.push(task); }
+
+private:
+    void run() {
+        std::function<void()> task;
+        while (true) {
+            tasks_.pop(task);
+            if (!task)
+                break;
+            task();
+        }
+    }
+    BlockingQueue<std::function<void()>> tasks_;
+    std::vector<ThreadSP> threads_;
+};
+
+void StreamDeserializer::setParallelism(int threads){
+    parallelism_ = std::max(1, threads);
+    std::shared_ptr<ChunkWorkers> workers;
+    if (parallelism_ > 1)
+        workers = std::make_shared<ChunkWorkers>(parallelism_ - 1);
+    std::atomic_store(&workers_, workers);
+}
+
+std::vector<std::string> StreamDeserializer::getSymbols() const {
+    TableInfoMapSP infos = getTableInfos();
+    std::vector<std::string> symbols;
+    symbols.reserve(infos->size());
+    for (auto &one : *infos)
+        symbols.push_back(one.first);
+    return symbols;
+}
+
+bool StreamDeserializer::newColumns(const std::string &symbol, INDEX capacity, std::vector<VectorSP> &columns, std::vector<std::string> &colNames) const {
+    TableInfoMapSP infos = getTableInfos();
+    auto iter = infos->find(symbol);
+    if (iter == infos->end())
+        return false;
+    columns = iter->second->newColumns(capacity);
+    colNames = iter->second->getColumnNames();
+    return true;
+}
+
+void StreamDeserializer::TableInfo::initFieldKinds(){
+    kinds_.resize(cols_.size());
+    for (size_t i = 0; i < cols_.size(); ++i) {
+        switch (cols_[i]) {
+        case DT_BOOL: kinds_[i] = FIELD_BOOL; break;
+        case DT_CHAR: kinds_[i] = FIELD_CHAR; break;
+        case DT_SHORT: kinds_[i] = FIELD_SHORT; break;
+        case DT_INT:
+        case DT_DATE:
+        case DT_MONTH:
+        case DT_TIME:
+        case DT_MINUTE:
+        case DT_SECOND:
+        case DT_DATETIME:
+        case DT_DATEHOUR: kinds_[i] = FIELD_INT; break;
+        case DT_LONG:
+        case DT_NANOTIME:
+        case DT_TIMESTAMP:
+        case DT_NANOTIMESTAMP: kinds_[i] = FIELD_LONG; break;
+        case DT_FLOAT: kinds_[i] = FIELD_FLOAT; break;
+        case DT_DOUBLE: kinds_[i] = FIELD_DOUBLE; break;
+        case DT_INT128:
+        case DT_UUID:
+        case DT_IP: kinds_[i] = FIELD_BINARY16; break;
+        default: kinds_[i] = FIELD_GENERIC; break;
+        }
+    }
+}
+
 ConstantSP StreamDeserializer::TableInfo::newTuple(){
     {
         LockGuard<Mutex> locker(&mutex_);
@@ -57,7 +188,7 @@ ConstantSP StreamDeserializer::TableInfo::newTuple(){
 }
 
 void StreamDeserializer::create(DBConnection &conn) {
-    if (symbol2tableInfo_.size() > 0 || sym2tableName_.empty())
+    if (getTableInfos()->size() > 0 || sym2tableName_.empty())
         return;
     std::unordered_map<std::string, DictionarySP> sym2schema;
     DictionarySP schema;
@@ -72,45 +203,287 @@ void StreamDeserializer::create(DBConnection &conn) {
     }
     parseSchema(sym2schema);
 }
-bool StreamDeserializer::parseBlob(const ConstantSP &src, std::vector<VectorSP> &rows, std::vector<std::string> &symbols, ErrorCodeInfo &errorInfo) {
-    const VectorSP &symbolVec = src->get(1);
-    const VectorSP &blobVec = src->get(2);
-    INDEX rowSize = symbolVec->rows();
-    rows.resize(rowSize);
-    symbols.resize(rowSize);
-    std::unordered_map<std::string, SmartPointer<TableInfo>>::iterator colTableIter;
-    std::unordered_map<std::string, std::vector<int>>::iterator colScaleIter;
-    for (INDEX rowIndex = 0; rowIndex < rowSize; rowIndex++) {
+std::vector<VectorSP> StreamDeserializer::TableInfo::newColumns(INDEX capacity) const {
+    std::vector<VectorSP> columns(cols_.size());
+    for (size_t i = 0; i < cols_.size(); ++i) {
+        if (cols_[i] == DT_STRING || cols_[i] == DT_BLOB)
+            columns[i] = Util::createArenaStringVector(cols_[i], capacity);
+        else if (cols_[i] < ARRAY_TYPE_BASE)
+            columns[i] = Util::createVector(cols_[i], 0, capacity, true, scales_[i]);
+        else
+            columns[i] = Util::createArrayVector(cols_[i], 0, capacity, true, scales_[i]);
+    }
+    return columns;
+}
+
+bool StreamDeserializer::TableInfo::decodeTuple(const char *data, size_t size, const VectorSP &tuple, DataInputStream &stream, ErrorCodeInfo &errorInfo) const {
+    size_t pos = 0;
+    for (size_t i = 0; i < kinds_.size(); ++i) {
+        ConstantSP field = tuple->get(i);
+        int width = fieldWidth(kinds_[i]);
+        if (width == 0) {
+            stream.reset(data + pos, size - pos);
+            INDEX num;
+            IO_ERR ioError = field->deserialize(&stream, 0, 1, num);
+            if (ioError != OK)
+                return blobError(errorInfo, ioError);
+            pos += (size_t)stream.getPosition();
+            continue;
+        }
+        if (pos + width > size)
+            return blobError(errorInfo, END_OF_STREAM);
+        const char *value = data + pos;
+        switch (kinds_[i]) {
+        case FIELD_BOOL: field->setBool(*value); break;
+        case FIELD_CHAR: field->setChar(*value); break;
+        case FIELD_SHORT: field->setShort(readRaw<short>(value)); break;
+        case FIELD_INT: field->setInt(readRaw<int>(value)); break;
+        case FIELD_LONG: field->setLong(readRaw<long long>(value)); break;
+        case FIELD_FLOAT: field->setFloat(readRaw<float>(value)); break;
+        case FIELD_DOUBLE: field->setDouble(readRaw<double>(value)); break;
+        default: field->setBinary((const unsigned char*)value, 16); break;
+        }
+        pos += width;
+    }
+    return true;
+}
+
+bool StreamDeserializer::TableInfo::decodeColumns(const char *data, size_t size, std::vector<VectorSP> &columns, const VectorSP &scratch,
+                                                  std::vector<std::string> &fixedBuffers, DataInputStream &stream, ErrorCodeInfo &errorInfo) const {
+    size_t pos = 0;
+    for (size_t i = 0; i < kinds_.size(); ++i) {
+        int width = fieldWidth(kinds_[i]);
+        if (width == 0) {
+            ConstantSP field = scratch->get(i);
+            stream.reset(data + pos, size - pos);
+            INDEX num;
+            IO_ERR ioError = field->deserialize(&stream, 0, 1, num);
+            if (ioError != OK)
+                return blobError(errorInfo, ioError);
+            pos += (size_t)stream.getPosition();
+            columns[i]->append(field);
+            continue;
+        }
+        if (pos + width > size)
+            return blobError(errorInfo, END_OF_STREAM);
+        if (kinds_[i] == FIELD_BINARY16) {
+            ConstantSP field = scratch->get(i);
+            field->setBinary((const unsigned char*)(data + pos), 16);
+            columns[i]->append(field);
+        }
+        else {
+            //Buffered and appended in bulk by flushColumns
+            fixedBuffers[i].append(data + pos, width);
+        }
+        pos += width;
+    }
+    return true;
+}
+
+void StreamDeserializer::TableInfo::flushColumns(std::vector<VectorSP> &columns, std::vector<std::string> &fixedBuffers) const {
+    for (size_t i = 0; i < kinds_.size(); ++i) {
+        std::string &buffer = fixedBuffers[i];
+        if (buffer.empty())
+            continue;
+        const VectorSP &column = columns[i];
+        INDEX start = column->size();
+        int count = (int)(buffer.size() / fieldWidth(kinds_[i]));
+        char *raw = &buffer[0];
+        switch (kinds_[i]) {
+        case FIELD_BOOL: column->appendBool(raw, count); break;
+        case FIELD_CHAR: column->appendChar(raw, count); break;
+        case FIELD_SHORT: column->appendShort((short*)raw, count); break;
+        case FIELD_INT: column->appendInt((int*)raw, count); break;
+        case FIELD_LONG: column->appendLong((long long*)raw, count); break;
+        case FIELD_FLOAT: column->appendFloat((float*)raw, count); break;
+        case FIELD_DOUBLE: column->appendDouble((double*)raw, count); break;
+        default: break;
+        }
+        //The bulk append copies raw values and doesn't track nulls.
+        if (!column->getNullFlag() && column->hasNull(start, count))
+            column->setNullFlag(true);
+        buffer.clear();
+    }
+}
+
+bool StreamDeserializer::parseRows(const TableInfoMapSP &infos, const ConstantSP &src, INDEX begin, INDEX end, std::vector<VectorSP> &rows,
+                                   std::vector<std::string> &symbols, ErrorCodeInfo &errorInfo) {
+    VectorSP symbolVec = src->get(1);
+    VectorSP blobVec = src->get(2);
+    //Blobs are read in place, so an arena vector is not converted to std::string.
+    const StringVector *blobs = dynamic_cast<const StringVector*>(blobVec.get());
+    DataInputStream stream(nullptr, 0, false);
+    TableInfo *info = nullptr;
+    std::string lastSymbol;
+    for (INDEX rowIndex = begin; rowIndex < end; rowIndex++) {
         std::string symbol = symbolVec->getString(rowIndex);
-        {
-            LockGuard<Mutex> lock(&mutex_);
-            colTableIter = symbol2tableInfo_.find(symbol);
-            if (colTableIter == symbol2tableInfo_.end()) {
+        //Rows of the same symbol usually come in runs, skip the lookup for those.
+        if (info == nullptr || symbol != lastSymbol) {
+            auto iter = infos->find(symbol);
+            if (iter == infos->end()) {
                 errorInfo.set(ErrorCodeInfo::EC_InvalidParameter, std::string("Unknown symbol ") + symbol);
                 return false;
             }
+            info = iter->second.get();
+            lastSymbol = symbol;
         }
+        VectorSP rowVec = info->newTuple();
+        StringView blob = StringVector::getStringView(blobVec.get(), blobs, rowIndex);
+        if (!info->decodeTuple(blob.data, blob.length, rowVec, stream, errorInfo))
+            return false;
+        rows[rowIndex] = rowVec;
         symbols[rowIndex] = std::move(symbol);
+    }
+    return true;
+}
 
-        const std::string &blob = blobVec->getStringRef(rowIndex);
-        DataInputStreamSP dis = new DataInputStream(blob.data(), blob.size(), false);
-        INDEX num;
-        IO_ERR ioError;
-        VectorSP rowVec = colTableIter->second->newTuple();
-        for (auto i = 0; i < (int)rowVec->size(); i++) {
-            ioError = rowVec->get(i)->deserialize(dis.get(), 0, 1, num);
-            if (ioError != OK) {
-                errorInfo.set(ErrorCodeInfo::EC_InvalidObject, "Deserialize blob error " + std::to_string(ioError));
-                return false;
+bool StreamDeserializer::parseColumns(const TableInfoMapSP &infos, const ConstantSP &src, INDEX begin, INDEX end,
+                                      std::unordered_map<std::string, std::vector<VectorSP>> &columns, ErrorCodeInfo &errorInfo) {
+    struct SymbolColumns {
+        TableInfo *info;
+        std::vector<VectorSP> *columns;
+        VectorSP scratch;
+        std::vector<std::string> fixedBuffers;
+        INDEX rows;
+    };
+    VectorSP symbolVec = src->get(1);
+    VectorSP blobVec = src->get(2);
+    const StringVector *blobs = dynamic_cast<const StringVector*>(blobVec.get());
+    //First pass resolves the symbol of every row, so that new columns can be sized exactly.
+    std::unordered_map<std::string, SymbolColumns> states;
+    std::vector<SymbolColumns*> rowStates(end - begin);
+    SymbolColumns *state = nullptr;
+    std::string lastSymbol;
+    for (INDEX rowIndex = begin; rowIndex < end; rowIndex++) {
+        std::string symbol = symbolVec->getString(rowIndex);
+        if (state == nullptr || symbol != lastSymbol) {
+            auto iter = states.find(symbol);
+            if (iter == states.end()) {
+                auto infoIter = infos->find(symbol);
+                if (infoIter == infos->end()) {
+                    errorInfo.set(ErrorCodeInfo::EC_InvalidParameter, std::string("Unknown symbol ") + symbol);
+                    return false;
+                }
+                SymbolColumns one;
+                one.info = infoIter->second.get();
+                one.columns = nullptr;
+                one.rows = 0;
+                iter = states.emplace(symbol, one).first;
             }
+            state = &iter->second;
+            lastSymbol = std::move(symbol);
+        }
+        state->rows++;
+        rowStates[rowIndex - begin] = state;
+    }
+    for (auto &one : states) {
+        SymbolColumns &cur = one.second;
+        std::vector<VectorSP> &target = columns[one.first];
+        if (target.empty())
+            target = cur.info->newColumns(cur.rows);
+        cur.columns = &target;
+        cur.scratch = cur.info->newTuple();
+        cur.fixedBuffers.resize(target.size());
+    }
+    DataInputStream stream(nullptr, 0, false);
+    for (INDEX rowIndex = begin; rowIndex < end; rowIndex++) {
+        SymbolColumns *cur = rowStates[rowIndex - begin];
+        StringView blob = StringVector::getStringView(blobVec.get(), blobs, rowIndex);
+        if (!cur->info->decodeColumns(blob.data, blob.length, *cur->columns, cur->scratch, cur->fixedBuffers, stream, errorInfo))
+            return false;
+    }
+    for (auto &one : states)
+        one.second.info->flushColumns(*one.second.columns, one.second.fixedBuffers);
+    return true;
+}
+
+int StreamDeserializer::getChunkCount(INDEX rows) const {
+    if (parallelism_ <= 1 || rows < 2 * PARALLEL_MIN_ROWS)
+        return 1;
+    return (int)std::min<INDEX>(parallelism_, rows / PARALLEL_MIN_ROWS);
+}
+
+bool StreamDeserializer::runChunks(int chunkCount, INDEX rows, const std::function<bool(int, INDEX, INDEX, ErrorCodeInfo&)> &task, ErrorCodeInfo &errorInfo) {
+    INDEX chunkSize = (rows + chunkCount - 1) / chunkCount;
+    std::vector<ErrorCodeInfo> errors(chunkCount);
+    std::vector<char> results(chunkCount, 0);
+    auto runOne = [&](int chunk) {
+        INDEX begin = chunk * chunkSize;
+        INDEX end = std::min(rows, begin + chunkSize);
+        try {
+            results[chunk] = task(chunk, begin, end, errors[chunk]);
+        }
+        catch (std::exception &e) {
+            errors[chunk].set(ErrorCodeInfo::EC_InvalidObject, e.what());
+        }
+    };
+    std::shared_ptr<ChunkWorkers> workers = std::atomic_load(&workers_);
+    CountDownLatch done(chunkCount - 1);
+    for (int chunk = 1; chunk < chunkCount; ++chunk) {
+        if (workers) {
+            workers->submit([&runOne, &done, chunk]() { runOne(chunk); done.countDown(); });
+        }
+        else {
+            runOne(chunk);
+            done.countDown();
+        }
+    }
+    runOne(0);
+    done.wait();
+    for (int chunk = 0; chunk < chunkCount; ++chunk) {
+        if (!results[chunk]) {
+            errorInfo.set(errors[chunk]);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StreamDeserializer::parseBlob(const ConstantSP &src, std::vector<VectorSP> &rows, std::vector<std::string> &symbols, ErrorCodeInfo &errorInfo) {
+    TableInfoMapSP infos = getTableInfos();
+    INDEX rowSize = src->get(1)->rows();
+    rows.resize(rowSize);
+    symbols.resize(rowSize);
+    int chunkCount = getChunkCount(rowSize);
+    if (chunkCount <= 1)
+        return parseRows(infos, src, 0, rowSize, rows, symbols, errorInfo);
+    //Every chunk writes a disjoint range of rows and symbols.
+    return runChunks(chunkCount, rowSize, [&](int, INDEX begin, INDEX end, ErrorCodeInfo &chunkError) {
+        return parseRows(infos, src, begin, end, rows, symbols, chunkError);
+    }, errorInfo);
+}
+
+bool StreamDeserializer::parseBlob(const ConstantSP &src, std::unordered_map<std::string, std::vector<VectorSP>> &columns, ErrorCodeInfo &errorInfo) {
+    TableInfoMapSP infos = getTableInfos();
+    INDEX rowSize = src->get(1)->rows();
+    int chunkCount = getChunkCount(rowSize);
+    if (chunkCount <= 1)
+        return parseColumns(infos, src, 0, rowSize, columns, errorInfo);
+    std::vector<std::unordered_map<std::string, std::vector<VectorSP>>> parts(chunkCount);
+    bool ret = runChunks(chunkCount, rowSize, [&](int chunk, INDEX begin, INDEX end, ErrorCodeInfo &chunkError) {
+        return parseColumns(infos, src, begin, end, parts[chunk], chunkError);
+    }, errorInfo);
+    if (!ret)
+        return false;
+    //Concatenate in chunk order to keep the rows of each symbol in block order.
+    for (auto &part : parts) {
+        for (auto &one : part) {
+            std::vector<VectorSP> &target = columns[one.first];
+            if (target.empty()) {
+                target = std::move(one.second);
+                continue;
+            }
+            for (size_t i = 0; i < target.size(); ++i)
+                target[i]->append(one.second[i]);
         }
-        rows[rowIndex] = rowVec;
     }
     return true;
 }
+
 void StreamDeserializer::parseSchema(const std::unordered_map<std::string, DictionarySP> &sym2schema) {
 
     LockGuard<Mutex> lock(&mutex_);
+    std::shared_ptr<TableInfoMap> infos = std::make_shared<TableInfoMap>(*getTableInfos());
 
     for (auto &one : sym2schema) {
         const DictionarySP &schema = one.second;
@@ -131,7 +504,110 @@ void StreamDeserializer::parseSchema(const std::unordered_map<std::string, Dicti
                 colScales[i] = colDefsScales->getInt(i);
             }
         }
-        symbol2tableInfo_[one.first] = new TableInfo(colTypes, colScales);
+        ConstantSP colDefsName = colDefs->getColumn("name");
+        std::vector<std::string> colNames(columnSize);
+        for (auto i = 0; i < (int)columnSize; i++) {
+            colNames[i] = colDefsName->getString(i);
+        }
+        (*infos)[one.first] = new TableInfo(colTypes, colScales, colNames);
+    }
+    std::atomic_store(&symbol2tableInfo_, TableInfoMapSP(infos));
+}
+
+SymbolTableAccumulator::SymbolTableAccumulator(const StreamDeserializerSP &deserializer, const SymbolTableHandler &handler, int batchSize, int throttle)
+    : deserializer_(deserializer), handler_(handler), batchSize_(std::max(1, batchSize)), throttle_(std::max(0, throttle)) {
+    if (deserializer_.isNull())
+        throw RuntimeException("SymbolTableAccumulator requires a StreamDeserializer.");
+    //Preallocate a full batch for every symbol known up front.
+    for (auto &symbol : deserializer_->getSymbols()) {
+        SymbolState &state = states_[symbol];
+        deserializer_->newColumns(symbol, batchSize_, columns_[symbol], state.colNames);
+    }
+}
+
+bool SymbolTableAccumulator::append(const ConstantSP &block, ErrorCodeInfo &errorInfo) {
+    if (!deserializer_->parseBlob(block, columns_, errorInfo))
+        return false;
+    long long now = Util::getEpochTime();
+    for (auto &one : columns_) {
+        std::vector<VectorSP> &columns = one.second;
+        if (columns.empty() || columns[0]->size() == 0)
+            continue;
+        auto iter = states_.find(one.first);
+        if (iter == states_.end()) {
+            iter = states_.emplace(one.first, SymbolState()).first;
+            std::vector<VectorSP> unused;
+            deserializer_->newColumns(one.first, 0, unused, iter->second.colNames);
+        }
+        SymbolState &state = iter->second;
+        if (state.firstTime < 0)
+            state.firstTime = now;
+        if (columns[0]->size() >= batchSize_)
+            flush(one.first, columns, state);
+    }
+    return true;
+}
+
+int SymbolTableAccumulator::flushExpired(long long now) {
+    long long wait = throttle_;
+    for (auto &one : states_) {
+        SymbolState &state = one.second;
+        if (state.firstTime < 0)
+            continue;
+        long long left = state.firstTime + throttle_ - now;
+        if (left <= 0)
+            flush(one.first, columns_[one.first], state);
+        else
+            wait = std::min(wait, left);
+    }
+    return (int)wait;
+}
+
+void SymbolTableAccumulator::flushAll() {
+    for (auto &one : states_) {
+        if (one.second.firstTime >= 0)
+            flush(one.first, columns_[one.first], one.second);
+    }
+}
+
+void SymbolTableAccumulator::flush(const std::string &symbol, std::vector<VectorSP> &columns, SymbolState &state) {
+    state.firstTime = -1;
+    {
+        std::vector<ConstantSP> cols(columns.size());
+        for (size_t i = 0; i < columns.size(); ++i) {
+            //BasicTable adopts temporary vectors instead of copying them.
+            columns[i]->setTemporary(true);
+            cols[i] = columns[i];
+        }
+        TableSP table = new BasicTable(cols, state.colNames);
+        cols.clear();
+        handler_(symbol, table);
+    }
+    state.lent.push_back(std::move(columns));
+    //A column set comes back once the handler dropped every reference to the table it got.
+    for (auto iter = state.lent.begin(); iter != state.lent.end();) {
+        bool released = true;
+        for (auto &column : *iter)
+            released = released && column.count() == 1;
+        if (!released) {
+            ++iter;
+            continue;
+        }
+        for (auto &column : *iter)
+            column->clear();
+        state.pool.push_back(std::move(*iter));
+        iter = state.lent.erase(iter);
+    }
+    while (state.lent.size() > MAX_LENT)
+        state.lent.pop_front();
+    if (!state.pool.empty()) {
+        columns = std::move(state.pool.back());
+        state.pool.pop_back();
+    }
+    else {
+        std::vector<std::string> unused;
+        columns.clear();
+        deserializer_->newColumns(symbol, batchSize_, columns, unused);
     }
 }
 
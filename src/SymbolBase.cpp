@@ -1,6 +1,7 @@
 #include "SymbolBase.h"
 #include "SysIO.h"
 #include "Exceptions.h"
+#include "Metrics.h"
 #include <string.h>
 
 #define SYMBOLBASE_MAX_SIZE 1<<21
@@ -99,4 +100,25 @@ int SymbolBase::findAndInsert(const std::string& symbol){
     return index;
 }
 
-}
\ No newline at end of file
+SymbolBaseSP SymbolBaseCache::get(int id) const {
+    auto it = bases_.find(id);
+    return it == bases_.end() ? SymbolBaseSP() : it->second;
+}
+
+void SymbolBaseCache::put(int id, const SymbolBaseSP& base) {
+    bases_[id] = base;
+}
+
+void SymbolBaseCache::recordHit() {
+    static MetricCounter* hits = MetricsRegistry::instance().counter("ddb_symbol_base_cache_hits_total");
+    ++hits_;
+    hits->increment();
+}
+
+void SymbolBaseCache::recordMiss() {
+    static MetricCounter* misses = MetricsRegistry::instance().counter("ddb_symbol_base_cache_misses_total");
+    ++misses_;
+    misses->increment();
+}
+
+}
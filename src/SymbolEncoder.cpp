@@ -0,0 +1,168 @@
+#include "SymbolEncoder.h"
+#include "ConstantImp.h"
+#include "Util.h"
+#include "Vector.h"
+#include "Exceptions.h"
+
+namespace dolphindb {
+
+SymbolEncoder::SymbolEncoder(int maxSymbols) : maxSymbols_(std::max(1, maxSymbols)), remapSize_(0) {
+    clear();
+}
+
+void SymbolEncoder::clear() {
+    base_ = new SymbolBase(0);
+    base_->findAndInsert("");
+    remapBase_.clear();
+    remapSize_ = 0;
+    remap_.clear();
+    batchCodes_.clear();
+    batchSymbols_.clear();
+}
+
+void SymbolEncoder::prepare() {
+    if (base_->size() > (std::size_t)maxSymbols_)
+        clear();
+}
+
+VectorSP SymbolEncoder::createVector(INDEX capacity) {
+    prepare();
+    VectorSP vec = Util::createSymbolVector(base_, 0, std::max(1, capacity));
+    if (vec.isNull())
+        throw MemoryException();
+    return vec;
+}
+
+const int* SymbolEncoder::remap(const SymbolBaseSP &base) {
+    //A recycled source vector keeps its dictionary, so only the symbols added since the last call are looked up.
+    if (remapBase_.get() != base.get()) {
+        remapBase_ = base;
+        remapSize_ = 0;
+        remap_.clear();
+    }
+    std::size_t size = base->size();
+    if (size == 0)
+        base->find("");
+    size = base->size();
+    for (std::size_t i = remapSize_; i < size; ++i)
+        remap_.push_back(base_->findAndInsert(base->getSymbol((int)i)));
+    remapSize_ = size;
+    return remap_.data();
+}
+
+bool SymbolEncoder::needsEncoding(const VectorSP &col) const {
+    DATA_TYPE type = col->getType();
+    return type == DT_STRING || type == DT_SYMBOL;
+}
+
+void SymbolEncoder::beginBatch() {
+    for (int code : batchSymbols_)
+        batchCodes_[code] = -1;
+    //The long-lived dictionary only restarts between batches, the codes of a batch stay valid until it ends.
+    prepare();
+    if (batchCodes_.empty())
+        batchCodes_.push_back(-1);
+    batchCodes_[0] = 0;
+    batchSymbols_.assign(1, 0);
+}
+
+int SymbolEncoder::batchCode(int code) {
+    if ((std::size_t)code >= batchCodes_.size())
+        batchCodes_.resize(base_->size(), -1);
+    int &batch = batchCodes_[code];
+    if (batch < 0) {
+        batch = (int)batchSymbols_.size();
+        batchSymbols_.push_back(code);
+    }
+    return batch;
+}
+
+SymbolEncoder::Pending SymbolEncoder::encodeCodes(const VectorSP &col) {
+    Pending pending;
+    pending.rows = col->size();
+    pending.codes = new int[std::max(1, pending.rows)];
+    pending.containNull = false;
+    int *codes = pending.codes;
+    if (col->getType() == DT_SYMBOL) {
+        SymbolBaseSP source = col->getSymbolBase();
+        const int *src = (const int *)col->getDataArray();
+        if (source.get() == base_.get()) {
+            for (INDEX i = 0; i < pending.rows; ++i)
+                codes[i] = batchCode(src[i]);
+        }
+        else {
+            const int *map = remap(source);
+            for (INDEX i = 0; i < pending.rows; ++i)
+                codes[i] = batchCode(map[src[i]]);
+        }
+    }
+    else {
+        //Read strings in place, so an arena vector is not converted to std::string.
+        const StringVector *strings = dynamic_cast<const StringVector *>(col.get());
+        std::string symbol;
+        for (INDEX i = 0; i < pending.rows; ++i) {
+            StringView str = StringVector::getStringView(col.get(), strings, i);
+            symbol.assign(str.data, str.length);
+            codes[i] = batchCode(base_->findAndInsert(symbol));
+        }
+    }
+    for (INDEX i = 0; i < pending.rows && !pending.containNull; ++i)
+        pending.containNull = codes[i] == 0;
+    return pending;
+}
+
+SymbolBaseSP SymbolEncoder::endBatch() {
+    std::vector<std::string> symbols;
+    symbols.reserve(batchSymbols_.size());
+    for (int code : batchSymbols_)
+        symbols.push_back(base_->getSymbol(code));
+    return new SymbolBase(0, std::move(symbols));
+}
+
+VectorSP SymbolEncoder::createVector(const SymbolBaseSP &base, const Pending &pending) {
+    return Util::createSymbolVector(base, pending.rows, std::max(1, pending.rows), true, pending.codes, 0, 0, pending.containNull);
+}
+
+VectorSP SymbolEncoder::encode(const VectorSP &col) {
+    if (!needsEncoding(col))
+        return col;
+    beginBatch();
+    Pending pending = encodeCodes(col);
+    return createVector(endBatch(), pending);
+}
+
+void SymbolEncoder::encode(std::vector<ConstantSP> &columns, const std::vector<DATA_TYPE> &targetTypes) {
+    std::size_t count = std::min(columns.size(), targetTypes.size());
+    std::vector<std::pair<std::size_t, Pending>> pending;
+    beginBatch();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (targetTypes[i] == DT_SYMBOL && columns[i]->isVector() && needsEncoding(VectorSP(columns[i])))
+            pending.emplace_back(i, encodeCodes(VectorSP(columns[i])));
+    }
+    if (pending.empty())
+        return;
+    SymbolBaseSP base = endBatch();
+    for (auto &one : pending)
+        columns[one.first] = createVector(base, one.second);
+}
+
+TableSP SymbolEncoder::encode(const TableSP &table, const std::vector<DATA_TYPE> &targetTypes) {
+    int cols = table->columns();
+    std::vector<ConstantSP> columns(cols);
+    std::vector<DATA_TYPE> types(targetTypes.begin(), targetTypes.begin() + std::min((int)targetTypes.size(), cols));
+    for (int i = 0; i < cols; ++i)
+        columns[i] = table->getColumn(i);
+    std::vector<ConstantSP> encoded = columns;
+    encode(encoded, types);
+    bool changed = false;
+    for (int i = 0; i < cols; ++i)
+        changed = changed || encoded[i].get() != columns[i].get();
+    if (!changed)
+        return table;
+    std::vector<std::string> names(cols);
+    for (int i = 0; i < cols; ++i)
+        names[i] = table->getColumnName(i);
+    return Util::createTable(names, encoded);
+}
+
+}
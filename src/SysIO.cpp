@@ -37,6 +37,7 @@
 #include "SysIO.h"
 #include "Util.h"
 #include "Logger.h"
+#include "Metrics.h"
 
 #ifdef _MSC_VER
 	#define ftello64 _ftelli64
@@ -45,8 +46,24 @@
 
 namespace dolphindb {
 
-#define RECORD_READ(pbytes, bytelen) //Util::writeFile("/tmp/ddb_read.bin", pbytes, bytelen);
-#define RECORD_WRITE(pbytes, bytelen) //Util::writeFile("/tmp/ddb_write.bin", pbytes, bytelen);
+#define RECORD_READ(pbytes, bytelen) addSocketBytes(receivedBytesCounter(), bytelen); //Util::writeFile("/tmp/ddb_read.bin", pbytes, bytelen);
+#define RECORD_WRITE(pbytes, bytelen) addSocketBytes(sentBytesCounter(), bytelen); //Util::writeFile("/tmp/ddb_write.bin", pbytes, bytelen);
+
+static MetricCounter* receivedBytesCounter(){
+	static MetricCounter* counter = MetricsRegistry::instance().counter("ddb_socket_received_bytes_total");
+	return counter;
+}
+
+static MetricCounter* sentBytesCounter(){
+	static MetricCounter* counter = MetricsRegistry::instance().counter("ddb_socket_sent_bytes_total");
+	return counter;
+}
+
+static inline void addSocketBytes(MetricCounter* counter, size_t bytelen){
+	//recv/send/SSL_* report failures as a non-positive length
+	if((long long)bytelen > 0)
+		counter->increment((long long)bytelen);
+}
 
 bool Socket::ENABLE_TCP_NODELAY = true;
 
@@ -777,6 +794,16 @@ bool DataInputStream::reset(int size){
 	}
 }
 
+bool DataInputStream::reset(const char* data, std::size_t size){
+	if(!externalBuf_ || source_ != ARRAY_STREAM)
+		return false;
+	buf_ = (char*)data;
+	cursor_ = 0;
+	capacity_ = size;
+	size_ = size;
+	return true;
+}
+
 long long DataInputStream::getPosition() const {
 	if(source_ == FILE_STREAM && file_ != NULL){
 #ifdef MAC
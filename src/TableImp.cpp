@@ -718,6 +718,10 @@ bool BasicTable::internalUpdate(vector<ConstantSP>& valueVec, const ConstantSP&
 		else{
 			colIndex[i]=it->second;
 
+			if(cols_[colIndex[i]]->isReadOnly()){
+				errMsg.append("Can't update read only column " + colNames_->at(colIndex[i]) + ".");
+				return false;
+			}
 			if(cols_[colIndex[i]]->getCategory()!=valueVec[i]->getCategory() && (!valueVec[i]->isNumber() || !cols_[colIndex[i]]->isNumber()) && valueVec[i]->getCategory()!=NOTHING){
 				errMsg.append("The category of the value to update does not match the column ");
 				errMsg.append(colNames_->at(colIndex[i]));
@@ -756,6 +760,13 @@ bool BasicTable::remove(const ConstantSP& indexSP, string& errMsg){
 		errMsg = "Can't remove rows from a read only in-memory table.";
 		return false;
 	}
+	//Removing rows compacts the columns in place.
+	for(std::size_t i=0; i<cols_.size(); ++i){
+		if(cols_[i]->isReadOnly() && !(indexSP.isNull() || indexSP->isNothing())){
+			errMsg = "Can't remove rows from read only column " + colNames_->at(i) + ".";
+			return false;
+		}
+	}
 	return internalRemove(indexSP, errMsg);
 }
 
@@ -905,4 +916,27 @@ ConstantSP BasicTable::getSubTable(vector<int> indices) const{
 	}
 	return new BasicTable(cols, *colNames_.get());
 }
+
+ConstantSP BasicTable::getSubTableView(vector<int> indices) const{
+	std::shared_ptr<const vector<int>> rows = std::make_shared<vector<int>>(std::move(indices));
+	std::size_t colCount = cols_.size();
+	vector<ConstantSP> cols(colCount);
+	for(std::size_t i = 0; i < colCount; i++){
+		cols[i] = Util::createGatherView(cols_[i], rows);
+	}
+	ConstantSP table = new BasicTable(cols, *colNames_.get());
+	table->setReadOnly(true);
+	return table;
+}
+
+ConstantSP BasicTable::getSubTableView(INDEX start, INDEX length) const{
+	std::size_t colCount = cols_.size();
+	vector<ConstantSP> cols(colCount);
+	for(std::size_t i = 0; i < colCount; i++){
+		cols[i] = Util::createSliceView(cols_[i], start, length);
+	}
+	ConstantSP table = new BasicTable(cols, *colNames_.get());
+	table->setReadOnly(true);
+	return table;
+}
 }
@@ -0,0 +1,288 @@
+#include "TemporalKernels.h"
+
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include "Exceptions.h"
+#include "Util.h"
+
+namespace dolphindb {
+namespace kernels {
+
+Divisor::Divisor(unsigned long long divisor) : divisor_(divisor), magic_(0), shift_(0) {
+    if (divisor == 0)
+        throw RuntimeException("Divisor must not be zero.");
+    if (divisor == 1)
+        return;
+    int log2 = 63;
+    while ((divisor >> log2) == 0)
+        --log2;
+    if ((divisor & (divisor - 1)) == 0) {
+        //2^64 as magic: q == n, so ((n - q) >> 1) + q == n and one bit of the shift is already done.
+        shift_ = log2 - 1;
+        return;
+    }
+    //proposed = floor(2^(64 + log2) / divisor) by long division; the quotient fits since 2^log2 < divisor.
+    unsigned long long proposed = 0, rem = 1ULL << log2;
+    for (int i = 0; i < 64; ++i) {
+        bool carry = (rem >> 63) != 0;
+        rem <<= 1;
+        proposed <<= 1;
+        if (carry || rem >= divisor) {
+            rem -= divisor;
+            proposed |= 1;
+        }
+    }
+    proposed += proposed;
+    unsigned long long twiceRem = rem + rem;
+    if (twiceRem >= divisor || twiceRem < rem)
+        proposed += 1;
+    magic_ = proposed + 1;
+    shift_ = log2;
+}
+
+namespace {
+
+//Nanoseconds per unit, and whether the type is a point in time or a time of day.
+struct TemporalUnit {
+    long long nanos;
+    bool timeOfDay;
+};
+
+const long long NANOS_PER_DAY = 86400000000000LL;
+
+bool getUnit(DATA_TYPE type, TemporalUnit& unit) {
+    switch (type) {
+        case DT_DATE: unit.nanos = NANOS_PER_DAY; unit.timeOfDay = false; return true;
+        case DT_DATEHOUR: unit.nanos = 3600000000000LL; unit.timeOfDay = false; return true;
+        case DT_DATETIME: unit.nanos = 1000000000LL; unit.timeOfDay = false; return true;
+        case DT_TIMESTAMP: unit.nanos = 1000000LL; unit.timeOfDay = false; return true;
+        case DT_NANOTIMESTAMP: unit.nanos = 1; unit.timeOfDay = false; return true;
+        case DT_MINUTE: unit.nanos = 60000000000LL; unit.timeOfDay = true; return true;
+        case DT_SECOND: unit.nanos = 1000000000LL; unit.timeOfDay = true; return true;
+        case DT_TIME: unit.nanos = 1000000LL; unit.timeOfDay = true; return true;
+        case DT_NANOTIME: unit.nanos = 1; unit.timeOfDay = true; return true;
+        default: return false;
+    }
+}
+
+bool isLong(DATA_TYPE type) {
+    return type == DT_TIMESTAMP || type == DT_NANOTIME || type == DT_NANOTIMESTAMP;
+}
+
+/**
+ * Per-value operations. Each maps a non-null source value, widened to long long, to the target
+ * value; they have no data-dependent branches so the loop below stays a straight line.
+ */
+struct Identity {
+    long long operator()(long long x) const { return x; }
+};
+
+struct Multiply {
+    unsigned long long ratio;
+    //Unsigned arithmetic: out-of-range values wrap instead of being undefined.
+    long long operator()(long long x) const { return (long long)((unsigned long long)x * ratio); }
+};
+
+struct FloorDivide {
+    Divisor divisor;
+    long long operator()(long long x) const { return divisor.floorDivide(x); }
+};
+
+template<class Scale>
+struct TimeOfDay {
+    Divisor day;
+    Scale scale;
+    long long operator()(long long x) const { return scale(day.floorMod(x)); }
+};
+
+//Remembers the day range of the last month seen; columns are mostly sorted, so most rows hit it.
+class ToMonth {
+public:
+    explicit ToMonth(const Divisor& day) : day_(day), first_(1), last_(0), month_(0) {}
+
+    long long operator()(long long x) {
+        int days = static_cast<int>(day_.floorDivide(x));
+        if (days < first_ || days > last_) {
+            //Null rows and far-off dates are converted without touching the cache.
+            if (days < -MAX_CACHED_DAYS || days > MAX_CACHED_DAYS)
+                return civilMonth(days);
+            month_ = civilMonth(days);
+            int year = month_ / 12 - (month_ % 12 < 0), month = month_ - year * 12 + 1;
+            first_ = Util::countDays(year, month, 1);
+            last_ = month == 12 ? Util::countDays(year + 1, 1, 1) - 1 : Util::countDays(year, month + 1, 1) - 1;
+            //Outside the range countDays handles, fall back to converting every row.
+            if (first_ == INT_MIN || last_ < first_ || days < first_ || days > last_) {
+                first_ = 1;
+                last_ = 0;
+            }
+        }
+        return month_;
+    }
+
+private:
+    //About 8000 years either side of 1970, well within what Util::countDays handles.
+    static const int MAX_CACHED_DAYS = 3000000;
+
+    Divisor day_;
+    int first_, last_, month_;
+};
+
+template<class S, class D, class Op>
+void convertLoop(const S* src, D* dst, INDEX n, S srcNull, D dstNull, Op op) {
+    for (INDEX i = 0; i < n; ++i) {
+        S x = src[i];
+        D y = static_cast<D>(op(static_cast<long long>(x)));
+        dst[i] = x == srcNull ? dstNull : y;
+    }
+}
+
+template<class Op>
+void run(bool srcLong, const void* src, bool dstLong, void* dst, INDEX n, const Op& op) {
+    if (srcLong) {
+        if (dstLong)
+            convertLoop((const long long*)src, (long long*)dst, n, LLONG_MIN, LLONG_MIN, op);
+        else
+            convertLoop((const long long*)src, (int*)dst, n, LLONG_MIN, INT_MIN, op);
+    } else {
+        if (dstLong)
+            convertLoop((const int*)src, (long long*)dst, n, INT_MIN, LLONG_MIN, op);
+        else
+            convertLoop((const int*)src, (int*)dst, n, INT_MIN, INT_MIN, op);
+    }
+}
+
+void runTimeOfDay(bool srcLong, const void* src, bool dstLong, void* dst, INDEX n, const Divisor& day, long long fromNanos, long long toNanos) {
+    if (fromNanos == toNanos) {
+        TimeOfDay<Identity> op = {day, Identity()};
+        run(srcLong, src, dstLong, dst, n, op);
+    } else if (fromNanos > toNanos) {
+        TimeOfDay<Multiply> op = {day, {(unsigned long long)(fromNanos / toNanos)}};
+        run(srcLong, src, dstLong, dst, n, op);
+    } else {
+        TimeOfDay<FloorDivide> op = {day, {Divisor(toNanos / fromNanos)}};
+        run(srcLong, src, dstLong, dst, n, op);
+    }
+}
+
+}
+
+bool canConvertTemporal(DATA_TYPE from, DATA_TYPE to) {
+    if (from == to)
+        return from == DT_MONTH || from == DT_DATEHOUR || (from >= DT_DATE && from <= DT_NANOTIMESTAMP);
+    TemporalUnit source = {1, false}, target = {1, false};
+    if (!getUnit(from, source))
+        return false;
+    if (source.timeOfDay)
+        return to == DT_TIME || to == DT_NANOTIME || to == DT_SECOND || to == DT_MINUTE;
+    if (to == DT_MONTH)
+        return true;
+    if (!getUnit(to, target))
+        return false;
+    //A DATE carries no time of day.
+    return !(from == DT_DATE && target.timeOfDay);
+}
+
+void convertTemporal(DATA_TYPE from, const void* src, DATA_TYPE to, void* dst, INDEX n) {
+    if (!canConvertTemporal(from, to))
+        throw RuntimeException("castTemporal from " + Util::getDataTypeString(from) + " to " + Util::getDataTypeString(to) + " not supported ");
+    bool srcLong = isLong(from), dstLong = isLong(to);
+    if (from == to) {
+        if (src != dst)
+            memcpy(dst, src, (size_t)n * (srcLong ? sizeof(long long) : sizeof(int)));
+        return;
+    }
+    TemporalUnit source = {1, false}, target = {1, false};
+    getUnit(from, source);
+    if (to == DT_MONTH) {
+        run(srcLong, src, dstLong, dst, n, ToMonth(Divisor(NANOS_PER_DAY / source.nanos)));
+        return;
+    }
+    getUnit(to, target);
+    if (!source.timeOfDay && target.timeOfDay) {
+        runTimeOfDay(srcLong, src, dstLong, dst, n, Divisor(NANOS_PER_DAY / source.nanos), source.nanos, target.nanos);
+    } else if (source.nanos >= target.nanos) {
+        Multiply op = {(unsigned long long)(source.nanos / target.nanos)};
+        run(srcLong, src, dstLong, dst, n, op);
+    } else {
+        FloorDivide op = {Divisor(target.nanos / source.nanos)};
+        run(srcLong, src, dstLong, dst, n, op);
+    }
+}
+
+namespace {
+
+/**
+ * UTC offset lookups through localtime, cached for the hour of the last lookup. Time zone
+ * rules only change the offset at transitions, so when both ends of an hour agree the whole
+ * hour shares one offset; hours containing a transition are looked up per value.
+ */
+class LocalOffsetCache {
+public:
+    LocalOffsetCache() : hour_(3600), hourStart_(1), offset_(0) {}
+
+    //Seconds to add to epoch second t, false if localtime produced no valid date.
+    bool get(long long t, long long& offset) {
+        long long hour = hour_.floorDivide(t) * 3600;
+        if (hour == hourStart_) {
+            offset = offset_;
+            return true;
+        }
+        long long first, last;
+        if (!lookup(hour, first) || !lookup(hour + 3599, last))
+            return lookup(t, offset);
+        if (first != last)
+            return lookup(t, offset);
+        hourStart_ = hour;
+        offset_ = first;
+        offset = first;
+        return true;
+    }
+
+private:
+    static bool lookup(long long t, long long& offset) {
+        time_t time = (time_t)t;
+        struct tm lt;
+#ifdef WINDOWS
+        localtime_s(&lt, &time);
+#else
+        localtime_r(&time, &lt);
+#endif
+        int days = Util::countDays(lt.tm_year + 1900, lt.tm_mon + 1, lt.tm_mday);
+        if (days == INT_MIN)
+            return false;
+        offset = days * 86400LL + (lt.tm_hour * 60 + lt.tm_min) * 60 + lt.tm_sec - t;
+        return true;
+    }
+
+    Divisor hour_;
+    //1 is never the start of an hour, so the first lookup always misses.
+    long long hourStart_;
+    long long offset_;
+};
+
+}
+
+void toLocalTime(int* epochTimes, INDEX n) {
+    LocalOffsetCache cache;
+    long long offset;
+    for (INDEX i = 0; i < n; ++i) {
+        if (epochTimes[i] == INT_MIN)
+            continue;
+        epochTimes[i] = cache.get(epochTimes[i], offset) ? static_cast<int>(epochTimes[i] + offset) : INT_MIN;
+    }
+}
+
+void toLocalTime(long long* epochTimes, INDEX n, long long unitsPerSecond) {
+    LocalOffsetCache cache;
+    long long offset;
+    for (INDEX i = 0; i < n; ++i) {
+        if (epochTimes[i] == LLONG_MIN)
+            continue;
+        //The second is truncated towards zero like Util::toLocalTimestamp always did.
+        epochTimes[i] = cache.get(epochTimes[i] / unitsPerSecond, offset) ? epochTimes[i] + offset * unitsPerSecond : LLONG_MIN;
+    }
+}
+
+}
+}
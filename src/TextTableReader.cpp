@@ -0,0 +1,754 @@
+#include "TextTableReader.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include "Concurrent.h"
+#include "ConstantImp.h"
+#include "Exceptions.h"
+#include "FlatHashMap.h"
+#include "Guid.h"
+#include "MappedFile.h"
+#include "TemporalKernels.h"
+#include "Util.h"
+
+namespace dolphindb {
+
+namespace {
+
+const long long NANOS_PER_DAY = 86400000000000LL;
+//Smaller batches are parsed by fewer threads, so no thread gets less than this.
+const size_t MIN_PIECE_BYTES = 1 << 20;
+
+enum ColumnKind {KIND_BOOL, KIND_CHAR, KIND_SHORT, KIND_INT, KIND_LONG, KIND_FLOAT, KIND_DOUBLE, KIND_TEMPORAL, KIND_SYMBOL, KIND_TEXT};
+
+struct ColumnSpec {
+    ColumnSpec() : kind(KIND_TEXT), longValue(false), timeOfDay(false), month(false), unitsPerDay(1), unit(1) {}
+
+    ColumnKind kind;
+    //Temporal columns: whether values are long long, relative to midnight or month indices,
+    //and the units per day and nanoseconds per unit of the type.
+    bool longValue;
+    bool timeOfDay;
+    bool month;
+    long long unitsPerDay;
+    kernels::Divisor unit;
+};
+
+ColumnSpec getColumnSpec(DATA_TYPE type) {
+    ColumnSpec spec;
+    long long unitNanos = 0;
+    switch (type) {
+        case DT_BOOL: spec.kind = KIND_BOOL; return spec;
+        case DT_CHAR: spec.kind = KIND_CHAR; return spec;
+        case DT_SHORT: spec.kind = KIND_SHORT; return spec;
+        case DT_INT: spec.kind = KIND_INT; return spec;
+        case DT_LONG: spec.kind = KIND_LONG; return spec;
+        case DT_FLOAT: spec.kind = KIND_FLOAT; return spec;
+        case DT_DOUBLE: spec.kind = KIND_DOUBLE; return spec;
+        case DT_SYMBOL: spec.kind = KIND_SYMBOL; return spec;
+        case DT_STRING: case DT_BLOB: case DT_UUID: case DT_IP: case DT_INT128:
+        case DT_DECIMAL32: case DT_DECIMAL64: case DT_DECIMAL128:
+            spec.kind = KIND_TEXT;
+            return spec;
+        case DT_MONTH: spec.month = true; unitNanos = NANOS_PER_DAY; break;
+        case DT_DATE: unitNanos = NANOS_PER_DAY; break;
+        case DT_DATEHOUR: unitNanos = 3600000000000LL; break;
+        case DT_DATETIME: unitNanos = 1000000000LL; break;
+        case DT_TIMESTAMP: unitNanos = 1000000LL; spec.longValue = true; break;
+        case DT_NANOTIMESTAMP: unitNanos = 1; spec.longValue = true; break;
+        case DT_MINUTE: unitNanos = 60000000000LL; spec.timeOfDay = true; break;
+        case DT_SECOND: unitNanos = 1000000000LL; spec.timeOfDay = true; break;
+        case DT_TIME: unitNanos = 1000000LL; spec.timeOfDay = true; break;
+        case DT_NANOTIME: unitNanos = 1; spec.longValue = true; spec.timeOfDay = true; break;
+        default:
+            throw RuntimeException("TextTableReader doesn't support column type " + Util::getDataTypeString(type));
+    }
+    spec.kind = KIND_TEMPORAL;
+    spec.unitsPerDay = NANOS_PER_DAY / unitNanos;
+    spec.unit = kernels::Divisor(unitNanos);
+    return spec;
+}
+
+inline bool isDigit(char ch) {
+    return (unsigned char)(ch - '0') <= 9;
+}
+
+//Exactly count digits at p.
+inline bool parseDigits(const char* p, const char* e, int count, int& value) {
+    if (e - p < count)
+        return false;
+    int v = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!isDigit(p[i]))
+            return false;
+        v = v * 10 + (p[i] - '0');
+    }
+    value = v;
+    return true;
+}
+
+//One or two digits.
+inline bool parseSmall(const char*& p, const char* e, int& value) {
+    if (p == e || !isDigit(*p))
+        return false;
+    value = *p++ - '0';
+    if (p < e && isDigit(*p))
+        value = value * 10 + (*p++ - '0');
+    return true;
+}
+
+template<class T>
+bool parseInteger(const char* p, const char* e, T& value) {
+    bool negative = false;
+    if (p < e && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    //19 digits cannot overflow an unsigned long long.
+    if (p == e || e - p > 19)
+        return false;
+    unsigned long long v = 0;
+    for (; p < e; ++p) {
+        if (!isDigit(*p))
+            return false;
+        v = v * 10 + (*p - '0');
+    }
+    if (v > (unsigned long long)std::numeric_limits<T>::max() + negative)
+        return false;
+    value = negative ? (T)(0 - v) : (T)v;
+    return true;
+}
+
+//word is lower case.
+inline bool equalIgnoreCase(const char* p, const char* word, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        if ((p[i] | 0x20) != word[i])
+            return false;
+    }
+    return true;
+}
+
+bool parseBool(const char* p, const char* e, char& value) {
+    size_t len = e - p;
+    if (len == 1 && (*p == '0' || *p == '1')) {
+        value = *p - '0';
+        return true;
+    }
+    if (len == 4 && equalIgnoreCase(p, "true", 4)) {
+        value = 1;
+        return true;
+    }
+    if (len == 5 && equalIgnoreCase(p, "false", 5)) {
+        value = 0;
+        return true;
+    }
+    return false;
+}
+
+bool parseByStrtod(const char* p, const char* e, double& value) {
+    char buf[64];
+    std::string copy;
+    const char* str;
+    size_t len = e - p;
+    if (len < sizeof(buf)) {
+        memcpy(buf, p, len);
+        buf[len] = 0;
+        str = buf;
+    } else {
+        copy.assign(p, len);
+        str = copy.c_str();
+    }
+    char* end;
+    value = strtod(str, &end);
+    return end == str + len;
+}
+
+/**
+ * Values with at most 15 significant digits and a decimal exponent within +-22 are exact in a
+ * double on both sides of one multiplication or division, which is then correctly rounded
+ * (Clinger's fast path). That covers prices and quantities; the rest goes to strtod.
+ */
+bool parseDouble(const char* p, const char* e, double& value) {
+    static const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* start = p;
+    bool negative = false;
+    if (p < e && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    unsigned long long mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool any = false;
+    for (; p < e && isDigit(*p); ++p) {
+        any = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += mantissa != 0;
+        } else {
+            ++exponent;
+        }
+    }
+    if (p < e && *p == '.') {
+        for (++p; p < e && isDigit(*p); ++p) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += mantissa != 0;
+                --exponent;
+            }
+        }
+    }
+    if (!any)
+        return p != e && parseByStrtod(start, e, value);
+    if (p < e && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExp = false;
+        if (p < e && (*p == '-' || *p == '+'))
+            negativeExp = *p++ == '-';
+        if (p == e || !isDigit(*p))
+            return false;
+        int exp = 0;
+        for (; p < e && isDigit(*p); ++p)
+            exp = std::min(exp * 10 + (*p - '0'), 100000);
+        exponent += negativeExp ? -exp : exp;
+    }
+    if (p != e)
+        return false;
+    if (digits > 15 || exponent < -22 || exponent > 22)
+        return parseByStrtod(start, e, value);
+    double v = (double)mantissa;
+    v = exponent < 0 ? v / POW10[-exponent] : v * POW10[exponent];
+    value = negative ? -v : v;
+    return true;
+}
+
+//yyyy.MM.dd with '.', '-' or '/' as separator, or yyyyMMdd. day is 0 when it is left out.
+bool parseCalendar(const char*& p, const char* e, int& year, int& month, int& day) {
+    if (!parseDigits(p, e, 4, year))
+        return false;
+    const char* q = p + 4;
+    day = 0;
+    if (q < e && (*q == '.' || *q == '-' || *q == '/')) {
+        char separator = *q++;
+        if (!parseSmall(q, e, month))
+            return false;
+        if (q < e && *q == separator) {
+            ++q;
+            if (!parseSmall(q, e, day) || day == 0)
+                return false;
+        }
+    } else {
+        if (!parseDigits(q, e, 2, month))
+            return false;
+        q += 2;
+        if (parseDigits(q, e, 2, day)) {
+            if (day == 0)
+                return false;
+            q += 2;
+        }
+    }
+    if (month < 1 || month > 12)
+        return false;
+    p = q;
+    return true;
+}
+
+//Nanoseconds since midnight of HH:mm, HH:mm:ss or HH:mm:ss followed by up to 9 fraction digits.
+bool parseClock(const char*& p, const char* e, long long& nanos) {
+    const char* q = p;
+    int hour, minute, second = 0;
+    if (!parseSmall(q, e, hour) || q == e || *q != ':' || !parseDigits(q + 1, e, 2, minute))
+        return false;
+    q += 3;
+    long long fraction = 0;
+    if (q < e && *q == ':') {
+        if (!parseDigits(q + 1, e, 2, second))
+            return false;
+        q += 3;
+        if (q < e && *q == '.') {
+            int digits = 0;
+            for (++q; q < e && isDigit(*q); ++q) {
+                if (digits < 9) {
+                    fraction = fraction * 10 + (*q - '0');
+                    ++digits;
+                }
+            }
+            if (digits == 0)
+                return false;
+            for (; digits < 9; ++digits)
+                fraction *= 10;
+        }
+    }
+    if (hour > 23 || minute > 59 || second > 59)
+        return false;
+    nanos = ((hour * 60LL + minute) * 60 + second) * 1000000000LL + fraction;
+    p = q;
+    return true;
+}
+
+bool parseTemporal(const ColumnSpec& spec, const char* p, const char* e, long long& value) {
+    int year, month, day;
+    if (spec.month) {
+        if (!parseCalendar(p, e, year, month, day))
+            return false;
+        if (p < e && *p == 'M')
+            ++p;
+        if (p != e || (day != 0 && Util::countDays(year, month, day) == INT_MIN))
+            return false;
+        value = year * 12 + month - 1;
+        return true;
+    }
+    long long nanos = 0;
+    bool hasDate = !(e - p >= 3 && (p[1] == ':' || p[2] == ':'));
+    int days = 0;
+    if (hasDate) {
+        if (!parseCalendar(p, e, year, month, day) || day == 0)
+            return false;
+        days = Util::countDays(year, month, day);
+        if (days == INT_MIN)
+            return false;
+        if (p < e) {
+            if (*p != ' ' && *p != 'T')
+                return false;
+            ++p;
+            if (!parseClock(p, e, nanos))
+                return false;
+        }
+    } else {
+        if (!parseClock(p, e, nanos))
+            return false;
+        //MINUTE values are written as 09:30m.
+        if (p < e && *p == 'm')
+            ++p;
+    }
+    if (p != e)
+        return false;
+    if (spec.timeOfDay) {
+        value = (long long)spec.unit.divide(nanos);
+        return true;
+    }
+    if (!hasDate)
+        return false;
+    value = days * spec.unitsPerDay + (long long)spec.unit.divide(nanos);
+    return true;
+}
+
+struct StringViewHash {
+    size_t operator()(const StringView& str) const { return murmur32(str.data, str.length); }
+};
+
+struct StringViewEqual {
+    bool operator()(const StringView& a, const StringView& b) const {
+        return a.length == b.length && memcmp(a.data, b.data, a.length) == 0;
+    }
+};
+
+/**
+ * Distinct values of a SYMBOL column within one piece. Rows get local codes, with 0 for the
+ * empty string, and are mapped to codes of the column's SymbolBase once all pieces are parsed,
+ * so each distinct value is copied into a std::string once per piece instead of once per row.
+ */
+struct LocalSymbols {
+    LocalSymbols() : symbols(1, StringView{"", 0}) {}
+
+    //stable tells whether str points into the file; otherwise it is copied when first seen.
+    int getCode(StringView str, bool stable) {
+        if (str.length == 0)
+            return 0;
+        FlatHashMap<StringView, int, StringViewHash, StringViewEqual>::iterator it = codes.find(str);
+        if (it != codes.end())
+            return it->second;
+        if (!stable) {
+            owned.emplace_back(str.data, str.length);
+            str.data = owned.back().data();
+        }
+        int code = (int)symbols.size();
+        symbols.push_back(str);
+        codes.emplace(str, code);
+        return code;
+    }
+
+    FlatHashMap<StringView, int, StringViewHash, StringViewEqual> codes;
+    std::vector<StringView> symbols;
+    std::deque<std::string> owned;
+};
+
+//One piece of a batch: a run of whole lines parsed by one thread.
+struct Piece {
+    const char* begin;
+    const char* end;
+    INDEX rows;
+    INDEX firstRow;
+    std::vector<char> hasNull;
+    //Arena StringVectors holding the text columns of the piece; null for the other columns.
+    std::vector<VectorSP> strings;
+    //Local dictionaries of the SYMBOL columns; unused for the other columns.
+    std::vector<LocalSymbols> symbols;
+};
+
+//Advance a line: returns the start of the next line and sets lineEnd, excluding "\r\n".
+inline const char* nextLine(const char* p, const char* end, const char*& lineEnd) {
+    const char* nl = (const char*)memchr(p, '\n', end - p);
+    lineEnd = nl == nullptr ? end : nl;
+    const char* next = nl == nullptr ? end : nl + 1;
+    if (lineEnd > p && lineEnd[-1] == '\r')
+        --lineEnd;
+    return next;
+}
+
+INDEX countRows(const char* p, const char* end) {
+    INDEX rows = 0;
+    const char* lineEnd;
+    while (p < end) {
+        const char* next = nextLine(p, end, lineEnd);
+        rows += lineEnd != p;
+        p = next;
+    }
+    return rows;
+}
+
+template<class T>
+inline void put(void* column, INDEX row, bool ok, T value, T nullValue, char& hasNull) {
+    ((T*)column)[row] = ok ? value : nullValue;
+    hasNull |= !ok;
+}
+
+void storeField(const ColumnSpec& spec, void* column, INDEX row, const char* p, const char* e, char& hasNull) {
+    while (p < e && (*p == ' ' || *p == '\t'))
+        ++p;
+    while (e > p && (e[-1] == ' ' || e[-1] == '\t'))
+        --e;
+    switch (spec.kind) {
+        case KIND_BOOL: {
+            char v = 0;
+            bool ok = parseBool(p, e, v);
+            put(column, row, ok, v, (char)CHAR_MIN, hasNull);
+            break;
+        }
+        case KIND_CHAR: {
+            char v = 0;
+            bool ok = parseInteger(p, e, v);
+            //A single non-digit character stands for itself.
+            if (!ok && e - p == 1 && !isDigit(*p)) {
+                v = *p;
+                ok = true;
+            }
+            put(column, row, ok, v, (char)CHAR_MIN, hasNull);
+            break;
+        }
+        case KIND_SHORT: {
+            short v = 0;
+            bool ok = parseInteger(p, e, v);
+            put(column, row, ok, v, (short)SHRT_MIN, hasNull);
+            break;
+        }
+        case KIND_INT: {
+            int v = 0;
+            bool ok = parseInteger(p, e, v);
+            put(column, row, ok, v, INT_MIN, hasNull);
+            break;
+        }
+        case KIND_LONG: {
+            long long v = 0;
+            bool ok = parseInteger(p, e, v);
+            put(column, row, ok, v, LLONG_MIN, hasNull);
+            break;
+        }
+        case KIND_FLOAT: {
+            double v = 0;
+            bool ok = parseDouble(p, e, v);
+            put(column, row, ok, (float)v, FLT_NMIN, hasNull);
+            break;
+        }
+        case KIND_DOUBLE: {
+            double v = 0;
+            bool ok = parseDouble(p, e, v);
+            put(column, row, ok, v, DBL_NMIN, hasNull);
+            break;
+        }
+        case KIND_TEMPORAL: {
+            long long v = 0;
+            bool ok = parseTemporal(spec, p, e, v);
+            if (spec.longValue)
+                put(column, row, ok, v, LLONG_MIN, hasNull);
+            else
+                put(column, row, ok, (int)v, INT_MIN, hasNull);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void parsePiece(const std::vector<ColumnSpec>& specs, const std::vector<void*>& columns, char delimiter, Piece& piece) {
+    int cols = (int)specs.size();
+    std::string unescaped;
+    INDEX row = piece.firstRow;
+    const char* p = piece.begin;
+    const char* lineEnd;
+    while (p < piece.end) {
+        const char* next = nextLine(p, piece.end, lineEnd);
+        if (lineEnd == p) {
+            p = next;
+            continue;
+        }
+        //Missing trailing fields read as empty, i.e. null.
+        bool exhausted = false;
+        for (int c = 0; c < cols; ++c) {
+            const char* fieldBegin = lineEnd;
+            const char* fieldEnd = lineEnd;
+            bool escaped = false;
+            if (!exhausted) {
+                if (p < lineEnd && *p == '"') {
+                    fieldBegin = ++p;
+                    fieldEnd = lineEnd;
+                    while (p < lineEnd) {
+                        const char* quote = (const char*)memchr(p, '"', lineEnd - p);
+                        if (quote == nullptr) {
+                            p = lineEnd;
+                            break;
+                        }
+                        if (quote + 1 < lineEnd && quote[1] == '"') {
+                            escaped = true;
+                            p = quote + 2;
+                            continue;
+                        }
+                        fieldEnd = quote;
+                        p = quote + 1;
+                        break;
+                    }
+                    if (escaped) {
+                        unescaped.clear();
+                        for (const char* q = fieldBegin; q < fieldEnd; ++q) {
+                            unescaped.push_back(*q);
+                            if (*q == '"')
+                                ++q;
+                        }
+                        fieldBegin = unescaped.data();
+                        fieldEnd = fieldBegin + unescaped.size();
+                    }
+                    const char* sep = (const char*)memchr(p, delimiter, lineEnd - p);
+                    p = sep == nullptr ? lineEnd : sep;
+                } else {
+                    const char* sep = (const char*)memchr(p, delimiter, lineEnd - p);
+                    fieldBegin = p;
+                    fieldEnd = p = sep == nullptr ? lineEnd : sep;
+                }
+                if (p < lineEnd)
+                    ++p;
+                else
+                    exhausted = true;
+            }
+            const ColumnSpec& spec = specs[c];
+            if (spec.kind == KIND_TEXT) {
+                StringView str = {fieldBegin, (size_t)(fieldEnd - fieldBegin)};
+                ((StringVector*)piece.strings[c].get())->appendStringView(&str, 1);
+                piece.hasNull[c] |= str.length == 0;
+            } else if (spec.kind == KIND_SYMBOL) {
+                StringView str = {fieldBegin, (size_t)(fieldEnd - fieldBegin)};
+                int code = piece.symbols[c].getCode(str, !escaped);
+                ((int*)columns[c])[row] = code;
+                piece.hasNull[c] |= code == 0;
+            } else {
+                storeField(spec, columns[c], row, fieldBegin, fieldEnd, piece.hasNull[c]);
+            }
+        }
+        ++row;
+        p = next;
+    }
+}
+
+}
+
+TextTableReader::TextTableReader(const std::string& path, const std::vector<std::string>& colNames, const std::vector<DATA_TYPE>& colTypes,
+                                 const TextReaderOptions& options, const std::vector<int>& extraParams)
+        : colNames_(colNames), colTypes_(colTypes), extraParams_(extraParams), options_(options), offset_(0) {
+    init(path);
+}
+
+TextTableReader::TextTableReader(const std::string& path, const DictionarySP& schema, const TextReaderOptions& options)
+        : options_(options), offset_(0) {
+    TableSP colDefs = schema->getMember("colDefs");
+    ConstantSP names = colDefs->getColumn("name");
+    ConstantSP types = colDefs->getColumn("typeInt");
+    int extraIndex = colDefs->getColumnIndex("extra");
+    ConstantSP extras = extraIndex >= 0 ? colDefs->getColumn(extraIndex) : ConstantSP();
+    for (INDEX i = 0; i < colDefs->rows(); ++i) {
+        colNames_.push_back(names->getString(i));
+        colTypes_.push_back(static_cast<DATA_TYPE>(types->getInt(i)));
+        extraParams_.push_back(extras.isNull() ? 0 : extras->getInt(i));
+    }
+    init(path);
+}
+
+TextTableReader::~TextTableReader() {}
+
+void TextTableReader::init(const std::string& path) {
+    if (colNames_.empty() || colNames_.size() != colTypes_.size())
+        throw RuntimeException("TextTableReader requires the same positive number of column names and types.");
+    if (!extraParams_.empty() && extraParams_.size() != colTypes_.size())
+        throw RuntimeException("The number of extra parameters must match the number of columns.");
+    extraParams_.resize(colTypes_.size(), 0);
+    for (DATA_TYPE type : colTypes_)
+        getColumnSpec(type);
+    if (options_.delimiter == '"' || options_.delimiter == '\n' || options_.delimiter == '\r')
+        throw RuntimeException("Invalid delimiter for TextTableReader.");
+    file_ = std::make_shared<MappedFile>(path, false, true);
+    const char* data = file_->data();
+    size_t size = file_->size();
+    if (size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+        offset_ = 3;
+    if (options_.header && offset_ < size) {
+        const char* nl = (const char*)memchr(data + offset_, '\n', size - offset_);
+        offset_ = nl == nullptr ? size : nl - data + 1;
+    }
+}
+
+bool TextTableReader::hasNext() const {
+    return offset_ < file_->size();
+}
+
+TableSP TextTableReader::read() {
+    return parse(file_->size());
+}
+
+TableSP TextTableReader::next() {
+    size_t size = file_->size();
+    if (offset_ >= size)
+        return TableSP();
+    size_t batch = (size_t)std::max(1LL, options_.batchBytes);
+    size_t end = size - offset_ > batch ? offset_ + batch : size;
+    if (end < size && file_->data()[end - 1] != '\n') {
+        const char* nl = (const char*)memchr(file_->data() + end, '\n', size - end);
+        end = nl == nullptr ? size : nl - file_->data() + 1;
+    }
+    return parse(end);
+}
+
+TableSP TextTableReader::parse(size_t end) {
+    const char* data = file_->data();
+    int cols = (int)colTypes_.size();
+    size_t bytes = end > offset_ ? end - offset_ : 0;
+    size_t workers = options_.workerCount > 0 ? options_.workerCount : std::max(1, Util::getCoreCount());
+    size_t pieceCount = std::max((size_t)1, std::min(workers, bytes / MIN_PIECE_BYTES));
+
+    //Cut the batch into pieces of about the same size, each ending after a line break.
+    std::vector<Piece> pieces;
+    size_t start = offset_;
+    for (size_t i = 1; i <= pieceCount && (start < end || pieces.empty()); ++i) {
+        size_t cut = i == pieceCount ? end : offset_ + bytes / pieceCount * i;
+        if (cut < start)
+            cut = start;
+        if (cut < end && cut > 0 && data[cut - 1] != '\n') {
+            const char* nl = (const char*)memchr(data + cut, '\n', end - cut);
+            cut = nl == nullptr ? end : nl - data + 1;
+        }
+        Piece piece;
+        piece.begin = data + start;
+        piece.end = data + cut;
+        piece.rows = 0;
+        piece.firstRow = 0;
+        piece.hasNull.resize(cols, 0);
+        pieces.push_back(std::move(piece));
+        start = cut;
+    }
+
+    runInParallel(pieces.size(), [&](size_t i) {
+        pieces[i].rows = countRows(pieces[i].begin, pieces[i].end);
+    });
+    INDEX rows = 0;
+    for (Piece& piece : pieces) {
+        piece.firstRow = rows;
+        rows += piece.rows;
+    }
+
+    std::vector<ColumnSpec> specs;
+    std::vector<VectorSP> vectors(cols);
+    std::vector<void*> columns(cols, nullptr);
+    for (int c = 0; c < cols; ++c) {
+        specs.push_back(getColumnSpec(colTypes_[c]));
+        if (specs[c].kind == KIND_TEXT) {
+            DATA_TYPE arenaType = colTypes_[c] == DT_BLOB ? DT_BLOB : DT_STRING;
+            for (Piece& piece : pieces) {
+                piece.strings.resize(cols);
+                piece.strings[c] = Util::createArenaStringVector(arenaType, piece.rows);
+            }
+        } else {
+            vectors[c] = Util::createVector(colTypes_[c], rows, rows, true, extraParams_[c]);
+            columns[c] = vectors[c]->getDataArray();
+            if (specs[c].kind == KIND_SYMBOL) {
+                for (Piece& piece : pieces)
+                    piece.symbols.resize(cols);
+            }
+        }
+    }
+
+    char delimiter = options_.delimiter;
+    runInParallel(pieces.size(), [&](size_t i) {
+        parsePiece(specs, columns, delimiter, pieces[i]);
+    });
+
+    for (int c = 0; c < cols; ++c) {
+        bool hasNull = false;
+        for (Piece& piece : pieces)
+            hasNull |= piece.hasNull[c] != 0;
+        if (specs[c].kind == KIND_SYMBOL) {
+            SymbolBaseSP base = vectors[c]->getSymbolBase();
+            int* codes = (int*)columns[c];
+            for (Piece& piece : pieces) {
+                const std::vector<StringView>& symbols = piece.symbols[c].symbols;
+                std::vector<int> remap(symbols.size());
+                for (size_t i = 0; i < symbols.size(); ++i)
+                    remap[i] = base->findAndInsert(symbols[i].toString());
+                for (INDEX i = piece.firstRow; i < piece.firstRow + piece.rows; ++i)
+                    codes[i] = remap[codes[i]];
+                piece.symbols[c] = LocalSymbols();
+            }
+        }
+        if (specs[c].kind != KIND_TEXT) {
+            vectors[c]->setNullFlag(hasNull);
+            continue;
+        }
+        DATA_TYPE type = colTypes_[c];
+        if ((type == DT_STRING || type == DT_BLOB) && pieces.size() == 1) {
+            vectors[c] = pieces[0].strings[c];
+            continue;
+        }
+        if (type == DT_STRING || type == DT_BLOB) {
+            VectorSP vec = Util::createArenaStringVector(type, rows);
+            StringVector* merged = (StringVector*)vec.get();
+            StringView buf[Util::BUF_SIZE];
+            for (Piece& piece : pieces) {
+                StringVector* strings = (StringVector*)piece.strings[c].get();
+                for (INDEX i = 0; i < piece.rows; i += Util::BUF_SIZE) {
+                    int count = (int)std::min((INDEX)Util::BUF_SIZE, piece.rows - i);
+                    strings->getStringView(i, count, buf);
+                    merged->appendStringView(buf, count);
+                }
+                piece.strings[c].clear();
+            }
+            vectors[c] = vec;
+            continue;
+        }
+        //UUID, IPADDR, INT128 and DECIMAL values are converted by the target vector.
+        VectorSP vec = Util::createVector(type, 0, rows, true, extraParams_[c]);
+        char* buf[Util::BUF_SIZE];
+        for (Piece& piece : pieces) {
+            Vector* strings = piece.strings[c].get();
+            for (INDEX i = 0; i < piece.rows; i += Util::BUF_SIZE) {
+                int count = (int)std::min((INDEX)Util::BUF_SIZE, piece.rows - i);
+                if (!vec->appendString(strings->getStringConst(i, count, buf), count))
+                    throw RuntimeException("Failed to parse column " + colNames_[c] + " as " + Util::getDataTypeString(type) + ".");
+            }
+            piece.strings[c].clear();
+        }
+        vectors[c] = vec;
+    }
+    offset_ = std::max(offset_, end);
+
+    std::vector<ConstantSP> result(vectors.begin(), vectors.end());
+    return Util::createTable(colNames_, result);
+}
+
+}
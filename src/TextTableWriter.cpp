@@ -0,0 +1,511 @@
+#include "TextTableWriter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include "Concurrent.h"
+#include "ConstantImp.h"
+#include "DolphinDB.h"
+#include "Exceptions.h"
+#include "Format.h"
+#include "Util.h"
+
+#ifdef WINDOWS
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace dolphindb {
+
+namespace {
+
+//Formatted text is handed to the file descriptor once this much has accumulated.
+const size_t FLUSH_BYTES = 1 << 20;
+
+//Bytes appended to a std::vector<char> whose size is tracked separately, so it is never shrunk or zero-filled twice.
+class TextBuffer {
+public:
+    TextBuffer(std::vector<char>& data, size_t& size) : data_(data), size_(size) {}
+
+    char* reserve(size_t n) {
+        if (size_ + n > data_.size())
+            data_.resize(std::max(data_.size() * 2, size_ + n));
+        return data_.data() + size_;
+    }
+    void commit(size_t n) { size_ += n; }
+    void append(const char* p, size_t n) {
+        memcpy(reserve(n), p, n);
+        size_ += n;
+    }
+    void append(char c) {
+        *reserve(1) = c;
+        ++size_;
+    }
+    size_t size() const { return size_; }
+    const char* data() const { return data_.data(); }
+
+private:
+    std::vector<char>& data_;
+    size_t& size_;
+};
+
+bool needsQuotes(const char* p, size_t n, char delimiter) {
+    for (size_t i = 0; i < n; ++i) {
+        char c = p[i];
+        if (c == delimiter || c == '"' || c == '\n' || c == '\r')
+            return true;
+    }
+    return false;
+}
+
+void appendField(TextBuffer& out, const char* p, size_t n, char delimiter) {
+    if (!needsQuotes(p, n, delimiter)) {
+        out.append(p, n);
+        return;
+    }
+    out.append('"');
+    for (size_t i = 0; i < n; ++i) {
+        if (p[i] == '"')
+            out.append('"');
+        out.append(p[i]);
+    }
+    out.append('"');
+}
+
+/**
+ * Formats the cells of one column, a block of at most Util::BUF_SIZE rows at a time, back to back
+ * into out; ends[i] receives the end offset of cell i. Each thread has its own formatters.
+ */
+class CellFormatter {
+public:
+    virtual ~CellFormatter() {}
+    virtual void format(Vector* col, INDEX start, int count, TextBuffer& out, size_t* ends) = 0;
+};
+
+template<class T>
+const T* getConst(Vector* col, INDEX start, int count, T* buf);
+template<>
+const short* getConst(Vector* col, INDEX start, int count, short* buf) { return col->getShortConst(start, count, buf); }
+template<>
+const int* getConst(Vector* col, INDEX start, int count, int* buf) { return col->getIntConst(start, count, buf); }
+template<>
+const long long* getConst(Vector* col, INDEX start, int count, long long* buf) { return col->getLongConst(start, count, buf); }
+template<>
+const float* getConst(Vector* col, INDEX start, int count, float* buf) { return col->getFloatConst(start, count, buf); }
+template<>
+const double* getConst(Vector* col, INDEX start, int count, double* buf) { return col->getDoubleConst(start, count, buf); }
+
+template<class T>
+class IntegerFormatter : public CellFormatter {
+public:
+    explicit IntegerFormatter(T nullValue) : nullValue_(nullValue) {}
+
+    void format(Vector* col, INDEX start, int count, TextBuffer& out, size_t* ends) override {
+        const T* values = getConst(col, start, count, buf_);
+        char* p = out.reserve((size_t)count * 20);
+        char* begin = p - out.size();
+        for (int i = 0; i < count; ++i) {
+            if (values[i] != nullValue_)
+                p += NumberFormat::toString(values[i], p);
+            ends[i] = p - begin;
+        }
+        out.commit(p - begin - out.size());
+    }
+
+private:
+    T nullValue_;
+    T buf_[Util::BUF_SIZE];
+};
+
+class BoolFormatter : public CellFormatter {
+public:
+    void format(Vector* col, INDEX start, int count, TextBuffer& out, size_t* ends) override {
+        const char* values = col->getBoolConst(start, count, buf_);
+        char* p = out.reserve(count);
+        char* begin = p - out.size();
+        for (int i = 0; i < count; ++i) {
+            if (values[i] != CHAR_MIN)
+                *p++ = values[i] ? '1' : '0';
+            ends[i] = p - begin;
+        }
+        out.commit(p - begin - out.size());
+    }
+
+private:
+    char buf_[Util::BUF_SIZE];
+};
+
+//Printable characters are written as themselves, like Char::getString, and the others as numbers.
+class CharFormatter : public CellFormatter {
+public:
+    explicit CharFormatter(char delimiter) : delimiter_(delimiter) {}
+
+    void format(Vector* col, INDEX start, int count, TextBuffer& out, size_t* ends) override {
+        const char* values = col->getCharConst(start, count, buf_);
+        for (int i = 0; i < count; ++i) {
+            char c = values[i];
+            if (c == CHAR_MIN) {
+            } else if (c > 31 && c < 127) {
+                appendField(out, &c, 1, delimiter_);
+            } else {
+                out.commit(NumberFormat::toString(c, out.reserve(20)));
+            }
+            ends[i] = out.size();
+        }
+    }
+
+private:
+    char delimiter_;
+    char buf_[Util::BUF_SIZE];
+};
+
+//Double::toString and Float::toString: plain notation, or scientific for magnitudes up to 1e-6 and from 1e6.
+template<class T>
+class FloatingFormatter : public CellFormatter {
+public:
+    FloatingFormatter(T nullValue) : nullValue_(nullValue) {}
+
+    void format(Vector* col, INDEX start, int count, TextBuffer& out, size_t* ends) override {
+        static const NumberFormat plain("0.######");
+        static const NumberFormat scientific("0.0#####E0");
+        int maxLength = std::max(std::max(plain.getMaxLength(), scientific.getMaxLength()), 3);
+        const T* values = getConst(col, start, count, buf_);
+        for (int i = 0; i < count; ++i) {
+            T x = values[i];
+            char* p = out.reserve(maxLength);
+            if (x == nullValue_) {
+            } else if (std::isnan(x)) {
+                memcpy(p, "NaN", 3);
+                out.commit(3);
+            } else if (std::isinf(x)) {
+                memcpy(p, "inf", 3);
+                out.commit(3);
+            } else {
+                T magnitude = std::abs(x);
+                if ((magnitude > 0 && magnitude <= 0.000001) || magnitude >= 1000000.0)
+                    out.commit(scientific.format(x, p));
+                else
+                    out.commit(plain.format(x, p));
+            }
+            ends[i] = out.size();
+        }
+    }
+
+private:
+    T nullValue_;
+    T buf_[Util::BUF_SIZE];
+};
+
+//Values outside [minValue, maxValue] print as null, as the temporal scalars do.
+template<class T>
+class TemporalFormatter : public CellFormatter {
+public:
+    TemporalFormatter(const TemporalFormat& format, DATA_TYPE type, T minValue, T maxValue)
+        : format_(format), type_(type), minValue_(minValue), maxValue_(maxValue) {}
+
+    void format(Vector* col, INDEX start, int count, TextBuffer& out, size_t* ends) override {
+        const T* values = getConst(col, start, count, buf_);
+        for (int i = 0; i < count; ++i) {
+            T x = values[i];
+            if (x >= minValue_ && x <= maxValue_)
+                out.commit(format_.format(x, type_, out.reserve(TemporalFormat::MAX_OUTPUT_LENGTH)));
+            ends[i] = out.size();
+        }
+    }
+
+private:
+    const TemporalFormat& format_;
+    DATA_TYPE type_;
+    T minValue_, maxValue_;
+    T buf_[Util::BUF_SIZE];
+};
+
+//STRING and BLOB columns are read as views, which works for both layouts of StringVector.
+class StringFormatter : public CellFormatter {
+public:
+    StringFormatter(char delimiter) : delimiter_(delimiter) {}
+
+    void format(Vector* col, INDEX start, int count, TextBuffer& out, size_t* ends) override {
+        StringVector* strings = static_cast<StringVector*>(col);
+        strings->getStringView(start, count, buf_);
+        for (int i = 0; i < count; ++i) {
+            appendField(out, buf_[i].data, buf_[i].length, delimiter_);
+            ends[i] = out.size();
+        }
+    }
+
+private:
+    char delimiter_;
+    StringView buf_[Util::BUF_SIZE];
+};
+
+class SymbolFormatter : public CellFormatter {
+public:
+    SymbolFormatter(char delimiter) : delimiter_(delimiter) {}
+
+    void format(Vector* col, INDEX start, int count, TextBuffer& out, size_t* ends) override {
+        char** values = col->getStringConst(start, count, buf_);
+        for (int i = 0; i < count; ++i) {
+            appendField(out, values[i], strlen(values[i]), delimiter_);
+            ends[i] = out.size();
+        }
+    }
+
+private:
+    char delimiter_;
+    char* buf_[Util::BUF_SIZE];
+};
+
+//UUID, IPADDR, INT128, DECIMAL, array vectors and anything else go through getString.
+class GenericFormatter : public CellFormatter {
+public:
+    GenericFormatter(char delimiter) : delimiter_(delimiter) {}
+
+    void format(Vector* col, INDEX start, int count, TextBuffer& out, size_t* ends) override {
+        for (int i = 0; i < count; ++i) {
+            std::string cell = col->getString(start + i);
+            appendField(out, cell.data(), cell.size(), delimiter_);
+            ends[i] = out.size();
+        }
+    }
+
+private:
+    char delimiter_;
+};
+
+const TemporalFormat& getTemporalFormat(DATA_TYPE type) {
+    static const TemporalFormat date("yyyy.MM.dd");
+    static const TemporalFormat month("yyyy.MM\\M");
+    static const TemporalFormat time("HH:mm:ss.SSS");
+    static const TemporalFormat minute("HH:mm\\m");
+    static const TemporalFormat second("HH:mm:ss");
+    static const TemporalFormat datetime("yyyy.MM.ddTHH:mm:ss");
+    static const TemporalFormat timestamp("yyyy.MM.ddTHH:mm:ss.SSS");
+    static const TemporalFormat nanotime("HH:mm:ss.nnnnnnnnn");
+    static const TemporalFormat nanotimestamp("yyyy.MM.ddTHH:mm:ss.nnnnnnnnn");
+    static const TemporalFormat datehour("yyyy.MM.ddTHH");
+    switch (type) {
+        case DT_DATE: return date;
+        case DT_MONTH: return month;
+        case DT_TIME: return time;
+        case DT_MINUTE: return minute;
+        case DT_SECOND: return second;
+        case DT_DATETIME: return datetime;
+        case DT_TIMESTAMP: return timestamp;
+        case DT_NANOTIME: return nanotime;
+        case DT_NANOTIMESTAMP: return nanotimestamp;
+        default: return datehour;
+    }
+}
+
+CellFormatter* createFormatter(Vector* col, char delimiter) {
+    DATA_TYPE type = col->getType();
+    switch (type) {
+        case DT_BOOL: return new BoolFormatter();
+        case DT_CHAR: return new CharFormatter(delimiter);
+        case DT_SHORT: return new IntegerFormatter<short>(SHRT_MIN);
+        case DT_INT: return new IntegerFormatter<int>(INT_MIN);
+        case DT_LONG: return new IntegerFormatter<long long>(LLONG_MIN);
+        case DT_FLOAT: return new FloatingFormatter<float>(FLT_NMIN);
+        case DT_DOUBLE: return new FloatingFormatter<double>(DBL_NMIN);
+        case DT_DATE:
+        case DT_MONTH:
+        case DT_DATETIME:
+        case DT_DATEHOUR:
+            return new TemporalFormatter<int>(getTemporalFormat(type), type, INT_MIN + 1, INT_MAX);
+        case DT_TIME: return new TemporalFormatter<int>(getTemporalFormat(type), type, 0, 86399999);
+        case DT_MINUTE: return new TemporalFormatter<int>(getTemporalFormat(type), type, 0, 1439);
+        case DT_SECOND: return new TemporalFormatter<int>(getTemporalFormat(type), type, 0, 86399);
+        case DT_TIMESTAMP:
+        case DT_NANOTIMESTAMP:
+            return new TemporalFormatter<long long>(getTemporalFormat(type), type, LLONG_MIN + 1, LLONG_MAX);
+        case DT_NANOTIME: return new TemporalFormatter<long long>(getTemporalFormat(type), type, 0, 86399999999999LL);
+        case DT_STRING:
+        case DT_BLOB:
+            if (dynamic_cast<StringVector*>(col) != nullptr)
+                return new StringFormatter(delimiter);
+            return new GenericFormatter(delimiter);
+        case DT_SYMBOL: return new SymbolFormatter(delimiter);
+        default: return new GenericFormatter(delimiter);
+    }
+}
+
+/**
+ * Append rows [start, end) of table to out. Every column of a block is formatted into its own
+ * scratch buffer first, so the typed loops run column by column; the cells are then stitched
+ * into lines.
+ */
+void formatRows(const TableSP& table, INDEX start, INDEX end, char delimiter, TextBuffer& out) {
+    int columns = table->columns();
+    std::vector<Vector*> cols(columns);
+    std::vector<std::unique_ptr<CellFormatter>> formatters(columns);
+    for (int c = 0; c < columns; ++c) {
+        cols[c] = (Vector*)table->getColumn(c).get();
+        formatters[c].reset(createFormatter(cols[c], delimiter));
+    }
+    std::vector<std::vector<char>> cellData(columns);
+    std::vector<size_t> cellSizes(columns);
+    std::vector<size_t> ends((size_t)columns * Util::BUF_SIZE);
+    for (INDEX block = start; block < end; block += Util::BUF_SIZE) {
+        int count = (int)std::min((INDEX)Util::BUF_SIZE, end - block);
+        for (int c = 0; c < columns; ++c) {
+            cellSizes[c] = 0;
+            TextBuffer cells(cellData[c], cellSizes[c]);
+            formatters[c]->format(cols[c], block, count, cells, ends.data() + (size_t)c * Util::BUF_SIZE);
+        }
+        size_t blockSize = (size_t)count * columns;
+        for (int c = 0; c < columns; ++c)
+            blockSize += cellSizes[c];
+        char* p = out.reserve(blockSize);
+        for (int i = 0; i < count; ++i) {
+            for (int c = 0; c < columns; ++c) {
+                const size_t* colEnds = ends.data() + (size_t)c * Util::BUF_SIZE;
+                size_t from = i == 0 ? 0 : colEnds[i - 1];
+                memcpy(p, cellData[c].data() + from, colEnds[i] - from);
+                p += colEnds[i] - from;
+                *p++ = delimiter;
+            }
+            p[-1] = '\n';
+        }
+        out.commit(blockSize);
+    }
+}
+
+}
+
+TextTableWriter::TextTableWriter(int fd, const TextWriterOptions& options) : fd_(fd), ownsFd_(false), options_(options) {
+    init();
+}
+
+TextTableWriter::TextTableWriter(const std::string& path, const TextWriterOptions& options) : ownsFd_(true), options_(options) {
+#ifdef WINDOWS
+    fd_ = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (fd_ < 0)
+        throw RuntimeException("Failed to open file " + path + ": " + strerror(errno));
+    init();
+}
+
+TextTableWriter::~TextTableWriter() {
+    try {
+        flush();
+    } catch (...) {
+    }
+    if (ownsFd_) {
+#ifdef WINDOWS
+        _close(fd_);
+#else
+        close(fd_);
+#endif
+    }
+}
+
+void TextTableWriter::init() {
+    if (options_.delimiter == '"' || options_.delimiter == '\n' || options_.delimiter == '\r')
+        throw RuntimeException("The delimiter can't be a quote or a line break.");
+    if (options_.workerCount <= 0)
+        options_.workerCount = std::max(1, (int)std::thread::hardware_concurrency());
+    if (options_.chunkRows <= 0)
+        throw RuntimeException("chunkRows must be positive.");
+    columns_ = -1;
+    rowsWritten_ = 0;
+    pendingSize_ = 0;
+}
+
+void TextTableWriter::writeHeader(const TableSP& table) {
+    TextBuffer out(pending_, pendingSize_);
+    for (int c = 0; c < columns_; ++c) {
+        const std::string& name = table->getColumnName(c);
+        appendField(out, name.data(), name.size(), options_.delimiter);
+        out.append(c + 1 == columns_ ? '\n' : options_.delimiter);
+    }
+}
+
+void TextTableWriter::write(const TableSP& table) {
+    if (table.isNull())
+        throw RuntimeException("Can't write a null table.");
+    if (columns_ < 0) {
+        columns_ = table->columns();
+        if (options_.header)
+            writeHeader(table);
+    } else if (table->columns() != columns_) {
+        throw RuntimeException("The table has " + std::to_string(table->columns()) + " columns but " + std::to_string(columns_) +
+                               " were written before.");
+    }
+    if (columns_ == 0)
+        return;
+    INDEX rows = table->rows();
+    INDEX chunkRows = options_.chunkRows;
+    INDEX chunks = (rows + chunkRows - 1) / chunkRows;
+    if (options_.workerCount == 1 || chunks <= 1) {
+        TextBuffer out(pending_, pendingSize_);
+        for (INDEX start = 0; start < rows; start += chunkRows) {
+            formatRows(table, start, std::min(rows, start + chunkRows), options_.delimiter, out);
+            if (pendingSize_ >= FLUSH_BYTES)
+                flush();
+        }
+    } else {
+        //One round formats a chunk per worker into its own buffer; the buffers are written in row order.
+        flush();
+        size_t workers = (size_t)std::min((INDEX)options_.workerCount, chunks);
+        chunks_.resize(workers);
+        chunkSizes_.resize(workers);
+        for (INDEX first = 0; first < chunks; first += workers) {
+            size_t count = (size_t)std::min((INDEX)workers, chunks - first);
+            runInParallel(count, [&](size_t i) {
+                INDEX start = (first + i) * chunkRows;
+                chunkSizes_[i] = 0;
+                TextBuffer out(chunks_[i], chunkSizes_[i]);
+                formatRows(table, start, std::min(rows, start + chunkRows), options_.delimiter, out);
+            });
+            for (size_t i = 0; i < count; ++i)
+                writeOut(chunks_[i].data(), chunkSizes_[i]);
+        }
+    }
+    rowsWritten_ += rows;
+}
+
+void TextTableWriter::write(BlockReader& reader) {
+    while (reader.hasNext()) {
+        ConstantSP block = reader.read();
+        if (!block->isTable())
+            throw RuntimeException("BlockReader returned a " + Util::getDataFormString(block->getForm()) + " instead of a table.");
+        write(TableSP(block));
+    }
+}
+
+void TextTableWriter::flush() {
+    //Clear first so a failed write isn't repeated by the destructor.
+    size_t size = pendingSize_;
+    pendingSize_ = 0;
+    writeOut(pending_.data(), size);
+}
+
+void TextTableWriter::writeOut(const char* data, size_t length) {
+    while (length > 0) {
+#ifdef WINDOWS
+        int written = _write(fd_, data, (unsigned int)std::min(length, (size_t)INT_MAX));
+#else
+        ssize_t written = ::write(fd_, data, length);
+#endif
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            throw RuntimeException(std::string("Failed to write the text table: ") + strerror(errno));
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+}
+
+}
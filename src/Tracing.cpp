@@ -0,0 +1,310 @@
+#include "Tracing.h"
+#include "Concurrent.h"
+#include "Util.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <memory>
+#include <unordered_map>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace dolphindb {
+
+namespace {
+
+struct TraceBuffer {
+    TraceBuffer(size_t capacity, unsigned long tid) : threadId(tid), events(capacity), mask(capacity - 1), head(0) {}
+    unsigned long threadId;
+    std::vector<Tracer::Event> events;
+    size_t mask;
+    std::atomic<unsigned long long> head;
+};
+
+struct TraceRegistry {
+    TraceRegistry() : bufferCapacity(1 << 16), nextSpanId(1) {}
+    Mutex mutex;
+    std::vector<std::string> siteNames;
+    std::unordered_map<std::string, int> siteIds;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    //Buffers of exited threads, kept with their events until a new thread takes one over.
+    std::vector<TraceBuffer*> idleBuffers;
+    size_t bufferCapacity;
+    std::atomic<unsigned long long> nextSpanId;
+};
+
+TraceRegistry& registry() {
+    static TraceRegistry instance;
+    return instance;
+}
+
+//Hands the thread's buffer back to the registry when the thread exits.
+struct BufferReturner {
+    TraceBuffer *buffer = nullptr;
+    ~BufferReturner() {
+        if (buffer == nullptr)
+            return;
+        TraceRegistry &reg = registry();
+        LockGuard<Mutex> guard(&reg.mutex);
+        reg.idleBuffers.push_back(buffer);
+    }
+};
+
+thread_local TraceBuffer *tlsBuffer = nullptr;
+thread_local BufferReturner tlsBufferReturner;
+thread_local unsigned long long tlsCurrentSpan = 0;
+
+TraceBuffer* threadBuffer() {
+    if (UNLIKELY(tlsBuffer == nullptr)) {
+        TraceRegistry &reg = registry();
+        LockGuard<Mutex> guard(&reg.mutex);
+        //Take over the buffer of an exited thread; its events stay until the ring wraps around.
+        //Buffers of another capacity (see setBufferCapacity) are dropped instead.
+        TraceBuffer *buffer = nullptr;
+        while (buffer == nullptr && !reg.idleBuffers.empty()) {
+            TraceBuffer *idle = reg.idleBuffers.back();
+            reg.idleBuffers.pop_back();
+            if (idle->events.size() == reg.bufferCapacity) {
+                buffer = idle;
+                buffer->threadId = Util::getCurThreadId();
+            }
+            else {
+                reg.buffers.erase(std::find_if(reg.buffers.begin(), reg.buffers.end(),
+                    [idle](const std::shared_ptr<TraceBuffer> &one) { return one.get() == idle; }));
+            }
+        }
+        if (buffer == nullptr) {
+            reg.buffers.push_back(std::make_shared<TraceBuffer>(reg.bufferCapacity, Util::getCurThreadId()));
+            buffer = reg.buffers.back().get();
+        }
+        tlsBuffer = buffer;
+        tlsBufferReturner.buffer = buffer;
+    }
+    return tlsBuffer;
+}
+
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+//Ticks per nanosecond, measured against the steady clock over 10ms.
+double calibrateTicks() {
+    long long startNano = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    unsigned long long startTick = Tracer::now();
+    long long elapsed;
+    unsigned long long tick;
+    do {
+        elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count() - startNano;
+        tick = Tracer::now();
+    } while (elapsed < 10000000LL);
+    return (double)(tick - startTick) / elapsed;
+}
+#endif
+
+void appendEscaped(std::string &out, const std::string &str) {
+    for (char ch : str) {
+        if (ch == '"' || ch == '\\')
+            out.append(1, '\\');
+        out.append(1, ch);
+    }
+}
+
+}
+
+std::atomic<bool> Tracer::enabled_(false);
+
+void Tracer::setBufferCapacity(size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity)
+        rounded <<= 1;
+    TraceRegistry &reg = registry();
+    LockGuard<Mutex> guard(&reg.mutex);
+    reg.bufferCapacity = rounded;
+}
+
+int Tracer::registerSite(const char *name) {
+    TraceRegistry &reg = registry();
+    LockGuard<Mutex> guard(&reg.mutex);
+    auto iter = reg.siteIds.find(name);
+    if (iter != reg.siteIds.end())
+        return iter->second;
+    int id = static_cast<int>(reg.siteNames.size());
+    reg.siteNames.push_back(name);
+    reg.siteIds[name] = id;
+    return id;
+}
+
+std::string Tracer::getSiteName(int siteId) {
+    TraceRegistry &reg = registry();
+    LockGuard<Mutex> guard(&reg.mutex);
+    if (siteId < 0 || siteId >= (int)reg.siteNames.size())
+        return "";
+    return reg.siteNames[siteId];
+}
+
+unsigned long long Tracer::now() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+double Tracer::ticksPerNanosecond() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    //Calibrated once, on first use.
+    static const double ratio = calibrateTicks();
+    return ratio;
+#else
+    return 1.0;
+#endif
+}
+
+size_t Tracer::bufferCount() {
+    TraceRegistry &reg = registry();
+    LockGuard<Mutex> guard(&reg.mutex);
+    return reg.buffers.size();
+}
+
+unsigned long long Tracer::nextSpanId() {
+    return registry().nextSpanId.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Tracer::record(int siteId, unsigned long long spanId, unsigned long long parentId, unsigned long long startTick, unsigned long long endTick) {
+    TraceBuffer *buffer = threadBuffer();
+    unsigned long long head = buffer->head.load(std::memory_order_relaxed);
+    Event &event = buffer->events[head & buffer->mask];
+    event.siteId = siteId;
+    event.threadId = buffer->threadId;
+    event.spanId = spanId;
+    event.parentId = parentId;
+    event.startTick = startTick;
+    event.endTick = endTick;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::collect(std::vector<Event> &events) {
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    {
+        TraceRegistry &reg = registry();
+        LockGuard<Mutex> guard(&reg.mutex);
+        buffers = reg.buffers;
+    }
+    //Events are copied without stopping the writers, so a slot being overwritten while the
+    //ring wraps around can be torn. Collect while the traced threads are quiet for exact data.
+    for (auto &buffer : buffers) {
+        unsigned long long head = buffer->head.load(std::memory_order_acquire);
+        unsigned long long count = std::min<unsigned long long>(head, buffer->events.size());
+        for (unsigned long long i = head - count; i < head; ++i)
+            events.push_back(buffer->events[i & buffer->mask]);
+    }
+}
+
+void Tracer::clear() {
+    TraceRegistry &reg = registry();
+    LockGuard<Mutex> guard(&reg.mutex);
+    for (auto &buffer : reg.buffers)
+        buffer->head.store(0, std::memory_order_release);
+}
+
+std::string Tracer::exportChromeTrace() {
+    std::vector<Event> events;
+    collect(events);
+    double ratio = ticksPerNanosecond() * 1000.0;
+    unsigned long long baseTick = ULLONG_MAX;
+    for (auto &event : events)
+        baseTick = std::min(baseTick, event.startTick);
+
+    std::string out("{\"traceEvents\":[");
+    char buf[256];
+    for (size_t i = 0; i < events.size(); ++i) {
+        const Event &event = events[i];
+        if (i > 0)
+            out.append(1, ',');
+        out.append("{\"name\":\"");
+        appendEscaped(out, getSiteName(event.siteId));
+        snprintf(buf, sizeof(buf), "\",\"cat\":\"ddb\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"id\":%llu,\"parent\":%llu}}",
+                 event.threadId, (event.startTick - baseTick) / ratio, (event.endTick - event.startTick) / ratio, event.spanId, event.parentId);
+        out.append(buf);
+    }
+    out.append("],\"displayTimeUnit\":\"ns\"}");
+    return out;
+}
+
+bool Tracer::writeChromeTrace(const std::string &path) {
+    std::string json = exportChromeTrace();
+    FILE *pf = NULL;
+#ifdef _MSC_VER
+    fopen_s(&pf, path.c_str(), "wb");
+#else
+    pf = fopen(path.c_str(), "wb");
+#endif
+    if (pf == NULL)
+        return false;
+    bool ok = fwrite(json.data(), 1, json.size(), pf) == json.size();
+    fclose(pf);
+    return ok;
+}
+
+std::string Tracer::summary() {
+    std::vector<Event> events;
+    collect(events);
+    double ratio = ticksPerNanosecond() * 1000.0;
+    std::vector<std::vector<double>> costs;
+    for (auto &event : events) {
+        if (event.siteId >= (int)costs.size())
+            costs.resize(event.siteId + 1);
+        costs[event.siteId].push_back((event.endTick - event.startTick) / ratio);
+    }
+    std::string out;
+    char buf[512];
+    for (size_t site = 0; site < costs.size(); ++site) {
+        std::vector<double> &one = costs[site];
+        if (one.empty())
+            continue;
+        std::sort(one.begin(), one.end());
+        double sum = 0;
+        for (double cost : one)
+            sum += cost;
+        size_t n = one.size();
+        snprintf(buf, sizeof(buf), ": count = %zu sum = %.3f avg = %.3f min = %.3f p50 = %.3f p90 = %.3f p99 = %.3f max = %.3f (us)\n",
+                 n, sum, sum / n, one[0], one[n / 2], one[n * 9 / 10], one[n * 99 / 100], one[n - 1]);
+        out.append(getSiteName(static_cast<int>(site))).append(buf);
+        //log2 buckets in microseconds
+        std::vector<size_t> buckets;
+        for (double cost : one) {
+            size_t bucket = 0;
+            while (bucket < 40 && cost >= (double)(1ULL << bucket))
+                ++bucket;
+            if (bucket >= buckets.size())
+                buckets.resize(bucket + 1);
+            ++buckets[bucket];
+        }
+        out.append("    histogram:");
+        for (size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+            if (buckets[bucket] == 0)
+                continue;
+            snprintf(buf, sizeof(buf), " <%llu:%zu", 1ULL << bucket, buckets[bucket]);
+            out.append(buf);
+        }
+        out.append("\n");
+    }
+    return out;
+}
+
+void TraceSpan::begin() {
+    spanId_ = Tracer::nextSpanId();
+    parentId_ = tlsCurrentSpan;
+    tlsCurrentSpan = spanId_;
+    startTick_ = Tracer::now();
+}
+
+void TraceSpan::finish() {
+    unsigned long long endTick = Tracer::now();
+    Tracer::record(siteId_, spanId_, parentId_, startTick_, endTick);
+    tlsCurrentSpan = parentId_;
+    spanId_ = 0;
+}
+
+}
@@ -39,6 +39,8 @@
 #include "ConstantFactory.h"
 #include "TableImp.h"
 #include "DomainImp.h"
+#include "TemporalKernels.h"
+#include "VectorView.h"
 
 #ifdef MAC
 #include <sys/syscall.h>
@@ -428,6 +430,64 @@ Vector* Util::createVector(DATA_TYPE type, INDEX size, INDEX capacity, bool fast
 		return createArrayVector(type, size, capacity, fast, extraParam);
 }
 
+namespace {
+
+template<class T>
+void attachExternalData(Vector* vec, void* data, INDEX size, const std::shared_ptr<void>& owner, bool readOnly, bool containNull){
+	static_cast<AbstractFastVector<T>*>(vec)->setExternalData((T*)data, size, owner, containNull, readOnly);
+}
+
+}
+
+Vector* Util::createVector(DATA_TYPE type, INDEX size, void* data, const std::shared_ptr<void>& owner, bool readOnly, int extraParam, bool containNull){
+	if(size < 0)
+		throw RuntimeException("The size of a vector can't be negative.");
+	if(size > 0 && data == NULL)
+		throw RuntimeException("The data of a vector over an external buffer can't be null.");
+	std::unique_ptr<Vector> vec;
+	switch(type){
+		case DT_BOOL: case DT_CHAR: case DT_SHORT: case DT_INT: case DT_LONG: case DT_FLOAT: case DT_DOUBLE:
+		case DT_DATE: case DT_MONTH: case DT_TIME: case DT_MINUTE: case DT_SECOND: case DT_DATETIME: case DT_DATEHOUR:
+		case DT_TIMESTAMP: case DT_NANOTIME: case DT_NANOTIMESTAMP: case DT_DECIMAL32: case DT_DECIMAL64: case DT_DECIMAL128:
+			vec.reset(createVector(type, 0, 1, true, extraParam));
+			break;
+		default:
+			throw RuntimeException("Can't create a " + getDataTypeString(type) + " vector over an external buffer.");
+	}
+	switch(getDataTypeSize(type)){
+		case 1: attachExternalData<char>(vec.get(), data, size, owner, readOnly, containNull); break;
+		case 2: attachExternalData<short>(vec.get(), data, size, owner, readOnly, containNull); break;
+		case 4:
+			if(type == DT_FLOAT)
+				attachExternalData<float>(vec.get(), data, size, owner, readOnly, containNull);
+			else
+				attachExternalData<int>(vec.get(), data, size, owner, readOnly, containNull);
+			break;
+		case 8:
+			if(type == DT_DOUBLE)
+				attachExternalData<double>(vec.get(), data, size, owner, readOnly, containNull);
+			else
+				attachExternalData<long long>(vec.get(), data, size, owner, readOnly, containNull);
+			break;
+		default: attachExternalData<wide_integer::int128>(vec.get(), data, size, owner, readOnly, containNull); break;
+	}
+	return vec.release();
+}
+
+Vector* Util::createVector(DATA_TYPE type, INDEX size, void* data, const std::function<void(void*)>& deleter, bool readOnly, int extraParam, bool containNull){
+	if(!deleter)
+		throw RuntimeException("The deleter of an external buffer can't be empty.");
+	//Take ownership first, so the buffer is freed even when the vector can't be created.
+	std::shared_ptr<void> owner(data, deleter);
+	return createVector(type, size, data, owner, readOnly, extraParam, containNull);
+}
+
+Vector* Util::createArenaStringVector(DATA_TYPE type, INDEX capacity){
+	if(type != DT_STRING && type != DT_SYMBOL && type != DT_BLOB)
+		throw RuntimeException("An arena string vector must be of type STRING, SYMBOL or BLOB.");
+	return new StringVector(0, capacity, type == DT_BLOB, true);
+}
+
 Vector* Util::createArrayVector(DATA_TYPE type, INDEX size, INDEX capacity, bool fast, int extraParam, void* data, INDEX *pindex, bool containNull){
 	return s_constFactory->createConstantArrayVector(type,size,capacity,true,extraParam, data, pindex, 0, 0, containNull);
 }
@@ -940,19 +1000,7 @@ int Util::toLocalDateTime(int epochTime){
 }
 
 int* Util::toLocalDateTime(int* epochTimes, int n){
-	struct tm lt;
-	for(int i=0; i<n; ++i){
-		if(epochTimes[i] == INT_MIN)
-			continue;
-		time_t t = epochTimes[i];
-	#ifdef WINDOWS
-	    localtime_s(&lt, &t);
-	#else
-	    localtime_r(&t, &lt);
-	#endif
-	    int days = countDays(lt.tm_year+1900,lt.tm_mon+1,lt.tm_mday);
-	    epochTimes[i] = days == INT_MIN ? INT_MIN : days * 86400 + ((lt.tm_hour * 60 + lt.tm_min)* 60 + lt.tm_sec);
-	}
+	kernels::toLocalTime(epochTimes, n);
 	return epochTimes;
 }
 
@@ -969,19 +1017,7 @@ long long Util::toLocalTimestamp(long long epochTime){
 }
 
 long long* Util::toLocalTimestamp(long long* epochTimes, int n){
-	struct tm lt;
-	for(int i=0; i<n; ++i){
-		if(epochTimes[i] == LLONG_MIN)
-			continue;
-		time_t t = epochTimes[i] / 1000;
-	#ifdef WINDOWS
-	    localtime_s(&lt, &t);
-	#else
-	    localtime_r(&t, &lt);
-	#endif
-	    int days = countDays(lt.tm_year+1900,lt.tm_mon+1,lt.tm_mday);
-	    epochTimes[i] = days == INT_MIN ? LLONG_MIN : days * 86400000ll + ((lt.tm_hour * 60 + lt.tm_min)* 60 + lt.tm_sec) * 1000ll + (epochTimes[i] % 1000);
-	}
+	kernels::toLocalTime(epochTimes, n, 1000);
 	return epochTimes;
 }
 
@@ -998,19 +1034,7 @@ long long Util::toLocalNanoTimestamp(long long epochNanoTime){
 }
 
 long long* Util::toLocalNanoTimestamp(long long* epochNanoTimes, int n){
-	struct tm lt;
-	for(int i=0; i<n; ++i){
-		if(epochNanoTimes[i] == LLONG_MIN)
-			continue;
-		time_t t = epochNanoTimes[i] / 1000000000;
-	#ifdef WINDOWS
-	    localtime_s(&lt, &t);
-	#else
-	    localtime_r(&t, &lt);
-	#endif
-	    int days = countDays(lt.tm_year+1900,lt.tm_mon+1,lt.tm_mday);
-	    epochNanoTimes[i] = days == INT_MIN ? LLONG_MIN : days * 86400000000000ll + ((lt.tm_hour * 60 + lt.tm_min)* 60 + lt.tm_sec) * 1000000000ll + (epochNanoTimes[i] % 1000000000);
-	}
+	kernels::toLocalTime(epochNanoTimes, n, 1000000000);
 	return epochNanoTimes;
 }
 
@@ -1332,6 +1356,67 @@ Vector* Util::createSubVector(const VectorSP& source, vector<int> indices){
 	}
 	return result;
 }
+namespace {
+
+template<class T>
+Vector* createFastSlice(const VectorSP& source, INDEX start, INDEX length){
+	const AbstractFastVector<T>* vec = dynamic_cast<const AbstractFastVector<T>*>(source.get());
+	if(vec == NULL)
+		return NULL;
+	std::unique_ptr<Vector> slice(source->getType() == DT_SYMBOL ? Util::createSymbolVector(source->getSymbolBase(), 0, 1)
+			: Util::createVector(source->getType(), 0, 1, true, source->getExtraParamForType()));
+	static_cast<AbstractFastVector<T>*>(slice.get())->setExternalData((T*)vec->getDataArray() + start, length, vec->shareData(), source->getNullFlag(), true);
+	return slice.release();
+}
+
+bool isViewable(const VectorSP& source){
+	return source->isArray() && source->getVectorType() == VECTOR_TYPE::ARRAY && source->getType() != DT_ANY && source->getType() != DT_VOID
+		&& ((source->isFastMode() && source->getDataArray() != NULL) || source->getType() == DT_STRING || source->getType() == DT_BLOB);
+}
+
+}
+
+Vector* Util::createSliceView(const VectorSP& source, INDEX start, INDEX length){
+	if(start < 0 || length < 0 || start > source->size() - length)
+		throw RuntimeException("Failed to create a slice of " + std::to_string(length) + " rows from row " + std::to_string(start) +
+			" of a vector of size " + std::to_string(source->size()));
+	VectorView* view = dynamic_cast<VectorView*>(source.get());
+	if(view != NULL)
+		return view->getView(start, length);
+	if(!isViewable(source)){
+		vector<int> indices(length);
+		for(INDEX i = 0; i < length; ++i)
+			indices[i] = (int)(start + i);
+		return createSubVector(source, std::move(indices));
+	}
+	Vector* slice = NULL;
+	switch(source->getRawType()){
+		case DT_BOOL: case DT_CHAR: slice = createFastSlice<char>(source, start, length); break;
+		case DT_SHORT: slice = createFastSlice<short>(source, start, length); break;
+		case DT_INT: case DT_DECIMAL32: slice = createFastSlice<int>(source, start, length); break;
+		case DT_LONG: case DT_DECIMAL64: slice = createFastSlice<long long>(source, start, length); break;
+		case DT_FLOAT: slice = createFastSlice<float>(source, start, length); break;
+		case DT_DOUBLE: slice = createFastSlice<double>(source, start, length); break;
+		case DT_DECIMAL128: slice = createFastSlice<wide_integer::int128>(source, start, length); break;
+		default: break;
+	}
+	return slice != NULL ? slice : new VectorView(source, start, length);
+}
+
+Vector* Util::createGatherView(const VectorSP& source, const std::shared_ptr<const std::vector<int>>& indices){
+	INDEX sourceSize = source->size();
+	for(int index : *indices){
+		if(index < 0 || index >= sourceSize)
+			throw RuntimeException("Failed to createSubVectot with index " + std::to_string(index));
+	}
+	VectorView* view = dynamic_cast<VectorView*>(source.get());
+	if(view != NULL)
+		return view->getView(*indices);
+	if(!isViewable(source))
+		return createSubVector(source, *indices);
+	return new VectorView(source, indices, 0, (INDEX)indices->size());
+}
+
 Vector* Util::createSymbolVector(const SymbolBaseSP& symbolBase, INDEX size, INDEX capacity, bool fast, void* data, void** dataSegment, int segmentSizeInBit, bool containNull){
 		if(data == NULL && dataSegment == NULL){
 			try{
@@ -0,0 +1,380 @@
+#include "VectorKernels.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(_MSC_VER))
+#define DDB_AVX2_KERNELS 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define DDB_AVX2_TARGET
+#else
+#define DDB_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace dolphindb {
+namespace kernels {
+
+#ifdef DDB_AVX2_KERNELS
+
+static bool detectAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    //The OS has to save the YMM registers on context switches (OSXSAVE + XCR0 bits 1 and 2).
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+        return false;
+    if ((_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+namespace avx2 {
+
+/**
+ * Per-type building blocks. Every comparison returns a lane mask as __m256i (all ones where
+ * true) so the loops below can be shared across the integer and floating point types.
+ */
+template<class T> struct Ops;
+
+template<> struct Ops<int> {
+    static const int LANES = 8;
+    DDB_AVX2_TARGET static __m256i load(const int* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    DDB_AVX2_TARGET static __m256i splat(int x) { return _mm256_set1_epi32(x); }
+    DDB_AVX2_TARGET static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+    DDB_AVX2_TARGET static __m256i gt(__m256i a, __m256i b) { return _mm256_cmpgt_epi32(a, b); }
+    DDB_AVX2_TARGET static __m256i ge(__m256i a, __m256i b) {
+        return _mm256_xor_si256(_mm256_cmpgt_epi32(b, a), _mm256_set1_epi32(-1));
+    }
+    DDB_AVX2_TARGET static __m256i count(__m256i counter, __m256i mask) { return _mm256_sub_epi32(counter, mask); }
+    DDB_AVX2_TARGET static long long countSum(__m256i counter) {
+        alignas(32) int lanes[8];
+        _mm256_store_si256((__m256i*)lanes, counter);
+        long long sum = 0;
+        for (int i = 0; i < 8; ++i)
+            sum += lanes[i];
+        return sum;
+    }
+};
+
+template<> struct Ops<long long> {
+    static const int LANES = 4;
+    DDB_AVX2_TARGET static __m256i load(const long long* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    DDB_AVX2_TARGET static __m256i splat(long long x) { return _mm256_set1_epi64x(x); }
+    DDB_AVX2_TARGET static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+    DDB_AVX2_TARGET static __m256i gt(__m256i a, __m256i b) { return _mm256_cmpgt_epi64(a, b); }
+    DDB_AVX2_TARGET static __m256i ge(__m256i a, __m256i b) {
+        return _mm256_xor_si256(_mm256_cmpgt_epi64(b, a), _mm256_set1_epi64x(-1));
+    }
+    DDB_AVX2_TARGET static __m256i count(__m256i counter, __m256i mask) { return _mm256_sub_epi64(counter, mask); }
+    DDB_AVX2_TARGET static long long countSum(__m256i counter) {
+        alignas(32) long long lanes[4];
+        _mm256_store_si256((__m256i*)lanes, counter);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+};
+
+template<> struct Ops<float> {
+    static const int LANES = 8;
+    DDB_AVX2_TARGET static __m256 load(const float* p) { return _mm256_loadu_ps(p); }
+    DDB_AVX2_TARGET static __m256 splat(float x) { return _mm256_set1_ps(x); }
+    DDB_AVX2_TARGET static __m256i eq(__m256 a, __m256 b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    DDB_AVX2_TARGET static __m256i gt(__m256 a, __m256 b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+    DDB_AVX2_TARGET static __m256i ge(__m256 a, __m256 b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GE_OQ)); }
+    DDB_AVX2_TARGET static __m256i count(__m256i counter, __m256i mask) { return _mm256_sub_epi32(counter, mask); }
+    DDB_AVX2_TARGET static long long countSum(__m256i counter) { return Ops<int>::countSum(counter); }
+};
+
+template<> struct Ops<double> {
+    static const int LANES = 4;
+    DDB_AVX2_TARGET static __m256d load(const double* p) { return _mm256_loadu_pd(p); }
+    DDB_AVX2_TARGET static __m256d splat(double x) { return _mm256_set1_pd(x); }
+    DDB_AVX2_TARGET static __m256i eq(__m256d a, __m256d b) { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+    DDB_AVX2_TARGET static __m256i gt(__m256d a, __m256d b) { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+    DDB_AVX2_TARGET static __m256i ge(__m256d a, __m256d b) { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_GE_OQ)); }
+    DDB_AVX2_TARGET static __m256i count(__m256i counter, __m256i mask) { return _mm256_sub_epi64(counter, mask); }
+    DDB_AVX2_TARGET static long long countSum(__m256i counter) { return Ops<long long>::countSum(counter); }
+};
+
+DDB_AVX2_TARGET static inline bool any(__m256i mask) { return !_mm256_testz_si256(mask, mask); }
+
+template<class T>
+DDB_AVX2_TARGET INDEX findNull(const T* data, INDEX n, T nullVal) {
+    typedef Ops<T> O;
+    const int step = 4 * O::LANES;
+    auto nv = O::splat(nullVal);
+    INDEX i = 0;
+    //Four vectors per iteration; on a hit the scalar loop below locates the null within the block.
+    for (; i + step <= n; i += step) {
+        __m256i m = _mm256_or_si256(_mm256_or_si256(O::eq(O::load(data + i), nv), O::eq(O::load(data + i + O::LANES), nv)),
+                _mm256_or_si256(O::eq(O::load(data + i + 2 * O::LANES), nv), O::eq(O::load(data + i + 3 * O::LANES), nv)));
+        if (any(m))
+            break;
+    }
+    for (; i < n && data[i] != nullVal; ++i);
+    return i;
+}
+
+template<class T>
+DDB_AVX2_TARGET INDEX countNull(const T* data, INDEX n, T nullVal) {
+    typedef Ops<T> O;
+    auto nv = O::splat(nullVal);
+    __m256i counter = _mm256_setzero_si256();
+    INDEX i = 0;
+    for (; i + O::LANES <= n; i += O::LANES)
+        counter = O::count(counter, O::eq(O::load(data + i), nv));
+    INDEX count = (INDEX)O::countSum(counter);
+    for (; i < n; ++i)
+        count += data[i] == nullVal;
+    return count;
+}
+
+template<class T>
+DDB_AVX2_TARGET bool isSorted(const T* data, INDEX n, bool asc, bool strict) {
+    typedef Ops<T> O;
+    INDEX i = 0;
+    //Compare data[i, i+LANES) with data[i+1, i+1+LANES); a violation is prev > cur (asc) or
+    //cur > prev (desc), including equality when strict.
+    for (; i + O::LANES < n; i += O::LANES) {
+        auto prev = O::load(data + i);
+        auto cur = O::load(data + i + 1);
+        __m256i bad = asc ? (strict ? O::ge(prev, cur) : O::gt(prev, cur)) : (strict ? O::ge(cur, prev) : O::gt(cur, prev));
+        if (any(bad))
+            return false;
+    }
+    return scalar::isSorted(data + i, n - i, asc, strict);
+}
+
+DDB_AVX2_TARGET void reduce(const int* data, INDEX n, int nullVal, Reduction<int>& result) {
+    const __m256i nv = _mm256_set1_epi32(nullVal);
+    __m256i vmin = _mm256_set1_epi32(INT_MAX), vmax = _mm256_set1_epi32(INT_MIN);
+    __m256i counter = _mm256_setzero_si256(), sum = _mm256_setzero_si256();
+    INDEX i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i m = _mm256_cmpeq_epi32(v, nv);
+        counter = _mm256_sub_epi32(counter, m);
+        vmin = _mm256_min_epi32(vmin, _mm256_blendv_epi8(v, _mm256_set1_epi32(INT_MAX), m));
+        vmax = _mm256_max_epi32(vmax, _mm256_blendv_epi8(v, _mm256_set1_epi32(INT_MIN), m));
+        __m256i z = _mm256_andnot_si256(m, v);
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(z)));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(z, 1)));
+    }
+    alignas(32) int mins[8], maxs[8];
+    alignas(32) long long sums[4];
+    _mm256_store_si256((__m256i*)mins, vmin);
+    _mm256_store_si256((__m256i*)maxs, vmax);
+    _mm256_store_si256((__m256i*)sums, sum);
+    INDEX nulls = (INDEX)Ops<int>::countSum(counter);
+    int mn = INT_MAX, mx = INT_MIN;
+    for (int k = 0; k < 8; ++k) {
+        mn = (std::min)(mn, mins[k]);
+        mx = (std::max)(mx, maxs[k]);
+    }
+    long long s = sums[0] + sums[1] + sums[2] + sums[3];
+    for (; i < n; ++i) {
+        int x = data[i];
+        if (x == nullVal) {
+            ++nulls;
+            continue;
+        }
+        mn = (std::min)(mn, x);
+        mx = (std::max)(mx, x);
+        s += x;
+    }
+    bool empty = nulls == n;
+    result.nullCount = nulls;
+    result.min = empty ? nullVal : mn;
+    result.max = empty ? nullVal : mx;
+    result.sum = s;
+}
+
+DDB_AVX2_TARGET void reduce(const long long* data, INDEX n, long long nullVal, Reduction<long long>& result) {
+    const __m256i nv = _mm256_set1_epi64x(nullVal);
+    const __m256i hi = _mm256_set1_epi64x(LLONG_MAX), lo = _mm256_set1_epi64x(LLONG_MIN);
+    __m256i vmin = hi, vmax = lo;
+    __m256i counter = _mm256_setzero_si256(), sum = _mm256_setzero_si256();
+    INDEX i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i m = _mm256_cmpeq_epi64(v, nv);
+        counter = _mm256_sub_epi64(counter, m);
+        __m256i forMin = _mm256_blendv_epi8(v, hi, m);
+        __m256i forMax = _mm256_blendv_epi8(v, lo, m);
+        vmin = _mm256_blendv_epi8(vmin, forMin, _mm256_cmpgt_epi64(vmin, forMin));
+        vmax = _mm256_blendv_epi8(vmax, forMax, _mm256_cmpgt_epi64(forMax, vmax));
+        sum = _mm256_add_epi64(sum, _mm256_andnot_si256(m, v));
+    }
+    alignas(32) long long mins[4], maxs[4], sums[4];
+    _mm256_store_si256((__m256i*)mins, vmin);
+    _mm256_store_si256((__m256i*)maxs, vmax);
+    _mm256_store_si256((__m256i*)sums, sum);
+    INDEX nulls = (INDEX)Ops<long long>::countSum(counter);
+    long long mn = LLONG_MAX, mx = LLONG_MIN;
+    //Sum with unsigned arithmetic: wrapping is intended, as in the scalar loop.
+    unsigned long long s = 0;
+    for (int k = 0; k < 4; ++k) {
+        mn = (std::min)(mn, mins[k]);
+        mx = (std::max)(mx, maxs[k]);
+        s += (unsigned long long)sums[k];
+    }
+    for (; i < n; ++i) {
+        long long x = data[i];
+        if (x == nullVal) {
+            ++nulls;
+            continue;
+        }
+        mn = (std::min)(mn, x);
+        mx = (std::max)(mx, x);
+        s += (unsigned long long)x;
+    }
+    bool empty = nulls == n;
+    result.nullCount = nulls;
+    result.min = empty ? nullVal : mn;
+    result.max = empty ? nullVal : mx;
+    result.sum = (long long)s;
+}
+
+/**
+ * Floating point min/max start from +/-infinity with nulls blended to the neutral value. The
+ * loaded value is the first operand of min/max, so a NaN lane keeps the running result, which
+ * matches the scalar "x < min" test.
+ */
+DDB_AVX2_TARGET void reduce(const double* data, INDEX n, double nullVal, Reduction<double>& result) {
+    const double inf = std::numeric_limits<double>::infinity();
+    const __m256d nv = _mm256_set1_pd(nullVal), pinf = _mm256_set1_pd(inf), ninf = _mm256_set1_pd(-inf);
+    __m256d vmin = pinf, vmax = ninf, sum = _mm256_setzero_pd();
+    __m256i counter = _mm256_setzero_si256();
+    INDEX i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(data + i);
+        __m256d m = _mm256_cmp_pd(v, nv, _CMP_EQ_OQ);
+        counter = _mm256_sub_epi64(counter, _mm256_castpd_si256(m));
+        vmin = _mm256_min_pd(_mm256_blendv_pd(v, pinf, m), vmin);
+        vmax = _mm256_max_pd(_mm256_blendv_pd(v, ninf, m), vmax);
+        sum = _mm256_add_pd(sum, _mm256_andnot_pd(m, v));
+    }
+    alignas(32) double mins[4], maxs[4], sums[4];
+    _mm256_store_pd(mins, vmin);
+    _mm256_store_pd(maxs, vmax);
+    _mm256_store_pd(sums, sum);
+    INDEX nulls = (INDEX)Ops<long long>::countSum(counter);
+    double mn = inf, mx = -inf;
+    for (int k = 0; k < 4; ++k) {
+        if (mins[k] < mn) mn = mins[k];
+        if (maxs[k] > mx) mx = maxs[k];
+    }
+    double s = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    for (; i < n; ++i) {
+        double x = data[i];
+        if (x == nullVal) {
+            ++nulls;
+            continue;
+        }
+        if (x < mn) mn = x;
+        if (x > mx) mx = x;
+        s += x;
+    }
+    bool empty = nulls == n;
+    result.nullCount = nulls;
+    result.min = empty ? nullVal : mn;
+    result.max = empty ? nullVal : mx;
+    result.sum = s;
+}
+
+DDB_AVX2_TARGET void reduce(const float* data, INDEX n, float nullVal, Reduction<float>& result) {
+    const float inf = std::numeric_limits<float>::infinity();
+    const __m256 nv = _mm256_set1_ps(nullVal), pinf = _mm256_set1_ps(inf), ninf = _mm256_set1_ps(-inf);
+    __m256 vmin = pinf, vmax = ninf;
+    __m256d sum = _mm256_setzero_pd();
+    __m256i counter = _mm256_setzero_si256();
+    INDEX i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(data + i);
+        __m256 m = _mm256_cmp_ps(v, nv, _CMP_EQ_OQ);
+        counter = _mm256_sub_epi32(counter, _mm256_castps_si256(m));
+        vmin = _mm256_min_ps(_mm256_blendv_ps(v, pinf, m), vmin);
+        vmax = _mm256_max_ps(_mm256_blendv_ps(v, ninf, m), vmax);
+        __m256 z = _mm256_andnot_ps(m, v);
+        sum = _mm256_add_pd(sum, _mm256_cvtps_pd(_mm256_castps256_ps128(z)));
+        sum = _mm256_add_pd(sum, _mm256_cvtps_pd(_mm256_extractf128_ps(z, 1)));
+    }
+    alignas(32) float mins[8], maxs[8];
+    alignas(32) double sums[4];
+    _mm256_store_ps(mins, vmin);
+    _mm256_store_ps(maxs, vmax);
+    _mm256_store_pd(sums, sum);
+    INDEX nulls = (INDEX)Ops<int>::countSum(counter);
+    float mn = inf, mx = -inf;
+    for (int k = 0; k < 8; ++k) {
+        if (mins[k] < mn) mn = mins[k];
+        if (maxs[k] > mx) mx = maxs[k];
+    }
+    double s = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    for (; i < n; ++i) {
+        float x = data[i];
+        if (x == nullVal) {
+            ++nulls;
+            continue;
+        }
+        if (x < mn) mn = x;
+        if (x > mx) mx = x;
+        s += x;
+    }
+    bool empty = nulls == n;
+    result.nullCount = nulls;
+    result.min = empty ? nullVal : mn;
+    result.max = empty ? nullVal : mx;
+    result.sum = s;
+}
+
+}
+
+bool hasAvx2() {
+    static const bool supported = detectAvx2();
+    return supported;
+}
+
+#define DDB_KERNEL_DISPATCH(call) \
+    if (hasAvx2()) return avx2::call; \
+    return scalar::call;
+
+#else
+
+bool hasAvx2() {
+    return false;
+}
+
+#define DDB_KERNEL_DISPATCH(call) return scalar::call;
+
+#endif
+
+#define DDB_KERNEL_OVERLOADS(T) \
+INDEX findNull(const T* data, INDEX n, T nullVal) { DDB_KERNEL_DISPATCH(findNull(data, n, nullVal)) } \
+INDEX countNull(const T* data, INDEX n, T nullVal) { DDB_KERNEL_DISPATCH(countNull(data, n, nullVal)) } \
+void reduce(const T* data, INDEX n, T nullVal, Reduction<T>& result) { DDB_KERNEL_DISPATCH(reduce(data, n, nullVal, result)) } \
+bool isSorted(const T* data, INDEX n, bool asc, bool strict) { DDB_KERNEL_DISPATCH(isSorted(data, n, asc, strict)) }
+
+DDB_KERNEL_OVERLOADS(int)
+DDB_KERNEL_OVERLOADS(long long)
+DDB_KERNEL_OVERLOADS(float)
+DDB_KERNEL_OVERLOADS(double)
+
+#undef DDB_KERNEL_OVERLOADS
+#undef DDB_KERNEL_DISPATCH
+
+}
+}
@@ -0,0 +1,315 @@
+#include "VectorView.h"
+
+#include <algorithm>
+#include <cstring>
+#include "ConstantImp.h"
+#include "Exceptions.h"
+#include "Util.h"
+
+namespace dolphindb {
+
+VectorView::VectorView(const VectorSP& source, INDEX offset, INDEX size)
+        : source_(source), offset_(offset), size_(size), strings_(dynamic_cast<const StringVector*>(source.get())) {
+    setReadOnly(true);
+}
+
+VectorView::VectorView(const VectorSP& source, const std::shared_ptr<const std::vector<int>>& indices, INDEX offset, INDEX size)
+        : source_(source), indices_(indices), offset_(offset), size_(size), strings_(dynamic_cast<const StringVector*>(source.get())) {
+    setReadOnly(true);
+}
+
+VectorView* VectorView::getView(INDEX start, INDEX count) const {
+    if (indices_)
+        return new VectorView(source_, indices_, offset_ + start, count);
+    return new VectorView(source_, offset_ + start, count);
+}
+
+VectorView* VectorView::getView(const std::vector<int>& rows) const {
+    std::shared_ptr<std::vector<int>> indices = std::make_shared<std::vector<int>>(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i)
+        (*indices)[i] = (int)sourceIndex(rows[i]);
+    return new VectorView(source_, indices, 0, (INDEX)rows.size());
+}
+
+long long VectorView::getAllocatedMemory() const {
+    return sizeof(VectorView) + (indices_ ? (long long)(size_ * sizeof(int)) : 0);
+}
+
+bool VectorView::hasNull(INDEX start, INDEX length) {
+    if (!source_->getNullFlag())
+        return false;
+    if (!indices_)
+        return source_->hasNull(offset_ + start, length);
+    for (INDEX i = start; i < start + length; ++i) {
+        if (source_->isNull(sourceIndex(i)))
+            return true;
+    }
+    return false;
+}
+
+ConstantSP VectorView::getValue(INDEX capacity) const {
+    capacity = std::max(capacity, size_);
+    if (strings_ != nullptr) {
+        VectorSP copy = Util::createArenaStringVector(getType(), capacity);
+        StringView views[Util::BUF_SIZE];
+        for (INDEX start = 0; start < size_; start += Util::BUF_SIZE) {
+            int count = (int)std::min((INDEX)Util::BUF_SIZE, size_ - start);
+            for (int i = 0; i < count; ++i)
+                views[i] = strings_->getStringView(sourceIndex(start + i));
+            ((StringVector*)copy.get())->appendStringView(views, count);
+        }
+        return copy;
+    }
+    const char* values = (const char*)source_->getDataArray();
+    if (source_->isFastMode() && values != nullptr) {
+        VectorSP copy = getType() == DT_SYMBOL ? Util::createSymbolVector(getSymbolBase(), size_, capacity)
+                                               : Util::createVector(getType(), size_, capacity, true, getExtraParamForType());
+        char* data = (char*)copy->getDataArray();
+        int unitLength = getUnitLength();
+        if (!indices_) {
+            memcpy(data, values + (size_t)offset_ * unitLength, (size_t)size_ * unitLength);
+        }
+        else {
+            for (INDEX i = 0; i < size_; ++i)
+                memcpy(data + (size_t)i * unitLength, values + (size_t)sourceIndex(i) * unitLength, unitLength);
+        }
+        copy->setNullFlag(source_->getNullFlag());
+        return copy;
+    }
+    VectorSP copy = Util::createVector(getType(), size_, capacity, true, getExtraParamForType());
+    for (INDEX i = 0; i < size_; ++i)
+        copy->set(i, get(i));
+    return copy;
+}
+
+ConstantSP VectorView::getSubVector(INDEX start, INDEX length) const {
+    if (length < 0)
+        return VectorSP(getValue())->getSubVector(start, length);
+    return getView(start, length);
+}
+
+template<class T>
+bool VectorView::gather(INDEX start, int len, T* buf, DATA_TYPE nativeType) const {
+    const T* values = (const T*)source_->getDataArray();
+    if (!source_->isFastMode() || values == nullptr || source_->getRawType() != nativeType)
+        return false;
+    for (int i = 0; i < len; ++i)
+        buf[i] = values[sourceIndex(start + i)];
+    return true;
+}
+
+//A slice reads through the source's own bulk getters; a gather copies raw values of the requested
+//type straight from the source's buffer, and converts row by row otherwise.
+#define VIEW_GETTER(Name, T, nativeType) \
+bool VectorView::get##Name(INDEX start, int len, T* buf) const { \
+    if (!indices_) \
+        return source_->get##Name(offset_ + start, len, buf); \
+    if (!gather(start, len, buf, nativeType)) { \
+        for (int i = 0; i < len; ++i) \
+            buf[i] = source_->get##Name(sourceIndex(start + i)); \
+    } \
+    return true; \
+} \
+const T* VectorView::get##Name##Const(INDEX start, int len, T* buf) const { \
+    if (!indices_) \
+        return source_->get##Name##Const(offset_ + start, len, buf); \
+    get##Name(start, len, buf); \
+    return buf; \
+}
+
+VIEW_GETTER(Bool, char, DT_BOOL)
+VIEW_GETTER(Char, char, DT_CHAR)
+VIEW_GETTER(Short, short, DT_SHORT)
+VIEW_GETTER(Int, int, DT_INT)
+VIEW_GETTER(Long, long long, DT_LONG)
+VIEW_GETTER(Index, INDEX, DT_ANY)
+VIEW_GETTER(Float, float, DT_FLOAT)
+VIEW_GETTER(Double, double, DT_DOUBLE)
+
+#undef VIEW_GETTER
+
+bool VectorView::isNull(INDEX start, int len, char* buf) const {
+    if (!indices_)
+        return source_->isNull(offset_ + start, len, buf);
+    for (int i = 0; i < len; ++i)
+        buf[i] = source_->isNull(sourceIndex(start + i));
+    return true;
+}
+
+bool VectorView::isValid(INDEX start, int len, char* buf) const {
+    if (!indices_)
+        return source_->isValid(offset_ + start, len, buf);
+    for (int i = 0; i < len; ++i)
+        buf[i] = !source_->isNull(sourceIndex(start + i));
+    return true;
+}
+
+bool VectorView::getSymbol(INDEX start, int len, int* buf, SymbolBase* symBase, bool insertIfNotThere) const {
+    if (!indices_)
+        return source_->getSymbol(offset_ + start, len, buf, symBase, insertIfNotThere);
+    for (int i = 0; i < len; ++i) {
+        if (!source_->getSymbol(sourceIndex(start + i), 1, buf + i, symBase, insertIfNotThere))
+            return false;
+    }
+    return true;
+}
+
+const int* VectorView::getSymbolConst(INDEX start, int len, int* buf, SymbolBase* symBase, bool insertIfNotThere) const {
+    if (!indices_)
+        return source_->getSymbolConst(offset_ + start, len, buf, symBase, insertIfNotThere);
+    for (int i = 0; i < len; ++i)
+        buf[i] = source_->getSymbolConst(sourceIndex(start + i), 1, buf + i, symBase, insertIfNotThere)[0];
+    return buf;
+}
+
+bool VectorView::getString(INDEX start, int len, std::string** buf) const {
+    getStringConst(start, len, buf);
+    return true;
+}
+
+bool VectorView::getString(INDEX start, int len, char** buf) const {
+    getStringConst(start, len, buf);
+    return true;
+}
+
+std::string** VectorView::getStringConst(INDEX start, int len, std::string** buf) const {
+    if (!indices_)
+        return source_->getStringConst(offset_ + start, len, buf);
+    for (int i = 0; i < len; ++i)
+        buf[i] = source_->getStringConst(sourceIndex(start + i), 1, buf + i)[0];
+    return buf;
+}
+
+char** VectorView::getStringConst(INDEX start, int len, char** buf) const {
+    if (!indices_)
+        return source_->getStringConst(offset_ + start, len, buf);
+    for (int i = 0; i < len; ++i)
+        buf[i] = source_->getStringConst(sourceIndex(start + i), 1, buf + i)[0];
+    return buf;
+}
+
+bool VectorView::getBinary(INDEX start, int len, int unitLength, unsigned char* buf) const {
+    if (!indices_)
+        return source_->getBinary(offset_ + start, len, unitLength, buf);
+    getBinaryConst(start, len, unitLength, buf);
+    return true;
+}
+
+const unsigned char* VectorView::getBinaryConst(INDEX start, int len, int unitLength, unsigned char* buf) const {
+    if (!indices_)
+        return source_->getBinaryConst(offset_ + start, len, unitLength, buf);
+    for (int i = 0; i < len; ++i) {
+        unsigned char* target = buf + (size_t)i * unitLength;
+        const unsigned char* value = source_->getBinaryConst(sourceIndex(start + i), 1, unitLength, target);
+        if (value != target)
+            memcpy(target, value, unitLength);
+    }
+    return buf;
+}
+
+bool VectorView::getDecimal32(INDEX start, int len, int scale, int32_t* buf) const {
+    if (!indices_)
+        return source_->getDecimal32(offset_ + start, len, scale, buf);
+    for (int i = 0; i < len; ++i)
+        buf[i] = source_->getDecimal32(sourceIndex(start + i), scale);
+    return true;
+}
+
+bool VectorView::getDecimal64(INDEX start, int len, int scale, int64_t* buf) const {
+    if (!indices_)
+        return source_->getDecimal64(offset_ + start, len, scale, buf);
+    for (int i = 0; i < len; ++i)
+        buf[i] = source_->getDecimal64(sourceIndex(start + i), scale);
+    return true;
+}
+
+bool VectorView::getDecimal128(INDEX start, int len, int scale, wide_integer::int128* buf) const {
+    if (!indices_)
+        return source_->getDecimal128(offset_ + start, len, scale, buf);
+    for (int i = 0; i < len; ++i)
+        buf[i] = source_->getDecimal128(sourceIndex(start + i), scale);
+    return true;
+}
+
+int VectorView::serialize(char* buf, int bufSize, INDEX indexStart, int offset, int cellCountToSerialize, int& numElement, int& partial) const {
+    if (indexStart >= size_)
+        return -1;
+    INDEX end = std::min(size_, indexStart + cellCountToSerialize);
+    partial = 0;
+    if (strings_ == nullptr) {
+        const char* values = (const char*)source_->getDataArray();
+        if (!source_->isFastMode() || values == nullptr)
+            throw RuntimeException("Can't serialize a view of a " + Util::getDataTypeString(getType()) + " vector.");
+        int unitLength = getUnitLength();
+        numElement = (int)std::min((INDEX)(bufSize / unitLength), end - indexStart);
+        if (!indices_) {
+            memcpy(buf, values + (size_t)(offset_ + indexStart) * unitLength, (size_t)numElement * unitLength);
+        }
+        else {
+            for (int i = 0; i < numElement; ++i)
+                memcpy(buf + (size_t)i * unitLength, values + (size_t)sourceIndex(indexStart + i) * unitLength, unitLength);
+        }
+        return numElement * unitLength;
+    }
+
+    //The same layout as StringVector::serialize: zero-terminated strings, or length-prefixed blobs.
+    int initialBufSize = bufSize;
+    INDEX initialIndex = indexStart;
+    if (getType() != DT_BLOB) {
+        while (bufSize > 0 && indexStart < end) {
+            StringView str = strings_->getStringView(sourceIndex(indexStart));
+            if (str.length >= 262144)
+                throw RuntimeException("String in vector too long, Serialization failed, length must be less than 256K bytes");
+            int len = static_cast<int>(str.length + 1 - offset);
+            if (bufSize >= len) {
+                memcpy(buf, str.data + offset, len);
+                buf += len;
+                bufSize -= len;
+                ++indexStart;
+                offset = 0;
+            }
+            else {
+                memcpy(buf, str.data + offset, bufSize);
+                partial = offset + bufSize;
+                bufSize = 0;
+            }
+        }
+    }
+    else {
+        const int lenBytes = sizeof(int);
+        while (bufSize > 0 && indexStart < end) {
+            StringView str = strings_->getStringView(sourceIndex(indexStart));
+            int len = static_cast<int>(str.length);
+            if (offset == 0) {
+                if (bufSize < lenBytes)
+                    break;
+                memcpy(buf, &len, lenBytes);
+                buf += lenBytes;
+                bufSize -= lenBytes;
+            }
+            else {
+                offset -= lenBytes;
+            }
+            if (bufSize >= len - offset) {
+                memcpy(buf, str.data + offset, len - offset);
+                buf += len - offset;
+                bufSize -= len - offset;
+                ++indexStart;
+                offset = 0;
+            }
+            else {
+                memcpy(buf, str.data + offset, bufSize);
+                partial = lenBytes + offset + bufSize;
+                bufSize = 0;
+            }
+        }
+    }
+    numElement = (int)(indexStart - initialIndex);
+    return initialBufSize - bufSize;
+}
+
+void VectorView::throwReadOnly() const {
+    throw RuntimeException("A view of a vector can't be modified; modify a copy made by getValue() instead.");
+}
+
+}
@@ -2414,3 +2414,73 @@ TEST_P(AFTA_append_null, test_append_empty_table)
 	EXPECT_EQ(res->rows(), 0);
 	conn.run("undef(`att, SHARED);go");
 }
+
+TEST_F(AutoFitTableappenderTest, test_AutoFitTableAppender_schemaCache)
+{
+	string dbName = "dfs://test_AutoFitTableAppender_schemaCache";
+	conn.run("dbName = \"" + dbName + "\";"
+		"if(existsDatabase(dbName)){dropDatabase(dbName)};"
+		"db = database(dbName, VALUE, 1..10);"
+		"t = table(1:0, `id`ts`sym, [INT, TIMESTAMP, SYMBOL]);"
+		"db.createPartitionedTable(t, `pt, `id);");
+	TableSchemaCache::instance().clear();
+	AutoFitTableAppender appender(dbName, "pt", conn);
+	EXPECT_EQ(TableSchemaCache::instance().size(), 1);
+	AutoFitTableAppender appender2(dbName, "pt", conn);
+	EXPECT_EQ(TableSchemaCache::instance().size(), 1);
+
+	//Matching types take the zero-copy path, a DATE column is still cast to TIMESTAMP.
+	VectorSP ids = Util::createVector(DT_INT, 0);
+	VectorSP ts = Util::createVector(DT_TIMESTAMP, 0);
+	VectorSP dates = Util::createVector(DT_DATE, 0);
+	VectorSP syms = Util::createVector(DT_STRING, 0);
+	for (int i = 0; i < 10; ++i) {
+		ids->append(Util::createInt(i % 10 + 1));
+		ts->append(Util::createTimestamp(1000LL * i));
+		dates->append(Util::createDate(i));
+		syms->append(Util::createString("s" + std::to_string(i % 3)));
+	}
+	VectorSP symbols = Util::createVector(DT_SYMBOL, 0);
+	symbols->append(syms);
+	EXPECT_EQ(appender.append(Util::createTable({"id", "ts", "sym"}, {ids, ts, symbols})), 10);
+	EXPECT_EQ(appender2.append(Util::createTable({"id", "ts", "sym"}, {ids, dates, syms})), 10);
+	EXPECT_EQ(conn.run("exec count(*) from loadTable(dbName, `pt)")->getInt(), 20);
+	EXPECT_EQ(conn.run("exec count(*) from loadTable(dbName, `pt) where ts = 1970.01.02T00:00:00.000")->getInt(), 1);
+
+	//A failed write drops the cached schema.
+	conn.run("dropTable(database(dbName), `pt)");
+	EXPECT_ANY_THROW(appender.append(Util::createTable({"id", "ts", "sym"}, {ids, ts, symbols})));
+	EXPECT_EQ(TableSchemaCache::instance().size(), 0);
+	conn.run("dropDatabase(dbName)");
+}
+
+TEST_F(AutoFitTableappenderTest, test_AutoFitTableAppender_concurrentAppend)
+{
+	conn.run("share table(1:0, `id`sym, [INT, SYMBOL]) as afta_concurrent");
+	AutoFitTableAppender appender("", "afta_concurrent", conn);
+	const int threads = 4;
+	const int rounds = 50;
+	const int rows = 100;
+	vector<std::thread> appenders;
+	std::atomic<int> appended(0);
+	for (int t = 0; t < threads; ++t) {
+		appenders.emplace_back([&, t]() {
+			for (int r = 0; r < rounds; ++r) {
+				VectorSP ids = Util::createVector(DT_INT, rows);
+				VectorSP syms = Util::createVector(DT_STRING, rows);
+				for (int i = 0; i < rows; ++i) {
+					ids->setInt(i, t);
+					syms->setString(i, "t" + std::to_string(t) + "_" + std::to_string((r * rows + i) % 37));
+				}
+				appended += appender.append(Util::createTable({"id", "sym"}, {ids, syms}));
+			}
+		});
+	}
+	for (auto &one : appenders)
+		one.join();
+	EXPECT_EQ(appended.load(), threads * rounds * rows);
+	EXPECT_EQ(conn.run("exec count(*) from afta_concurrent")->getInt(), threads * rounds * rows);
+	//Every row keeps the symbol of the thread that wrote it.
+	EXPECT_EQ(conn.run("exec count(*) from afta_concurrent where not startsWith(sym, \"t\" + string(id) + \"_\")")->getInt(), 0);
+	conn.run("undef(`afta_concurrent, SHARED)");
+}
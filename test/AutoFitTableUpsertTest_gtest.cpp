@@ -2175,3 +2175,65 @@ TEST_P(AFTU_append_null, test_append_empty_table)
 	conn.run("dropDatabase('dfs://test_append_empty');go");
 	delete kcols;
 }
+
+TEST_F(AutoFitTableUpsertTest, test_AutoFitTableUpsert_upsertAsyncMergesKeys){
+	string dbName = "dfs://test_AutoFitTableUpsert_upsertAsync";
+	conn.run("dbName = \"" + dbName + "\";"
+		"if(existsDatabase(dbName)){dropDatabase(dbName)};"
+		"db = database(dbName, HASH, [INT, 4]);"
+		"t = table(1:0, `id`price`qty, [INT, DOUBLE, LONG]);"
+		"db.createPartitionedTable(t, `pt, `id);");
+	vector<string> keyCols = {"id"};
+	AutoFitTableUpsert aftu(dbName, "pt", conn, false, &keyCols, nullptr, 1000, 50);
+	vector<std::future<int>> futures;
+	for(int round = 0; round < 5; ++round){
+		VectorSP ids = Util::createVector(DT_INT, 0);
+		VectorSP prices = Util::createVector(DT_DOUBLE, 0);
+		VectorSP qtys = Util::createVector(DT_INT, 0);
+		for(int i = 0; i < 10; ++i){
+			ids->append(Util::createInt(i));
+			prices->append(Util::createDouble(round + i / 10.0));
+			qtys->append(Util::createInt(round));
+		}
+		//qty is cast from INT to LONG
+		futures.push_back(aftu.upsertAsync(Util::createTable({"id", "price", "qty"}, {ids, prices, qtys})));
+	}
+	aftu.flush();
+	for(size_t i = 0; i + 1 < futures.size(); ++i)
+		EXPECT_NO_THROW(futures[i].get());
+	//The last rows of every key are always sent.
+	EXPECT_EQ(futures.back().get(), 10);
+	EXPECT_EQ(conn.run("exec count(*) from loadTable(dbName, `pt)")->getInt(), 10);
+	EXPECT_EQ(conn.run("exec sum(qty) from loadTable(dbName, `pt)")->getLong(), 40);
+
+	//A sync upsert is applied after the rows buffered before it.
+	VectorSP keys = Util::createVector(DT_INT, 0);
+	VectorSP newPrices = Util::createVector(DT_DOUBLE, 0);
+	VectorSP buffered = Util::createVector(DT_LONG, 0);
+	VectorSP latest = Util::createVector(DT_LONG, 0);
+	for(int i = 0; i < 10; ++i){
+		keys->append(Util::createInt(i));
+		newPrices->append(Util::createDouble(i));
+		buffered->append(Util::createLong(7));
+		latest->append(Util::createLong(9));
+	}
+	std::future<int> before = aftu.upsertAsync(Util::createTable({"id", "price", "qty"}, {keys, newPrices, buffered}));
+	aftu.upsert(Util::createTable({"id", "price", "qty"}, {keys, newPrices, latest}));
+	EXPECT_EQ(before.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+	EXPECT_EQ(conn.run("exec sum(qty) from loadTable(dbName, `pt)")->getLong(), 90);
+
+	//Errors are reported through the future.
+	VectorSP bad = Util::createVector(DT_STRING, 0);
+	bad->append(Util::createString("x"));
+	EXPECT_ANY_THROW(aftu.upsertAsync(Util::createTable({"id", "price", "qty"}, {bad, bad, bad})));
+	conn.run("dropTable(database(dbName), `pt)");
+	VectorSP ids = Util::createVector(DT_INT, 0);
+	ids->append(Util::createInt(1));
+	VectorSP prices = Util::createVector(DT_DOUBLE, 0);
+	prices->append(Util::createDouble(1));
+	VectorSP qtys = Util::createVector(DT_LONG, 0);
+	qtys->append(Util::createLong(1));
+	std::future<int> failed = aftu.upsertAsync(Util::createTable({"id", "price", "qty"}, {ids, prices, qtys}));
+	EXPECT_ANY_THROW(failed.get());
+	conn.run("dropDatabase(dbName)");
+}
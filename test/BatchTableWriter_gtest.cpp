@@ -1736,4 +1736,74 @@ namespace{
 		string script;
 		conn.run(script);
 	}
-}
\ No newline at end of file
+
+	//Timings of the flush triggers; disabled by default, run with --gtest_also_run_disabled_tests.
+	TEST_F(BatchTableWriterTest,DISABLED_test_BatchTableWriter_flush_triggers_benchmark){
+		conn.run("login('admin', '123456');go;share table(100:0, `sym`id`price`ts, [SYMBOL, INT, DOUBLE, TIMESTAMP]) as btwBench;");
+		const int rows = 200000;
+		struct Trigger { int batchSize; long long batchBytes; int throttle; };
+		for (Trigger trigger : {Trigger{1, 0, 0}, Trigger{10000, 0, 100}, Trigger{1000000, 64 * 1024, 1000}, Trigger{1000000, 0, 50}}) {
+			conn.run("delete from btwBench");
+			BatchTableWriter btw(hostName, port, "admin", "123456", true, trigger.batchSize, trigger.batchBytes, trigger.throttle);
+			btw.addTable("btwBench", "");
+			long long start = Util::getNanoBenchmark();
+			for (int i = 0; i < rows; i++)
+				btw.insert("btwBench", "", string("S") + to_string(i % 100), i, i * 0.5, (long long)i);
+			long long inserted = Util::getNanoBenchmark();
+			while (btw.getAllStatus()->getColumn(3)->getInt(0) < rows)
+				this_thread::sleep_for(chrono::milliseconds(1));
+			long long drained = Util::getNanoBenchmark();
+			EXPECT_EQ(std::get<0>(btw.getStatus("btwBench", "")), 0);
+			cout << "batchSize " << trigger.batchSize << " batchBytes " << trigger.batchBytes << " throttle " << trigger.throttle
+				<< "ms: insert " << (long long)(rows * 1e9 / (inserted - start)) << " rows/s, drain latency "
+				<< (drained - inserted) / 1000000 << "ms, end to end " << (long long)(rows * 1e9 / (drained - start)) << " rows/s" << endl;
+			EXPECT_EQ(conn.run("exec count(*) from btwBench")->getInt(), rows);
+			EXPECT_EQ(conn.run("exec id from btwBench limit 3")->getInt(2), 2);
+			EXPECT_EQ(conn.run("exec sym from btwBench where id = 123")->getString(0), "S23");
+			btw.removeTable("btwBench");
+		}
+		conn.run("undef(`btwBench, SHARED)");
+	}
+
+	TEST_F(BatchTableWriterTest,test_BatchTableWriter_getUnwrittenData){
+		//Rows not sent yet are handed back by getUnwrittenData.
+		conn.run("login('admin', '123456');go;share table(100:0, `sym`id`price`ts, [SYMBOL, INT, DOUBLE, TIMESTAMP]) as btwUnwritten;");
+		BatchTableWriter idle(hostName, port, "admin", "123456", true, 1000, 0, 60000);
+		idle.addTable("btwUnwritten", "");
+		for (int i = 0; i < 10; i++)
+			idle.insert("btwUnwritten", "", string("S"), i, 1.0, (long long)i);
+		EXPECT_EQ(std::get<0>(idle.getStatus("btwUnwritten", "")), 10);
+		TableSP unwritten = idle.getUnwrittenData("btwUnwritten", "");
+		EXPECT_EQ(unwritten->rows(), 10);
+		EXPECT_EQ(unwritten->getColumn(0)->getType(), DT_SYMBOL);
+		EXPECT_EQ(unwritten->getColumn(1)->getInt(9), 9);
+		EXPECT_EQ(std::get<0>(idle.getStatus("btwUnwritten", "")), 0);
+		conn.run("undef(`btwUnwritten, SHARED)");
+	}
+
+	TEST_F(BatchTableWriterTest,test_BatchTableWriter_shared_workers){
+		const int tables = 20;
+		const int rows = 1000;
+		string script = "login('admin', '123456');go;";
+		for (int i = 0; i < tables; i++)
+			script += "share table(100:0, `id`val, [INT, DOUBLE]) as btwPool" + to_string(i) + ";";
+		conn.run(script);
+		{
+			BatchTableWriter btw(hostName, port, "admin", "123456", true, 100, 0, 20, 2);
+			for (int i = 0; i < tables; i++)
+				btw.addTable("btwPool" + to_string(i), "");
+			for (int r = 0; r < rows; r++)
+				for (int i = 0; i < tables; i++)
+					btw.insert("btwPool" + to_string(i), "", r, r * 0.5);
+			btw.removeTable("btwPool0");
+			EXPECT_EQ(conn.run("exec count(*) from btwPool0")->getInt(), rows);
+			TableSP status = btw.getAllStatus();
+			EXPECT_EQ(status->rows(), tables - 1);
+		}
+		for (int i = 0; i < tables; i++) {
+			EXPECT_EQ(conn.run("exec count(*) from btwPool" + to_string(i))->getInt(), rows);
+			EXPECT_EQ(conn.run("exec sum(id) from btwPool" + to_string(i))->getLong(), (long long)rows * (rows - 1) / 2);
+			conn.run("undef(`btwPool" + to_string(i) + ", SHARED)");
+		}
+	}
+}
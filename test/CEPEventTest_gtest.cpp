@@ -1875,4 +1875,122 @@ TEST_P(CEPEventTest_EventClient_arrayVector, test_EventClient_arrayVector)
     EXPECT_TRUE(conn300->run("all(each(eqObj, fromApi.values(),fromCEP.values()))")->getBool());
 
     delete schema, client, sender;
-}
\ No newline at end of file
+}
+TEST_F(CEPEventTest, test_EventSender_batched)
+{
+    conn300->run("share streamTable(1:0, `time`eventType`event`qty, [TIMESTAMP,STRING,BLOB,INT]) as inputTable;");
+    EventSchema schema;
+    schema.eventType_ = "market";
+    schema.fieldNames_ = {"market", "time", "qty"};
+    schema.fieldTypes_ = {DT_STRING, DT_TIMESTAMP, DT_INT};
+    schema.fieldForms_ = {DF_SCALAR, DF_SCALAR, DF_SCALAR};
+    vector<EventSchema> eventSchemas = {schema};
+    vector<string> eventTimeKeys = {"time"};
+    vector<string> commonKeys = {"qty"};
+    int failures = 0;
+    {
+        EventSender sender(conn300, "inputTable", eventSchemas, eventTimeKeys, commonKeys, 100, 10, 200);
+        sender.setSendFailureHandler([&](const ErrorCodeInfo&, int events){ failures += events; });
+        for(int i = 0; i < 1000; ++i){
+            sender.sendEvent("market", {Util::createString("sz"), Util::createTimestamp(1000LL * i), Util::createInt(i)});
+            EXPECT_LE(sender.getPendingEvents(), 200);
+        }
+        EXPECT_ANY_THROW(sender.sendEvent("market", {Util::createString("sz")}));
+        sender.flush();
+        EXPECT_EQ(sender.getPendingEvents(), 0);
+        EXPECT_EQ(sender.getSentEvents(), 1000);
+        EXPECT_EQ(conn300->run("exec count(*) from inputTable")->getInt(), 1000);
+        EXPECT_EQ(conn300->run("exec sum(qty) from inputTable")->getLong(), 499500);
+
+        //Events still buffered are sent by the destructor.
+        sender.sendEvent("market", {Util::createString("sh"), Util::createTimestamp(0), Util::createInt(1)});
+    }
+    EXPECT_EQ(conn300->run("exec count(*) from inputTable")->getInt(), 1001);
+    EXPECT_EQ(failures, 0);
+
+    EventSender sender(conn300, "inputTable", eventSchemas, eventTimeKeys, commonKeys, 10, 10);
+    conn300->run("undef(`inputTable, SHARED)");
+    sender.sendEvent("market", {Util::createString("sz"), Util::createTimestamp(0), Util::createInt(1)});
+    EXPECT_ANY_THROW(sender.flush());
+    EXPECT_EQ(sender.getFailedEvents(), 1);
+}
+
+TEST_F(CEPEventTest, test_EventHandler_deserializeEvent_batch)
+{
+    EventSchema schema1;
+    schema1.eventType_ = "market";
+    schema1.fieldNames_ = {"code", "time", "price", "qty", "levels", "note"};
+    schema1.fieldTypes_ = {DT_SYMBOL, DT_TIMESTAMP, DT_DECIMAL64, DT_INT, DT_DOUBLE, DT_STRING};
+    schema1.fieldForms_ = {DF_SCALAR, DF_SCALAR, DF_SCALAR, DF_SCALAR, DF_VECTOR, DF_VECTOR};
+    schema1.fieldExtraParams_ = {0, 0, 4, 0, 0, 0};
+    EventSchema schema2;
+    schema2.eventType_ = "order";
+    schema2.fieldNames_ = {"id", "time"};
+    schema2.fieldTypes_ = {DT_LONG, DT_TIMESTAMP};
+    schema2.fieldForms_ = {DF_SCALAR, DF_SCALAR};
+    EventHandler handler({schema1, schema2}, {"time"}, {});
+    TableSP outputTable = Util::createTable({"time", "eventType", "blobs"}, {Util::createVector(DT_TIMESTAMP, 0), Util::createVector(DT_SYMBOL, 0), Util::createVector(DT_BLOB, 0)});
+    string errMsg;
+    ASSERT_TRUE(handler.checkOutputTable(outputTable, errMsg)) << errMsg;
+
+    vector<VectorSP> columns;
+    for(int i = 0; i < 3; ++i)
+        columns.push_back(VectorSP(outputTable->getColumn(i))->getInstance(0));
+    vector<string> types = {"market", "market", "order", "market", "order", "order"};
+    for(size_t row = 0; row < types.size(); ++row){
+        vector<ConstantSP> attributes;
+        if(types[row] == "market"){
+            VectorSP levels = Util::createVector(DT_DOUBLE, 0);
+            for(size_t k = 0; k < row; ++k)
+                levels->append(Util::createDouble(k + 0.5));
+            VectorSP notes = Util::createVector(DT_STRING, 0);
+            notes->append(Util::createString("n" + std::to_string(row)));
+            attributes = {Util::createString("sz" + std::to_string(row)), Util::createTimestamp(row), Util::createDecimal64(4, row + 0.25),
+                          Util::createInt((int)row), levels, notes};
+        }
+        else{
+            attributes = {Util::createLong(row * 100), Util::createTimestamp(row)};
+        }
+        ASSERT_TRUE(handler.appendEvent(types[row], attributes, columns, errMsg)) << errMsg;
+    }
+    VectorSP msg = Util::createVector(DT_ANY, 0);
+    for(auto& column : columns)
+        msg->append(column);
+
+    vector<string> eventTypes;
+    vector<vector<ConstantSP>> attributes;
+    ErrorCodeInfo errorInfo;
+    ASSERT_TRUE(handler.deserializeEvent(msg, eventTypes, attributes, errorInfo)) << errorInfo.errorInfo;
+
+    //Runs of consecutive events of the same type arrive as one batch each, in order.
+    vector<string> batchTypes;
+    vector<INDEX> batchRows;
+    size_t row = 0;
+    EventBatchMessageHandler batchHandler = [&](const string& eventType, const vector<VectorSP>& cols, INDEX rows){
+        batchTypes.push_back(eventType);
+        batchRows.push_back(rows);
+        for(INDEX r = 0; r < rows; ++r, ++row){
+            ASSERT_EQ(eventTypes[row], eventType);
+            for(size_t c = 0; c < cols.size(); ++c){
+                ASSERT_EQ(cols[c]->size(), rows);
+                EXPECT_EQ(cols[c]->get(r)->getString(), attributes[row][c]->getString());
+            }
+        }
+    };
+    ASSERT_TRUE(handler.deserializeEvent(msg, batchHandler, errorInfo)) << errorInfo.errorInfo;
+    EXPECT_EQ(row, types.size());
+    EXPECT_EQ(batchTypes, vector<string>({"market", "order", "market", "order"}));
+    EXPECT_EQ(batchRows, vector<INDEX>({2, 1, 1, 2}));
+
+    //The same message decodes again into the reused columns.
+    row = 0;
+    ASSERT_TRUE(handler.deserializeEvent(msg, batchHandler, errorInfo));
+    EXPECT_EQ(row, types.size());
+
+    //Events before an unknown type are still delivered.
+    ((Vector*)msg->get(1).get())->set(2, Util::createString("unknown"));
+    row = 0;
+    batchTypes.clear();
+    EXPECT_FALSE(handler.deserializeEvent(msg, batchHandler, errorInfo));
+    EXPECT_EQ(batchTypes, vector<string>({"market"}));
+}
@@ -1695,4 +1695,164 @@ TEST_F(MarshallTest, BoundedBlockingQueue_test){
     EXPECT_EQ(result, 1314);
 }
 
+TEST_F(MarshallTest, SymbolBaseCache){
+    IO_ERR ret;
+    SymbolEncoder encoder;
+    VectorSP names = Util::createVector(DT_STRING, 0, 4);
+    for (std::string s : {"AAPL", "IBM", "", "AAPL"})
+        names->append(Util::createString(s));
+    TableSP table = Util::createTable({"a", "b"}, {encoder.encode(names), encoder.encode(names)});
+    DataOutputStreamSP outStream = new DataOutputStream(1024);
+    ConstantMarshallSP marshall = ConstantMarshallFactory::getInstance(table->getForm(), outStream);
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_TRUE(marshall->start(table, true, false, ret));
+        marshall->reset();
+    }
+    std::string binary(outStream->getBuffer(), outStream->size());
+
+    SymbolBaseCacheSP cache = new SymbolBaseCache();
+    DataInputStreamSP inStream = new DataInputStream(binary.data(), binary.size());
+    ConstantUnmarshallFactory factory(inStream, cache);
+    std::vector<TableSP> results;
+    for (int i = 0; i < 2; ++i) {
+        short flag;
+        ASSERT_EQ(inStream->readShort(flag), OK);
+        ConstantUnmarshall* unmarshall = factory.getConstantUnmarshall(static_cast<DATA_FORM>(flag >> 8));
+        ASSERT_TRUE(unmarshall->start(flag, true, ret));
+        results.push_back(unmarshall->getConstant());
+        unmarshall->reset();
+    }
+    EXPECT_EQ(cache->getMisses(), 2);
+    EXPECT_EQ(cache->getHits(), 2);
+    EXPECT_EQ(cache->size(), 2);
+    for (int col = 0; col < 2; ++col) {
+        VectorSP first = results[0]->getColumn(col);
+        VectorSP second = results[1]->getColumn(col);
+        EXPECT_NE(first->getSymbolBase().get(), second->getSymbolBase().get());
+        for (int i = 0; i < 4; ++i)
+            EXPECT_EQ(second->getString(i), names->getString(i));
+    }
+    //Symbols inserted into one result stay out of the others.
+    VectorSP first = results[0]->getColumn(0);
+    first->set(0, Util::createString("MSFT"));
+    EXPECT_EQ(first->getString(0), "MSFT");
+    EXPECT_EQ(results[1]->getColumn(0)->getSymbolBase()->size(), 3);
+
+    //An empty body resolves to the base cached under the same id.
+    std::string empty(8, '\0');
+    inStream = new DataInputStream(empty.data(), empty.size());
+    SymbolBaseUnmarshall symbolUnmarshall(inStream, cache);
+    ASSERT_TRUE(symbolUnmarshall.start(true, ret));
+    EXPECT_EQ(symbolUnmarshall.getSymbolBase()->size(), 3);
+    EXPECT_EQ(symbolUnmarshall.getSymbolBase()->getSymbol(1), "AAPL");
+    EXPECT_EQ(cache->getHits(), 3);
+}
+
+TEST_F(MarshallTest, VectorUnmarshallStringArena){
+    VectorSP source = Util::createVector(DT_STRING, 0, 3000);
+    VectorSP blobs = Util::createVector(DT_BLOB, 0, 3000);
+    for (int i = 0; i < 3000; ++i) {
+        string value = i % 7 == 0 ? string() : "value_" + std::to_string(i) + string(i % 40, 'x');
+        string blob = string("a\0b", 3) + std::to_string(i);
+        source->appendString(&value, 1);
+        blobs->appendString(&blob, 1);
+    }
+    IO_ERR ret;
+    std::vector<VectorSP> decoded;
+    for (const VectorSP &vec : {source, blobs}) {
+        DataOutputStreamSP outStream = new DataOutputStream(1024);
+        ConstantMarshallSP marshall = ConstantMarshallFactory::getInstance(vec->getForm(), outStream);
+        ASSERT_TRUE(marshall->start(vec, true, false, ret));
+        std::string binary(outStream->getBuffer(), outStream->size());
+        DataInputStreamSP inStream = new DataInputStream(binary.data(), binary.size());
+        short flag;
+        inStream->readShort(flag);
+        ConstantUnmarshallSP unmarshall = ConstantUnmarshallFactory::getInstance(static_cast<DATA_FORM>(flag >> 8), inStream);
+        ASSERT_TRUE(unmarshall->start(flag, true, ret));
+        decoded.push_back(unmarshall->getConstant());
+    }
+    VectorSP strings = decoded[0];
+    StringVector *arena = dynamic_cast<StringVector*>(strings.get());
+    ASSERT_NE(arena, nullptr);
+    EXPECT_TRUE(arena->isArena());
+    ASSERT_EQ(strings->size(), 3000);
+    EXPECT_TRUE(strings->getNullFlag());
+    for (int i = 0; i < 3000; ++i) {
+        ASSERT_EQ(strings->getString(i), source->getString(i));
+        ASSERT_EQ(strings->isNull(i), i % 7 == 0);
+    }
+    StringView view = arena->getStringView(1);
+    EXPECT_EQ(view.toString(), "value_1x");
+    EXPECT_EQ(view.data[view.length], '\0');
+    char *cstr[2];
+    strings->getStringConst(1, 2, cstr);
+    EXPECT_STREQ(cstr[1], "value_2xx");
+    EXPECT_EQ(strings->getSubVector(8, 2)->getString(1), source->getString(9));
+    strings->append(Util::createString("tail"));
+    EXPECT_EQ(strings->getString(3000), "tail");
+    EXPECT_TRUE(arena->isArena());
+
+    //Round trip through the arena layout without converting it.
+    DataOutputStreamSP outStream = new DataOutputStream(1024);
+    ConstantMarshallSP marshall = ConstantMarshallFactory::getInstance(strings->getForm(), outStream);
+    ASSERT_TRUE(marshall->start(strings, true, false, ret));
+    EXPECT_TRUE(arena->isArena());
+
+    //Legacy accessors convert the vector in place.
+    EXPECT_EQ(strings->getStringRef(3000), "tail");
+    EXPECT_FALSE(arena->isArena());
+    //The arena outlives a const conversion for readers still on it; the next modification frees it.
+    long long converted = arena->getAllocatedMemory();
+    strings->setString(3000, "changed");
+    EXPECT_LT(arena->getAllocatedMemory(), converted - 3000 * (long long)sizeof(long long));
+    EXPECT_EQ(strings->getString(3000), "changed");
+    EXPECT_EQ(strings->getString(2999), source->getString(2999));
+
+    ASSERT_EQ(decoded[1]->getType(), DT_BLOB);
+    EXPECT_TRUE(dynamic_cast<StringVector*>(decoded[1].get())->isArena());
+    for (int i = 0; i < 3000; ++i)
+        ASSERT_EQ(decoded[1]->getString(i), blobs->getString(i));
+}
+
+TEST_F(MarshallTest, VectorUnmarshallStringArenaConcurrentReaders){
+    VectorSP source = Util::createVector(DT_STRING, 0, 5000);
+    for (int i = 0; i < 5000; ++i) {
+        string value = "value_" + std::to_string(i);
+        source->appendString(&value, 1);
+    }
+    IO_ERR ret;
+    DataOutputStreamSP outStream = new DataOutputStream(1024);
+    ConstantMarshallSP marshall = ConstantMarshallFactory::getInstance(source->getForm(), outStream);
+    ASSERT_TRUE(marshall->start(source, true, false, ret));
+    std::string binary(outStream->getBuffer(), outStream->size());
+    DataInputStreamSP inStream = new DataInputStream(binary.data(), binary.size());
+    short flag;
+    inStream->readShort(flag);
+    ConstantUnmarshallSP unmarshall = ConstantUnmarshallFactory::getInstance(static_cast<DATA_FORM>(flag >> 8), inStream);
+    ASSERT_TRUE(unmarshall->start(flag, true, ret));
+    VectorSP result = unmarshall->getConstant();
+    ASSERT_TRUE(dynamic_cast<StringVector*>(result.get())->isArena());
+
+    //One reader converts the vector to std::strings while the other still reads the arena.
+    std::atomic<int> mismatches(0);
+    std::thread legacyReader([&]() {
+        for (int i = 0; i < 5000; ++i) {
+            if (result->getStringRef(i) != source->getString(i))
+                ++mismatches;
+        }
+    });
+    std::thread arenaReader([&]() {
+        for (int round = 0; round < 20; ++round) {
+            for (int i = 0; i < 5000; ++i) {
+                if (result->getString(i) != source->getString(i))
+                    ++mismatches;
+            }
+        }
+    });
+    legacyReader.join();
+    arenaReader.join();
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_FALSE(dynamic_cast<StringVector*>(result.get())->isArena());
+}
+
 #endif
\ No newline at end of file
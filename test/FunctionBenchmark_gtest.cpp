@@ -0,0 +1,540 @@
+#include "config.h"
+#include "ColumnSpan.h"
+#include "VectorKernels.h"
+#include "TemporalKernels.h"
+#include "TextTableReader.h"
+#include "TextTableWriter.h"
+#include "ColumnarFile.h"
+#include "ArrowInterop.h"
+#include "VectorView.h"
+#include "RadixScatter.h"
+
+//Timings of the optimized paths against the code they replaced. The results they print are only
+//meaningful on a quiet machine, so they are disabled; FunctionTest checks the same paths for
+//correctness. Run them with --gtest_also_run_disabled_tests --gtest_filter=FunctionBenchmark.*
+class FunctionBenchmark:public testing::Test{};
+
+#ifndef WINDOWS
+TEST_F(FunctionBenchmark, DISABLED_FlatHashMap){
+    const int rows = 1 << 20;
+    std::mt19937_64 rng(7);
+    std::vector<long long> keys(rows);
+    for (auto &key : keys)
+        key = (long long)(rng() >> 1);
+    auto elapsed = [](std::chrono::steady_clock::time_point start) {
+        return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::unordered_map<long long, long long> stdMap;
+    for (int i = 0; i < rows; ++i)
+        stdMap[keys[i]] = i;
+    long long stdSum = 0;
+    for (int i = 0; i < rows; ++i)
+        stdSum += stdMap.find(keys[(i * 7LL) % rows])->second;
+    long long stdCost = elapsed(start);
+
+    start = std::chrono::steady_clock::now();
+    FlatHashMap<long long, long long> flatMap;
+    for (int i = 0; i < rows; ++i)
+        flatMap[keys[i]] = i;
+    long long flatSum = 0;
+    for (int i = 0; i < rows; ++i)
+        flatSum += flatMap.find(keys[(i * 7LL) % rows])->second;
+    long long flatCost = elapsed(start);
+    EXPECT_EQ(stdSum, flatSum);
+
+    VectorSP keyVector = Util::createVector(DT_LONG, rows);
+    keyVector->setLong(0, rows, keys.data());
+    DictionarySP dict = Util::createDictionary(DT_LONG, DT_LONG);
+    dict->set(keyVector, Util::createIndexVector(0, rows));
+    start = std::chrono::steady_clock::now();
+    ConstantSP values = dict->getMember(keyVector);
+    long long dictCost = elapsed(start);
+    EXPECT_EQ(values->getLong(rows - 1), rows - 1);
+
+    std::cout << "insert+find " << rows << " keys: unordered_map " << stdCost << " ms, FlatHashMap " << flatCost
+              << " ms; dictionary getMember " << dictCost << " ms" << std::endl;
+}
+
+TEST_F(FunctionBenchmark, DISABLED_ColumnView){
+    const int rows = 10000000;
+    VectorSP volumes = Util::createVector(DT_LONG, rows);
+    long long *data = (long long*)volumes->getDataArray();
+    for (int i = 0; i < rows; ++i)
+        data[i] = i % 1000;
+    auto elapsed = [](std::chrono::steady_clock::time_point start) {
+        return (long long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    long long enumSum = 0;
+    Util::enumLongVector(volumes, [&](const long long *pbuf, INDEX, int length) {
+        for (int i = 0; i < length; ++i)
+            enumSum += pbuf[i];
+        return true;
+    });
+    long long enumCost = elapsed(start);
+
+    start = std::chrono::steady_clock::now();
+    long long spanSum = 0;
+    for (long long value : ColumnView<long long>(volumes).span())
+        spanSum += value;
+    long long spanCost = elapsed(start);
+
+    start = std::chrono::steady_clock::now();
+    long long iteratorSum = 0;
+    ColumnView<long long> view(volumes);
+    for (auto it = view.begin(); it != view.end(); ++it)
+        iteratorSum += *it;
+    long long iteratorCost = elapsed(start);
+
+    EXPECT_EQ(enumSum, spanSum);
+    EXPECT_EQ(enumSum, iteratorSum);
+    std::cout << "sum of " << rows << " longs: enumLongVector " << enumCost << " us, ColumnSpan " << spanCost
+              << " us, ColumnView iterator " << iteratorCost << " us" << std::endl;
+}
+
+TEST_F(FunctionBenchmark, DISABLED_VectorKernels){
+    const INDEX rows = 10000000;
+    std::vector<double> data(rows);
+    for (INDEX i = 0; i < rows; ++i)
+        data[i] = i * 0.5;
+    auto time = [](std::function<void()> func) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        return (long long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+    INDEX fastIndex = 0, slowIndex = 0, fastCount = 0, slowCount = 0;
+    kernels::Reduction<double> fast, slow;
+    bool fastSorted = true, slowSorted = true;
+    std::cout << "AVX2 kernels: " << (kernels::hasAvx2() ? "yes" : "no") << std::endl;
+    std::cout << "findNull over " << rows << " doubles: kernel " << time([&] { fastIndex = kernels::findNull(data.data(), rows, DBL_NMIN); })
+              << " us, scalar " << time([&] { slowIndex = kernels::scalar::findNull(data.data(), rows, DBL_NMIN); }) << " us" << std::endl;
+    std::cout << "countNull: kernel " << time([&] { fastCount = kernels::countNull(data.data(), rows, DBL_NMIN); })
+              << " us, scalar " << time([&] { slowCount = kernels::scalar::countNull(data.data(), rows, DBL_NMIN); }) << " us" << std::endl;
+    std::cout << "min/max/sum: kernel " << time([&] { kernels::reduce(data.data(), rows, DBL_NMIN, fast); })
+              << " us, scalar " << time([&] { kernels::scalar::reduce(data.data(), rows, DBL_NMIN, slow); }) << " us" << std::endl;
+    std::cout << "isSorted: kernel " << time([&] { fastSorted = kernels::isSorted(data.data(), rows, true, false); })
+              << " us, scalar " << time([&] { slowSorted = kernels::scalar::isSorted(data.data(), rows, true, false); }) << " us" << std::endl;
+    EXPECT_EQ(fastIndex, slowIndex);
+    EXPECT_EQ(fastCount, slowCount);
+    EXPECT_EQ(fast.min, slow.min);
+    EXPECT_EQ(fast.max, slow.max);
+    EXPECT_DOUBLE_EQ(fast.sum, slow.sum);
+    EXPECT_EQ(fastSorted, slowSorted);
+}
+
+TEST_F(FunctionBenchmark, DISABLED_TemporalKernels){
+    const int rows = 10000000;
+    VectorSP nanos = Util::createVector(DT_NANOTIMESTAMP, rows);
+    long long* data = (long long*)nanos->getDataArray();
+    for (int i = 0; i < rows; ++i)
+        data[i] = 1700000000000000000LL + i * 1000003LL;
+    auto time = [](std::function<void()> func) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        return (long long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+    //The per-row division and parseDate loops castTemporal used before the kernels.
+    VectorSP reference, referenceMonths, timestamps, months, inPlace;
+    long long referenceUs = time([&] {
+        reference = Util::createVector(DT_TIMESTAMP, rows);
+        long long* pbuf = (long long*)reference->getDataArray();
+        long long ratio = -Util::getTemporalConversionRatio(DT_NANOTIMESTAMP, DT_TIMESTAMP);
+        for (int i = 0; i < rows; ++i) {
+            int tail = (data[i] < 0) && (data[i] % ratio);
+            data[i] == LLONG_MIN ? pbuf[i] = LLONG_MIN : pbuf[i] = data[i] / ratio - tail;
+        }
+    });
+    long long kernelUs = time([&] { timestamps = nanos->castTemporal(DT_TIMESTAMP); });
+    std::cout << "NANOTIMESTAMP->TIMESTAMP over " << rows << " rows: division loop " << referenceUs << " us, castTemporal " << kernelUs << " us" << std::endl;
+    referenceUs = time([&] {
+        referenceMonths = Util::createVector(DT_MONTH, rows);
+        int* pbuf = (int*)referenceMonths->getDataArray();
+        for (int i = 0; i < rows; ++i) {
+            int year, month, day;
+            Util::parseDate(static_cast<int>(data[i] / 86400000000000ll), year, month, day);
+            pbuf[i] = year * 12 + month - 1;
+        }
+    });
+    kernelUs = time([&] { months = nanos->castTemporal(DT_MONTH); });
+    std::cout << "NANOTIMESTAMP->MONTH: parseDate loop " << referenceUs << " us, castTemporal " << kernelUs << " us" << std::endl;
+    VectorSP copy = nanos->getValue(rows);
+    kernelUs = time([&] { inPlace = copy->castTemporalInPlace(DT_TIMESTAMP); });
+    std::cout << "NANOTIMESTAMP->TIMESTAMP in place: " << kernelUs << " us" << std::endl;
+    EXPECT_EQ(std::memcmp(timestamps->getDataArray(), reference->getDataArray(), sizeof(long long) * rows), 0);
+    EXPECT_EQ(std::memcmp(inPlace->getDataArray(), reference->getDataArray(), sizeof(long long) * rows), 0);
+    EXPECT_EQ(std::memcmp(months->getDataArray(), referenceMonths->getDataArray(), sizeof(int) * rows), 0);
+
+    const long long* millis = (const long long*)reference->getDataArray();
+    std::vector<long long> local(millis, millis + rows);
+    referenceUs = time([&] {
+        for (int i = 0; i < rows; i += 10)
+            Util::toLocalTimestamp(millis[i]);
+    });
+    kernelUs = time([&] { Util::toLocalTimestamp(local.data(), rows); });
+    std::cout << "toLocalTimestamp: localtime per row " << referenceUs * 10 << " us (extrapolated from every 10th row), cached offsets " << kernelUs << " us" << std::endl;
+    EXPECT_EQ(local[rows - 1], Util::toLocalTimestamp(millis[rows - 1]));
+}
+
+TEST_F(FunctionBenchmark, DISABLED_TextTableReader){
+    std::string path = "TextTableReader_benchmark.csv";
+    const int rows = 2000000;
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "sym,date,ts,qty,price\n";
+        char line[128];
+        for(int i = 0; i < rows; ++i){
+            snprintf(line, sizeof(line), "SYM%d,2024.01.%02d,2024.01.%02d 09:%02d:%02d.%03d,%d,%.2f\n", i % 500, 1 + i % 28, 1 + i % 28,
+                     30 + i / 60000 % 30, i / 1000 % 60, i % 1000, i % 10000, 100 + (i % 10000) / 100.0);
+            out << line;
+        }
+    }
+    std::vector<std::string> names = {"sym", "date", "ts", "qty", "price"};
+    std::vector<DATA_TYPE> types = {DT_SYMBOL, DT_DATE, DT_TIMESTAMP, DT_INT, DT_DOUBLE};
+
+    //Row by row through Util::parseConstant, the way loaders build tables today.
+    auto start = std::chrono::steady_clock::now();
+    std::vector<VectorSP> cols;
+    for(DATA_TYPE type : types)
+        cols.push_back(Util::createVector(type, 0, rows));
+    {
+        std::ifstream in(path);
+        std::string line, field;
+        std::getline(in, line);
+        while(std::getline(in, line)){
+            size_t pos = 0;
+            for(size_t c = 0; c < types.size(); ++c){
+                size_t next = line.find(',', pos);
+                field = line.substr(pos, next == std::string::npos ? std::string::npos : next - pos);
+                pos = next + 1;
+                ConstantSP value = types[c] == DT_SYMBOL ? ConstantSP(Util::createString(field)) : ConstantSP(Util::parseConstant(types[c], field));
+                cols[c]->append(value);
+            }
+        }
+    }
+    long long rowWise = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    TextReaderOptions options;
+    options.workerCount = 1;
+    TableSP single = TextTableReader(path, names, types, options).read();
+    long long oneThread = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    options.workerCount = 0;
+    TableSP parallel = TextTableReader(path, names, types, options).read();
+    long long allThreads = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "parseConstant per field: " << rowWise << " ms, TextTableReader 1 thread: " << oneThread
+              << " ms, " << Util::getCoreCount() << " threads: " << allThreads << " ms" << std::endl;
+    ASSERT_EQ(rows, single->rows());
+    ASSERT_EQ(rows, parallel->rows());
+    for(size_t c = 0; c < types.size(); ++c){
+        for(INDEX i = 0; i < rows; i += 997){
+            ASSERT_EQ(cols[c]->getString(i), single->getColumn(c)->getString(i));
+            ASSERT_EQ(cols[c]->getString(i), parallel->getColumn(c)->getString(i));
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST_F(FunctionBenchmark, DISABLED_TextTableWriter){
+    const int rows = 2000000;
+    std::vector<std::string> names = {"sym", "date", "ts", "qty", "price"};
+    std::vector<DATA_TYPE> types = {DT_SYMBOL, DT_DATE, DT_TIMESTAMP, DT_INT, DT_DOUBLE};
+    std::vector<ConstantSP> cols;
+    for(DATA_TYPE type : types)
+        cols.push_back(Util::createVector(type, rows, rows));
+    for(int i = 0; i < rows; ++i){
+        ((VectorSP)cols[0])->setString(i, "SYM" + std::to_string(i % 500));
+        ((VectorSP)cols[1])->setInt(i, 19723 + i % 28);
+        ((VectorSP)cols[2])->setLong(i, 1704187800000LL + i * 7LL);
+        ((VectorSP)cols[3])->setInt(i, i % 10000);
+        ((VectorSP)cols[4])->setDouble(i, 100 + (i % 10000) / 100.0);
+    }
+    TableSP table = Util::createTable(names, cols);
+    std::string path = "TextTableWriter_benchmark.csv";
+
+    //Cell by cell through getString, the way tables are dumped today.
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::ofstream out(path, std::ios::binary);
+        for(size_t c = 0; c < names.size(); ++c)
+            out << names[c] << (c + 1 == names.size() ? '\n' : ',');
+        for(INDEX i = 0; i < rows; ++i){
+            for(int c = 0; c < table->columns(); ++c)
+                out << table->getColumn(c)->getString(i) << (c + 1 == table->columns() ? '\n' : ',');
+        }
+    }
+    long long cellWise = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    std::ifstream in(path, std::ios::binary);
+    std::string expected((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    start = std::chrono::steady_clock::now();
+    {
+        TextTableWriter writer(path);
+        writer.write(table);
+    }
+    long long oneThread = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    in.open(path, std::ios::binary);
+    ASSERT_EQ(expected, std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>()));
+    in.close();
+
+    start = std::chrono::steady_clock::now();
+    {
+        TextWriterOptions options;
+        options.workerCount = 0;
+        TextTableWriter writer(path, options);
+        writer.write(table);
+    }
+    long long allThreads = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    in.open(path, std::ios::binary);
+    ASSERT_EQ(expected, std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>()));
+    in.close();
+
+    std::cout << "getString per cell: " << cellWise << " ms, TextTableWriter 1 thread: " << oneThread
+              << " ms, " << Util::getCoreCount() << " threads: " << allThreads << " ms" << std::endl;
+    std::remove(path.c_str());
+}
+
+TEST_F(FunctionBenchmark, DISABLED_ColumnarFile){
+    const int rows = 10000000;
+    std::vector<std::string> names = {"ts", "qty", "price"};
+    TableSP table = Util::createTable(names, {DT_TIMESTAMP, DT_INT, DT_DOUBLE}, rows, rows);
+    long long* ts = (long long*)((VectorSP)table->getColumn(0))->getDataArray();
+    int* qty = (int*)((VectorSP)table->getColumn(1))->getDataArray();
+    double* price = (double*)((VectorSP)table->getColumn(2))->getDataArray();
+    for(int i = 0; i < rows; ++i){
+        ts[i] = 1704187800000LL + i * 7LL;
+        qty[i] = i % 10000;
+        price[i] = 100 + (i % 10000) / 100.0;
+    }
+    std::string path = "ColumnarFile_benchmark.ddbcol";
+    auto elapsed = [](std::chrono::steady_clock::time_point start){
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0;
+    };
+
+    //Through the network format, as a hand-written serializer would do it.
+    auto start = std::chrono::steady_clock::now();
+    DataOutputStreamSP out = new DataOutputStream(1 << 20);
+    ConstantMarshallSP marshall = ConstantMarshallFactory::getInstance(DF_TABLE, out);
+    IO_ERR ret;
+    ASSERT_TRUE(marshall->start(table, true, false, ret));
+    marshall->flush();
+    double marshalled = elapsed(start);
+    start = std::chrono::steady_clock::now();
+    DataInputStreamSP in = new DataInputStream(out->getBuffer(), out->size(), false);
+    short flag;
+    in->readShort(flag);
+    ConstantUnmarshallSP unmarshall = ConstantUnmarshallFactory::getInstance(DF_TABLE, in);
+    ASSERT_TRUE(unmarshall->start(flag, true, ret));
+    double unmarshalled = elapsed(start);
+
+    start = std::chrono::steady_clock::now();
+    ColumnarFile::write(path, table);
+    double written = elapsed(start);
+    start = std::chrono::steady_clock::now();
+    TableSP mapped = ColumnarFile(path).getTable();
+    double loaded = elapsed(start);
+    start = std::chrono::steady_clock::now();
+    const double* mappedPrice = (const double*)((VectorSP)mapped->getColumn(2))->getDataArray();
+    double sum = 0;
+    for(int i = 0; i < rows; ++i)
+        sum += mappedPrice[i];
+    double scanned = elapsed(start);
+
+    table->setColumnCompressMethods({COMPRESS_DELTA, COMPRESS_DELTA, COMPRESS_LZ4});
+    start = std::chrono::steady_clock::now();
+    ColumnarFile::write(path, table);
+    double compressedWritten = elapsed(start);
+    start = std::chrono::steady_clock::now();
+    TableSP decoded = ColumnarFile(path).getTable();
+    double compressedLoaded = elapsed(start);
+
+    std::cout << "marshall " << marshalled << " ms, unmarshall " << unmarshalled << " ms; ColumnarFile write " << written
+              << " ms, load " << loaded << " ms, first scan of mapped price " << scanned << " ms; compressed write "
+              << compressedWritten << " ms, load " << compressedLoaded << " ms" << std::endl;
+    ASSERT_EQ(rows, mapped->rows());
+    ASSERT_EQ(rows, decoded->rows());
+    for(int c = 0; c < 3; ++c){
+        for(INDEX i = 0; i < rows; i += 9973){
+            ASSERT_EQ(table->getColumn(c)->getString(i), mapped->getColumn(c)->getString(i));
+            ASSERT_EQ(table->getColumn(c)->getString(i), decoded->getColumn(c)->getString(i));
+        }
+    }
+    ASSERT_GT(sum, 0);
+    std::remove(path.c_str());
+}
+
+TEST_F(FunctionBenchmark, DISABLED_ArrowInterop){
+    const int rows = 10000000;
+    TableSP table = Util::createTable({"ts", "qty", "price"}, {DT_TIMESTAMP, DT_INT, DT_DOUBLE}, rows, rows);
+    long long* ts = (long long*)((VectorSP)table->getColumn(0))->getDataArray();
+    int* qty = (int*)((VectorSP)table->getColumn(1))->getDataArray();
+    double* price = (double*)((VectorSP)table->getColumn(2))->getDataArray();
+    for(int i = 0; i < rows; ++i){
+        ts[i] = 1704187800000LL + i * 7LL;
+        qty[i] = i % 10000;
+        price[i] = 100 + (i % 10000) / 100.0;
+    }
+    auto elapsed = [](std::chrono::steady_clock::time_point start){
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0;
+    };
+
+    //Cell by cell, as a hand-written converter does it.
+    auto start = std::chrono::steady_clock::now();
+    std::vector<long long> tsCopy(rows);
+    std::vector<int> qtyCopy(rows);
+    std::vector<double> priceCopy(rows);
+    for(int i = 0; i < rows; ++i){
+        tsCopy[i] = table->getColumn(0)->getLong(i);
+        qtyCopy[i] = table->getColumn(1)->getInt(i);
+        priceCopy[i] = table->getColumn(2)->getDouble(i);
+    }
+    double copied = elapsed(start);
+
+    start = std::chrono::steady_clock::now();
+    ArrowSchema schema;
+    ArrowArray array;
+    exportToArrow(table, &schema, &array);
+    double exported = elapsed(start);
+    start = std::chrono::steady_clock::now();
+    TableSP imported = importFromArrow(&schema, &array);
+    double importedTime = elapsed(start);
+
+    std::cout << "cell by cell " << copied << " ms; exportToArrow " << exported << " ms, importFromArrow " << importedTime << " ms" << std::endl;
+    ASSERT_EQ(rows, imported->rows());
+    ASSERT_EQ((void*)price, ((VectorSP)imported->getColumn(2))->getDataArray());
+    ASSERT_EQ(priceCopy[rows - 1], imported->getColumn(2)->getDouble(rows - 1));
+}
+
+TEST_F(FunctionBenchmark, DISABLED_VectorViews){
+    const int rows = 10000000;
+    const int partitions = 8;
+    VectorSP ids = Util::createVector(DT_INT, rows);
+    VectorSP prices = Util::createVector(DT_DOUBLE, rows);
+    VectorSP times = Util::createVector(DT_TIMESTAMP, rows);
+    int* idData = (int*)ids->getDataArray();
+    double* priceData = (double*)prices->getDataArray();
+    long long* timeData = (long long*)times->getDataArray();
+    for(int i = 0; i < rows; ++i){
+        idData[i] = i;
+        priceData[i] = i * 0.01;
+        timeData[i] = 1704187800000LL + i;
+    }
+    TableSP table = Util::createTable({"id", "price", "time"}, {ids, prices, times});
+    vector<vector<int>> chunks(partitions);
+    for(int i = 0; i < rows; ++i)
+        chunks[i % partitions].push_back(i);
+
+    auto marshallRows = [](const vector<TableSP>& tables){
+        long long bytes = 0;
+        for(auto& t : tables){
+            DataOutputStreamSP out = new DataOutputStream(1 << 20);
+            TableMarshall marshall(out);
+            IO_ERR ret;
+            EXPECT_TRUE(marshall.start(0, 0, (ConstantSP)t, true, false, ret));
+            marshall.flush();
+            bytes += out->size();
+        }
+        return bytes;
+    };
+    //Resident memory in bytes, or 0 where /proc isn't available.
+    auto residentMemory = [](){
+        std::ifstream statm("/proc/self/statm");
+        long long pages = 0, resident = 0;
+        statm >> pages >> resident;
+        return resident * 4096;
+    };
+
+    long long baseMemory = residentMemory();
+    auto start = std::chrono::steady_clock::now();
+    vector<TableSP> copies;
+    for(auto& chunk : chunks){
+        vector<ConstantSP> cols;
+        for(int c = 0; c < table->columns(); ++c)
+            cols.push_back(Util::createSubVector(table->getColumn(c), chunk));
+        copies.push_back(Util::createTable({"id", "price", "time"}, cols));
+    }
+    long long copyMemory = residentMemory() - baseMemory;
+    long long copyBytes = marshallRows(copies);
+    double copyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    copies.clear();
+    baseMemory = residentMemory();
+
+    start = std::chrono::steady_clock::now();
+    vector<TableSP> views;
+    for(auto& chunk : chunks)
+        views.push_back(table->getSubTableView(chunk));
+    long long viewMemory = residentMemory() - baseMemory;
+    long long viewBytes = marshallRows(views);
+    double viewMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    views.clear();
+    baseMemory = residentMemory();
+
+    start = std::chrono::steady_clock::now();
+    vector<TableSP> slices;
+    for(int p = 0; p < partitions; ++p)
+        slices.push_back(table->getSubTableView((INDEX)p * (rows / partitions), rows / partitions));
+    long long sliceMemory = residentMemory() - baseMemory;
+    long long sliceBytes = marshallRows(slices);
+    double sliceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_EQ(copyBytes, viewBytes);
+    ASSERT_EQ(copyBytes, sliceBytes);
+    std::cout << "split " << rows << " rows into " << partitions << " tables (memory) and marshall them (time): copies " << copyMs << " ms, "
+              << copyMemory / (1 << 20) << " MB; gather views " << viewMs << " ms, " << viewMemory / (1 << 20)
+              << " MB; slices " << sliceMs << " ms, " << sliceMemory / (1 << 20) << " MB" << std::endl;
+}
+
+TEST_F(FunctionBenchmark, DISABLED_RadixScatter){
+    const int rows = 10000000;
+    VectorSP ids = Util::createVector(DT_INT, rows);
+    VectorSP prices = Util::createVector(DT_DOUBLE, rows);
+    VectorSP times = Util::createVector(DT_TIMESTAMP, rows);
+    int* idData = (int*)ids->getDataArray();
+    double* priceData = (double*)prices->getDataArray();
+    long long* timeData = (long long*)times->getDataArray();
+    for(int i = 0; i < rows; ++i){
+        idData[i] = i;
+        priceData[i] = i * 0.01;
+        timeData[i] = 1704187800000LL + i;
+    }
+    TableSP table = Util::createTable({"id", "price", "time"}, {ids, prices, times});
+    std::mt19937 rng(42);
+    vector<int> keys(rows);
+    for(int i = 0; i < rows; ++i)
+        keys[i] = (int)(rng() & 0x7fffffff);
+
+    for(int destinations : {1, 2, 4, 8, 16, 32, 64}){
+        //Row lists per destination, then a copy of each destination's rows.
+        auto start = std::chrono::steady_clock::now();
+        vector<vector<int>> chunks(destinations);
+        for(int i = 0; i < rows; ++i)
+            chunks[keys[i] % destinations].emplace_back(i);
+        vector<TableSP> gathered;
+        for(auto& chunk : chunks)
+            gathered.push_back(table->getSubTable(chunk));
+        double gatherMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        vector<int> partitionIds(rows);
+        for(int i = 0; i < rows; ++i)
+            partitionIds[i] = keys[i] % destinations;
+        RadixScatter scatter(std::move(partitionIds), destinations);
+        vector<TableSP> scattered = scatter.scatter(table);
+        double scatterMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        for(int dest = 0; dest < destinations; ++dest){
+            ASSERT_EQ(gathered[dest]->rows(), scattered[dest]->rows());
+            ASSERT_EQ(0, memcmp(gathered[dest]->getColumn(2)->getDataArray(), scattered[dest]->getColumn(2)->getDataArray(), scattered[dest]->rows() * sizeof(long long)));
+        }
+        std::cout << "route " << rows << " rows to " << destinations << " destinations: row lists and gather " << gatherMs
+                  << " ms, radix scatter " << scatterMs << " ms" << std::endl;
+    }
+}
+
+#endif
@@ -1,4 +1,13 @@
 #include "config.h"
+#include "ColumnSpan.h"
+#include "VectorKernels.h"
+#include "TemporalKernels.h"
+#include "TextTableReader.h"
+#include "TextTableWriter.h"
+#include "ColumnarFile.h"
+#include "ArrowInterop.h"
+#include "VectorView.h"
+#include "RadixScatter.h"
 
 class FunctionTest:public testing::Test
 {
@@ -1329,6 +1338,100 @@ TEST_F(FunctionTest, DLogger){
     RecordTime::printAllTime();
 }
 
+TEST_F(FunctionTest, Tracer){
+    Tracer::clear();
+    Tracer::enable();
+    {
+        DDB_TRACE("FunctionTest.outer");
+        for(int i = 0; i < 3; ++i){
+            DDB_TRACE("FunctionTest.inner");
+            Util::sleep(1);
+        }
+    }
+    Tracer::disable();
+    {
+        DDB_TRACE("FunctionTest.disabled");
+    }
+    std::vector<Tracer::Event> events;
+    Tracer::collect(events);
+    int outerSite = Tracer::registerSite("FunctionTest.outer");
+    int innerSite = Tracer::registerSite("FunctionTest.inner");
+    int disabledSite = Tracer::registerSite("FunctionTest.disabled");
+    unsigned long long outerId = 0;
+    int innerCount = 0;
+    for(auto &event : events){
+        EXPECT_NE(event.siteId, disabledSite);
+        EXPECT_GE(event.endTick, event.startTick);
+        if(event.siteId == outerSite)
+            outerId = event.spanId;
+    }
+    ASSERT_NE(outerId, 0ULL);
+    for(auto &event : events){
+        if(event.siteId == innerSite){
+            EXPECT_EQ(event.parentId, outerId);
+            innerCount++;
+        }
+    }
+    EXPECT_EQ(innerCount, 3);
+    std::string json = Tracer::exportChromeTrace();
+    EXPECT_NE(json.find("\"name\":\"FunctionTest.inner\""), std::string::npos);
+    std::string summary = Tracer::summary();
+    EXPECT_NE(summary.find("FunctionTest.outer: count = 1"), std::string::npos);
+    Tracer::clear();
+}
+
+TEST_F(FunctionTest, Tracer_reusesBuffersOfExitedThreads){
+    Tracer::clear();
+    Tracer::enable();
+    auto traceOnce = [](){ DDB_TRACE("FunctionTest.shortThread"); };
+    std::thread(traceOnce).join();
+    size_t buffers = Tracer::bufferCount();
+    for(int i = 0; i < 20; ++i)
+        std::thread(traceOnce).join();
+    Tracer::disable();
+    EXPECT_EQ(buffers, Tracer::bufferCount());
+    //The events of the exited threads are kept.
+    std::vector<Tracer::Event> events;
+    Tracer::collect(events);
+    int site = Tracer::registerSite("FunctionTest.shortThread");
+    EXPECT_EQ(21, std::count_if(events.begin(), events.end(), [site](const Tracer::Event &event){ return event.siteId == site; }));
+    Tracer::clear();
+}
+
+TEST_F(FunctionTest, MetricsRegistry){
+    MetricsRegistry &registry = MetricsRegistry::instance();
+    std::string labels = MetricsRegistry::label("case", "function\"test");
+    MetricCounter *counter = registry.counter("ddb_test_events_total", labels);
+    EXPECT_EQ(counter, registry.counter("ddb_test_events_total", labels));
+    counter->increment(5);
+    counter->increment();
+    EXPECT_EQ(counter->get(), 6);
+    EXPECT_ANY_THROW(registry.gauge("ddb_test_events_total", labels));
+
+    MetricHistogram *histogram = registry.histogram("ddb_test_latency_microseconds", labels);
+    histogram->reset();
+    for(long long i = 1; i <= 10000; ++i)
+        histogram->record(i);
+    EXPECT_EQ(histogram->count(), 10000);
+    EXPECT_EQ(histogram->min(), 1);
+    EXPECT_EQ(histogram->max(), 10000);
+    EXPECT_NEAR(histogram->percentile(0.5), 5000, 5000 / 64);
+    EXPECT_NEAR(histogram->percentile(0.99), 9900, 9900 / 64);
+    for(long long value : {0LL, 127LL, 128LL, 1000000LL, 1LL << 40})
+        EXPECT_LE(MetricHistogram::bucketLowerBound(MetricHistogram::bucketIndex(value)), value);
+
+    int depth = 3;
+    registry.registerGauge("ddb_test_queue_depth", labels, [&](){ return (double)depth; });
+    depth = 7;
+    std::string text = registry.toPrometheusText();
+    EXPECT_NE(text.find("# TYPE ddb_test_events_total counter"), std::string::npos);
+    EXPECT_NE(text.find("ddb_test_events_total{case=\"function\\\"test\"} 6"), std::string::npos);
+    EXPECT_NE(text.find("ddb_test_queue_depth{case=\"function\\\"test\"} 7"), std::string::npos);
+    EXPECT_NE(text.find("ddb_test_latency_microseconds_count{case=\"function\\\"test\"} 10000"), std::string::npos);
+    registry.unregisterGauge("ddb_test_queue_depth", labels);
+    EXPECT_EQ(registry.toPrometheusText().find("ddb_test_queue_depth"), std::string::npos);
+}
+
 
 BasicTableSP createTable(){
     int* data1 = new int[2]{1, 2};
@@ -1597,4 +1700,1276 @@ TEST_F(FunctionTest,test_FastFixedLengthVector_getDataArray){
     fastIntVec1->get(idx3);
 }
 
+TEST_F(FunctionTest, SymbolEncoder){
+    SymbolEncoder encoder(8);
+    VectorSP strings = Util::createVector(DT_STRING, 0, 6);
+    for (string s : {"AAPL", "IBM", "", "AAPL", "MSFT", "IBM"})
+        strings->append(Util::createString(s));
+    VectorSP codes = encoder.encode(strings);
+    ASSERT_EQ(codes->getType(), DT_SYMBOL);
+    ASSERT_EQ(codes->size(), 6);
+    for (int i = 0; i < 6; ++i)
+        EXPECT_EQ(codes->getString(i), strings->getString(i));
+    EXPECT_TRUE(codes->isNull(2));
+    EXPECT_TRUE(codes->hasNull());
+    EXPECT_EQ(codes->getSymbolBase()->size(), 4);
+    EXPECT_EQ(encoder.getSymbolBase()->size(), 4);
+
+    //Symbol vectors with their own dictionary are re-coded, and each batch only carries its own symbols.
+    VectorSP symbols = Util::createVector(DT_SYMBOL, 0, 4);
+    for (string s : {"TSLA", "IBM", "TSLA"})
+        symbols->append(Util::createString(s));
+    VectorSP recoded = encoder.encode(symbols);
+    EXPECT_NE(recoded->getSymbolBase().get(), codes->getSymbolBase().get());
+    EXPECT_EQ(recoded->getSymbolBase()->size(), 3);
+    EXPECT_EQ(encoder.getSymbolBase()->size(), 5);
+    EXPECT_EQ(recoded->getString(0), "TSLA");
+    EXPECT_EQ(recoded->getString(1), "IBM");
+    EXPECT_EQ(recoded->getInt(0), recoded->getInt(2));
+    EXPECT_FALSE(recoded->hasNull());
+    symbols->append(Util::createString("GOOG"));
+    recoded = encoder.encode(symbols);
+    EXPECT_EQ(recoded->getString(3), "GOOG");
+    VectorSP again = encoder.encode(recoded);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(again->getString(i), symbols->getString(i));
+
+    vector<ConstantSP> columns = {strings, strings, symbols};
+    encoder.encode(columns, {DT_STRING, DT_SYMBOL, DT_SYMBOL});
+    EXPECT_EQ(columns[0].get(), strings.get());
+    EXPECT_EQ(columns[1]->getType(), DT_SYMBOL);
+    EXPECT_EQ(columns[1]->getSymbolBase().get(), columns[2]->getSymbolBase().get());
+    EXPECT_EQ(columns[1]->getSymbolBase()->size(), 6);
+    EXPECT_EQ(columns[2]->getString(3), "GOOG");
+    TableSP table = Util::createTable({"a", "b"}, {strings, strings});
+    TableSP encoded = encoder.encode(table, {DT_SYMBOL, DT_STRING});
+    EXPECT_EQ(encoded->getColumn(0)->getType(), DT_SYMBOL);
+    EXPECT_EQ(encoded->getColumn(1)->getType(), DT_STRING);
+    EXPECT_EQ(encoded->getColumnName(0), "a");
+    EXPECT_EQ(encoded->getColumn(0)->getString(4), "MSFT");
+
+    //The dictionary restarts once it outgrows the limit, earlier vectors keep theirs.
+    VectorSP many = Util::createVector(DT_STRING, 0, 16);
+    for (int i = 0; i < 16; ++i)
+        many->append(Util::createString("S" + std::to_string(i)));
+    SymbolBaseSP before = encoder.getSymbolBase();
+    encoder.encode(many);
+    VectorSP after = encoder.encode(strings);
+    EXPECT_NE(encoder.getSymbolBase().get(), before.get());
+    EXPECT_EQ(after->getString(4), "MSFT");
+    EXPECT_EQ(encoder.getSymbolBase()->size(), 4);
+}
+
+TEST_F(FunctionTest, TableSchemaCache){
+    TableSchemaCache &cache = TableSchemaCache::instance();
+    cache.clear();
+    long long oldTTL = cache.getTTL();
+    int loads = 0;
+    auto loader = [&]() {
+        ++loads;
+        DictionarySP schema = Util::createDictionary(DT_STRING, DT_ANY);
+        schema->set("engineType", Util::createString("OLAP"));
+        return schema;
+    };
+    string key = TableSchemaCache::makeKey("127.0.0.1", 8848, "dfs://db", "pt");
+    EXPECT_EQ(key, "127.0.0.1:8848/dfs://db/pt");
+    EXPECT_EQ(TableSchemaCache::makeKey("127.0.0.1", 8848, "", "st"), "");
+
+    DictionarySP first = cache.get(key, loader);
+    DictionarySP second = cache.get(key, loader);
+    EXPECT_EQ(loads, 1);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(cache.size(), 1);
+
+    //In-memory tables are never cached.
+    cache.get("", loader);
+    cache.get("", loader);
+    EXPECT_EQ(loads, 3);
+
+    cache.invalidate(key);
+    EXPECT_EQ(cache.size(), 0);
+    cache.get(key, loader);
+    EXPECT_EQ(loads, 4);
+
+    cache.setTTL(1);
+    Util::sleep(5);
+    cache.get(key, loader);
+    EXPECT_EQ(loads, 5);
+    cache.setTTL(0);
+    EXPECT_EQ(cache.size(), 0);
+    cache.get(key, loader);
+    cache.get(key, loader);
+    EXPECT_EQ(loads, 7);
+    cache.setTTL(oldTTL);
+    cache.clear();
+}
+
+TEST_F(FunctionTest, FlatHashMap){
+    FlatHashMap<int, long long> map;
+    std::unordered_map<int, long long> expected;
+    std::mt19937 rng(42);
+    for (int i = 0; i < 200000; ++i) {
+        int key = (int)(rng() % 5000);
+        switch (rng() % 3) {
+        case 0: map[key] = i; expected[key] = i; break;
+        case 1: EXPECT_EQ(map.erase(key), expected.erase(key)); break;
+        default: {
+            auto it = map.find(key);
+            auto ref = expected.find(key);
+            ASSERT_EQ(it == map.end(), ref == expected.end());
+            if (ref != expected.end()) {
+                EXPECT_EQ(it->second, ref->second);
+            }
+        }
+        }
+    }
+    ASSERT_EQ(map.size(), expected.size());
+    size_t visited = 0;
+    for (auto &entry : map) {
+        EXPECT_EQ(expected[entry.first], entry.second);
+        ++visited;
+    }
+    EXPECT_EQ(visited, expected.size());
+    FlatHashMap<int, long long> copy(map);
+    EXPECT_EQ(copy.size(), map.size());
+    map.clear();
+    EXPECT_TRUE(map.find(1) == map.end());
+    //Clearing a table that holds only tombstones leaves every slot empty again.
+    FlatHashMap<int, int> erased;
+    for (int i = 0; i < 14; ++i)
+        erased[i] = i;
+    for (int i = 0; i < 14; ++i)
+        erased.erase(i);
+    erased.clear();
+    for (int i = 0; i < 100; ++i)
+        erased[i] = 1;
+    EXPECT_EQ(erased.size(), 100u);
+    EXPECT_TRUE(erased.find(1000) == erased.end());
+    DictionarySP emptied = Util::createDictionary(DT_INT, DT_INT);
+    VectorSP emptiedKeys = Util::createIndexVector(0, 14);
+    emptied->set(emptiedKeys, emptiedKeys);
+    for (int i = 0; i < 14; ++i)
+        emptied->remove(Util::createInt(i));
+    emptied->clear();
+    emptied->set(Util::createIndexVector(100, 100), Util::createIndexVector(0, 100));
+    EXPECT_EQ(emptied->size(), 100);
+    EXPECT_TRUE(emptied->getMember(Util::createInt(1000))->isNull());
+
+    FlatHashSet<string> set;
+    set.insert("a");
+    set.insert("b");
+    EXPECT_FALSE(set.insert("a").second);
+    set.erase(set.find("a"));
+    string keys[] = {"a", "b", "c"};
+    char found[3];
+    set.containBatch(keys, 3, found);
+    EXPECT_EQ(found[0], 0);
+    EXPECT_EQ(found[1], 1);
+    EXPECT_EQ(found[2], 0);
+
+    //Dictionaries and sets created by Util are backed by the flat tables.
+    DictionarySP dict = Util::createDictionary(DT_LONG, DT_STRING);
+    VectorSP dictKeys = Util::createIndexVector(0, 10000);
+    VectorSP dictValues = Util::createVector(DT_STRING, 10000);
+    for (int i = 0; i < 10000; ++i)
+        dictValues->setString(i, std::to_string(i * 2));
+    dict->set(dictKeys, dictValues);
+    EXPECT_EQ(dict->size(), 10000);
+    VectorSP probe = Util::createIndexVector(9990, 20);
+    ConstantSP members = dict->getMember(probe);
+    EXPECT_EQ(members->getString(0), "19980");
+    EXPECT_TRUE(members->isNull(10));
+    ConstantSP contained = Util::createVector(DT_BOOL, 20);
+    dict->contain(probe, contained);
+    EXPECT_TRUE(contained->getBool(9));
+    EXPECT_FALSE(contained->getBool(10));
+    dict->remove(Util::createLong(5));
+    EXPECT_EQ(dict->size(), 9999);
+    EXPECT_TRUE(dict->getMember(Util::createLong(5))->isNull());
+    EXPECT_EQ(dict->keys()->size(), 9999);
+
+    SetSP intSet = Util::createSet(DT_INT, 0);
+    intSet->append(dictKeys);
+    intSet->remove(Util::createInt(3));
+    intSet->contain(probe, contained);
+    EXPECT_EQ(intSet->size(), 9999);
+    EXPECT_TRUE(contained->getBool(0));
+    EXPECT_FALSE(contained->getBool(15));
+
+    //The constructors still take std containers and copy them into flat tables.
+    std::unordered_map<long long, U8> rawDict;
+    rawDict[7].longVal = 70;
+    LongDictionary fromStd(rawDict, DT_LONG, DT_LONG);
+    EXPECT_EQ(fromStd.getMember(Util::createLong(7))->getLong(), 70);
+    EXPECT_EQ(VectorSP(((ConstantSP)fromStd.getValue())->keys())->size(), 1);
+    Int128Dictionary guids(DT_UUID, DT_LONG);
+    U8 guidValue;
+    guidValue.longVal = 1;
+    guids.getInternalDict()[Guid(true)] = guidValue;
+    EXPECT_EQ(guids.size(), 1);
+    LongSet fromStdSet(DT_LONG, std::unordered_set<long long>({1, 2, 3}));
+    EXPECT_EQ(fromStdSet.size(), 3);
+}
+
+TEST_F(FunctionTest, ColumnView){
+    VectorSP ints = Util::createIndexVector(0, 5000);
+    ColumnView<int> view(ints, 10, 3000);
+    ASSERT_TRUE(view.isContiguous());
+    EXPECT_EQ(view.size(), 3000);
+    EXPECT_EQ(view[0], 10);
+    ColumnSpan<int> span = view.span();
+    EXPECT_EQ(span.data(), (const int*)ints->getDataArray() + 10);
+    EXPECT_EQ(span[2999], 3009);
+
+    //INT values read as long long are converted chunk by chunk.
+    ColumnView<long long> longs(ints, 100);
+    EXPECT_FALSE(longs.isContiguous());
+    EXPECT_ANY_THROW(longs.span());
+    EXPECT_EQ(longs.size(), 4900);
+    long long sum = 0;
+    int chunks = 0;
+    longs.forEachSpan([&](ColumnSpan<long long> chunk, INDEX start) {
+        EXPECT_EQ(chunk[0], 100 + start);
+        for (long long value : chunk)
+            sum += value;
+        ++chunks;
+    });
+    EXPECT_EQ(chunks, (4900 + Util::BUF_SIZE - 1) / Util::BUF_SIZE);
+    EXPECT_EQ(sum, (100LL + 4999) * 4900 / 2);
+    long long iterated = 0;
+    INDEX count = 0;
+    for (auto it = longs.begin(); it != longs.end(); ++it, ++count)
+        iterated += *it;
+    EXPECT_EQ(count, 4900);
+    EXPECT_EQ(iterated, sum);
+    EXPECT_EQ(longs[4899], 4999);
+
+    int visited = 0;
+    longs.forEachSpan([&](ColumnSpan<long long>, INDEX) { ++visited; return false; });
+    EXPECT_EQ(visited, 1);
+
+    VectorSP bools = Util::createVector(DT_BOOL, 3);
+    bools->setBool(0, 0);
+    bools->setBool(1, 1);
+    bools->setBool(2, 0);
+    int trues = 0;
+    ColumnView<char>(bools).forEach([&](char value) { trues += value; });
+    EXPECT_EQ(trues, 1);
+}
+
+template<class T>
+static void checkKernels(T nullVal, T (*gen)(std::mt19937&)) {
+    std::mt19937 rng(7);
+    for (INDEX n : {0, 1, 3, 7, 8, 31, 32, 33, 100, 1000, 4099}) {
+        std::vector<T> data(n);
+        for (INDEX i = 0; i < n; ++i)
+            data[i] = rng() % 5 == 0 ? nullVal : gen(rng);
+        EXPECT_EQ(kernels::findNull(data.data(), n, nullVal), kernels::scalar::findNull(data.data(), n, nullVal));
+        EXPECT_EQ(kernels::countNull(data.data(), n, nullVal), kernels::scalar::countNull(data.data(), n, nullVal));
+        kernels::Reduction<T> fast, slow;
+        kernels::reduce(data.data(), n, nullVal, fast);
+        kernels::scalar::reduce(data.data(), n, nullVal, slow);
+        EXPECT_EQ(fast.nullCount, slow.nullCount);
+        EXPECT_EQ(fast.min, slow.min);
+        EXPECT_EQ(fast.max, slow.max);
+        EXPECT_EQ(fast.sum, slow.sum);
+        std::vector<T> sorted(data);
+        std::sort(sorted.begin(), sorted.end());
+        for (bool strict : {false, true}) {
+            EXPECT_EQ(kernels::isSorted(sorted.data(), n, true, strict), kernels::scalar::isSorted(sorted.data(), n, true, strict));
+            EXPECT_EQ(kernels::isSorted(sorted.data(), n, false, strict), kernels::scalar::isSorted(sorted.data(), n, false, strict));
+            EXPECT_EQ(kernels::isSorted(data.data(), n, true, strict), kernels::scalar::isSorted(data.data(), n, true, strict));
+        }
+        //A single null at the very end must still be found.
+        if (n > 0) {
+            std::vector<T> tail(n, gen(rng));
+            tail[n - 1] = nullVal;
+            EXPECT_EQ(kernels::findNull(tail.data(), n, nullVal), n - 1);
+        }
+    }
+}
+
+TEST_F(FunctionTest, VectorKernels){
+    //Integer-valued doubles keep the sums exact whatever the summation order.
+    checkKernels<int>(INT_MIN, [](std::mt19937& rng) { return (int)(rng() % 2000000) - 1000000; });
+    checkKernels<long long>(LLONG_MIN, [](std::mt19937& rng) { return (long long)rng() * 1000 - (1LL << 40); });
+    checkKernels<float>(FLT_NMIN, [](std::mt19937& rng) { return (float)((int)(rng() % 2000) - 1000); });
+    checkKernels<double>(DBL_NMIN, [](std::mt19937& rng) { return (double)((int)(rng() % 2000000) - 1000000); });
+    checkKernels<short>(SHRT_MIN, [](std::mt19937& rng) { return (short)((int)(rng() % 2000) - 1000); });
+
+    VectorSP ints = Util::createVector(DT_INT, 0, 10);
+    int values[] = {5, INT_MIN, -3, 9, INT_MIN, 1};
+    ints->appendInt(values, 6);
+    VectorStats stats = ints->stats();
+    EXPECT_EQ(stats.count, 4);
+    EXPECT_EQ(stats.nullCount, 2);
+    EXPECT_EQ(stats.min->getType(), DT_INT);
+    EXPECT_EQ(stats.min->getInt(), -3);
+    EXPECT_EQ(stats.max->getInt(), 9);
+    EXPECT_DOUBLE_EQ(stats.sum, 12);
+    EXPECT_DOUBLE_EQ(stats.avg, 3);
+    EXPECT_TRUE(ints->hasNull());
+    EXPECT_FALSE(ints->hasNull(2, 2));
+    EXPECT_FALSE(ints->isSorted(true));
+
+    VectorSP dates = Util::createVector(DT_DATE, 3);
+    dates->setInt(0, 100);
+    dates->setInt(1, 200);
+    dates->setInt(2, 150);
+    stats = dates->stats();
+    EXPECT_EQ(stats.max->getType(), DT_DATE);
+    EXPECT_EQ(stats.max->getString(), Util::createDate(1970, 7, 20)->getString());
+
+    VectorSP empty = Util::createVector(DT_DOUBLE, 2);
+    empty->setNull(0);
+    empty->setNull(1);
+    stats = empty->stats();
+    EXPECT_EQ(stats.count, 0);
+    EXPECT_TRUE(stats.min->isNull());
+    EXPECT_TRUE(stats.max->isNull());
+    EXPECT_EQ(stats.avg, DBL_NMIN);
+
+    VectorSP decimals = Util::createVector(DT_DECIMAL64, 0, 3, true, 2);
+    decimals->append(Util::createDecimal64(2, 1.25));
+    decimals->append(Util::createDecimal64(2, 2.5));
+    stats = decimals->stats();
+    EXPECT_DOUBLE_EQ(stats.sum, 3.75);
+    EXPECT_EQ(stats.max->getString(), "2.50");
+
+    VectorSP symbols = Util::createVector(DT_SYMBOL, 1);
+    EXPECT_ANY_THROW(symbols->stats());
+    EXPECT_ANY_THROW(Util::createVector(DT_STRING, 1)->stats());
+}
+
+static long long floorDivRef(long long a, long long b) {
+    long long q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+TEST_F(FunctionTest, TemporalKernels_divisor){
+    std::mt19937_64 rng(11);
+    unsigned long long divisors[] = {1, 2, 3, 7, 24, 60, 1000, 3600, 86400, 1000000, 86400000, 3600000000000ULL, 86400000000000ULL, 0x8000000000000001ULL};
+    for (unsigned long long d : divisors) {
+        kernels::Divisor divisor(d);
+        for (int i = 0; i < 2000; ++i) {
+            unsigned long long n = i < 10 ? (unsigned long long)i : rng();
+            ASSERT_EQ(divisor.divide(n), n / d) << n << " / " << d;
+            if (d <= (unsigned long long)LLONG_MAX) {
+                long long x = (long long)rng() >> (i % 40);
+                ASSERT_EQ(divisor.floorDivide(x), floorDivRef(x, (long long)d)) << x << " / " << d;
+                ASSERT_EQ(divisor.floorDivide(-x), floorDivRef(-x, (long long)d)) << -x << " / " << d;
+                long long mod = divisor.floorMod(-x);
+                ASSERT_TRUE(mod >= 0 && (unsigned long long)mod < d);
+            }
+        }
+        ASSERT_EQ(divisor.divide(ULLONG_MAX), ULLONG_MAX / d);
+    }
+    EXPECT_ANY_THROW(kernels::Divisor(0));
+
+    //Util::parseDate is exact from year 1 on.
+    for (int days = -719162; days <= 800000; days += 7) {
+        int year, month, day;
+        Util::parseDate(days, year, month, day);
+        ASSERT_EQ(kernels::civilMonth(days), year * 12 + month - 1) << days;
+    }
+}
+
+TEST_F(FunctionTest, TemporalKernels_castTemporal){
+    //Nanoseconds per unit; 0 marks time-of-day types by a negative sign.
+    std::map<DATA_TYPE, long long> units = {{DT_DATE, 86400000000000LL}, {DT_DATEHOUR, 3600000000000LL}, {DT_DATETIME, 1000000000LL},
+        {DT_TIMESTAMP, 1000000LL}, {DT_NANOTIMESTAMP, 1}, {DT_MINUTE, -60000000000LL}, {DT_SECOND, -1000000000LL}, {DT_TIME, -1000000LL}, {DT_NANOTIME, -1}};
+    DATA_TYPE types[] = {DT_DATE, DT_DATEHOUR, DT_DATETIME, DT_TIMESTAMP, DT_NANOTIMESTAMP, DT_MINUTE, DT_SECOND, DT_TIME, DT_NANOTIME, DT_MONTH};
+    std::mt19937_64 rng(5);
+    const int rows = 1000;
+    for (DATA_TYPE from : types) {
+        if (from == DT_MONTH)
+            continue;
+        long long fromUnit = units[from];
+        bool fromTimeOfDay = fromUnit < 0;
+        fromUnit = std::abs(fromUnit);
+        bool isLong = Util::getDataTypeSize(from) == 8;
+        VectorSP src = Util::createVector(from, rows);
+        long long range = fromTimeOfDay ? 86400000000000LL / fromUnit : (4000000000000000000LL / fromUnit);
+        if (!isLong && range > INT_MAX)
+            range = INT_MAX;
+        std::vector<long long> values(rows);
+        for (int i = 0; i < rows; ++i) {
+            long long v = (long long)(rng() % (unsigned long long)range);
+            if (!fromTimeOfDay && i % 2)
+                v = -v;
+            values[i] = v;
+            if (isLong)
+                src->setLong(i, v);
+            else
+                src->setInt(i, (int)v);
+        }
+        src->setNull(3);
+        for (DATA_TYPE to : types) {
+            bool supported = from == to || (fromTimeOfDay ? (to != DT_MONTH && units[to] < 0) : (to == DT_MONTH || !(from == DT_DATE && units[to] < 0)));
+            if (!supported) {
+                EXPECT_ANY_THROW(src->castTemporal(to)) << Util::getDataTypeString(from) << " -> " << Util::getDataTypeString(to);
+                continue;
+            }
+            VectorSP res = src->castTemporal(to);
+            ASSERT_EQ(res->getType(), to);
+            ASSERT_EQ(res->size(), rows);
+            EXPECT_TRUE(res->isNull(3));
+            for (int i = 0; i < rows; ++i) {
+                if (i == 3)
+                    continue;
+                long long v = values[i], expected;
+                if (to == DT_MONTH) {
+                    int year, month, day;
+                    Util::parseDate((int)floorDivRef(v, 86400000000000LL / fromUnit), year, month, day);
+                    expected = year * 12 + month - 1;
+                } else {
+                    long long toUnit = std::abs(units[to]);
+                    if (!fromTimeOfDay && units[to] < 0) {
+                        long long perDay = 86400000000000LL / fromUnit;
+                        v = v - floorDivRef(v, perDay) * perDay;
+                    }
+                    expected = fromUnit >= toUnit ? v * (fromUnit / toUnit) : floorDivRef(v, toUnit / fromUnit);
+                }
+                long long actual = Util::getDataTypeSize(to) == 8 ? res->getLong(i) : res->getInt(i);
+                if (Util::getDataTypeSize(to) == 4)
+                    expected = (int)expected;
+                ASSERT_EQ(actual, expected) << Util::getDataTypeString(from) << " " << values[i] << " -> " << Util::getDataTypeString(to);
+            }
+        }
+    }
+
+    VectorSP timestamps = Util::createVector(DT_TIMESTAMP, 2);
+    timestamps->setLong(0, -1);
+    timestamps->setLong(1, 86400000LL * 31);
+    VectorSP dates = timestamps->castTemporal(DT_DATE);
+    EXPECT_EQ(dates->getString(0), "1969.12.31");
+    EXPECT_EQ(timestamps->castTemporal(DT_MONTH)->getString(0), "1969.12M");
+    EXPECT_EQ(timestamps->castTemporal(DT_DATEHOUR)->getInt(0), -1);
+
+    //Same width: the buffer moves to the result and the source is left empty.
+    const long long* buffer = (const long long*)timestamps->getDataArray();
+    VectorSP nanos = timestamps->castTemporalInPlace(DT_NANOTIMESTAMP);
+    EXPECT_EQ(nanos->getType(), DT_NANOTIMESTAMP);
+    EXPECT_EQ((const long long*)nanos->getDataArray(), buffer);
+    EXPECT_EQ(nanos->getLong(0), -1000000LL);
+    EXPECT_EQ(nanos->getLong(1), 86400000000000LL * 31);
+    EXPECT_EQ(timestamps->size(), 0);
+    //Different width: a new vector, the source is untouched.
+    VectorSP datetimes = nanos->castTemporalInPlace(DT_DATETIME);
+    EXPECT_EQ(datetimes->getInt(1), 86400 * 31);
+    EXPECT_EQ(nanos->size(), 2);
+}
+
+TEST_F(FunctionTest, TemporalKernels_toLocalTime){
+    const char* oldTz = getenv("TZ");
+    std::string savedTz = oldTz ? oldTz : "";
+    setenv("TZ", "America/New_York", 1);
+    tzset();
+    //Half-hour steps across the 2023 spring-forward and fall-back transitions, plus nulls.
+    std::vector<long long> millis;
+    for (long long t = 1678600000LL; t < 1678600000LL + 86400 * 2; t += 1799)
+        millis.push_back(t * 1000 + 123);
+    for (long long t = 1699160000LL; t < 1699160000LL + 86400 * 2; t += 1801)
+        millis.push_back(-(t * 1000) + 7);
+    millis.push_back(LLONG_MIN);
+    std::vector<long long> converted(millis);
+    Util::toLocalTimestamp(converted.data(), (int)converted.size());
+    std::vector<int> seconds, convertedSeconds;
+    for (size_t i = 0; i < millis.size(); ++i) {
+        EXPECT_EQ(converted[i], millis[i] == LLONG_MIN ? LLONG_MIN : Util::toLocalTimestamp(millis[i])) << millis[i];
+        seconds.push_back(millis[i] == LLONG_MIN ? INT_MIN : (int)(millis[i] / 1000));
+    }
+    convertedSeconds = seconds;
+    Util::toLocalDateTime(convertedSeconds.data(), (int)convertedSeconds.size());
+    for (size_t i = 0; i < seconds.size(); ++i)
+        EXPECT_EQ(convertedSeconds[i], seconds[i] == INT_MIN ? INT_MIN : Util::toLocalDateTime(seconds[i])) << seconds[i];
+    if (oldTz)
+        setenv("TZ", savedTz.c_str(), 1);
+    else
+        unsetenv("TZ");
+    tzset();
+}
+
+TEST_F(FunctionTest, TextTableReader){
+    std::string path = "TextTableReader_test.csv";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "\xEF\xBB\xBF" << "sym,id,price,qty,flag,date,ts,tm,note,month,nts\r\n";
+        out << "A,1,10.5,100,true,2024.01.31,2024.01.31 09:30:00.123,09:30:00.5,plain,2024.01,2024-01-31T09:30:00.123456789\r\n";
+        out << "\r\n";
+        out << "B,-2,1e3,,0,2024-02-29,2024-02-29 23:59:59,23:59:59.999,\"with, comma\",2024.02M,20240229\n";
+        out << "C,abc,-0.25,-7,false,20240301,1969.12.31 23:59:59.999,00:00,\"say \"\"hi\"\"\",202403,2024.03.01 00:00:00.000001\n";
+        out << "\n";
+        out << "D,2147483648,12345678901234567890,5,x,2023.02.29,bad,24:00:00,,2024.13\n";
+        out << "E,7";
+    }
+    std::vector<std::string> names = {"sym", "id", "price", "qty", "flag", "date", "ts", "tm", "note", "month", "nts"};
+    std::vector<DATA_TYPE> types = {DT_SYMBOL, DT_INT, DT_DOUBLE, DT_LONG, DT_BOOL, DT_DATE, DT_TIMESTAMP, DT_TIME, DT_STRING, DT_MONTH, DT_NANOTIMESTAMP};
+    TextReaderOptions options;
+    options.workerCount = 1;
+    TextTableReader reader(path, names, types, options);
+    TableSP t = reader.read();
+    ASSERT_FALSE(reader.hasNext());
+    ASSERT_EQ(5, t->rows());
+    ASSERT_EQ(11, t->columns());
+    ASSERT_EQ(DT_SYMBOL, t->getColumnType(0));
+    ASSERT_EQ(DT_TIMESTAMP, t->getColumnType(6));
+    ASSERT_EQ("A", t->getColumn(0)->getString(0));
+    ASSERT_EQ("E", t->getColumn(0)->getString(4));
+    ASSERT_EQ(1, t->getColumn(1)->getInt(0));
+    ASSERT_EQ(-2, t->getColumn(1)->getInt(1));
+    ASSERT_TRUE(t->getColumn(1)->isNull(2));
+    ASSERT_TRUE(t->getColumn(1)->isNull(3));
+    ASSERT_EQ(7, t->getColumn(1)->getInt(4));
+    ASSERT_EQ(10.5, t->getColumn(2)->getDouble(0));
+    ASSERT_EQ(1000.0, t->getColumn(2)->getDouble(1));
+    ASSERT_EQ(-0.25, t->getColumn(2)->getDouble(2));
+    ASSERT_EQ(12345678901234567890.0, t->getColumn(2)->getDouble(3));
+    ASSERT_TRUE(t->getColumn(2)->isNull(4));
+    ASSERT_EQ(100, t->getColumn(3)->getLong(0));
+    ASSERT_TRUE(t->getColumn(3)->isNull(1));
+    ASSERT_EQ(-7, t->getColumn(3)->getLong(2));
+    ASSERT_EQ("[1,0,0,,]", t->getColumn(4)->getString());
+    ASSERT_EQ("[2024.01.31,2024.02.29,2024.03.01,,]", t->getColumn(5)->getString());
+    ASSERT_EQ("[2024.01.31T09:30:00.123,2024.02.29T23:59:59.000,1969.12.31T23:59:59.999,,]", t->getColumn(6)->getString());
+    ASSERT_EQ("[09:30:00.500,23:59:59.999,00:00:00.000,,]", t->getColumn(7)->getString());
+    ASSERT_EQ("plain", t->getColumn(8)->getString(0));
+    ASSERT_EQ("with, comma", t->getColumn(8)->getString(1));
+    ASSERT_EQ("say \"hi\"", t->getColumn(8)->getString(2));
+    ASSERT_TRUE(t->getColumn(8)->isNull(3));
+    ASSERT_TRUE(t->getColumn(8)->isNull(4));
+    ASSERT_EQ("[2024.01M,2024.02M,2024.03M,,]", t->getColumn(9)->getString());
+    ASSERT_EQ("[2024.01.31T09:30:00.123456789,2024.02.29T00:00:00.000000000,2024.03.01T00:00:00.000001000,,]", t->getColumn(10)->getString());
+    for(int i = 0; i < t->columns(); ++i)
+        ASSERT_EQ(i != 0, ((Vector*)t->getColumn(i).get())->hasNull()) << i;
+
+    //Batches and several workers give the same rows.
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "id,ts,sym,v\n";
+        for(int i = 0; i < 200000; ++i)
+            out << i << ",2024.01.02 09:30:" << (i % 60 < 10 ? "0" : "") << i % 60 << "." << 100 + i % 900 << ",S" << i % 37 << "," << i * 0.5 << "\n";
+    }
+    std::vector<std::string> names2 = {"id", "ts", "sym", "v"};
+    std::vector<DATA_TYPE> types2 = {DT_INT, DT_TIMESTAMP, DT_STRING, DT_DOUBLE};
+    options.workerCount = 4;
+    options.batchBytes = 1 << 20;
+    TextTableReader batches(path, names2, types2, options);
+    INDEX rows = 0;
+    int batchCount = 0;
+    for(TableSP batch = batches.next(); !batch.isNull(); batch = batches.next()){
+        ++batchCount;
+        for(INDEX i = 0; i < batch->rows(); ++i, ++rows){
+            ASSERT_EQ(rows, batch->getColumn(0)->getInt(i));
+            ASSERT_EQ(Util::countDays(2024, 1, 2) * 86400000LL + (9 * 3600 + 30 * 60 + rows % 60) * 1000LL + 100 + rows % 900, batch->getColumn(1)->getLong(i));
+            ASSERT_EQ("S" + std::to_string(rows % 37), batch->getColumn(2)->getString(i));
+            ASSERT_EQ(rows * 0.5, batch->getColumn(3)->getDouble(i));
+        }
+    }
+    ASSERT_EQ(200000, rows);
+    ASSERT_GT(batchCount, 1);
+    options.batchBytes = 64LL << 20;
+    options.workerCount = 3;
+    types2[2] = DT_SYMBOL;
+    TableSP whole = TextTableReader(path, names2, types2, options).read();
+    ASSERT_EQ(200000, whole->rows());
+    ASSERT_EQ(DT_SYMBOL, whole->getColumnType(2));
+    ASSERT_EQ(38, (int)whole->getColumn(2)->getSymbolBase()->size());
+    for(INDEX i = 0; i < whole->rows(); ++i){
+        ASSERT_EQ(i, whole->getColumn(0)->getInt(i));
+        ASSERT_EQ("S" + std::to_string(i % 37), whole->getColumn(2)->getString(i));
+    }
+    std::remove(path.c_str());
+
+    ASSERT_ANY_THROW(TextTableReader("TextTableReader_missing.csv", names2, types2));
+    std::vector<DATA_TYPE> badTypes = {DT_INT, DT_ANY, DT_STRING, DT_DOUBLE};
+    ASSERT_ANY_THROW(TextTableReader(path, names2, badTypes));
+}
+
+TEST_F(FunctionTest, TextTableWriter){
+    std::vector<std::string> names = {"b", "c", "s", "i", "l", "f", "d", "date", "month", "time", "minute", "second", "datetime",
+                                      "timestamp", "nanotime", "nanotimestamp", "datehour", "sym", "str", "uuid"};
+    std::vector<DATA_TYPE> types = {DT_BOOL, DT_CHAR, DT_SHORT, DT_INT, DT_LONG, DT_FLOAT, DT_DOUBLE, DT_DATE, DT_MONTH, DT_TIME, DT_MINUTE,
+                                    DT_SECOND, DT_DATETIME, DT_TIMESTAMP, DT_NANOTIME, DT_NANOTIMESTAMP, DT_DATEHOUR, DT_SYMBOL, DT_STRING, DT_UUID};
+    const int rows = 3000;
+    std::vector<ConstantSP> cols;
+    for(DATA_TYPE type : types)
+        cols.push_back(Util::createVector(type, rows, rows));
+    for(int i = 0; i < rows; ++i){
+        bool null = i % 7 == 3;
+        VectorSP b = cols[0], c = cols[1], s = cols[2], n = cols[3], l = cols[4], f = cols[5], d = cols[6];
+        null ? b->setNull(i) : b->setBool(i, i % 2 == 0);
+        null ? c->setNull(i) : c->setChar(i, (char)(i % 2 ? ',' : i % 120));
+        null ? s->setNull(i) : s->setShort(i, (short)(i * 37 - 30000));
+        null ? n->setNull(i) : n->setInt(i, i % 5 == 0 ? INT_MAX - i : -i * 1234567);
+        null ? l->setNull(i) : l->setLong(i, i % 5 == 0 ? LLONG_MIN + 1 + i : i * 1234567890123LL);
+        null ? f->setNull(i) : f->setFloat(i, i % 11 == 0 ? 1.5e-7f * i : i * 0.25f - 100);
+        null ? d->setNull(i) : d->setDouble(i, i % 13 == 0 ? 1e8 * i : i % 13 == 1 ? -0.1 / (i + 1) : i * 0.001 - 1);
+        for(int k = 7; k <= 16; ++k){
+            VectorSP v = cols[k];
+            if(null)
+                v->setNull(i);
+            else if(v->getRawType() == DT_LONG)
+                v->setLong(i, 86399999LL * 1000000 / rows * i);
+            else
+                v->setInt(i, types[k] == DT_MINUTE ? i % 1500 : types[k] == DT_SECOND ? i * 29 : i * 10007);
+        }
+        if(i == 1)
+            ((VectorSP)cols[15])->setLong(i, 1e12 * 86400 * 100);
+        ((VectorSP)cols[17])->setString(i, null ? "" : "S" + std::to_string(i % 10) + (i % 10 == 4 ? ",x" : ""));
+        ((VectorSP)cols[18])->setString(i, null ? "" : i % 4 == 0 ? "say \"hi\"" : i % 4 == 1 ? "line\nbreak" : "plain " + std::to_string(i));
+        if(null)
+            ((VectorSP)cols[19])->setNull(i);
+        else
+            ((VectorSP)cols[19])->set(i, Util::parseConstant(DT_UUID, "5d212a78-cc48-e3b1-4235-b4d91473ee8" + std::to_string(i % 10)));
+    }
+    TableSP table = Util::createTable(names, cols);
+
+    //Expected text: getString of every cell, quoted like a CSV field when needed.
+    auto quote = [](const std::string& cell){
+        if(cell.find_first_of(",\"\r\n") == std::string::npos)
+            return cell;
+        std::string s = "\"";
+        for(char c : cell){
+            if(c == '"')
+                s += '"';
+            s += c;
+        }
+        return s + "\"";
+    };
+    std::string header, body;
+    for(size_t c = 0; c < names.size(); ++c)
+        header += names[c] + (c + 1 == names.size() ? "\n" : ",");
+    for(int i = 0; i < rows; ++i){
+        for(int c = 0; c < table->columns(); ++c)
+            body += quote(table->getColumn(c)->getString(i)) + (c + 1 == table->columns() ? "\n" : ",");
+    }
+    auto readFile = [](const std::string& path){
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    };
+
+    std::string path = "TextTableWriter_test.csv";
+    {
+        TextTableWriter writer(path);
+        writer.write(table);
+        writer.write(table);
+        writer.flush();
+        ASSERT_EQ(2 * rows, writer.getRowsWritten());
+    }
+    std::string text = readFile(path);
+    ASSERT_EQ(header.size() + 2 * body.size(), text.size());
+    ASSERT_EQ(header + body + body, text);
+
+    //Chunks formatted by several workers land in row order; no header.
+    TextWriterOptions options;
+    options.workerCount = 3;
+    options.chunkRows = 700;
+    options.header = false;
+    {
+        TextTableWriter writer(path, options);
+        writer.write(table);
+    }
+    ASSERT_EQ(body, readFile(path));
+
+    //The text reads back into the same values.
+    std::vector<std::string> names2 = {"i", "l", "d", "date", "timestamp", "minute", "sym", "str"};
+    std::vector<DATA_TYPE> types2 = {DT_INT, DT_LONG, DT_DOUBLE, DT_DATE, DT_TIMESTAMP, DT_MINUTE, DT_SYMBOL, DT_STRING};
+    std::vector<ConstantSP> cols2 = {cols[3], cols[4], cols[6], cols[7], cols[13], cols[10], cols[17], cols[18]};
+    for(ConstantSP& col : cols2)
+        col = col->getValue();
+    //Line breaks inside quotes don't read back: the reader splits at every '\n'.
+    for(int i = 0; i < rows; ++i){
+        if(i % 4 == 1)
+            ((VectorSP)cols2[7])->setString(i, "no break");
+    }
+    TableSP table2 = Util::createTable(names2, cols2);
+    {
+        TextTableWriter writer(path);
+        writer.write(table2);
+    }
+    TableSP back = TextTableReader(path, names2, types2).read();
+    ASSERT_EQ(rows, back->rows());
+    for(int c = 0; c < back->columns(); ++c){
+        for(int i = 0; i < rows; ++i)
+            ASSERT_EQ(table2->getColumn(c)->getString(i), back->getColumn(c)->getString(i)) << names2[c] << " " << i;
+    }
+
+    {
+        TextTableWriter writer(path);
+        writer.write(table);
+        ASSERT_ANY_THROW(writer.write(table2));
+    }
+    std::remove(path.c_str());
+    ASSERT_ANY_THROW(TextTableWriter("no_such_dir/TextTableWriter_test.csv"));
+}
+
+TEST_F(FunctionTest, ColumnarFile){
+    std::vector<std::string> names = {"id", "flag", "price", "date", "ts", "sym", "note", "uid", "amount", "qty"};
+    std::vector<DATA_TYPE> types = {DT_INT, DT_BOOL, DT_DOUBLE, DT_DATE, DT_TIMESTAMP, DT_SYMBOL, DT_STRING, DT_UUID, DT_DECIMAL32, DT_LONG};
+    const int rows = 100000;
+    TableSP table = Util::createTable(names, types, rows, rows, {0, 0, 0, 0, 0, 0, 0, 0, 2, 0});
+    for(int i = 0; i < rows; ++i){
+        VectorSP id = table->getColumn(0), flag = table->getColumn(1), price = table->getColumn(2), date = table->getColumn(3), ts = table->getColumn(4);
+        id->setInt(i, i);
+        i % 10 == 3 ? flag->setNull(i) : flag->setBool(i, i % 2 == 0);
+        i % 11 == 5 ? price->setNull(i) : price->setDouble(i, i * 0.25);
+        date->setInt(i, 19000 + i / 1000);
+        ts->setLong(i, 1704187800000LL + i * 13LL);
+        ((VectorSP)table->getColumn(5))->setString(i, "S" + std::to_string(i % 17));
+        ((VectorSP)table->getColumn(6))->setString(i, i % 9 == 0 ? "" : "note " + std::to_string(i));
+        ((VectorSP)table->getColumn(7))->set(i, Util::parseConstant(DT_UUID, "5d212a78-cc48-e3b1-4235-b4d91473ee8" + std::to_string(i % 10)));
+        ((VectorSP)table->getColumn(8))->set(i, Util::createDecimal32(2, i * 0.01));
+        ((VectorSP)table->getColumn(9))->setLong(i, (long long)i * i);
+    }
+    std::string path = "ColumnarFile_test.ddbcol";
+    ColumnarFile::write(path, table, {COMPRESS_NONE, COMPRESS_NONE, COMPRESS_NONE, COMPRESS_NONE, COMPRESS_DELTA, COMPRESS_NONE,
+                                      COMPRESS_LZ4, COMPRESS_NONE, COMPRESS_LZ4, COMPRESS_NONE}, 3);
+    {
+        ColumnarFile file(path);
+        ASSERT_EQ(rows, file.rows());
+        ASSERT_EQ(10, file.columns());
+        ASSERT_EQ("ts", file.getColumnName(4));
+        ASSERT_EQ(DT_DECIMAL32, file.getColumnType(8));
+        ASSERT_EQ(COMPRESS_DELTA, file.getColumnCompressMethod(4));
+        ASSERT_EQ(6, file.getColumnIndex("note"));
+        ASSERT_EQ(-1, file.getColumnIndex("missing"));
+
+        //Columns load one at a time, and the same vector is returned again.
+        VectorSP price = file.getColumn("price");
+        ASSERT_EQ(price.get(), file.getColumn(2).get());
+        ASSERT_EQ(DT_DOUBLE, price->getType());
+        ASSERT_TRUE(price->hasNull());
+        ASSERT_EQ(table->getColumn(2)->getString(), price->getString());
+
+        TableSP loaded = file.getTable();
+        ASSERT_EQ(rows, loaded->rows());
+        for(int c = 0; c < loaded->columns(); ++c){
+            ASSERT_EQ(names[c], loaded->getColumnName(c));
+            ASSERT_EQ(types[c], loaded->getColumnType(c)) << names[c];
+            ASSERT_EQ(table->getColumn(c)->getString(), loaded->getColumn(c)->getString()) << names[c];
+        }
+        ASSERT_EQ(2, loaded->getColumn(8)->getExtraParamForType());
+        ASSERT_FALSE(((Vector*)loaded->getColumn(0).get())->hasNull());
+
+        TableSP part = file.getTable({"qty", "id"});
+        ASSERT_EQ("qty", part->getColumnName(0));
+        ASSERT_EQ((long long)rows * rows - 2 * rows + 1, part->getColumn(0)->getLong(rows - 1));
+
+        //Vectors over the mapping can be changed and grown without touching the file.
+        VectorSP id = file.getColumn(0);
+        id->setInt(0, -1);
+        for(int i = 0; i < 1000; ++i)
+            id->append(Util::createInt(rows + i));
+        ASSERT_EQ(rows + 1000, id->size());
+        ASSERT_EQ(-1, id->getInt(0));
+        ASSERT_EQ(rows + 999, id->getInt(rows + 999));
+        ColumnarFile again(path);
+        ASSERT_EQ(0, again.getColumn(0)->getInt(0));
+        ASSERT_EQ(rows, again.getColumn(0)->size());
+
+        //Rewriting the file leaves vectors of the old mapping intact.
+        ColumnarFile::write(path, part);
+        ASSERT_EQ(table->getColumn(3)->getString(), loaded->getColumn(3)->getString());
+    }
+    ColumnarFile rewritten(path);
+    ASSERT_EQ(2, rewritten.columns());
+
+    //The table's own compress methods apply by default.
+    table->setColumnCompressMethods(std::vector<COMPRESS_METHOD>(10, COMPRESS_LZ4));
+    ColumnarFile::write(path, table);
+    ColumnarFile compressed(path);
+    for(int c = 0; c < compressed.columns(); ++c){
+        ASSERT_EQ(COMPRESS_LZ4, compressed.getColumnCompressMethod(c));
+        ASSERT_EQ(table->getColumn(c)->getString(), compressed.getColumn(c)->getString()) << names[c];
+    }
+
+    ASSERT_ANY_THROW(ColumnarFile::write(path, table, {COMPRESS_DELTA}));
+    ASSERT_ANY_THROW(ColumnarFile::write(path, table, std::vector<COMPRESS_METHOD>(10, COMPRESS_DELTA)));
+    ASSERT_ANY_THROW(compressed.getColumn("missing"));
+    ASSERT_ANY_THROW(compressed.getColumn(10));
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a columnar file, just some text";
+    }
+    ASSERT_ANY_THROW(ColumnarFile file(path));
+    std::remove(path.c_str());
+    ASSERT_ANY_THROW(ColumnarFile file(path));
+}
+
+TEST_F(FunctionTest, ArrowInterop){
+    std::vector<std::string> names = {"b", "c", "s", "i", "l", "f", "d", "date", "month", "time", "minute", "second", "datetime",
+                                      "ts", "nt", "nts", "dh", "d32", "d64", "d128", "str", "blob", "sym"};
+    std::vector<DATA_TYPE> types = {DT_BOOL, DT_CHAR, DT_SHORT, DT_INT, DT_LONG, DT_FLOAT, DT_DOUBLE, DT_DATE, DT_MONTH, DT_TIME,
+                                    DT_MINUTE, DT_SECOND, DT_DATETIME, DT_TIMESTAMP, DT_NANOTIME, DT_NANOTIMESTAMP, DT_DATEHOUR,
+                                    DT_DECIMAL32, DT_DECIMAL64, DT_DECIMAL128, DT_STRING, DT_BLOB, DT_SYMBOL};
+    std::vector<int> extras(types.size(), 0);
+    extras[17] = 2;
+    extras[18] = 4;
+    extras[19] = 6;
+    const int rows = 3000;
+    TableSP table = Util::createTable(names, types, 0, rows, extras);
+    for(int i = 0; i < rows; ++i){
+        std::vector<ConstantSP> row = {Util::createBool(i % 2 == 0), Util::createChar(i % 100), Util::createShort(i), Util::createInt(i * 7),
+            Util::createLong(i * 1000000007LL), Util::createFloat(i * 0.5f), Util::createDouble(i * 0.125), Util::createDate(19000 + i),
+            Util::createMonth(24000 + i), Util::createTime(i * 1000), Util::createMinute(i % 1440), Util::createSecond(i % 86400),
+            Util::createDateTime(1700000000 + i), Util::createTimestamp(1704187800000LL + i), Util::createNanoTime(i * 1000000007LL),
+            Util::createNanoTimestamp(1704187800000000000LL + i), Util::createDateHour(470000 + i), Util::createDecimal32(2, i * 0.01),
+            Util::createDecimal64(4, i * 0.0001), Util::createDecimal128(6, i * 0.5), Util::createString("s" + std::to_string(i)),
+            Util::createBlob("b" + std::to_string(i % 10)), Util::createString("S" + std::to_string(i % 17))};
+        ConstantSP cols = Util::createVector(DT_ANY, (INDEX)row.size());
+        for(size_t c = 0; c < row.size(); ++c){
+            if(i % 13 == 4)
+                row[c]->setNull();
+            cols->set((INDEX)c, row[c]);
+        }
+        INDEX inserted;
+        std::string errMsg;
+        std::vector<ConstantSP> values;
+        for(size_t c = 0; c < row.size(); ++c){
+            ConstantSP col = Util::createVector(types[c], 0, 1, true, extras[c]);
+            ((Vector*)col.get())->append(row[c]);
+            values.push_back(col);
+        }
+        ASSERT_TRUE(table->append(values, inserted, errMsg)) << errMsg;
+    }
+
+    ArrowSchema schema;
+    ArrowArray array;
+    exportToArrow(table, &schema, &array);
+    ASSERT_STREQ("+s", schema.format);
+    ASSERT_EQ((int64_t)names.size(), schema.n_children);
+    ASSERT_EQ(rows, array.length);
+    std::vector<std::string> formats = {"b", "c", "s", "i", "l", "f", "g", "tdD", "tdD", "ttm", "tts", "tts", "tss:", "tsm:", "ttn",
+                                        "tsn:", "tss:", "d:9,2", "d:18,4", "d:38,6", "u", "z", "i"};
+    int nulls = (rows + 8) / 13;
+    for(size_t c = 0; c < names.size(); ++c){
+        ASSERT_EQ(formats[c], schema.children[c]->format) << names[c];
+        ASSERT_EQ(names[c], schema.children[c]->name);
+        ASSERT_EQ(nulls, array.children[c]->null_count) << names[c];
+        const unsigned char* valid = (const unsigned char*)array.children[c]->buffers[0];
+        ASSERT_FALSE(valid[0] & (1 << 4));
+        ASSERT_TRUE(valid[0] & (1 << 5));
+    }
+    //Fixed-width columns share the vector's buffer.
+    for(int c : {1, 2, 3, 4, 5, 6, 7, 9, 11, 13, 14, 15, 19, 22})
+        ASSERT_EQ(((VectorSP)table->getColumn(c))->getDataArray(), array.children[c]->buffers[1]) << names[c];
+    ASSERT_NE(nullptr, schema.children[22]->dictionary);
+    ASSERT_STREQ("u", schema.children[22]->dictionary->format);
+    ASSERT_EQ(((int*)array.children[3]->buffers[1])[10], 70);
+    ASSERT_EQ(((long long*)array.children[16]->buffers[1])[5], (470000 + 5) * 3600LL);
+    ASSERT_EQ(((int*)array.children[10]->buffers[1])[5], 300);
+    const int* offsets = (const int*)array.children[20]->buffers[1];
+    ASSERT_EQ("s11", std::string((const char*)array.children[20]->buffers[2] + offsets[11], offsets[12] - offsets[11]));
+
+    //The export stays valid after the table is gone, until released.
+    VectorSP ints = table->getColumn(3);
+    table = TableSP();
+    TableSP imported = importFromArrow(&schema, &array);
+    ASSERT_EQ(nullptr, array.release);
+    ASSERT_EQ(nullptr, schema.release);
+    ASSERT_EQ(rows, imported->rows());
+    std::vector<DATA_TYPE> importedTypes = {DT_BOOL, DT_CHAR, DT_SHORT, DT_INT, DT_LONG, DT_FLOAT, DT_DOUBLE, DT_DATE, DT_DATE, DT_TIME,
+                                            DT_SECOND, DT_SECOND, DT_DATETIME, DT_TIMESTAMP, DT_NANOTIME, DT_NANOTIMESTAMP, DT_DATETIME,
+                                            DT_DECIMAL128, DT_DECIMAL128, DT_DECIMAL128, DT_STRING, DT_BLOB, DT_SYMBOL};
+    for(size_t c = 0; c < names.size(); ++c){
+        ASSERT_EQ(names[c], imported->getColumnName((int)c));
+        ASSERT_EQ(importedTypes[c], imported->getColumnType((int)c)) << names[c];
+        ConstantSP col = imported->getColumn((int)c);
+        ASSERT_TRUE(col->isNull(4)) << names[c];
+        ASSERT_TRUE(col->isNull(rows - 6)) << names[c];
+    }
+    ASSERT_EQ(ints->getString(), imported->getColumn(3)->getString());
+    ASSERT_EQ("S5", imported->getColumn(22)->getString(5));
+    ASSERT_EQ("s11", imported->getColumn(20)->getString(11));
+    ASSERT_EQ("b7", imported->getColumn(21)->getString(7));
+    ASSERT_EQ(19001, imported->getColumn(7)->getInt(1));
+    ASSERT_EQ("2000.02.01", imported->getColumn(8)->getString(1));
+    ASSERT_EQ("00:05:00", imported->getColumn(10)->getString(5));
+    ASSERT_EQ(470005 * 3600LL, imported->getColumn(16)->getLong(5));
+    ASSERT_EQ("0.05", imported->getColumn(17)->getString(5));
+    ASSERT_EQ("2.500000", imported->getColumn(19)->getString(5));
+    ASSERT_TRUE(imported->getColumn(0)->getBool(2));
+    ASSERT_FALSE(imported->getColumn(0)->getBool(3));
+
+    //A producer's array without nulls is wrapped, not copied, and released with the last vector.
+    static bool released;
+    released = false;
+    static long long values[] = {1, 2, 3, 4, 5, 6};
+    static const void* buffers[] = {nullptr, values};
+    ArrowArray longs;
+    memset(&longs, 0, sizeof(longs));
+    longs.length = 4;
+    longs.offset = 2;
+    longs.n_buffers = 2;
+    longs.buffers = buffers;
+    longs.release = [](ArrowArray* a){ released = true; a->release = nullptr; };
+    ArrowSchema longSchema;
+    memset(&longSchema, 0, sizeof(longSchema));
+    longSchema.format = "l";
+    longSchema.release = [](ArrowSchema* s){ s->release = nullptr; };
+    {
+        VectorSP vec = importFromArrow(&longSchema, &longs);
+        ASSERT_EQ(nullptr, longSchema.release);
+        ASSERT_EQ(DT_LONG, vec->getType());
+        ASSERT_EQ(4, vec->size());
+        ASSERT_EQ((void*)(values + 2), vec->getDataArray());
+        ASSERT_EQ("[3,4,5,6]", vec->getString());
+        ASSERT_FALSE(released);
+    }
+    ASSERT_TRUE(released);
+
+    //Dictionary-encoded strings with narrow indices become a symbol vector.
+    static int dictOffsets[] = {0, 3, 7, 12};
+    static const char dictBytes[] = "ibmmsftgoogl";
+    static const void* dictBuffers[] = {nullptr, dictOffsets, dictBytes};
+    static char indices[] = {2, 0, 1, 2, 0};
+    static unsigned char validity[] = {0x1d};
+    static const void* indexBuffers[] = {validity, indices};
+    ArrowArray dict, coded;
+    memset(&dict, 0, sizeof(dict));
+    memset(&coded, 0, sizeof(coded));
+    dict.length = 3;
+    dict.n_buffers = 3;
+    dict.buffers = dictBuffers;
+    coded.length = 5;
+    coded.null_count = -1;
+    coded.n_buffers = 2;
+    coded.buffers = indexBuffers;
+    coded.dictionary = &dict;
+    coded.release = [](ArrowArray* a){ a->release = nullptr; };
+    ArrowSchema dictSchema, codedSchema;
+    memset(&dictSchema, 0, sizeof(dictSchema));
+    memset(&codedSchema, 0, sizeof(codedSchema));
+    dictSchema.format = "u";
+    codedSchema.format = "c";
+    codedSchema.dictionary = &dictSchema;
+    VectorSP syms = importFromArrow(&codedSchema, &coded);
+    ASSERT_EQ(DT_SYMBOL, syms->getType());
+    ASSERT_EQ("[\"googl\",,\"msft\",\"googl\",\"ibm\"]", syms->getString());
+
+    //Unsupported types throw, and the inputs are still released.
+    VectorSP uuids = Util::createVector(DT_UUID, 2);
+    ASSERT_ANY_THROW(exportToArrow(uuids, &schema, &array));
+    ArrowArray unsigned8;
+    memset(&unsigned8, 0, sizeof(unsigned8));
+    unsigned8.release = [](ArrowArray* a){ a->release = nullptr; };
+    ArrowSchema unsignedSchema;
+    memset(&unsignedSchema, 0, sizeof(unsignedSchema));
+    unsignedSchema.format = "C";
+    unsignedSchema.release = [](ArrowSchema* s){ s->release = nullptr; };
+    ASSERT_ANY_THROW(importFromArrow(&unsignedSchema, &unsigned8));
+    ASSERT_EQ(nullptr, unsignedSchema.release);
+}
+
+TEST_F(FunctionTest, ExternalBufferVector){
+    static int freed;
+    freed = 0;
+    const int rows = 100000;
+    double* prices = new double[rows];
+    for(int i = 0; i < rows; ++i)
+        prices[i] = i * 0.5;
+    {
+        VectorSP vec = Util::createVector(DT_DOUBLE, rows, prices, [](void* data){ delete[] (double*)data; ++freed; }, true);
+        ASSERT_EQ(rows, vec->size());
+        ASSERT_TRUE(vec->isReadOnly());
+        ASSERT_EQ((void*)prices, vec->getDataArray());
+        ASSERT_EQ(49999.5, vec->getDouble(rows - 1));
+
+        //Sub vectors of a read-only vector share its buffer and keep it alive.
+        VectorSP sub = vec->getSubVector(10, 5);
+        ASSERT_EQ((void*)(prices + 10), sub->getDataArray());
+        ASSERT_TRUE(sub->isReadOnly());
+        ASSERT_EQ("[5,5.5,6,6.5,7]", sub->getString());
+        vec = VectorSP();
+        ASSERT_EQ(0, freed);
+        ASSERT_EQ(7.0, sub->getDouble(4));
+
+        //Marshalling writes the buffer as is, the same bytes as for an owned copy.
+        VectorSP owned = ((ConstantSP)sub)->getValue();
+        ASSERT_NE(sub->getDataArray(), owned->getDataArray());
+        auto marshall = [](const VectorSP& v){
+            DataOutputStreamSP out = new DataOutputStream(1024);
+            VectorMarshall marshall(out);
+            IO_ERR ret;
+            EXPECT_TRUE(marshall.start(v, true, false, ret));
+            marshall.flush();
+            return std::string(out->getBuffer(), out->size());
+        };
+        ASSERT_EQ(marshall(owned), marshall(sub));
+    }
+    ASSERT_EQ(1, freed);
+
+    //A large external vector round-trips through the marshaller.
+    std::shared_ptr<std::vector<long long>> pool = std::make_shared<std::vector<long long>>(rows);
+    for(int i = 0; i < rows; ++i)
+        (*pool)[i] = 1704187800000LL + i;
+    VectorSP ts = Util::createVector(DT_TIMESTAMP, rows, pool->data(), pool, true);
+    DataOutputStreamSP out = new DataOutputStream(1024);
+    VectorMarshall marshall(out);
+    IO_ERR ret;
+    ASSERT_TRUE(marshall.start(ts, true, false, ret));
+    marshall.flush();
+    DataInputStreamSP in = new DataInputStream(out->getBuffer(), out->size(), false);
+    short flag;
+    in->readShort(flag);
+    VectorUnmarshall unmarshall(in);
+    ASSERT_TRUE(unmarshall.start(flag, true, ret));
+    ASSERT_EQ(ts->getString(), unmarshall.getConstant()->getString());
+
+    //A writable vector updates the buffer in place until it grows into a buffer of its own.
+    std::shared_ptr<std::vector<int>> ints = std::make_shared<std::vector<int>>(4, 7);
+    VectorSP qty = Util::createVector(DT_INT, 4, ints->data(), ints);
+    ASSERT_FALSE(qty->isReadOnly());
+    qty->setInt(0, 1);
+    ASSERT_EQ(1, (*ints)[0]);
+    ASSERT_EQ("[1,7]", qty->getSubVector(0, 2)->getString());
+    ASSERT_NE((void*)ints->data(), qty->getSubVector(0, 2)->getDataArray());
+    qty->append(Util::createInt(9));
+    ASSERT_NE((void*)ints->data(), qty->getDataArray());
+    qty->setInt(1, 2);
+    ASSERT_EQ(7, (*ints)[1]);
+    ASSERT_EQ("[1,2,7,7,9]", qty->getString());
+
+    //Decimals are stored as their raw values.
+    std::shared_ptr<std::vector<long long>> cents = std::make_shared<std::vector<long long>>(3, 12345);
+    VectorSP amount = Util::createVector(DT_DECIMAL64, 3, cents->data(), cents, true, 2);
+    ASSERT_EQ("123.45", amount->getString(2));
+
+    //Tables refuse to change read-only columns in place, but may grow them.
+    TableSP table = Util::createTable({"ts", "qty"}, std::vector<ConstantSP>{ts->getSubVector(0, 4), Util::createVector(DT_INT, 4, ints->data(), ints, true)});
+    std::string errMsg;
+    std::vector<ConstantSP> values = {Util::createInt(5)};
+    std::vector<std::string> names = {"qty"};
+    ASSERT_FALSE(table->update(values, new Void(), names, errMsg));
+    ASSERT_FALSE(table->remove(Util::createVector(DT_INT, 1, 1), errMsg));
+    INDEX inserted;
+    std::vector<ConstantSP> row = {Util::createTimestamp(0), Util::createInt(3)};
+    ASSERT_TRUE(table->append(row, inserted, errMsg)) << errMsg;
+    ASSERT_EQ(5, table->rows());
+    ASSERT_EQ(1, (*ints)[0]);
+
+    ASSERT_ANY_THROW(Util::createVector(DT_STRING, 1, ints->data(), ints));
+    freed = 0;
+    char* bytes = new char[4];
+    ASSERT_ANY_THROW(Util::createVector(DT_SYMBOL, 4, bytes, [](void* data){ delete[] (char*)data; ++freed; }));
+    ASSERT_EQ(1, freed);
+}
+
+TEST_F(FunctionTest, VectorViews){
+    auto marshall = [](const ConstantSP& v, COMPRESS_METHOD method){
+        DataOutputStreamSP out = new DataOutputStream(1024);
+        VectorMarshall marshall(out);
+        marshall.setCompressMethod(method);
+        IO_ERR ret;
+        EXPECT_TRUE(marshall.start(v, true, method != COMPRESS_NONE, ret));
+        marshall.flush();
+        return std::string(out->getBuffer(), out->size());
+    };
+    auto checkSameAsCopy = [&](const VectorSP& view){
+        ConstantSP copy = ((ConstantSP)view)->getValue();
+        ASSERT_EQ(copy->getString(), view->getString());
+        ASSERT_EQ(marshall(copy, COMPRESS_NONE), marshall(view, COMPRESS_NONE));
+        if(view->getType() != DT_SYMBOL){
+            ASSERT_EQ(marshall(copy, COMPRESS_LZ4), marshall(view, COMPRESS_LZ4));
+        }
+    };
+
+    const int rows = 20000;
+    VectorSP ints = Util::createVector(DT_INT, rows);
+    VectorSP strs = Util::createVector(DT_STRING, rows);
+    VectorSP blobs = Util::createVector(DT_BLOB, rows);
+    VectorSP syms = Util::createSymbolVector(new SymbolBase(0), 0, rows);
+    VectorSP uuids = Util::createVector(DT_UUID, rows);
+    VectorSP decs = Util::createVector(DT_DECIMAL64, rows, 0, true, 2);
+    for(int i = 0; i < rows; ++i){
+        ints->setInt(i, i % 97 == 0 ? INT_MIN : i);
+        strs->setString(i, i % 89 == 0 ? "" : std::string(i % 300, 'a' + i % 26));
+        blobs->setString(i, std::string(i % 500, 'b'));
+        decs->setLong(i, i * 3LL);
+    }
+    ints->setNullFlag(true);
+    for(int i = 0; i < rows; ++i)
+        syms->append(Util::createString("s" + std::to_string(i % 50)));
+    for(int i = 0; i < rows; ++i){
+        unsigned char bytes[16];
+        for(int j = 0; j < 16; ++j)
+            bytes[j] = (unsigned char)(i + j);
+        uuids->setBinary(i, 16, bytes);
+    }
+
+    //A slice of a fixed-width vector is a plain vector over the source's buffer.
+    VectorSP slice = Util::createSliceView(ints, 100, 50);
+    ASSERT_EQ((void*)((int*)ints->getDataArray() + 100), slice->getDataArray());
+    ASSERT_TRUE(slice->isReadOnly());
+    ASSERT_TRUE(slice->isFastMode());
+    ASSERT_EQ(149, slice->getInt(49));
+    ints->setInt(149, -1);
+    ASSERT_EQ(-1, slice->getInt(49));
+    ints->setInt(149, 149);
+    checkSameAsCopy(slice);
+    //It stays valid when the source grows into a new buffer.
+    int* before = (int*)ints->getDataArray();
+    for(int i = 0; i < rows; ++i)
+        ints->append(Util::createInt(i));
+    ASSERT_NE(before, ints->getDataArray());
+    ASSERT_EQ(149, slice->getInt(49));
+    ASSERT_EQ(2 * rows, ints->size());
+    checkSameAsCopy(Util::createSliceView(decs, 7, 1000));
+    VectorSP symSlice = Util::createSliceView(syms, 10, 3);
+    ASSERT_EQ(syms->getSymbolBase().get(), symSlice->getSymbolBase().get());
+    ASSERT_EQ("[\"s10\",\"s11\",\"s12\"]", symSlice->getString());
+
+    //Other types and gathers are views that share the source.
+    std::shared_ptr<std::vector<int>> picks = std::make_shared<std::vector<int>>();
+    for(int i = rows - 1; i >= 0; i -= 3)
+        picks->push_back(i);
+    picks->push_back(0);
+    for(const VectorSP& source : {ints, strs, blobs, syms, uuids, decs}){
+        VectorSP gathered = Util::createGatherView(source, picks);
+        ASSERT_EQ((INDEX)picks->size(), gathered->size());
+        ASSERT_TRUE(dynamic_cast<VectorView*>(gathered.get()) != NULL);
+        ASSERT_EQ(source->getString((*picks)[5]), gathered->getString(5));
+        checkSameAsCopy(gathered);
+        checkSameAsCopy(Util::createSliceView(source, 3, rows - 10));
+        //Views of views compose over the original source.
+        VectorSP nested = gathered->getSubVector(2, 100);
+        ASSERT_EQ(source.get(), dynamic_cast<VectorView*>(nested.get())->getSource().get());
+        ASSERT_EQ(gathered->getString(2), nested->getString(0));
+        checkSameAsCopy(nested);
+    }
+    VectorSP view = Util::createSliceView(strs, 0, 10);
+    ASSERT_ANY_THROW(view->clear());
+    ASSERT_ANY_THROW(Util::createSliceView(strs, rows - 5, 10));
+    ASSERT_ANY_THROW(Util::createGatherView(strs, std::make_shared<std::vector<int>>(1, rows)));
+
+    //Appending from a view copies its rows.
+    VectorSP target = Util::createVector(DT_STRING, 0);
+    target->append(Util::createGatherView(strs, picks));
+    ASSERT_EQ(strs->getString(rows - 4), target->getString(1));
+    VectorSP intTarget = Util::createVector(DT_INT, 0);
+    intTarget->append(Util::createGatherView(ints, picks));
+    ASSERT_EQ(ints->getInt((*picks)[7]), intTarget->getInt(7));
+
+    //A temporal cast of a view converts a copy of its rows.
+    VectorSP dates = Util::createVector(DT_DATE, rows);
+    for(int i = 0; i < rows; ++i)
+        dates->setInt(i, i);
+    VectorSP dateView = Util::createGatherView(dates, picks);
+    VectorSP months = dateView->castTemporal(DT_MONTH);
+    ASSERT_EQ(DT_MONTH, months->getType());
+    ASSERT_EQ((INDEX)picks->size(), months->size());
+    ASSERT_EQ(dates->castTemporal(DT_MONTH)->getString((*picks)[9]), months->getString(9));
+
+    //Concurrent slices of a vector share one owner of its buffer.
+    VectorSP shared = Util::createVector(DT_LONG, rows);
+    std::vector<VectorSP> slices(8);
+    std::vector<std::thread> slicers;
+    for(int t = 0; t < 8; ++t)
+        slicers.emplace_back([&, t]{ slices[t] = Util::createSliceView(shared, t, 100); });
+    for(std::thread& slicer : slicers)
+        slicer.join();
+    for(int t = 0; t < 8; ++t)
+        ASSERT_EQ((void*)((long long*)shared->getDataArray() + t), slices[t]->getDataArray());
+    shared.clear();
+    for(int t = 0; t < 8; ++t)
+        slices[t]->getLong(99);
+
+    //Sub table views are read-only; marshalling one writes the same bytes as a copy.
+    TableSP table = Util::createTable({"id", "name", "sym", "uuid", "price"}, {Util::createSliceView(ints, 0, rows), strs, syms, uuids, decs});
+    TableSP owned = table->getSubTable(*picks);
+    ASSERT_FALSE(owned->isReadOnly());
+    ASSERT_EQ(table->getColumn(1)->getString((*picks)[3]), owned->getColumn(1)->getString(3));
+    TableSP sub = table->getSubTableView(*picks);
+    ASSERT_TRUE(sub->isReadOnly());
+    ASSERT_EQ((INDEX)picks->size(), sub->rows());
+    ASSERT_EQ(table->getColumn(1)->getString((*picks)[3]), sub->getColumn(1)->getString(3));
+    vector<ConstantSP> row = {Util::createInt(1), Util::createString("x"), Util::createString("s"), Util::createConstant(DT_UUID), Util::createNullConstant(DT_DECIMAL64, 2)};
+    INDEX inserted;
+    std::string errMsg;
+    ASSERT_FALSE(sub->append(row, inserted, errMsg));
+    TableSP copy = sub->getValue();
+    ASSERT_FALSE(copy->isReadOnly());
+    ASSERT_TRUE(copy->append(row, inserted, errMsg)) << errMsg;
+    auto marshallTable = [](const TableSP& t){
+        DataOutputStreamSP out = new DataOutputStream(1024);
+        TableMarshall marshall(out);
+        IO_ERR ret;
+        EXPECT_TRUE(marshall.start(0, 0, (ConstantSP)t, true, false, ret));
+        marshall.flush();
+        return std::string(out->getBuffer(), out->size());
+    };
+    ASSERT_EQ(marshallTable(sub->getValue()), marshallTable(sub));
+    for(int i = 0; i < table->columns(); ++i)
+        ASSERT_EQ(owned->getColumn(i)->getString(), sub->getColumn(i)->getString());
+    TableSP rangeTable = table->getSubTableView(1000, 5000);
+    ASSERT_EQ((void*)((int*)ints->getDataArray() + 1000), rangeTable->getColumn(0)->getDataArray());
+    ASSERT_EQ(marshallTable(rangeTable->getValue()), marshallTable(rangeTable));
+}
+
+TEST_F(FunctionTest, RadixScatter){
+    const int rows = 30011;
+    const int destinations = 7;
+    VectorSP ints = Util::createVector(DT_INT, rows);
+    VectorSP doubles = Util::createVector(DT_DOUBLE, rows);
+    VectorSP bools = Util::createVector(DT_BOOL, rows);
+    VectorSP strs = Util::createVector(DT_STRING, rows);
+    VectorSP blobs = Util::createVector(DT_BLOB, rows);
+    VectorSP syms = Util::createSymbolVector(new SymbolBase(0), 0, rows);
+    VectorSP uuids = Util::createVector(DT_UUID, rows);
+    VectorSP decs = Util::createVector(DT_DECIMAL128, rows, 0, true, 3);
+    VectorSP anys = Util::createVector(DT_ANY, rows);
+    vector<int> ids(rows);
+    for(int i = 0; i < rows; ++i){
+        ids[i] = (i * 31 + i / 5) % destinations;
+        ints->setInt(i, i % 101 == 0 ? INT_MIN : i);
+        doubles->setDouble(i, i * 0.25);
+        bools->setBool(i, i % 3 == 0);
+        strs->setString(i, i % 53 == 0 ? "" : std::string(i % 40, 'a' + i % 26));
+        blobs->setString(i, std::string(i % 70, 'z'));
+        syms->append(Util::createString("s" + std::to_string(i % 13)));
+        unsigned char bytes[16];
+        for(int j = 0; j < 16; ++j)
+            bytes[j] = (unsigned char)(i * 7 + j);
+        uuids->setBinary(i, 16, bytes);
+        decs->set(i, Util::createDecimal128(3, i * 1.5));
+        anys->set(i, Util::createInt(i));
+    }
+    ints->setNullFlag(true);
+    strs->setNullFlag(true);
+    TableSP table = Util::createTable({"i", "d", "b", "s", "bl", "sym", "u", "dec", "a", "view"},
+        {ints, doubles, bools, strs, blobs, syms, uuids, decs, anys, Util::createSliceView(strs, 0, rows)});
+
+    RadixScatter scatter(ids, destinations);
+    ASSERT_EQ(rows, scatter.offset(destinations));
+    vector<int> order = scatter.rowOrder();
+    vector<TableSP> parts = scatter.scatter(table);
+    ASSERT_EQ(destinations, (int)parts.size());
+    for(int dest = 0; dest < destinations; ++dest){
+        vector<int> expected;
+        for(int i = 0; i < rows; ++i){
+            if(ids[i] == dest)
+                expected.push_back(i);
+        }
+        ASSERT_EQ((INDEX)expected.size(), scatter.count(dest));
+        ASSERT_EQ(expected, vector<int>(order.begin() + scatter.offset(dest), order.begin() + scatter.offset(dest) + scatter.count(dest)));
+        TableSP part = parts[dest];
+        TableSP reference = table->getSubTable(expected);
+        ASSERT_FALSE(part->isReadOnly());
+        ASSERT_EQ(reference->rows(), part->rows());
+        for(int c = 0; c < table->columns(); ++c){
+            ASSERT_EQ(reference->getColumn(c)->getType(), part->getColumn(c)->getType());
+            ASSERT_EQ(reference->getColumn(c)->getString(), part->getColumn(c)->getString()) << c;
+        }
+        ASSERT_EQ(syms->getSymbolBase().get(), part->getColumn(5)->getSymbolBase().get());
+        ASSERT_TRUE(part->getColumn(0)->getNullFlag());
+    }
+    ASSERT_ANY_THROW(RadixScatter(vector<int>{0, 3}, 3));
+    ASSERT_ANY_THROW(RadixScatter(vector<int>{-1}, 3));
+    ASSERT_ANY_THROW(scatter.scatter(Util::createVector(DT_INT, rows - 1)));
+    //One destination is a plain copy.
+    vector<VectorSP> whole = RadixScatter(vector<int>(rows, 0), 1).scatter(ints);
+    ASSERT_EQ(ints->getString(), whole[0]->getString());
+}
+
 #endif
\ No newline at end of file
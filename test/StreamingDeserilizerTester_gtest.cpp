@@ -2195,4 +2195,293 @@ TEST_P(StreamingDeserilizerTester_arrayVector, test_Threadpooledclient_subscribe
     }
 
     usedPorts.insert(listenport);
-}
\ No newline at end of file
+}
+static ConstantSP createBlobBlock(int rows)
+{
+    //msg1: INT, DOUBLE, STRING, TIMESTAMP; msg2: SYMBOL, LONG
+    VectorSP timeVec = Util::createVector(DT_TIMESTAMP, rows);
+    VectorSP symVec = Util::createVector(DT_STRING, rows);
+    VectorSP blobVec = Util::createVector(DT_BLOB, rows);
+    for (int i = 0; i < rows; ++i)
+    {
+        string blob;
+        if (i % 3 != 2)
+        {
+            int iv = i % 7 == 0 ? INT_MIN : i;
+            double dv = i * 0.5;
+            string sv = "s" + std::to_string(i);
+            long long tv = 1000LL * i;
+            blob.append((const char *)&iv, sizeof(iv));
+            blob.append((const char *)&dv, sizeof(dv));
+            blob.append(sv.c_str(), sv.size() + 1);
+            blob.append((const char *)&tv, sizeof(tv));
+            symVec->setString(i, "msg1");
+        }
+        else
+        {
+            string sv = i % 2 == 0 ? "AAPL" : "IBM";
+            long long lv = -i;
+            blob.append(sv.c_str(), sv.size() + 1);
+            blob.append((const char *)&lv, sizeof(lv));
+            symVec->setString(i, "msg2");
+        }
+        blobVec->setString(i, blob);
+        timeVec->setLong(i, 0);
+    }
+    VectorSP src = Util::createVector(DT_ANY, 3);
+    src->set(0, timeVec);
+    src->set(1, symVec);
+    src->set(2, blobVec);
+    return src;
+}
+
+TEST_F(StreamingDeserilizerTester, parseBlob_rowsAndColumns)
+{
+    unordered_map<string, vector<DATA_TYPE>> sym2col;
+    sym2col["msg1"] = {DT_INT, DT_DOUBLE, DT_STRING, DT_TIMESTAMP};
+    sym2col["msg2"] = {DT_SYMBOL, DT_LONG};
+    StreamDeserializerSP sdsp = new StreamDeserializer(sym2col);
+    int rows = StreamDeserializer::PARALLEL_MIN_ROWS * 4 + 5;
+    ConstantSP src = createBlobBlock(rows);
+    for (int parallelism : {1, 4})
+    {
+        sdsp->setParallelism(parallelism);
+        vector<VectorSP> tuples;
+        vector<string> symbols;
+        ErrorCodeInfo errorInfo;
+        ASSERT_TRUE(sdsp->parseBlob(src, tuples, symbols, errorInfo)) << errorInfo.errorInfo;
+        ASSERT_EQ(tuples.size(), rows);
+        EXPECT_EQ(symbols[1], "msg1");
+        EXPECT_TRUE(tuples[0]->get(0)->isNull());
+        EXPECT_EQ(tuples[4]->get(0)->getInt(), 4);
+        EXPECT_EQ(tuples[4]->get(2)->getString(), "s4");
+        EXPECT_EQ(tuples[4]->get(3)->getLong(), 4000);
+        EXPECT_EQ(tuples[rows - 1]->get(0)->getString(), symbols[rows - 1] == "msg1" ? std::to_string(rows - 1) : (rows - 1) % 2 == 0 ? "AAPL" : "IBM");
+
+        unordered_map<string, vector<VectorSP>> columns;
+        ASSERT_TRUE(sdsp->parseBlob(src, columns, errorInfo)) << errorInfo.errorInfo;
+        ASSERT_TRUE(sdsp->parseBlob(src, columns, errorInfo)) << errorInfo.errorInfo;
+        vector<VectorSP> &msg1 = columns["msg1"];
+        vector<VectorSP> &msg2 = columns["msg2"];
+        ASSERT_EQ(msg1.size(), 4);
+        ASSERT_EQ(msg2.size(), 2);
+        EXPECT_EQ(msg1[0]->size() + msg2[0]->size(), 2 * rows);
+        EXPECT_EQ(msg1[0]->getType(), DT_INT);
+        EXPECT_EQ(msg1[3]->getType(), DT_TIMESTAMP);
+        EXPECT_EQ(msg2[0]->getType(), DT_SYMBOL);
+        EXPECT_TRUE(msg1[0]->hasNull());
+        EXPECT_TRUE(msg1[0]->isNull(0));
+        EXPECT_EQ(msg1[0]->getInt(2), 3);
+        EXPECT_EQ(msg1[1]->getDouble(2), 1.5);
+        EXPECT_EQ(msg1[2]->getString(2), "s3");
+        EXPECT_EQ(msg1[3]->getLong(2), 3000);
+        EXPECT_EQ(msg2[0]->getString(0), "AAPL");
+        EXPECT_EQ(msg2[1]->getLong(1), -5);
+        INDEX half = msg1[0]->size() / 2;
+        EXPECT_EQ(msg1[2]->getString(half + 2), "s3");
+    }
+
+    //Concurrent callers share the decode threads of the deserializer.
+    std::atomic<int> parsed(0);
+    vector<std::thread> callers;
+    for (int i = 0; i < 4; ++i)
+    {
+        callers.emplace_back([&]() {
+            vector<VectorSP> tuples;
+            vector<string> symbols;
+            ErrorCodeInfo errorInfo;
+            if (sdsp->parseBlob(src, tuples, symbols, errorInfo) && tuples.size() == (size_t)rows)
+                ++parsed;
+        });
+    }
+    for (auto &caller : callers)
+        caller.join();
+    EXPECT_EQ(parsed, 4);
+
+    //Blobs decoded from the wire are arena vectors; parsing reads them in place without converting them.
+    VectorSP arenaBlobs = Util::createArenaStringVector(DT_BLOB, rows);
+    StringVector *legacyBlobs = dynamic_cast<StringVector *>(src->get(2).get());
+    for (int i = 0; i < rows; ++i)
+    {
+        StringView blob = legacyBlobs->getStringView(i);
+        dynamic_cast<StringVector *>(arenaBlobs.get())->appendStringView(&blob, 1);
+    }
+    VectorSP arenaSrc = Util::createVector(DT_ANY, 3);
+    arenaSrc->set(0, src->get(0));
+    arenaSrc->set(1, src->get(1));
+    arenaSrc->set(2, arenaBlobs);
+    vector<VectorSP> arenaTuples;
+    vector<string> arenaSymbols;
+    unordered_map<string, vector<VectorSP>> arenaColumns;
+    ErrorCodeInfo arenaError;
+    ASSERT_TRUE(sdsp->parseBlob(arenaSrc, arenaTuples, arenaSymbols, arenaError)) << arenaError.errorInfo;
+    ASSERT_TRUE(sdsp->parseBlob(arenaSrc, arenaColumns, arenaError)) << arenaError.errorInfo;
+    EXPECT_TRUE(dynamic_cast<StringVector *>(arenaBlobs.get())->isArena());
+    EXPECT_EQ(arenaTuples[4]->get(2)->getString(), "s4");
+    EXPECT_EQ(arenaColumns["msg2"][0]->getString(0), "AAPL");
+
+    VectorSP badSymbols = src->get(1);
+    badSymbols->setString(10, "msg3");
+    vector<VectorSP> tuples;
+    vector<string> symbols;
+    ErrorCodeInfo errorInfo;
+    EXPECT_FALSE(sdsp->parseBlob(src, tuples, symbols, errorInfo));
+    EXPECT_NE(errorInfo.errorInfo.find("Unknown symbol msg3"), string::npos);
+}
+
+TEST_F(StreamingDeserilizerTester, symbolTableAccumulator)
+{
+    unordered_map<string, vector<DATA_TYPE>> sym2col;
+    sym2col["msg1"] = {DT_INT, DT_DOUBLE, DT_STRING, DT_TIMESTAMP};
+    sym2col["msg2"] = {DT_SYMBOL, DT_LONG};
+    StreamDeserializerSP sdsp = new StreamDeserializer(sym2col);
+    vector<pair<string, TableSP>> tables;
+    SymbolTableHandler keep = [&](const string &symbol, const TableSP &table) {
+        tables.emplace_back(symbol, table);
+    };
+    SymbolTableAccumulator accumulator(sdsp, keep, 16, 100);
+    ErrorCodeInfo errorInfo;
+    //30 rows: 20 msg1 and 10 msg2
+    ConstantSP src = createBlobBlock(30);
+    ASSERT_TRUE(accumulator.append(src, errorInfo)) << errorInfo.errorInfo;
+    ASSERT_EQ(tables.size(), 1);
+    EXPECT_EQ(tables[0].first, "msg1");
+    EXPECT_EQ(tables[0].second->rows(), 20);
+    EXPECT_EQ(tables[0].second->getColumnName(0), "col1");
+    EXPECT_EQ(tables[0].second->getColumn(2)->getString(2), "s3");
+
+    long long now = Util::getEpochTime();
+    int wait = accumulator.flushExpired(now);
+    EXPECT_GT(wait, 0);
+    EXPECT_LE(wait, 100);
+    EXPECT_EQ(tables.size(), 1);
+    EXPECT_EQ(accumulator.flushExpired(now + 200), 100);
+    ASSERT_EQ(tables.size(), 2);
+    EXPECT_EQ(tables[1].first, "msg2");
+    EXPECT_EQ(tables[1].second->rows(), 10);
+    EXPECT_EQ(tables[1].second->getColumn(1)->getLong(0), -2);
+
+    //Columns of a table the handler has released are recycled.
+    const Vector *lastColumn = nullptr;
+    SymbolTableHandler drop = [&](const string &symbol, const TableSP &table) {
+        if (symbol == "msg1")
+            lastColumn = (const Vector *)table->getColumn(0).get();
+    };
+    SymbolTableAccumulator recycler(sdsp, drop, 16, 100);
+    ASSERT_TRUE(recycler.append(src, errorInfo));
+    const Vector *first = lastColumn;
+    ASSERT_TRUE(recycler.append(src, errorInfo));
+    ASSERT_TRUE(recycler.append(src, errorInfo));
+    EXPECT_EQ(lastColumn, first);
+}
+
+class StreamingDeserilizerTester_parseThreads : public StreamingDeserilizerTester, public ::testing::WithParamInterface<int>
+{
+};
+
+//A heterogeneous stream table st, and local tables table1_SDT (msg1) and table2_SDT (msg2) of 1000 rows each to replay into it.
+static void createParseThreadsStream(const string &st)
+{
+    conn.run("login(\"admin\",\"123456\")\n\
+            st2 = streamTable(1:0, `timestampv`sym`blob`price1,[TIMESTAMP,SYMBOL,BLOB,DOUBLE])\n\
+            enableTableShareAndPersistence(table=st2, tableName=`" + st + ", asynWrite=true, compress=true, cacheSize=200000, retentionMinutes=180, preCache = 0)\n\
+            go\n\
+            setStreamTableFilterColumn(" + st + ", `sym)");
+    conn.run("n = 1000;\
+            table1_SDT = table(1:0, `datetimev`timestampv`sym`price1`price2, [DATETIME, TIMESTAMP, SYMBOL, DOUBLE, DOUBLE]);\
+            table2_SDT = table(1:0, `datetimev`timestampv`sym`price1, [DATETIME, TIMESTAMP, SYMBOL, DOUBLE]);\
+            tableInsert(table1_SDT, 2012.01.01T01:21:23 + 1..n, 2018.12.01T01:21:23.000 + 1..n, take(`a`b`c,n), rand(100,n)+rand(1.0, n), rand(100,n)+rand(1.0, n));\
+            tableInsert(table2_SDT, 2012.01.01T01:21:23 + 1..n, 2018.12.01T01:21:23.000 + 1..n, take(`a`b`c,n), rand(100,n)+rand(1.0, n));");
+}
+
+static void replayParseThreadsStream(const string &st, const string &symbols, const string &tables)
+{
+    conn.run("replay(inputTables=dict(" + symbols + ", " + tables + "), outputTables=`" + st + ", dateColumn=`timestampv, timeColumn=`timestampv)");
+}
+
+INSTANTIATE_TEST_SUITE_P(, StreamingDeserilizerTester_parseThreads, testing::Values(0, 3));
+TEST_P(StreamingDeserilizerTester_parseThreads, offsetsInOrder)
+{
+    const string st = "test_SD_" + getRandString(10);
+    createParseThreadsStream(st);
+    unordered_map<string, DictionarySP> sym2schema;
+    sym2schema["msg1"] = conn.run("schema(table1_SDT)");
+    sym2schema["msg2"] = conn.run("schema(table2_SDT)");
+    StreamDeserializerSP sdsp = new StreamDeserializer(sym2schema);
+
+    Signal notify;
+    Mutex mutex;
+    vector<long long> offsets;
+    int msg1_total = 0;
+    string metrics;
+    auto onehandler = [&](Message msg)
+    {
+        LockGuard<Mutex> lock(&mutex);
+        offsets.push_back(msg.getOffset());
+        if (msg.getSymbol() == "msg1")
+            msg1_total += 1;
+        if (msg.getOffset() == 1999)
+        {
+            //The pipeline gauges are unregistered when the parse thread ends.
+            metrics = MetricsRegistry::instance().toPrometheusText();
+            notify.set();
+        }
+    };
+
+    ThreadedClient threadedClient;
+    threadedClient.setParseThreads(GetParam(), 8);
+    auto thread1 = threadedClient.subscribe(hostName, port, onehandler, st, "test_SD", 0, true, nullptr, false, false, "admin", "123456", sdsp);
+    replayParseThreadsStream(st, "['msg1','msg2']", "[table1_SDT, table2_SDT]");
+    EXPECT_TRUE(notify.tryWait(60000));
+    threadedClient.unsubscribe(hostName, port, st, "test_SD");
+
+    LockGuard<Mutex> lock(&mutex);
+    ASSERT_EQ(offsets.size(), 2000u);
+    for (size_t i = 0; i < offsets.size(); ++i)
+        ASSERT_EQ(offsets[i], (long long)i);
+    EXPECT_EQ(msg1_total, 1000);
+    if (GetParam() > 0)
+    {
+        EXPECT_NE(metrics.find("ddb_streaming_stage_depth{stage=\"decode\",pipeline="), string::npos);
+        EXPECT_NE(metrics.find("ddb_streaming_stage_depth{stage=\"dispatch\",pipeline="), string::npos);
+        EXPECT_NE(metrics.find("ddb_streaming_stage_busy_nanoseconds_total{stage=\"decode\"}"), string::npos);
+    }
+    EXPECT_NE(metrics.find("ddb_streaming_stage_busy_nanoseconds_total{stage=\"read\"}"), string::npos);
+}
+
+TEST_P(StreamingDeserilizerTester_parseThreads, decodeFailureStopsParseThread)
+{
+    const string st = "test_SD_" + getRandString(10);
+    createParseThreadsStream(st);
+    //msg1 is unknown to the deserializer, so any block with a msg1 row fails to decode.
+    unordered_map<string, DictionarySP> sym2schema;
+    sym2schema["msg2"] = conn.run("schema(table2_SDT)");
+    StreamDeserializerSP sdsp = new StreamDeserializer(sym2schema);
+
+    Signal notify;
+    Mutex mutex;
+    vector<long long> offsets;
+    auto onehandler = [&](Message msg)
+    {
+        LockGuard<Mutex> lock(&mutex);
+        offsets.push_back(msg.getOffset());
+        if (msg.getOffset() == 999)
+            notify.set();
+    };
+
+    ThreadedClient threadedClient;
+    threadedClient.setParseThreads(GetParam(), 8);
+    auto thread1 = threadedClient.subscribe(hostName, port, onehandler, st, "test_SD", 0, false, nullptr, false, false, "admin", "123456", sdsp);
+    replayParseThreadsStream(st, "['msg2']", "[table2_SDT]");
+    EXPECT_TRUE(notify.tryWait(60000));
+    //The msg1 rows stop the parse thread, so the msg2 rows published after them never arrive.
+    replayParseThreadsStream(st, "['msg1']", "[table1_SDT]");
+    replayParseThreadsStream(st, "['msg2']", "[table2_SDT]");
+    Util::sleep(3000);
+    threadedClient.unsubscribe(hostName, port, st, "test_SD");
+
+    LockGuard<Mutex> lock(&mutex);
+    ASSERT_EQ(offsets.size(), 1000u);
+    for (size_t i = 0; i < offsets.size(); ++i)
+        ASSERT_EQ(offsets[i], (long long)i);
+}
@@ -12,6 +12,8 @@
 #include "Format.h"
 #include "DFSChunkMeta.h"
 #include "Logger.h"
+#include "Tracing.h"
+#include "Metrics.h"
 // #include "Database.h"
 // #include "Utility.h"
 // #include "DBTable.h"